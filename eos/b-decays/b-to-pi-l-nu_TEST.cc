@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2014, 2019 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,7 @@
 #include <eos/observable.hh>
 #include <eos/b-decays/b-to-psd-l-nu.hh>
 #include <eos/maths/complex.hh>
+#include <eos/utils/observable_cache.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
 #include <array>
@@ -169,5 +171,54 @@ class BToPiLeptonNeutrinoTest :
 
                 TEST_CHECK_NEARLY_EQUAL(8.29930e-5 / 2.,  d.integrated_branching_ratio( 0.01, 12.00), eps);
             }
+
+            // Consistency check for the binned observables, which share one cumulative spectrum
+            {
+                Parameters p = Parameters::Defaults();
+                p["CKM::abs(V_ub)"]        =  3.32e-3;
+                p["B->pi::f_+(0)@BCL2008"] =  0.290;
+                p["B->pi::b_+^1@BCL2008"]  = -1.930;
+                p["B->pi::b_+^2@BCL2008"]  = -0.441;
+                p["mass::B_d"]             =  5.2796;
+                p["mass::pi^+"]            =  1.3957e-1;
+
+                Options oo
+                {
+                    { "model",        "CKM" },
+                    { "form-factors", "BCL2008" },
+                    { "U",            "u"       },
+                    { "q",            "d"       },
+                    { "l",            "mu"      },
+                    { "I",            "1"       }
+                };
+
+                BToPseudoscalarLeptonNeutrino d(p, oo);
+
+                const std::vector<std::array<double, 2>> bins
+                {
+                    {{  0.01,  2.00 }}, {{  2.00,  4.00 }}, {{  4.00,  6.00 }}, {{  6.00,  8.00 }},
+                    {{  8.00, 10.00 }}, {{ 10.00, 12.00 }}, {{ 12.00, 16.00 }}, {{ 16.00, 26.40 }}
+                };
+
+                ObservableCache cache(p);
+                std::vector<std::array<ObservableCache::Id, 2>> ids;
+                for (const auto & bin : bins)
+                {
+                    Kinematics k{ { "q2_min", bin[0] }, { "q2_max", bin[1] } };
+                    ids.push_back({{
+                        cache.add(Observable::make("B->pilnu::BR",                p, k, oo)),
+                        cache.add(Observable::make("B->pilnu::P(q2_min,q2_max)", p, k, oo))
+                    }});
+                }
+                cache.update();
+
+                const double eps = 1e-5;
+                for (unsigned i = 0 ; i < bins.size() ; ++i)
+                {
+                    const auto & bin = bins[i];
+                    TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio(bin[0], bin[1]), cache[ids[i][0]], eps);
+                    TEST_CHECK_RELATIVE_ERROR(d.integrated_pdf_q2(bin[0], bin[1]),          cache[ids[i][1]], eps);
+                }
+            }
         }
 } b_to_pi_l_nu_test;
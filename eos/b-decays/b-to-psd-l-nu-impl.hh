@@ -0,0 +1,80 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_B_DECAYS_B_TO_PSD_L_NU_IMPL_HH
+#define EOS_GUARD_EOS_B_DECAYS_B_TO_PSD_L_NU_IMPL_HH 1
+
+#include <eos/observable.hh>
+#include <eos/b-decays/b-to-psd-l-nu.hh>
+
+#include <vector>
+
+namespace eos
+{
+    namespace b_to_psd_l_nu
+    {
+        /*
+         * Cumulative integral of the normalized (|V_Ub| = 1) differential decay width
+         * across the entire physical q2 range.
+         *
+         * The q2 range is split into adaptively refined panels. For each panel we keep the
+         * differential decay width at its lower boundary and its midpoint, and the integral of the
+         * differential decay width from the lower end of the physical range to its lower boundary.
+         * Within each panel the differential decay width is interpolated quadratically.
+         */
+        struct CumulativeSpectrum
+        {
+            // panel boundaries; n + 1 entries for n panels
+            std::vector<double> q2;
+
+            // differential decay width at the panel boundaries; n + 1 entries
+            std::vector<double> width;
+
+            // differential decay width at the panel midpoints; n entries
+            std::vector<double> width_mid;
+
+            // integrated decay width up to the panel boundaries; n + 1 entries
+            std::vector<double> cumulative;
+
+            // integrated decay width from the lower end of the physical range up to q2
+            double integral(const double & q2) const;
+
+            // integrated decay width between q2_min and q2_max
+            double integral(const double & q2_min, const double & q2_max) const;
+
+            // integrated decay width across the entire physical range
+            double total() const;
+        };
+    }
+
+    class BToPseudoscalarLeptonNeutrino::IntermediateResult :
+        public CacheableObservable::IntermediateResult
+    {
+        public:
+            b_to_psd_l_nu::CumulativeSpectrum spectrum;
+
+            IntermediateResult()
+            {
+            }
+
+            ~IntermediateResult() = default;
+    };
+}
+
+#endif
@@ -5,6 +5,7 @@
  * Copyright (c) 2015 Marzia Bordone
  * Copyright (c) 2018, 2019 Ahmet Kokulu
  * Copyright (c) 2021 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,7 @@
  */
 
 #include <eos/b-decays/b-to-psd-l-nu.hh>
+#include <eos/b-decays/b-to-psd-l-nu-impl.hh>
 #include <eos/form-factors/form-factors.hh>
 #include <eos/maths/integrate.hh>
 #include <eos/maths/power-of.hh>
@@ -30,6 +32,8 @@
 #include <eos/utils/options-impl.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
+#include <algorithm>
+#include <array>
 #include <map>
 #include <string>
 
@@ -49,6 +53,41 @@ namespace eos
             double p;
             double NF;
         };
+
+        double
+        CumulativeSpectrum::integral(const double & x) const
+        {
+            if (x <= q2.front())
+                return 0.0;
+
+            if (x >= q2.back())
+                return cumulative.back();
+
+            // find the panel [q2[i], q2[i + 1]) that contains x
+            const std::size_t i = std::upper_bound(q2.cbegin(), q2.cend(), x) - q2.cbegin() - 1;
+            const double h  = q2[i + 1] - q2[i];
+            const double t  = (x - q2[i]) / h;
+            const double t2 = t * t, t3 = t2 * t;
+
+            // integrals of the quadratic Lagrange polynomials through t = 0, 1/2, 1 from 0 to t
+            return cumulative[i] + h * (
+                      width[i]     * (2.0 / 3.0 * t3 - 3.0 / 2.0 * t2 + t)
+                    + width_mid[i] * (-4.0 / 3.0 * t3 + 2.0 * t2)
+                    + width[i + 1] * (2.0 / 3.0 * t3 - 1.0 / 2.0 * t2)
+                   );
+        }
+
+        double
+        CumulativeSpectrum::integral(const double & q2_min, const double & q2_max) const
+        {
+            return integral(q2_max) - integral(q2_min);
+        }
+
+        double
+        CumulativeSpectrum::total() const
+        {
+            return cumulative.back();
+        }
     }
 
     template <>
@@ -90,6 +129,10 @@ namespace eos
 
         GSL::QAGS::Config int_config;
 
+        using IntermediateResult = BToPseudoscalarLeptonNeutrino::IntermediateResult;
+
+        IntermediateResult intermediate_result;
+
         bool cp_conjugate;
 
         // { U, q, I } -> { process, m_B, m_V, c_I }
@@ -412,6 +455,84 @@ namespace eos
 
             return integrated_pdf_q2(q2_min, q2_max) * (q2_max - q2_min) / (w_max - w_min);
         }
+
+        // Split the panel [a, b] until Simpson's rule agrees with its composite counterpart, and append the resulting panels
+        void refine_spectrum(b_to_psd_l_nu::CumulativeSpectrum & spectrum, double & running,
+                const double & a, const double & b, const double & f_a, const double & f_m, const double & f_b,
+                const double & tolerance, const unsigned & depth) const
+        {
+            const double h   = b - a;
+            const double m   = (a + b) / 2.0;
+            const double f_l = normalized_differential_decay_width((a + m) / 2.0);
+            const double f_r = normalized_differential_decay_width((m + b) / 2.0);
+
+            const double coarse = h / 6.0  * (f_a + 4.0 * f_m + f_b);
+            const double fine   = h / 12.0 * (f_a + 4.0 * f_l + 2.0 * f_m + 4.0 * f_r + f_b);
+
+            if ((0 == depth) || (std::abs(fine - coarse) <= 15.0 * tolerance))
+            {
+                spectrum.q2.push_back(a);
+                spectrum.width.push_back(f_a);
+                spectrum.width_mid.push_back(f_l);
+                spectrum.cumulative.push_back(running);
+                running += h / 12.0 * (f_a + 4.0 * f_l + f_m);
+
+                spectrum.q2.push_back(m);
+                spectrum.width.push_back(f_m);
+                spectrum.width_mid.push_back(f_r);
+                spectrum.cumulative.push_back(running);
+                running += h / 12.0 * (f_m + 4.0 * f_r + f_b);
+
+                return;
+            }
+
+            refine_spectrum(spectrum, running, a, m, f_a, f_l, f_m, tolerance / 2.0, depth - 1);
+            refine_spectrum(spectrum, running, m, b, f_m, f_r, f_b, tolerance / 2.0, depth - 1);
+        }
+
+        // Build the cumulative spectrum across the entire physical q2 range
+        const IntermediateResult * prepare_spectrum()
+        {
+            static const unsigned initial_panels = 16;
+            static const unsigned max_depth = 10;
+            static const double epsrel = 1.0e-7;
+
+            const double q2_min = power_of<2>(m_l());
+            const double q2_max = power_of<2>(m_B() - m_P());
+            const double h      = (q2_max - q2_min) / initial_panels;
+
+            // evaluate on a coarse grid first, to estimate the total width
+            std::array<double, 2 * initial_panels + 1> f;
+            for (unsigned i = 0 ; i < f.size() ; ++i)
+            {
+                f[i] = normalized_differential_decay_width(q2_min + h * i / 2.0);
+            }
+
+            double estimate = 0.0;
+            for (unsigned i = 0 ; i < initial_panels ; ++i)
+            {
+                estimate += h / 6.0 * (f[2 * i] + 4.0 * f[2 * i + 1] + f[2 * i + 2]);
+            }
+            const double tolerance = epsrel * std::abs(estimate) / initial_panels;
+
+            auto & spectrum = intermediate_result.spectrum;
+            spectrum.q2.clear();
+            spectrum.width.clear();
+            spectrum.width_mid.clear();
+            spectrum.cumulative.clear();
+
+            double running = 0.0;
+            for (unsigned i = 0 ; i < initial_panels ; ++i)
+            {
+                refine_spectrum(spectrum, running, q2_min + h * i, q2_min + h * (i + 1), f[2 * i], f[2 * i + 1], f[2 * i + 2], tolerance, max_depth);
+            }
+
+            spectrum.q2.push_back(q2_max);
+            spectrum.width.push_back(f.back());
+            spectrum.cumulative.push_back(running);
+
+            return &intermediate_result;
+        }
     };
 
     const std::map<std::tuple<char, char, std::string>, std::tuple<std::string, std::string, std::string, double>>
@@ -614,6 +735,63 @@ namespace eos
         return _imp->integrated_pdf_w(w_min, w_max);
     }
 
+    const BToPseudoscalarLeptonNeutrino::IntermediateResult *
+    BToPseudoscalarLeptonNeutrino::prepare_spectrum() const
+    {
+        return _imp->prepare_spectrum();
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::integrated_branching_ratio_from_spectrum(const IntermediateResult * ir, const double & q2_min, const double & q2_max) const
+    {
+        return ir->spectrum.integral(q2_min, q2_max) * std::norm(_imp->v_Ub()) * _imp->tau_B / _imp->hbar;
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio_from_spectrum(const IntermediateResult * ir, const double & q2_min, const double & q2_max) const
+    {
+        return ir->spectrum.integral(q2_min, q2_max) * _imp->tau_B / _imp->hbar;
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::normalized_integrated_decay_width_from_spectrum(const IntermediateResult * ir, const double & q2_min, const double & q2_max) const
+    {
+        return ir->spectrum.integral(q2_min, q2_max);
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::differential_pdf_q2_from_spectrum(const IntermediateResult * ir, const double & q2) const
+    {
+        return _imp->normalized_differential_decay_width(q2) / ir->spectrum.total();
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::differential_pdf_w_from_spectrum(const IntermediateResult * ir, const double & w) const
+    {
+        const double m_B = _imp->m_B(), m_B2 = m_B * m_B;
+        const double m_P = _imp->m_P(), m_P2 = m_P * m_P;
+        const double q2  = m_B2 + m_P2 - 2.0 * m_B * m_P * w;
+
+        return 2.0 * m_B * m_P * differential_pdf_q2_from_spectrum(ir, q2);
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::integrated_pdf_q2_from_spectrum(const IntermediateResult * ir, const double & q2_min, const double & q2_max) const
+    {
+        return ir->spectrum.integral(q2_min, q2_max) / ir->spectrum.total() / (q2_max - q2_min);
+    }
+
+    double
+    BToPseudoscalarLeptonNeutrino::integrated_pdf_w_from_spectrum(const IntermediateResult * ir, const double & w_min, const double & w_max) const
+    {
+        const double m_B    = _imp->m_B(), m_B2 = m_B * m_B;
+        const double m_P    = _imp->m_P(), m_P2 = m_P * m_P;
+        const double q2_max = m_B2 + m_P2 - 2.0 * m_B * m_P * w_min;
+        const double q2_min = m_B2 + m_P2 - 2.0 * m_B * m_P * w_max;
+
+        return integrated_pdf_q2_from_spectrum(ir, q2_min, q2_max) * (q2_max - q2_min) / (w_max - w_min);
+    }
+
     const std::string
     BToPseudoscalarLeptonNeutrino::description = "\
     The decay B->P l nu, where both B=(B qbar) and P=(U qbar) are pseudoscalars, and l=e,mu,tau is a lepton.";
@@ -4,6 +4,7 @@
  * Copyright (c) 2013, 2014, 2015, 2016, 2017 Danny van Dyk
  * Copyright (c) 2018, 2019 Ahmet Kokulu
  * Copyright (c) 2019 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -70,6 +71,17 @@ namespace eos
             double integrated_pdf_q2(const double & q2_min, const double & q2_max) const;
             double integrated_pdf_w(const double & w_min, const double & w_max) const;
 
+            // Observables evaluated from the cumulative q2 spectrum, which is shared by all bins
+            class IntermediateResult;
+            const IntermediateResult * prepare_spectrum() const;
+            double integrated_branching_ratio_from_spectrum(const IntermediateResult *, const double & q2_min, const double & q2_max) const;
+            double normalized_integrated_branching_ratio_from_spectrum(const IntermediateResult *, const double & q2_min, const double & q2_max) const;
+            double normalized_integrated_decay_width_from_spectrum(const IntermediateResult *, const double & q2_min, const double & q2_max) const;
+            double differential_pdf_q2_from_spectrum(const IntermediateResult *, const double & q2) const;
+            double differential_pdf_w_from_spectrum(const IntermediateResult *, const double & w) const;
+            double integrated_pdf_q2_from_spectrum(const IntermediateResult *, const double & q2_min, const double & q2_max) const;
+            double integrated_pdf_w_from_spectrum(const IntermediateResult *, const double & w_min, const double & w_max) const;
+
             /*!
              * Descriptions of the process and its kinematics.
              */
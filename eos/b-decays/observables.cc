@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2019-2021 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -22,6 +23,7 @@
 #include <eos/b-decays/b-to-l-nu.hh>
 #include <eos/b-decays/b-to-pi-pi-l-nu.hh>
 #include <eos/b-decays/b-to-psd-l-nu.hh>
+#include <eos/b-decays/b-to-psd-l-nu-impl.hh>
 #include <eos/b-decays/b-to-psd-nu-nu.hh>
 #include <eos/b-decays/b-to-vec-l-nu.hh>
 #include <eos/b-decays/b-to-vec-l-nu-impl.hh>
@@ -77,15 +79,17 @@ namespace eos
                         std::make_tuple("q2"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
-                make_observable("B->pilnu::BR", R"(\mathcal{B}(B\to\pi\ell^-\bar\nu))",
+                make_cacheable_observable("B->pilnu::BR", R"(\mathcal{B}(B\to\pi\ell^-\bar\nu))",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
-                make_observable("B->pilnu::width", R"(\Gamma(B\to\pi\ell^-\bar\nu))",
+                make_cacheable_observable("B->pilnu::width", R"(\Gamma(B\to\pi\ell^-\bar\nu))",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_decay_width,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_decay_width_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
@@ -145,15 +149,17 @@ namespace eos
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
-                make_observable("B->pilnu::P(q2)", R"(dP(B\to\pi\ell^-\bar\nu)/dq^2)",
+                make_cacheable_observable("B->pilnu::P(q2)", R"(dP(B\to\pi\ell^-\bar\nu)/dq^2)",
                         Unit::InverseGeV2(),
-                        &BToPseudoscalarLeptonNeutrino::differential_pdf_q2,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::differential_pdf_q2_from_spectrum,
                         std::make_tuple("q2"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
-                make_observable("B->pilnu::P(q2_min,q2_max)", R"(P(B\to\pi\ell^-\bar\nu))",
+                make_cacheable_observable("B->pilnu::P(q2_min,q2_max)", R"(P(B\to\pi\ell^-\bar\nu))",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_q2,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_q2_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
@@ -169,9 +175,10 @@ namespace eos
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
 
-                make_observable("B->pilnu::zeta",
+                make_cacheable_observable("B->pilnu::zeta", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "u" }, { "I", "1" } }),
             }
@@ -197,9 +204,10 @@ namespace eos
                         std::make_tuple("q2"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
-                make_observable("B->Dlnu::BR", R"(\mathcal{B}(B\to \bar{D}\ell^-\bar\nu))",
+                make_cacheable_observable("B->Dlnu::BR", R"(\mathcal{B}(B\to \bar{D}\ell^-\bar\nu))",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
@@ -209,9 +217,10 @@ namespace eos
                         std::make_tuple("q2"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
-                make_observable("B->Dlnu::normBR",
+                make_cacheable_observable("B->Dlnu::normBR", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
@@ -243,15 +252,17 @@ namespace eos
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
-                make_observable("B->Dlnu::P(w)",
+                make_cacheable_observable("B->Dlnu::P(w)", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::differential_pdf_w,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::differential_pdf_w_from_spectrum,
                         std::make_tuple("w"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
-                make_observable("B->Dlnu::P(w_min,w_max)",
+                make_cacheable_observable("B->Dlnu::P(w_min,w_max)", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_w,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_w_from_spectrum,
                         std::make_tuple("w_min", "w_max"),
                         Options{ { "U", "c" }, { "I", "1/2" } }),
 
@@ -283,9 +294,10 @@ namespace eos
                         std::make_tuple("q2"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
-                make_observable("B_s->D_slnu::BR", R"(\mathcal{B}(B_s\to \bar{D}_s\ell^-\bar\nu))",
+                make_cacheable_observable("B_s->D_slnu::BR", R"(\mathcal{B}(B_s\to \bar{D}_s\ell^-\bar\nu))",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
@@ -295,9 +307,10 @@ namespace eos
                         std::make_tuple("q2"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
-                make_observable("B_s->D_slnu::normBR",
+                make_cacheable_observable("B_s->D_slnu::normBR", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::normalized_integrated_branching_ratio_from_spectrum,
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
@@ -329,15 +342,17 @@ namespace eos
                         std::make_tuple("q2_min", "q2_max"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
-                make_observable("B_s->D_slnu::P(w)",
+                make_cacheable_observable("B_s->D_slnu::P(w)", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::differential_pdf_w,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::differential_pdf_w_from_spectrum,
                         std::make_tuple("w"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
-                make_observable("B_s->D_slnu::P(w_min,w_max)",
+                make_cacheable_observable("B_s->D_slnu::P(w_min,w_max)", R"()",
                         Unit::None(),
-                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_w,
+                        &BToPseudoscalarLeptonNeutrino::prepare_spectrum,
+                        &BToPseudoscalarLeptonNeutrino::integrated_pdf_w_from_spectrum,
                         std::make_tuple("w_min", "w_max"),
                         Options{ { "U", "c" }, {"q", "s"}, { "I", "0" } }),
 
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011-2021 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -26,10 +27,12 @@
 #include <eos/utils/destringify.hh>
 #include <eos/utils/exception.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qualified-name.hh>
+#include <eos/utils/registry-cache.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
@@ -2252,13 +2255,78 @@ namespace eos
         return std::bind(&Factory_::make, f, std::placeholders::_1, std::placeholders::_2);
     }
 
-    std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>
-    load_constraint_entries()
+    /*
+     * DeferredConstraintEntry holds the YAML representation of a constraint that has been read from
+     * a snapshot of the constraint input files. The representation is only deserialized once the
+     * entry is actually used.
+     */
+    class DeferredConstraintEntry :
+        public ConstraintEntry
     {
-        using ValueType = std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>::value_type;
+        private:
+            QualifiedName _name;
 
-        std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> result;
+            std::string _yaml;
+
+            mutable Mutex _mutex;
+
+            mutable std::shared_ptr<const ConstraintEntry> _entry;
+
+            const ConstraintEntry & entry() const
+            {
+                Lock l(_mutex);
+
+                if (! _entry)
+                {
+                    _entry.reset(ConstraintEntry::FromYAML(_name, YAML::Load(_yaml)));
+                }
+
+                return *_entry;
+            }
+
+        public:
+            DeferredConstraintEntry(const QualifiedName & name, const std::string & yaml) :
+                _name(name),
+                _yaml(yaml)
+            {
+            }
+
+            virtual ~DeferredConstraintEntry() = default;
+
+            virtual Constraint make(const QualifiedName & name, const Options & options) const
+            {
+                return entry().make(name, options);
+            }
+
+            virtual const QualifiedName & name() const
+            {
+                return _name;
+            }
+
+            virtual const std::string & type() const
+            {
+                return entry().type();
+            }
+
+            virtual ConstraintEntry::ObservableNameIterator begin_observable_names() const
+            {
+                return entry().begin_observable_names();
+            }
 
+            virtual ConstraintEntry::ObservableNameIterator end_observable_names() const
+            {
+                return entry().end_observable_names();
+            }
+
+            virtual void serialize(YAML::Emitter & out) const
+            {
+                entry().serialize(out);
+            }
+    };
+
+    fs::path
+    constraint_entries_directory()
+    {
         fs::path base;
         if (std::getenv("EOS_TESTS_CONSTRAINTS"))
         {
@@ -2285,6 +2353,38 @@ namespace eos
             throw InternalError("Expect '" + base.string() + " to be a directory");
         }
 
+        return base;
+    }
+
+    std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>
+    load_constraint_entries()
+    {
+        using ValueType = std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>::value_type;
+
+        std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> result;
+
+        const fs::path base = constraint_entries_directory();
+
+        // use the snapshot of the input files if it is still valid; its entries are deserialized on demand
+        RegistryCache cache("constraints", base.string());
+        const bool loaded = cache.load([&] (RegistryCache::Reader & reader)
+        {
+            for (auto i = reader.read_unsigned() ; i > 0 ; --i)
+            {
+                QualifiedName name(reader.read_string());
+                std::string yaml = reader.read_string();
+
+                result.insert(ValueType{ name, std::make_shared<DeferredConstraintEntry>(name, yaml) });
+            }
+        });
+
+        if (loaded)
+            return result;
+
+        result.clear();
+
+        // otherwise parse all input files, and store the YAML representation of each entry in a new snapshot
+        std::vector<std::pair<std::string, std::string>> snapshot;
         for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
         {
             auto file_path = f->path();
@@ -2314,6 +2414,10 @@ namespace eos
                     {
                         throw ConstraintInputFileParseError(file, "encountered duplicate constraint '" + keyname + "'");
                     }
+
+                    YAML::Emitter out;
+                    out << p.second;
+                    snapshot.emplace_back(name.str(), out.c_str());
                 }
             }
             catch (ConstraintDeserializationError & e)
@@ -2322,6 +2426,15 @@ namespace eos
             }
         }
 
+        RegistryCache::Writer writer;
+        writer.write_unsigned(snapshot.size());
+        for (const auto & s : snapshot)
+        {
+            writer.write_string(s.first);
+            writer.write_string(s.second);
+        }
+        cache.store(writer);
+
         return result;
     }
 
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011, 2013, 2014, 2015, 2017 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -25,12 +26,26 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 using namespace test;
 using namespace eos;
 
+namespace fs = boost::filesystem;
+
+namespace eos
+{
+    // defined in eos/constraint.cc
+    std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> load_constraint_entries();
+}
+
 class ConstraintDeserializationTest :
     public TestCase
 {
@@ -1355,3 +1370,105 @@ class ConstraintTest :
             }
         }
 } constraint_test;
+
+class DeferredConstraintEntryTest :
+    public TestCase
+{
+    public:
+        DeferredConstraintEntryTest() :
+            TestCase("deferred_constraint_entry_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            const fs::path base = fs::temp_directory_path() / fs::unique_path("eos-constraint-cache-%%%%-%%%%");
+            fs::create_directories(base);
+
+            const char * previous_cache_dir = std::getenv("EOS_CACHE_DIR");
+            const std::string previous = previous_cache_dir ? previous_cache_dir : "";
+            ::setenv("EOS_CACHE_DIR", base.c_str(), 1);
+
+            // the first load parses the input files and writes a snapshot
+            auto parsed = load_constraint_entries();
+
+            bool has_snapshot = false;
+            for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
+            {
+                if (0 == f->path().filename().string().find("constraints-"))
+                    has_snapshot = true;
+            }
+            TEST_CHECK(has_snapshot);
+
+            // the second load reads the snapshot, and yields deferred entries
+            auto loaded = load_constraint_entries();
+            TEST_CHECK_EQUAL(parsed.size(), loaded.size());
+
+            auto p = parsed.cbegin(), p_end = parsed.cend();
+            auto l = loaded.cbegin(), l_end = loaded.cend();
+            for ( ; (p != p_end) && (l != l_end) ; ++p, ++l)
+            {
+                TEST_CHECK_EQUAL(p->first,         l->first);
+                TEST_CHECK_EQUAL(p->second->name(), l->second->name());
+                TEST_CHECK_EQUAL(p->second->type(), l->second->type());
+
+                std::vector<QualifiedName> parsed_names(p->second->begin_observable_names(), p->second->end_observable_names());
+                std::vector<QualifiedName> loaded_names(l->second->begin_observable_names(), l->second->end_observable_names());
+                TEST_CHECK(parsed_names == loaded_names);
+
+                TEST_CHECK_EQUAL(p->second->serialize(), l->second->serialize());
+            }
+            TEST_CHECK(p == p_end);
+            TEST_CHECK(l == l_end);
+
+            // constraints made from deferred entries match those made from parsed entries
+            static const std::vector<QualifiedName> names
+            {
+                "B->pi::f_+@IKMvD:2014A",
+                "B->K::f_0+f_++f_T@HPQCD:2013A"
+            };
+
+            for (const auto & n : names)
+            {
+                auto p = parsed.find(n);
+                auto l = loaded.find(n);
+                TEST_CHECK(p != parsed.end());
+                TEST_CHECK(l != loaded.end());
+
+                Constraint cp = p->second->make(n, Options());
+                Constraint cl = l->second->make(n, Options());
+                TEST_CHECK_EQUAL(cp.name(), cl.name());
+
+                auto op = cp.begin_observables(), op_end = cp.end_observables();
+                auto ol = cl.begin_observables(), ol_end = cl.end_observables();
+                for ( ; (op != op_end) && (ol != ol_end) ; ++op, ++ol)
+                {
+                    TEST_CHECK_EQUAL((**op).name(),                    (**ol).name());
+                    TEST_CHECK_EQUAL((**op).kinematics().as_string(), (**ol).kinematics().as_string());
+                    TEST_CHECK_EQUAL((**op).evaluate(),               (**ol).evaluate());
+                }
+                TEST_CHECK(op == op_end);
+                TEST_CHECK(ol == ol_end);
+
+                auto bp = cp.begin_blocks(), bp_end = cp.end_blocks();
+                auto bl = cl.begin_blocks(), bl_end = cl.end_blocks();
+                for ( ; (bp != bp_end) && (bl != bl_end) ; ++bp, ++bl)
+                {
+                    TEST_CHECK_EQUAL((**bp).as_string(), (**bl).as_string());
+                }
+                TEST_CHECK(bp == bp_end);
+                TEST_CHECK(bl == bl_end);
+            }
+
+            if (previous_cache_dir)
+            {
+                ::setenv("EOS_CACHE_DIR", previous.c_str(), 1);
+            }
+            else
+            {
+                ::unsetenv("EOS_CACHE_DIR");
+            }
+
+            fs::remove_all(base);
+        }
+} deferred_constraint_entry_test;
@@ -0,0 +1,50 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_FORM_FACTORS_ANALYTIC_B_LCSR_MOMENTS_HH
+#define EOS_GUARD_EOS_FORM_FACTORS_ANALYTIC_B_LCSR_MOMENTS_HH 1
+
+namespace eos
+{
+    namespace lcsr
+    {
+        /*!
+         * Result of a combined evaluation of a B-LCSR for a single form factor.
+         */
+        struct SumRuleMoments
+        {
+            /// The form factor.
+            double value;
+
+            /// The first moment of the Borel-transformed sum rule.
+            double moment_1;
+
+            /// The zeroth moment of the Borel-transformed sum rule, i.e., the normalization of the moments.
+            double normalization;
+
+            /// The first moment, normalized to the zeroth moment.
+            double normalized_moment_1() const
+            {
+                return moment_1 / normalization;
+            }
+        };
+    }
+}
+
+#endif
@@ -4,6 +4,7 @@
  * Copyright (c) 2017 Danny van Dyk
  * Copyright (c) 2018 Nico Gubernari
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -25,7 +26,7 @@
 #include <eos/form-factors/analytic-b-to-p-lcsr.hh>
 #include <eos/form-factors/b-lcdas.hh>
 #include <eos/utils/exception.hh>
-#include <eos/maths/integrate.hh>
+#include <eos/maths/integrate-impl.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/models/model.hh>
@@ -34,7 +35,9 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <array>
 #include <functional>
+#include <limits>
 
 namespace eos
 {
@@ -346,6 +349,92 @@ namespace eos
             return sigma(s0, q2);
         }
 
+        /* Combined evaluation of a sum rule and its moments */
+        // {{{
+        using Function2pt  = double (Implementation::*)(const double &, const double &) const;
+        using Function3pt  = double (Implementation::*)(const std::array<double, 3> &, const double &) const;
+        using Surface3ptA  = double (Implementation::*)(const std::array<double, 2> &, const double &, const double &) const;
+        using Surface3ptBC = double (Implementation::*)(const double &, const double &, const double &) const;
+
+        // The integrands and surface terms of the sum rule for one form factor, and their first moments
+        struct SumRule
+        {
+            const std::function<double (const Implementation *, const double &, const double &)> & integrand_2pt;
+            Function2pt integrand_2pt_borel, integrand_2pt_borel_m1;
+            Function2pt surface_2pt, surface_2pt_m1;
+            Function3pt integrand_3pt, integrand_3pt_m1;
+            Surface3ptA surface_3pt_A, surface_3pt_A_m1;
+            Surface3ptBC surface_3pt_B, surface_3pt_B_m1;
+            Surface3ptBC surface_3pt_C, surface_3pt_C_m1;
+            Function2pt surface_3pt_D, surface_3pt_D_m1;
+        };
+
+        /*
+         * Evaluate the form factor, the first moment and the normalization of a sum rule together.
+         *
+         * The three-particle contributions to the zeroth and the first moment are integrated on a common
+         * set of points. The three-particle contributions to the form factor coincide with those to the
+         * normalization, as do the two-particle contributions if the Borel method is used. Otherwise, the
+         * two-particle contribution to the form factor is only integrated if with_value is true; the form
+         * factor is NaN else.
+         */
+        lcsr::SumRuleMoments moments(const SumRule & r, const double & sigma_0, const double & q2, const double & prefactor, const bool & with_value) const
+        {
+            using namespace std::placeholders;
+
+            const std::function<double (const double &)> integrand_2pt    = std::bind(r.integrand_2pt_borel, this, _1, q2);
+            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(r.integrand_2pt_borel_m1, this, _1, q2);
+
+            double normalization = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0)    - (this->*r.surface_2pt)(sigma_0, q2);
+            double moment_1      = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0) - (this->*r.surface_2pt_m1)(sigma_0, q2);
+            double value         = switch_borel ? normalization : std::numeric_limits<double>::quiet_NaN();
+
+            if (! switch_borel && with_value)
+            {
+                const std::function<double (const double &)> integrand_2pt_value = std::bind(r.integrand_2pt, this, _1, q2);
+
+                value = integrate<GSL::QAGS>(integrand_2pt_value, 0.0, sigma_0) - (this->*r.surface_2pt)(0.0, q2);
+            }
+
+            if (switch_3pt != 0.0)
+            {
+                const cubature::fvd<3, 2> integrand_3pt = [&] (const std::array<double, 3> & x) -> std::array<double, 2>
+                {
+                    return { (this->*r.integrand_3pt)(x, q2), (this->*r.integrand_3pt_m1)(x, q2) };
+                };
+                const cubature::fvd<2, 2> surface_3pt_A = [&] (const std::array<double, 2> & x) -> std::array<double, 2>
+                {
+                    return { (this->*r.surface_3pt_A)(x, sigma_0, q2), (this->*r.surface_3pt_A_m1)(x, sigma_0, q2) };
+                };
+                const std::function<double (const double &)> surface_3pt_B    = std::bind(r.surface_3pt_B,    this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(r.surface_3pt_B_m1, this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C    = std::bind(r.surface_3pt_C,    this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(r.surface_3pt_C_m1, this, _1, sigma_0, q2);
+
+                const std::array<double, 2> integral_3pt   = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                const std::array<double, 2> surface_3pt_AA = integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()); // integrate over x_1 and x_2
+
+                const double contribution_3pt = integral_3pt[0]
+                                              - surface_3pt_AA[0]
+                                              - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)     // integrate over x_1
+                                              - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)     // integrate over x_2
+                                              - (this->*r.surface_3pt_D)(sigma_0, q2);
+
+                const double contribution_3pt_m1 = integral_3pt[1]
+                                                 - surface_3pt_AA[1]
+                                                 - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0) // integrate over x_1
+                                                 - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0) // integrate over x_2
+                                                 - (this->*r.surface_3pt_D_m1)(sigma_0, q2);
+
+                normalization += contribution_3pt;
+                moment_1      += contribution_3pt_m1;
+                value         += contribution_3pt;
+            }
+
+            return lcsr::SumRuleMoments{ prefactor * value, moment_1, normalization };
+        }
+        // }}}
+
         /* f_+ : 2-particle functions */
 
         inline
@@ -2717,88 +2806,29 @@ namespace eos
         // {{{
         double f_p(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_p(), s0_1_p());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_fp_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_fp_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_f_p(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_f_p(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_fp_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_fp_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fp_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fp_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_fp_3pt_D(sigma_0, q2);
-            }
+                integrand_fp_2pt,
+                &Implementation::integrand_fp_2pt_borel, &Implementation::integrand_fp_2pt_borel_m1,
+                &Implementation::surface_fp_2pt,         &Implementation::surface_fp_2pt_m1,
+                &Implementation::integrand_fp_3pt,       &Implementation::integrand_fp_3pt_m1,
+                &Implementation::surface_fp_3pt_A,       &Implementation::surface_fp_3pt_A_m1,
+                &Implementation::surface_fp_3pt_B,       &Implementation::surface_fp_3pt_B_m1,
+                &Implementation::surface_fp_3pt_C,       &Implementation::surface_fp_3pt_C_m1,
+                &Implementation::surface_fp_3pt_D,       &Implementation::surface_fp_3pt_D_m1
+            };
 
-            return f_B() * m_B() / f_P() * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_p(), s0_1_p()), q2, f_B() * m_B() / f_P() / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_f_p(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_p(), s0_1_p());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_fp_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_fp_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_fp_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fp_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fp_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fp_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fp_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fp_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fp_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fp_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fp_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fp_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fp_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fp_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_f_p(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -5456,88 +5486,29 @@ namespace eos
         // {{{
         double f_pm(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_pm(), s0_1_pm());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_fpm_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_fpm_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_f_pm(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_f_pm(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_fpm_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_fpm_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fpm_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fpm_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_fpm_3pt_D(sigma_0, q2);
-            }
+                integrand_fpm_2pt,
+                &Implementation::integrand_fpm_2pt_borel, &Implementation::integrand_fpm_2pt_borel_m1,
+                &Implementation::surface_fpm_2pt,         &Implementation::surface_fpm_2pt_m1,
+                &Implementation::integrand_fpm_3pt,       &Implementation::integrand_fpm_3pt_m1,
+                &Implementation::surface_fpm_3pt_A,       &Implementation::surface_fpm_3pt_A_m1,
+                &Implementation::surface_fpm_3pt_B,       &Implementation::surface_fpm_3pt_B_m1,
+                &Implementation::surface_fpm_3pt_C,       &Implementation::surface_fpm_3pt_C_m1,
+                &Implementation::surface_fpm_3pt_D,       &Implementation::surface_fpm_3pt_D_m1
+            };
 
-            return f_B() * m_B() / f_P() * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_pm(), s0_1_pm()), q2, f_B() * m_B() / f_P() / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_f_pm(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_pm(), s0_1_pm());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_fpm_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_fpm_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_fpm_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fpm_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fpm_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fpm_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fpm_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fpm_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fpm_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fpm_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fpm_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fpm_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fpm_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fpm_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_f_pm(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -8331,88 +8302,29 @@ namespace eos
         // {{{
         double f_t(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_t(), s0_1_t());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_fT_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_fT_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_f_t(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_f_t(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_fT_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_fT_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fT_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fT_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_fT_3pt_D(sigma_0, q2);
-            }
+                integrand_fT_2pt,
+                &Implementation::integrand_fT_2pt_borel, &Implementation::integrand_fT_2pt_borel_m1,
+                &Implementation::surface_fT_2pt,         &Implementation::surface_fT_2pt_m1,
+                &Implementation::integrand_fT_3pt,       &Implementation::integrand_fT_3pt_m1,
+                &Implementation::surface_fT_3pt_A,       &Implementation::surface_fT_3pt_A_m1,
+                &Implementation::surface_fT_3pt_B,       &Implementation::surface_fT_3pt_B_m1,
+                &Implementation::surface_fT_3pt_C,       &Implementation::surface_fT_3pt_C_m1,
+                &Implementation::surface_fT_3pt_D,       &Implementation::surface_fT_3pt_D_m1
+            };
 
-            return f_B() * power_of<2>(m_B()) * (m_B() + m_P()) / (f_P() * (power_of<2>(m_B()) - power_of<2>(m_P()) - q2)) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_t(), s0_1_t()), q2, f_B() * power_of<2>(m_B()) * (m_B() + m_P()) / (f_P() * (power_of<2>(m_B()) - power_of<2>(m_P()) - q2)) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_f_t(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_t(), s0_1_t());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_fT_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_fT_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_fT_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fT_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fT_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fT_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fT_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fT_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fT_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fT_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fT_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fT_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fT_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_fT_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_f_t(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -9557,6 +9469,13 @@ namespace eos
         return this->_imp->normalized_moment_1_f_p(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToPLCSR<Process_>::moments_f_p(const double & q2) const
+    {
+        return this->_imp->moments_f_p(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToPLCSR<Process_>::normalized_moment_1_f_pm(const double & q2) const
@@ -9564,6 +9483,13 @@ namespace eos
         return this->_imp->normalized_moment_1_f_pm(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToPLCSR<Process_>::moments_f_pm(const double & q2) const
+    {
+        return this->_imp->moments_f_pm(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToPLCSR<Process_>::normalized_moment_1_f_t(const double & q2) const
@@ -9571,6 +9497,13 @@ namespace eos
         return this->_imp->normalized_moment_1_f_t(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToPLCSR<Process_>::moments_f_t(const double & q2) const
+    {
+        return this->_imp->moments_f_t(q2);
+    }
+
     template <typename Process_>
     Diagnostics
     AnalyticFormFactorBToPLCSR<Process_>::diagnostics() const
@@ -4,6 +4,7 @@
  * Copyright (c) 2018 Danny van Dyk
  * Copyright (c) 2018 Nico Gubernari
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -22,6 +23,7 @@
 #ifndef EOS_GUARD_EOS_FORM_FACTORS_ANALYTIC_B_TO_P_LCSR_HH
 #define EOS_GUARD_EOS_FORM_FACTORS_ANALYTIC_B_TO_P_LCSR_HH 1
 
+#include <eos/form-factors/analytic-b-lcsr-moments.hh>
 #include <eos/form-factors/mesonic.hh>
 #include <eos/utils/diagnostics.hh>
 #include <eos/utils/parameters.hh>
@@ -66,6 +68,11 @@ namespace eos
             double normalized_moment_1_f_pm(const double & q2) const;
             double normalized_moment_1_f_t(const double & q2) const;
 
+            /* Form factors together with the first moments and the normalizations of their sum rules */
+            lcsr::SumRuleMoments moments_f_p(const double & q2) const;
+            lcsr::SumRuleMoments moments_f_pm(const double & q2) const;
+            lcsr::SumRuleMoments moments_f_t(const double & q2) const;
+
             /* Diagnostics for unit tests */
             Diagnostics diagnostics() const;
 
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2018 Danny van Dyk
  * Copyright (c) 2018 Nico Gubernari
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -1149,6 +1150,18 @@ class LCSRFormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_f_t(-5.0), 0.279865, 1.0e-4);
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_f_t( 0.0), 0.276469, 1.0e-4);
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_f_t( 5.0), 0.272724, 1.0e-4);
+
+                // the fused evaluation agrees with the individual ones
+                for (const double & q2 : { -5.0, 0.0, 5.0 })
+                {
+                    const auto m_f_p = ff.moments_f_p(q2);
+                    TEST_CHECK_NEARLY_EQUAL(m_f_p.value,                 ff.f_p(q2),                      1.0e-4);
+                    TEST_CHECK_NEARLY_EQUAL(m_f_p.normalized_moment_1(), ff.normalized_moment_1_f_p(q2),  1.0e-4);
+
+                    const auto m_f_t = ff.moments_f_t(q2);
+                    TEST_CHECK_NEARLY_EQUAL(m_f_t.value,                 ff.f_t(q2),                      1.0e-4);
+                    TEST_CHECK_NEARLY_EQUAL(m_f_t.normalized_moment_1(), ff.normalized_moment_1_f_t(q2),  1.0e-4);
+                }
             }
 
 
@@ -4,6 +4,7 @@
  * Copyright (c) 2018 Danny van Dyk
  * Copyright (c) 2018 Nico Gubernari
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -34,7 +35,9 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <array>
 #include <functional>
+#include <limits>
 
 #include <iostream>
 
@@ -403,6 +406,92 @@ namespace eos
 
             return sigma(s0, q2);
         }
+
+        /* Combined evaluation of a sum rule and its moments */
+        // {{{
+        using Function2pt  = double (Implementation::*)(const double &, const double &) const;
+        using Function3pt  = double (Implementation::*)(const std::array<double, 3> &, const double &) const;
+        using Surface3ptA  = double (Implementation::*)(const std::array<double, 2> &, const double &, const double &) const;
+        using Surface3ptBC = double (Implementation::*)(const double &, const double &, const double &) const;
+
+        // The integrands and surface terms of the sum rule for one form factor, and their first moments
+        struct SumRule
+        {
+            const std::function<double (const Implementation *, const double &, const double &)> & integrand_2pt;
+            Function2pt integrand_2pt_borel, integrand_2pt_borel_m1;
+            Function2pt surface_2pt, surface_2pt_m1;
+            Function3pt integrand_3pt, integrand_3pt_m1;
+            Surface3ptA surface_3pt_A, surface_3pt_A_m1;
+            Surface3ptBC surface_3pt_B, surface_3pt_B_m1;
+            Surface3ptBC surface_3pt_C, surface_3pt_C_m1;
+            Function2pt surface_3pt_D, surface_3pt_D_m1;
+        };
+
+        /*
+         * Evaluate the form factor, the first moment and the normalization of a sum rule together.
+         *
+         * The three-particle contributions to the zeroth and the first moment are integrated on a common
+         * set of points. The three-particle contributions to the form factor coincide with those to the
+         * normalization, as do the two-particle contributions if the Borel method is used. Otherwise, the
+         * two-particle contribution to the form factor is only integrated if with_value is true; the form
+         * factor is NaN else.
+         */
+        lcsr::SumRuleMoments moments(const SumRule & r, const double & sigma_0, const double & q2, const double & prefactor, const bool & with_value) const
+        {
+            using namespace std::placeholders;
+
+            const std::function<double (const double &)> integrand_2pt    = std::bind(r.integrand_2pt_borel, this, _1, q2);
+            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(r.integrand_2pt_borel_m1, this, _1, q2);
+
+            double normalization = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0)    - (this->*r.surface_2pt)(sigma_0, q2);
+            double moment_1      = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0) - (this->*r.surface_2pt_m1)(sigma_0, q2);
+            double value         = switch_borel ? normalization : std::numeric_limits<double>::quiet_NaN();
+
+            if (! switch_borel && with_value)
+            {
+                const std::function<double (const double &)> integrand_2pt_value = std::bind(r.integrand_2pt, this, _1, q2);
+
+                value = integrate<GSL::QAGS>(integrand_2pt_value, 0.0, sigma_0) - (this->*r.surface_2pt)(0.0, q2);
+            }
+
+            if (switch_3pt != 0.0)
+            {
+                const cubature::fvd<3, 2> integrand_3pt = [&] (const std::array<double, 3> & x) -> std::array<double, 2>
+                {
+                    return { (this->*r.integrand_3pt)(x, q2), (this->*r.integrand_3pt_m1)(x, q2) };
+                };
+                const cubature::fvd<2, 2> surface_3pt_A = [&] (const std::array<double, 2> & x) -> std::array<double, 2>
+                {
+                    return { (this->*r.surface_3pt_A)(x, sigma_0, q2), (this->*r.surface_3pt_A_m1)(x, sigma_0, q2) };
+                };
+                const std::function<double (const double &)> surface_3pt_B    = std::bind(r.surface_3pt_B,    this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(r.surface_3pt_B_m1, this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C    = std::bind(r.surface_3pt_C,    this, _1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(r.surface_3pt_C_m1, this, _1, sigma_0, q2);
+
+                const std::array<double, 2> integral_3pt   = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                const std::array<double, 2> surface_3pt_AA = integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()); // integrate over x_1 and x_2
+
+                const double contribution_3pt = integral_3pt[0]
+                                              - surface_3pt_AA[0]
+                                              - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)     // integrate over x_1
+                                              - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)     // integrate over x_2
+                                              - (this->*r.surface_3pt_D)(sigma_0, q2);
+
+                const double contribution_3pt_m1 = integral_3pt[1]
+                                                 - surface_3pt_AA[1]
+                                                 - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0) // integrate over x_1
+                                                 - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0) // integrate over x_2
+                                                 - (this->*r.surface_3pt_D_m1)(sigma_0, q2);
+
+                normalization += contribution_3pt;
+                moment_1      += contribution_3pt_m1;
+                value         += contribution_3pt;
+            }
+
+            return lcsr::SumRuleMoments{ prefactor * value, moment_1, normalization };
+        }
+        // }}}
         // }}}
 
         /* A_1 : 2-particle functions */
@@ -3705,88 +3794,29 @@ namespace eos
         // {{{
         double a_1(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A1(), s0_1_A1());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a1_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A1_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_a_1(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_a_1(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_A1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_A1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_A1_3pt_D(sigma_0, q2);
-            }
+                integrand_a1_2pt,
+                &Implementation::integrand_A1_2pt_borel, &Implementation::integrand_A1_2pt_borel_m1,
+                &Implementation::surface_A1_2pt,         &Implementation::surface_A1_2pt_m1,
+                &Implementation::integrand_A1_3pt,       &Implementation::integrand_A1_3pt_m1,
+                &Implementation::surface_A1_3pt_A,       &Implementation::surface_A1_3pt_A_m1,
+                &Implementation::surface_A1_3pt_B,       &Implementation::surface_A1_3pt_B_m1,
+                &Implementation::surface_A1_3pt_C,       &Implementation::surface_A1_3pt_C_m1,
+                &Implementation::surface_A1_3pt_D,       &Implementation::surface_A1_3pt_D_m1
+            };
 
-            return f_B() * power_of<3>(m_B()) / (2.0 * f_V() * m_V * (m_B + m_V)) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_A1(), s0_1_A1()), q2, f_B() * power_of<3>(m_B()) / (2.0 * f_V() * m_V * (m_B + m_V)) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_a_1(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A1(), s0_1_A1()) ;
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A1_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A1_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_A1_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_A1_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_A1_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_A1_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_A1_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A1_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A1_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A1_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_a_1(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -6461,88 +6491,29 @@ namespace eos
         // {{{
         double a_2(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A2(), s0_1_A2());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a2_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A2_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_a_2(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_a_2(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_A2_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_A2_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A2_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A2_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_A2_3pt_D(sigma_0, q2);
-            }
+                integrand_a2_2pt,
+                &Implementation::integrand_A2_2pt_borel, &Implementation::integrand_A2_2pt_borel_m1,
+                &Implementation::surface_A2_2pt,         &Implementation::surface_A2_2pt_m1,
+                &Implementation::integrand_A2_3pt,       &Implementation::integrand_A2_3pt_m1,
+                &Implementation::surface_A2_3pt_A,       &Implementation::surface_A2_3pt_A_m1,
+                &Implementation::surface_A2_3pt_B,       &Implementation::surface_A2_3pt_B_m1,
+                &Implementation::surface_A2_3pt_C,       &Implementation::surface_A2_3pt_C_m1,
+                &Implementation::surface_A2_3pt_D,       &Implementation::surface_A2_3pt_D_m1
+            };
 
-            return f_B() * m_B() * (m_B + m_V) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_A2(), s0_1_A2()), q2, f_B() * m_B() * (m_B + m_V) / (2.0 * f_V() * m_V) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_a_2(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A2(), s0_1_A2());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A2_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A2_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_A2_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_A2_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_A2_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_A2_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_A2_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A2_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A2_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A2_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A2_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A2_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A2_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A2_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_a_2(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -9213,88 +9184,29 @@ namespace eos
         // {{{
         double a_30(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A30(), s0_1_A30());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_a30_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_A30_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_a_30(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_a_30(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_A30_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_A30_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A30_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A30_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_A30_3pt_D(sigma_0, q2);
-            }
+                integrand_a30_2pt,
+                &Implementation::integrand_A30_2pt_borel, &Implementation::integrand_A30_2pt_borel_m1,
+                &Implementation::surface_A30_2pt,         &Implementation::surface_A30_2pt_m1,
+                &Implementation::integrand_A30_3pt,       &Implementation::integrand_A30_3pt_m1,
+                &Implementation::surface_A30_3pt_A,       &Implementation::surface_A30_3pt_A_m1,
+                &Implementation::surface_A30_3pt_B,       &Implementation::surface_A30_3pt_B_m1,
+                &Implementation::surface_A30_3pt_C,       &Implementation::surface_A30_3pt_C_m1,
+                &Implementation::surface_A30_3pt_D,       &Implementation::surface_A30_3pt_D_m1
+            };
 
-            return f_B() * q2 * m_B / (4.0 * f_V() * power_of<2>(m_V)) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_A30(), s0_1_A30()), q2, f_B() * q2 * m_B / (4.0 * f_V() * power_of<2>(m_V)) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_a_30(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_A30(), s0_1_A30());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_A30_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_A30_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_A30_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_A30_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_A30_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_A30_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_A30_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A30_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_A30_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_A30_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_A30_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_A30_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_A30_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_A30_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_a_30(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -11542,88 +11454,29 @@ namespace eos
         // {{{
         double v(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_V(), s0_1_V());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_v_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_V_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_v(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_v(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_V_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_V_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_V_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_V_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_V_3pt_D(sigma_0, q2);
-            }
+                integrand_v_2pt,
+                &Implementation::integrand_V_2pt_borel, &Implementation::integrand_V_2pt_borel_m1,
+                &Implementation::surface_V_2pt,         &Implementation::surface_V_2pt_m1,
+                &Implementation::integrand_V_3pt,       &Implementation::integrand_V_3pt_m1,
+                &Implementation::surface_V_3pt_A,       &Implementation::surface_V_3pt_A_m1,
+                &Implementation::surface_V_3pt_B,       &Implementation::surface_V_3pt_B_m1,
+                &Implementation::surface_V_3pt_C,       &Implementation::surface_V_3pt_C_m1,
+                &Implementation::surface_V_3pt_D,       &Implementation::surface_V_3pt_D_m1
+            };
 
-            return f_B() * power_of<2>(m_B) * (m_B + m_V) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_V(), s0_1_V()), q2, f_B() * power_of<2>(m_B) * (m_B + m_V) / (2.0 * f_V() * m_V) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_v(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_V(), s0_1_V());
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_V_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_V_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_V_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_V_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_V_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_V_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_V_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_V_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_V_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_V_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_V_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_V_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_V_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_V_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_v(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -14191,88 +14044,29 @@ namespace eos
         // {{{
         double t_1(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T1(), s0_1_T1());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t1_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T1_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_t_1(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_t_1(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_T1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_T1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_T1_3pt_D(sigma_0, q2);
-            }
+                integrand_t1_2pt,
+                &Implementation::integrand_T1_2pt_borel, &Implementation::integrand_T1_2pt_borel_m1,
+                &Implementation::surface_T1_2pt,         &Implementation::surface_T1_2pt_m1,
+                &Implementation::integrand_T1_3pt,       &Implementation::integrand_T1_3pt_m1,
+                &Implementation::surface_T1_3pt_A,       &Implementation::surface_T1_3pt_A_m1,
+                &Implementation::surface_T1_3pt_B,       &Implementation::surface_T1_3pt_B_m1,
+                &Implementation::surface_T1_3pt_C,       &Implementation::surface_T1_3pt_C_m1,
+                &Implementation::surface_T1_3pt_D,       &Implementation::surface_T1_3pt_D_m1
+            };
 
-            return f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_T1(), s0_1_T1()), q2, f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_t_1(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T1(), s0_1_T1()) ;
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T1_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T1_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_T1_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_T1_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_T1_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_T1_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_T1_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T1_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T1_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T1_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T1_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T1_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T1_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T1_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_t_1(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -17081,88 +16875,29 @@ namespace eos
         // {{{
         double t_23A(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T23A(), s0_1_T23A());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t23A_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T23A_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_t_23A(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_t_23A(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_T23A_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_T23A_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23A_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23A_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_T23A_3pt_D(sigma_0, q2);
-            }
+                integrand_t23A_2pt,
+                &Implementation::integrand_T23A_2pt_borel, &Implementation::integrand_T23A_2pt_borel_m1,
+                &Implementation::surface_T23A_2pt,         &Implementation::surface_T23A_2pt_m1,
+                &Implementation::integrand_T23A_3pt,       &Implementation::integrand_T23A_3pt_m1,
+                &Implementation::surface_T23A_3pt_A,       &Implementation::surface_T23A_3pt_A_m1,
+                &Implementation::surface_T23A_3pt_B,       &Implementation::surface_T23A_3pt_B_m1,
+                &Implementation::surface_T23A_3pt_C,       &Implementation::surface_T23A_3pt_C_m1,
+                &Implementation::surface_T23A_3pt_D,       &Implementation::surface_T23A_3pt_D_m1
+            };
 
-            return f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_T23A(), s0_1_T23A()), q2, f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_t_23A(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T23A(), s0_1_T23A()) ;
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T23A_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T23A_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_T23A_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_T23A_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_T23A_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_T23A_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_T23A_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23A_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T23A_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T23A_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T23A_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23A_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23A_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23A_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_t_23A(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -20264,88 +19999,29 @@ namespace eos
         // {{{
         double t_23B(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T23B(), s0_1_T23B());
-
-            const std::function<double (const double &)> integrand_2pt = std::bind(integrand_t23B_2pt, this, std::placeholders::_1, q2);
-
-            const double integral_2pt = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt  = 0.0 - surface_T23B_2pt(switch_borel ? sigma_0 : 0.0, q2);
-
-            double integral_3pt = 0.0;
-            double surface_3pt  = 0.0;
+            return moments_t_23B(q2).value;
+        }
 
-            if (switch_3pt != 0.0)
+        lcsr::SumRuleMoments moments_t_23B(const double & q2, const bool & with_value = true) const
+        {
+            const SumRule sum_rule
             {
-                const std::function<double (const double &)> surface_3pt_B = std::bind(&Implementation::surface_T23B_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C = std::bind(&Implementation::surface_T23B_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23B_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23B_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt  = 0.0
-                             - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                             - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                             - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                             - surface_T23B_3pt_D(sigma_0, q2);
-            }
+                integrand_t23B_2pt,
+                &Implementation::integrand_T23B_2pt_borel, &Implementation::integrand_T23B_2pt_borel_m1,
+                &Implementation::surface_T23B_2pt,         &Implementation::surface_T23B_2pt_m1,
+                &Implementation::integrand_T23B_3pt,       &Implementation::integrand_T23B_3pt_m1,
+                &Implementation::surface_T23B_3pt_A,       &Implementation::surface_T23B_3pt_A_m1,
+                &Implementation::surface_T23B_3pt_B,       &Implementation::surface_T23B_3pt_B_m1,
+                &Implementation::surface_T23B_3pt_C,       &Implementation::surface_T23B_3pt_C_m1,
+                &Implementation::surface_T23B_3pt_D,       &Implementation::surface_T23B_3pt_D_m1
+            };
 
-            return f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) * (integral_2pt + surface_2pt + integral_3pt + surface_3pt) / ( Process_::chi2);
+            return moments(sum_rule, this->sigma_0(q2, s0_0_T23B(), s0_1_T23B()), q2, f_B() * power_of<2>(m_B()) / (2.0 * f_V() * m_V) / Process_::chi2, with_value);
         }
 
         double normalized_moment_1_t_23B(const double & q2) const
         {
-            const double sigma_0 = this->sigma_0(q2, s0_0_T23B(), s0_1_T23B()) ;
-
-            const std::function<double (const double &)> integrand_2pt_m1 = std::bind(&Implementation::integrand_T23B_2pt_borel_m1, this, std::placeholders::_1, q2);
-
-
-            const std::function<double (const double &)> integrand_2pt    = std::bind(&Implementation::integrand_T23B_2pt_borel, this, std::placeholders::_1, q2);
-
-            const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
-            const double surface_2pt_m1  = 0.0 - surface_T23B_2pt_m1(sigma_0, q2);
-
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_T23B_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_T23B_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_T23B_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_T23B_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23B_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_T23B_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_T23B_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_T23B_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_T23B_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_T23B_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
-                surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
-                                - surface_T23B_3pt_D(sigma_0, q2);
-            }
-            const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
-
-            return numerator / denominator;
+            return moments_t_23B(q2, false).normalized_moment_1();
         }
         // }}}
 
@@ -23241,6 +22917,13 @@ namespace eos
         return this->_imp->normalized_moment_1_a_1(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_a_1(const double & q2) const
+    {
+        return this->_imp->moments_a_1(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_a_2(const double & q2) const
@@ -23248,6 +22931,13 @@ namespace eos
         return this->_imp->normalized_moment_1_a_2(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_a_2(const double & q2) const
+    {
+        return this->_imp->moments_a_2(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_a_30(const double & q2) const
@@ -23255,6 +22945,13 @@ namespace eos
         return this->_imp->normalized_moment_1_a_30(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_a_30(const double & q2) const
+    {
+        return this->_imp->moments_a_30(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_v(const double & q2) const
@@ -23262,6 +22959,13 @@ namespace eos
         return this->_imp->normalized_moment_1_v(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_v(const double & q2) const
+    {
+        return this->_imp->moments_v(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_t_1(const double & q2) const
@@ -23269,6 +22973,13 @@ namespace eos
         return this->_imp->normalized_moment_1_t_1(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_t_1(const double & q2) const
+    {
+        return this->_imp->moments_t_1(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_t_23A(const double & q2) const
@@ -23276,6 +22987,13 @@ namespace eos
         return this->_imp->normalized_moment_1_t_23A(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_t_23A(const double & q2) const
+    {
+        return this->_imp->moments_t_23A(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::normalized_moment_1_t_23B(const double & q2) const
@@ -23283,6 +23001,13 @@ namespace eos
         return this->_imp->normalized_moment_1_t_23B(q2);
     }
 
+    template <typename Process_>
+    lcsr::SumRuleMoments
+    AnalyticFormFactorBToVLCSR<Process_>::moments_t_23B(const double & q2) const
+    {
+        return this->_imp->moments_t_23B(q2);
+    }
+
     template <typename Process_>
     double
     AnalyticFormFactorBToVLCSR<Process_>::f_perp(const double &) const
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2018 Danny van Dyk
  * Copyright (c) 2018 Nico Gubernari
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -2871,6 +2872,18 @@ class LCSRFormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_t_23B(-5.0), 0.832092, 1.0e-3);
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_t_23B( 0.0), 0.818786, 1.0e-3);
                 TEST_CHECK_NEARLY_EQUAL(ff.normalized_moment_1_t_23B( 5.0), 0.809531, 1.0e-3);
+
+                // the fused evaluation agrees with the individual ones
+                for (const double & q2 : { -5.0, 0.0, 5.0 })
+                {
+                    const auto m_a_1 = ff.moments_a_1(q2);
+                    TEST_CHECK_NEARLY_EQUAL(m_a_1.value,                 ff.a_1(q2),                      1.0e-4);
+                    TEST_CHECK_NEARLY_EQUAL(m_a_1.normalized_moment_1(), ff.normalized_moment_1_a_1(q2),  1.0e-3);
+
+                    const auto m_v = ff.moments_v(q2);
+                    TEST_CHECK_NEARLY_EQUAL(m_v.value,                   ff.v(q2),                        1.0e-4);
+                    TEST_CHECK_NEARLY_EQUAL(m_v.normalized_moment_1(),   ff.normalized_moment_1_v(q2),    1.0e-3);
+                }
             }
 
 
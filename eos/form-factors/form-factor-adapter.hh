@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2013, 2016, 2017 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -29,6 +30,57 @@
 
 namespace eos
 {
+    namespace impl
+    {
+        /* Look up the counterpart of a form factor for forward-mode automatic differentiation, if any */
+        template <typename Transition_, typename ... Args_>
+        struct DualFormFactor
+        {
+            using Type = std::function<Dual (const FormFactors<Transition_> *, const Args_ & ...)>;
+
+            static Type find(double (FormFactors<Transition_>::*)(const Args_ & ...) const)
+            {
+                return Type();
+            }
+
+            static bool differentiable(const FormFactors<Transition_> *)
+            {
+                return false;
+            }
+        };
+
+        template <>
+        struct DualFormFactor<PToP, double>
+        {
+            using Type = std::function<Dual (const FormFactors<PToP> *, const double &)>;
+
+            static Type find(double (FormFactors<PToP>::* function)(const double &) const)
+            {
+                using Function = double (FormFactors<PToP>::*)(const double &) const;
+
+                const Function f_p = &FormFactors<PToP>::f_p;
+                const Function f_0 = &FormFactors<PToP>::f_0;
+                const Function f_t = &FormFactors<PToP>::f_t;
+
+                if (function == f_p)
+                    return Type(&FormFactors<PToP>::f_p_dual);
+
+                if (function == f_0)
+                    return Type(&FormFactors<PToP>::f_0_dual);
+
+                if (function == f_t)
+                    return Type(&FormFactors<PToP>::f_t_dual);
+
+                return Type();
+            }
+
+            static bool differentiable(const FormFactors<PToP> * form_factors)
+            {
+                return form_factors->differentiable();
+            }
+        };
+    }
+
     /* Form factor adapter class for interfacing Observable */
     template <typename Transition_, typename ... Args_>
     class FormFactorAdapter :
@@ -49,6 +101,8 @@ namespace eos
 
             std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> _form_factor_function;
 
+            typename impl::DualFormFactor<Transition_, Args_ ...>::Type _dual_form_factor_function;
+
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
             std::tuple<const FormFactors<Transition_> *, typename impl::ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple;
@@ -60,7 +114,8 @@ namespace eos
                     const Kinematics & kinematics,
                     const Options & options,
                     const std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> & form_factor_function,
-                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
+                    const typename impl::DualFormFactor<Transition_, Args_ ...>::Type & dual_form_factor_function = {}) :
                 _name(name),
                 _process(process),
                 _parameters(parameters),
@@ -68,6 +123,7 @@ namespace eos
                 _options(options),
                 _form_factors(FormFactorFactory<Transition_>::create(process.str() + "::" + options["form-factors"], _parameters, _options)),
                 _form_factor_function(form_factor_function),
+                _dual_form_factor_function(dual_form_factor_function),
                 _kinematics_names(kinematics_names),
                 _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _form_factors.get()))
             {
@@ -92,6 +148,21 @@ namespace eos
                 return std::apply(_form_factor_function, values);
             };
 
+            virtual bool differentiable() const
+            {
+                return _dual_form_factor_function && impl::DualFormFactor<Transition_, Args_ ...>::differentiable(_form_factors.get());
+            }
+
+            virtual Dual evaluate_dual() const
+            {
+                if (! differentiable())
+                    return Observable::evaluate_dual();
+
+                std::tuple<const FormFactors<Transition_> *, typename impl::ConvertTo<Args_, double>::Type ...> values = _argument_tuple;
+
+                return std::apply(_dual_form_factor_function, values);
+            }
+
             virtual Parameters parameters()
             {
                 return _parameters;
@@ -109,12 +180,12 @@ namespace eos
 
             virtual ObservablePtr clone() const
             {
-                return ObservablePtr(new FormFactorAdapter(_name, _process, _parameters.clone(), _kinematics.clone(), _options, _form_factor_function, _kinematics_names));
+                return ObservablePtr(new FormFactorAdapter(_name, _process, _parameters.clone(), _kinematics.clone(), _options, _form_factor_function, _kinematics_names, _dual_form_factor_function));
             }
 
             virtual ObservablePtr clone(const Parameters & parameters) const
             {
-                return ObservablePtr(new FormFactorAdapter(_name, _process, parameters, _kinematics.clone(), _options, _form_factor_function, _kinematics_names));
+                return ObservablePtr(new FormFactorAdapter(_name, _process, parameters, _kinematics.clone(), _options, _form_factor_function, _kinematics_names, _dual_form_factor_function));
             }
     };
 
@@ -133,6 +204,8 @@ namespace eos
 
             std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> _form_factor_function;
 
+            typename impl::DualFormFactor<Transition_, Args_ ...>::Type _dual_form_factor_function;
+
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
             std::array<const std::string, sizeof...(Args_)> _kinematics_names_array;
@@ -145,12 +218,14 @@ namespace eos
                     const Unit & unit,
                     const qnp::Prefix & process,
                     const std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> & form_factor_function,
-                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
+                    const typename impl::DualFormFactor<Transition_, Args_ ...>::Type & dual_form_factor_function = {}) :
                 _name(name),
                 _latex(latex),
                 _unit(unit),
                 _process(process),
                 _form_factor_function(form_factor_function),
+                _dual_form_factor_function(dual_form_factor_function),
                 _kinematics_names(kinematics_names),
                 _kinematics_names_array(impl::make_array<const std::string>(kinematics_names)),
                 _options{ FormFactorFactory<Transition_>::option_specification(process) }
@@ -198,7 +273,7 @@ namespace eos
 
             virtual ObservablePtr make(const Parameters & parameters, const Kinematics & kinematics, const Options & options) const
             {
-                return ObservablePtr(new FormFactorAdapter<Transition_, Args_ ...>(_name, _process, parameters, kinematics, options, _form_factor_function, _kinematics_names));
+                return ObservablePtr(new FormFactorAdapter<Transition_, Args_ ...>(_name, _process, parameters, kinematics, options, _form_factor_function, _kinematics_names, _dual_form_factor_function));
             }
 
             virtual std::ostream & insert(std::ostream & os) const
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2013 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -27,6 +28,9 @@ namespace eos
 
     template <typename Transition_>
     class FormFactorFactory;
+
+    template <typename Transition_>
+    struct FormFactorValues;
 }
 
 #endif
@@ -5,6 +5,7 @@
  * Copyright (c) 2015 Christoph Bobeth
  * Copyright (c) 2018 Ahmet Kokulu
  * Copyright (c) 2019 Nico Gubernari
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -155,6 +156,25 @@ namespace eos
         return complex<double>(std::numeric_limits<double>::signaling_NaN());
     }
 
+    void
+    FormFactors<PToV>::evaluate_all(const double * q2, const std::size_t & n, FormFactorValues<PToV> * out) const
+    {
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double & s = q2[i];
+
+            out[i].v    = this->v(s);
+            out[i].a_0  = this->a_0(s);
+            out[i].a_1  = this->a_1(s);
+            out[i].a_2  = this->a_2(s);
+            out[i].a_12 = this->a_12(s);
+            out[i].t_1  = this->t_1(s);
+            out[i].t_2  = this->t_2(s);
+            out[i].t_3  = this->t_3(s);
+            out[i].t_23 = this->t_23(s);
+        }
+    }
+
     std::shared_ptr<FormFactors<PToV>>
     FormFactorFactory<PToV>::create(const QualifiedName & name, const Parameters & parameters, const Options & options)
     {
@@ -232,6 +252,38 @@ namespace eos
         return derivative<2u, deriv::TwoSided>(f, s);
     }
 
+    bool FormFactors<PToP>::differentiable() const
+    {
+        return false;
+    }
+
+    Dual FormFactors<PToP>::f_p_dual(const double &) const
+    {
+        throw InternalError("FormFactors<PToP>::f_p_dual: not supported by this parametrization");
+    }
+
+    Dual FormFactors<PToP>::f_0_dual(const double &) const
+    {
+        throw InternalError("FormFactors<PToP>::f_0_dual: not supported by this parametrization");
+    }
+
+    Dual FormFactors<PToP>::f_t_dual(const double &) const
+    {
+        throw InternalError("FormFactors<PToP>::f_t_dual: not supported by this parametrization");
+    }
+
+    void FormFactors<PToP>::evaluate_all(const double * q2, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double & s = q2[i];
+
+            out[i].f_p = this->f_p(s);
+            out[i].f_0 = this->f_0(s);
+            out[i].f_t = this->f_t(s);
+        }
+    }
+
     const std::map<FormFactorFactory<PToP>::KeyType, FormFactorFactory<PToP>::ValueType>
     FormFactorFactory<PToP>::form_factors
     {
@@ -4,6 +4,7 @@
  * Copyright (c) 2010, 2011, 2013, 2014, 2015, 2016 Danny van Dyk
  * Copyright (c) 2015 Christoph Bobeth
  * Copyright (c) 2010 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -28,6 +29,7 @@
 #include <eos/utils/options.hh>
 #include <eos/utils/qualified-name.hh>
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -52,6 +54,20 @@ namespace eos
 
     struct VToV { };
 
+    /*!
+     * Values of all P -> V form factors at a single q^2 point.
+     *
+     * The values agree with those of the individual form factors. BGL1997 does not implement
+     * the tensor form factors yet; like its individual accessors, it sets t_1, t_2, t_3 and t_23 to 0.
+     */
+    template <>
+    struct FormFactorValues<PToV>
+    {
+        double v;
+        double a_0, a_1, a_2, a_12;
+        double t_1, t_2, t_3, t_23;
+    };
+
     template <>
     class FormFactors<PToV> :
         public virtual ParameterUser
@@ -91,6 +107,19 @@ namespace eos
             virtual complex<double> t_1(const complex<double> & q2) const;
             virtual complex<double> t_2(const complex<double> & q2) const;
             virtual complex<double> t_23(const complex<double> & q2) const;
+
+            /*!
+             * Evaluate all form factors on a grid of q^2 points.
+             *
+             * The default implementation calls the individual form factors for each point.
+             * Parametrisations override it to share the common parts, e.g. the conformal
+             * variable z and the pole factors, among all form factors at a point.
+             *
+             * @param q2   Array of n values of q^2.
+             * @param n    Number of points.
+             * @param out  Array of n elements that receives the form factors.
+             */
+            virtual void evaluate_all(const double * q2, const std::size_t & n, FormFactorValues<PToV> * out) const;
     };
 
     template <>
@@ -107,6 +136,20 @@ namespace eos
             static OptionSpecification option_specification();
     };
 
+    /*!
+     * Values of the P -> P form factors at a single q^2 point.
+     *
+     * The values agree with those of the individual form factors. Parametrisations whose
+     * individual accessor for the tensor form factor throws, e.g. BCL2008 without tensor form
+     * factors, set f_t to NaN. BGL1997 does not implement the tensor form factor yet; like its
+     * individual accessor, it sets f_t to 0.
+     */
+    template <>
+    struct FormFactorValues<PToP>
+    {
+        double f_p, f_0, f_t;
+    };
+
     template <>
     class FormFactors<PToP> :
         public virtual ParameterUser
@@ -130,6 +173,22 @@ namespace eos
             virtual complex<double> f_0(const complex<double> & q2) const;
             virtual complex<double> f_t(const complex<double> & q2) const;
 
+            // for forward-mode automatic differentiation with respect to the parameters, cf. Parameters::seed_gradient()
+            virtual bool differentiable() const;
+            virtual Dual f_p_dual(const double & s) const;
+            virtual Dual f_0_dual(const double & s) const;
+            virtual Dual f_t_dual(const double & s) const;
+
+            /*!
+             * Evaluate all form factors on a grid of q^2 points.
+             *
+             * The default implementation calls the individual form factors for each point.
+             *
+             * @param q2   Array of n values of q^2.
+             * @param n    Number of points.
+             * @param out  Array of n elements that receives the form factors.
+             */
+            virtual void evaluate_all(const double * q2, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <>
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2019, 2020 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -45,8 +46,9 @@ namespace eos
         QualifiedName qn(name);
         qnp::Prefix pp = qn.prefix_part();
         std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> function(_function);
+        auto dual_function = impl::DualFormFactor<Transition_, Args_ ...>::find(_function);
 
-        auto result = std::make_pair(qn, std::make_shared<FormFactorAdapterEntry<Transition_, Args_ ...>>(qn, latex, Unit::None(), pp, function, kinematics_names));
+        auto result = std::make_pair(qn, std::make_shared<FormFactorAdapterEntry<Transition_, Args_ ...>>(qn, latex, Unit::None(), pp, function, kinematics_names, dual_function));
 
         impl::observable_entries.insert(result);
 
@@ -61,8 +63,9 @@ namespace eos
         QualifiedName qn(name);
         qnp::Prefix pp = qn.prefix_part();
         std::function<double (const FormFactors<Transition_> *, const Args_ & ...)> function(_function);
+        auto dual_function = impl::DualFormFactor<Transition_, Args_ ...>::find(_function);
 
-        auto result = std::make_pair(qn, std::make_shared<FormFactorAdapterEntry<Transition_, Args_ ...>>(qn, "", Unit::None(), pp, function, kinematics_names));
+        auto result = std::make_pair(qn, std::make_shared<FormFactorAdapterEntry<Transition_, Args_ ...>>(qn, "", Unit::None(), pp, function, kinematics_names, dual_function));
 
         impl::observable_entries.insert(result);
 
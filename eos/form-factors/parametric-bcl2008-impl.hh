@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2013-2016, 2018 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -23,6 +24,8 @@
 #include <eos/form-factors/parametric-bcl2008.hh>
 #include <eos/utils/exception.hh>
 
+#include <limits>
+
 namespace eos
 {
     template <typename Process_> 
@@ -50,19 +53,42 @@ namespace eos
     }
 
     template <typename Process_> 
-    double
-    BCL2008FormFactorBase<Process_, 3u, false>::f_p(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 3u, false>::_f_p(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03;
 
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_plus_1 * (zbar - z3bar / 3.0) + _b_plus_2 * (z2bar + 2.0 * z3bar / 3.0));
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_plus_1) * (zbar - z3bar / 3.0) + parameter_value<T_>(_b_plus_2) * (z2bar + 2.0 * z3bar / 3.0));
     }
 
     template <typename Process_> 
     double
-    BCL2008FormFactorBase<Process_, 3u, false>::f_0(const double & s) const
+    BCL2008FormFactorBase<Process_, 3u, false>::f_p(const double & s) const
+    {
+        return _f_p<double>(s);
+    }
+
+    template <typename Process_> 
+    Dual
+    BCL2008FormFactorBase<Process_, 3u, false>::f_p_dual(const double & s) const
+    {
+        return _f_p<Dual>(s);
+    }
+
+    template <typename Process_> 
+    bool
+    BCL2008FormFactorBase<Process_, 3u, false>::differentiable() const
+    {
+        return true;
+    }
+
+    template <typename Process_> 
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 3u, false>::_f_0(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02;
@@ -71,7 +97,21 @@ namespace eos
         // note that f_0(0) = f_+(0)!
         // for f_0(s) we do not have an equation of motion to express _b_zero_K in terms of the
         // other coefficients!
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br0p) * (1.0 + _b_zero_1 * zbar + _b_zero_2 * z2bar + _b_zero_3 * z3bar);
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br0p) * (1.0 + parameter_value<T_>(_b_zero_1) * zbar + parameter_value<T_>(_b_zero_2) * z2bar + parameter_value<T_>(_b_zero_3) * z3bar);
+    }
+
+    template <typename Process_> 
+    double
+    BCL2008FormFactorBase<Process_, 3u, false>::f_0(const double & s) const
+    {
+        return _f_0<double>(s);
+    }
+
+    template <typename Process_> 
+    Dual
+    BCL2008FormFactorBase<Process_, 3u, false>::f_0_dual(const double & s) const
+    {
+        return _f_0<Dual>(s);
     }
 
     template <typename Process_> 
@@ -92,6 +132,29 @@ namespace eos
         return 0.0;
     }
 
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 3u, false>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters and compute z(0) once for the entire grid
+        const double f_plus_0 = _f_plus_0();
+        const double b_plus_1 = _b_plus_1(), b_plus_2 = _b_plus_2();
+        const double b_zero_1 = _b_zero_1(), b_zero_2 = _b_zero_2(), b_zero_3 = _b_zero_3();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03;
+
+            // note that f_0(0) = f_+(0)!
+            out[i].f_p = f_plus_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_plus_1 * (zbar - z3bar / 3.0) + b_plus_2 * (z2bar + 2.0 * z3bar / 3.0));
+            out[i].f_0 = f_plus_0 / (1.0 - s[i] / Process_::m2_Br0p) * (1.0 + b_zero_1 * zbar + b_zero_2 * z2bar + b_zero_3 * z3bar);
+            out[i].f_t = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
     template <typename Process_>
     double
     BCL2008FormFactorBase<Process_, 4u, false>::_z(const double & s) const
@@ -119,19 +182,42 @@ namespace eos
     }
 
     template <typename Process_>
-    double
-    BCL2008FormFactorBase<Process_, 4u, false>::f_p(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 4u, false>::_f_p(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2, z4 = z * z3;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04;
 
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_plus_1 * (zbar + z4bar / 4.0) + _b_plus_2 * (z2bar - z4bar / 2.0) + _b_plus_3 * (z3bar + 3.0 * z4bar / 4.0));
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_plus_1) * (zbar + z4bar / 4.0) + parameter_value<T_>(_b_plus_2) * (z2bar - z4bar / 2.0) + parameter_value<T_>(_b_plus_3) * (z3bar + 3.0 * z4bar / 4.0));
     }
 
     template <typename Process_>
     double
-    BCL2008FormFactorBase<Process_, 4u, false>::f_0(const double & s) const
+    BCL2008FormFactorBase<Process_, 4u, false>::f_p(const double & s) const
+    {
+        return _f_p<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 4u, false>::f_p_dual(const double & s) const
+    {
+        return _f_p<Dual>(s);
+    }
+
+    template <typename Process_>
+    bool
+    BCL2008FormFactorBase<Process_, 4u, false>::differentiable() const
+    {
+        return true;
+    }
+
+    template <typename Process_>
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 4u, false>::_f_0(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2, z4 = z * z3;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03;
@@ -140,7 +226,21 @@ namespace eos
         // note that f_0(0) = f_+(0)!
         // for f_0(s) we do not have an equation of motion to express _b_zero_K in terms of the
         // other coefficients!
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br0p) * (1.0 + _b_zero_1 * zbar + _b_zero_2 * z2bar + _b_zero_3 * z3bar + _b_zero_4 * z4bar);
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br0p) * (1.0 + parameter_value<T_>(_b_zero_1) * zbar + parameter_value<T_>(_b_zero_2) * z2bar + parameter_value<T_>(_b_zero_3) * z3bar + parameter_value<T_>(_b_zero_4) * z4bar);
+    }
+
+    template <typename Process_>
+    double
+    BCL2008FormFactorBase<Process_, 4u, false>::f_0(const double & s) const
+    {
+        return _f_0<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 4u, false>::f_0_dual(const double & s) const
+    {
+        return _f_0<Dual>(s);
     }
 
     template <typename Process_>
@@ -161,6 +261,29 @@ namespace eos
         return 0.0;
     }
 
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 4u, false>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters and compute z(0) once for the entire grid
+        const double f_plus_0 = _f_plus_0();
+        const double b_plus_1 = _b_plus_1(), b_plus_2 = _b_plus_2(), b_plus_3 = _b_plus_3();
+        const double b_zero_1 = _b_zero_1(), b_zero_2 = _b_zero_2(), b_zero_3 = _b_zero_3(), b_zero_4 = _b_zero_4();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2, z4 = z * z3;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04;
+
+            // note that f_0(0) = f_+(0)!
+            out[i].f_p = f_plus_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_plus_1 * (zbar + z4bar / 4.0) + b_plus_2 * (z2bar - z4bar / 2.0) + b_plus_3 * (z3bar + 3.0 * z4bar / 4.0));
+            out[i].f_0 = f_plus_0 / (1.0 - s[i] / Process_::m2_Br0p) * (1.0 + b_zero_1 * zbar + b_zero_2 * z2bar + b_zero_3 * z3bar + b_zero_4 * z4bar);
+            out[i].f_t = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
     template <typename Process_>
     double
     BCL2008FormFactorBase<Process_, 5u, false>::_z(const double & s) const
@@ -191,19 +314,42 @@ namespace eos
     }
 
     template <typename Process_>
-    double
-    BCL2008FormFactorBase<Process_, 5u, false>::f_p(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 5u, false>::_f_p(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2, z4 = z * z3, z5 = z * z4;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03, z05 = z0 * z04;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04, z5bar = z5 - z05;
 
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_plus_1 * (zbar - z5bar / 5.0) + _b_plus_2 * (z2bar + 2.0 * z5bar / 5.0) + _b_plus_3 * (z3bar - 3.0 * z5bar / 5.0) + _b_plus_4 * (z4bar + 4.0 * z5bar / 5.0));
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_plus_1) * (zbar - z5bar / 5.0) + parameter_value<T_>(_b_plus_2) * (z2bar + 2.0 * z5bar / 5.0) + parameter_value<T_>(_b_plus_3) * (z3bar - 3.0 * z5bar / 5.0) + parameter_value<T_>(_b_plus_4) * (z4bar + 4.0 * z5bar / 5.0));
     }
 
     template <typename Process_>
     double
-    BCL2008FormFactorBase<Process_, 5u, false>::f_0(const double & s) const
+    BCL2008FormFactorBase<Process_, 5u, false>::f_p(const double & s) const
+    {
+        return _f_p<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 5u, false>::f_p_dual(const double & s) const
+    {
+        return _f_p<Dual>(s);
+    }
+
+    template <typename Process_>
+    bool
+    BCL2008FormFactorBase<Process_, 5u, false>::differentiable() const
+    {
+        return true;
+    }
+
+    template <typename Process_>
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 5u, false>::_f_0(const double & s) const
     {
         const double z = _z(s), z2 = z * z, z3 = z * z2, z4 = z * z3, z5 = z * z4;
         const double z0 = _z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03, z05 = z0 * z04;
@@ -212,7 +358,21 @@ namespace eos
         // note that f_0(0) = f_+(0)!
         // for f_0(s) we do not have an equation of motion to express _b_zero_K in terms of the
         // other coefficients!
-        return _f_plus_0 / (1.0 - s / Process_::m2_Br0p) * (1.0 + _b_zero_1 * zbar + _b_zero_2 * z2bar + _b_zero_3 * z3bar + _b_zero_4 * z4bar + _b_zero_5 * z5bar);
+        return parameter_value<T_>(_f_plus_0) / (1.0 - s / Process_::m2_Br0p) * (1.0 + parameter_value<T_>(_b_zero_1) * zbar + parameter_value<T_>(_b_zero_2) * z2bar + parameter_value<T_>(_b_zero_3) * z3bar + parameter_value<T_>(_b_zero_4) * z4bar + parameter_value<T_>(_b_zero_5) * z5bar);
+    }
+
+    template <typename Process_>
+    double
+    BCL2008FormFactorBase<Process_, 5u, false>::f_0(const double & s) const
+    {
+        return _f_0<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 5u, false>::f_0_dual(const double & s) const
+    {
+        return _f_0<Dual>(s);
     }
 
     template <typename Process_>
@@ -233,6 +393,29 @@ namespace eos
         return 0.0;
     }
 
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 5u, false>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters and compute z(0) once for the entire grid
+        const double f_plus_0 = _f_plus_0();
+        const double b_plus_1 = _b_plus_1(), b_plus_2 = _b_plus_2(), b_plus_3 = _b_plus_3(), b_plus_4 = _b_plus_4();
+        const double b_zero_1 = _b_zero_1(), b_zero_2 = _b_zero_2(), b_zero_3 = _b_zero_3(), b_zero_4 = _b_zero_4(), b_zero_5 = _b_zero_5();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03, z05 = z0 * z04;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2, z4 = z * z3, z5 = z * z4;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04, z5bar = z5 - z05;
+
+            // note that f_0(0) = f_+(0)!
+            out[i].f_p = f_plus_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_plus_1 * (zbar - z5bar / 5.0) + b_plus_2 * (z2bar + 2.0 * z5bar / 5.0) + b_plus_3 * (z3bar - 3.0 * z5bar / 5.0) + b_plus_4 * (z4bar + 4.0 * z5bar / 5.0));
+            out[i].f_0 = f_plus_0 / (1.0 - s[i] / Process_::m2_Br0p) * (1.0 + b_zero_1 * zbar + b_zero_2 * z2bar + b_zero_3 * z3bar + b_zero_4 * z4bar + b_zero_5 * z5bar);
+            out[i].f_t = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
     template <typename Process_>
     BCL2008FormFactorBase<Process_, 3u, true>::BCL2008FormFactorBase(const Parameters & p, const Options & o) :
         BCL2008FormFactorBase<Process_, 3u, false>(p, o),
@@ -243,14 +426,49 @@ namespace eos
     }
 
     template <typename Process_>
-    double
-    BCL2008FormFactorBase<Process_, 3u, true>::f_t(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 3u, true>::_f_t(const double & s) const
     {
         const double z = this->_z(s), z2 = z * z, z3 = z * z2;
         const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03;
 
-        return _f_t_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_t_1 * (zbar - z3bar / 3.0) + _b_t_2 * (z2bar + 2.0 * z3bar / 3.0));
+        return parameter_value<T_>(_f_t_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_t_1) * (zbar - z3bar / 3.0) + parameter_value<T_>(_b_t_2) * (z2bar + 2.0 * z3bar / 3.0));
+    }
+
+    template <typename Process_>
+    double
+    BCL2008FormFactorBase<Process_, 3u, true>::f_t(const double & s) const
+    {
+        return _f_t<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 3u, true>::f_t_dual(const double & s) const
+    {
+        return _f_t<Dual>(s);
+    }
+
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 3u, true>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        BCL2008FormFactorBase<Process_, 3u, false>::evaluate_all(s, n, out);
+
+        const double f_t_0 = _f_t_0();
+        const double b_t_1 = _b_t_1(), b_t_2 = _b_t_2();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03;
+
+            out[i].f_t = f_t_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_t_1 * (zbar - z3bar / 3.0) + b_t_2 * (z2bar + 2.0 * z3bar / 3.0));
+        }
     }
 
     template <typename Process_>
@@ -265,14 +483,49 @@ namespace eos
     }
 
     template <typename Process_>
-    double
-    BCL2008FormFactorBase<Process_, 4u, true>::f_t(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 4u, true>::_f_t(const double & s) const
     {
         const double z = this->_z(s), z2 = z * z, z3 = z * z2, z4 = z * z3;
         const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04;
 
-        return _f_t_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_t_1 * (zbar + z4bar / 4.0) + _b_t_2 * (z2bar - z4bar / 2.0) + _b_t_3 * (z3bar + 3.0 * z4bar / 4.0));
+        return parameter_value<T_>(_f_t_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_t_1) * (zbar + z4bar / 4.0) + parameter_value<T_>(_b_t_2) * (z2bar - z4bar / 2.0) + parameter_value<T_>(_b_t_3) * (z3bar + 3.0 * z4bar / 4.0));
+    }
+
+    template <typename Process_>
+    double
+    BCL2008FormFactorBase<Process_, 4u, true>::f_t(const double & s) const
+    {
+        return _f_t<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 4u, true>::f_t_dual(const double & s) const
+    {
+        return _f_t<Dual>(s);
+    }
+
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 4u, true>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        BCL2008FormFactorBase<Process_, 4u, false>::evaluate_all(s, n, out);
+
+        const double f_t_0 = _f_t_0();
+        const double b_t_1 = _b_t_1(), b_t_2 = _b_t_2(), b_t_3 = _b_t_3();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2, z4 = z * z3;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04;
+
+            out[i].f_t = f_t_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_t_1 * (zbar + z4bar / 4.0) + b_t_2 * (z2bar - z4bar / 2.0) + b_t_3 * (z3bar + 3.0 * z4bar / 4.0));
+        }
     }
 
     template <typename Process_>
@@ -288,14 +541,49 @@ namespace eos
     }
 
     template <typename Process_>
-    double
-    BCL2008FormFactorBase<Process_, 5u, true>::f_t(const double & s) const
+    template <typename T_>
+    T_
+    BCL2008FormFactorBase<Process_, 5u, true>::_f_t(const double & s) const
     {
         const double z = this->_z(s), z2 = z * z, z3 = z * z2, z4 = z * z3, z5 = z * z4;
         const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03, z05 = z0 * z04;
         const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04, z5bar = z5 - z05;
 
-        return _f_t_0 / (1.0 - s / Process_::m2_Br1m) * (1.0 + _b_t_1 * (zbar - z5bar / 5.0) + _b_t_2 * (z2bar + 2.0 * z5bar / 5.0) + _b_t_3 * (z3bar - 3.0 * z5bar / 5.0) + _b_t_4 * (z4bar + 4.0 * z5bar / 5.0));
+        return parameter_value<T_>(_f_t_0) / (1.0 - s / Process_::m2_Br1m) * (1.0 + parameter_value<T_>(_b_t_1) * (zbar - z5bar / 5.0) + parameter_value<T_>(_b_t_2) * (z2bar + 2.0 * z5bar / 5.0) + parameter_value<T_>(_b_t_3) * (z3bar - 3.0 * z5bar / 5.0) + parameter_value<T_>(_b_t_4) * (z4bar + 4.0 * z5bar / 5.0));
+    }
+
+    template <typename Process_>
+    double
+    BCL2008FormFactorBase<Process_, 5u, true>::f_t(const double & s) const
+    {
+        return _f_t<double>(s);
+    }
+
+    template <typename Process_>
+    Dual
+    BCL2008FormFactorBase<Process_, 5u, true>::f_t_dual(const double & s) const
+    {
+        return _f_t<Dual>(s);
+    }
+
+    template <typename Process_>
+    void
+    BCL2008FormFactorBase<Process_, 5u, true>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        BCL2008FormFactorBase<Process_, 5u, false>::evaluate_all(s, n, out);
+
+        const double f_t_0 = _f_t_0();
+        const double b_t_1 = _b_t_1(), b_t_2 = _b_t_2(), b_t_3 = _b_t_3(), b_t_4 = _b_t_4();
+
+        const double z0 = this->_z(0), z02 = z0 * z0, z03 = z0 * z02, z04 = z0 * z03, z05 = z0 * z04;
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = this->_z(s[i]), z2 = z * z, z3 = z * z2, z4 = z * z3, z5 = z * z4;
+            const double zbar = z - z0, z2bar = z2 - z02, z3bar = z3 - z03, z4bar = z4 - z04, z5bar = z5 - z05;
+
+            out[i].f_t = f_t_0 / (1.0 - s[i] / Process_::m2_Br1m) * (1.0 + b_t_1 * (zbar - z5bar / 5.0) + b_t_2 * (z2bar + 2.0 * z5bar / 5.0) + b_t_3 * (z3bar - 3.0 * z5bar / 5.0) + b_t_4 * (z4bar + 4.0 * z5bar / 5.0));
+        }
     }
 
     template <typename Process_, unsigned K_>
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2013-2016, 2018 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -49,6 +50,10 @@ namespace eos
             UsedParameter _f_plus_0, _b_plus_1, _b_plus_2;
             UsedParameter            _b_zero_1, _b_zero_2, _b_zero_3;
 
+            template <typename T_> T_ _f_p(const double & s) const;
+
+            template <typename T_> T_ _f_0(const double & s) const;
+
         protected:
             double _z(const double & s) const;
 
@@ -62,6 +67,14 @@ namespace eos
             virtual double f_t(const double &) const;
 
             virtual double f_plus_T(const double &) const;
+
+            virtual bool differentiable() const;
+
+            virtual Dual f_p_dual(const double & s) const;
+
+            virtual Dual f_0_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <typename Process_> class BCL2008FormFactorBase<Process_, 4u, false> :
@@ -77,6 +90,10 @@ namespace eos
             UsedParameter _f_plus_0, _b_plus_1, _b_plus_2, _b_plus_3;
             UsedParameter            _b_zero_1, _b_zero_2, _b_zero_3, _b_zero_4;
 
+            template <typename T_> T_ _f_p(const double & s) const;
+
+            template <typename T_> T_ _f_0(const double & s) const;
+
         protected:
             double _z(const double & s) const;
 
@@ -90,6 +107,14 @@ namespace eos
             virtual double f_t(const double &) const;
 
             virtual double f_plus_T(const double &) const;
+
+            virtual bool differentiable() const;
+
+            virtual Dual f_p_dual(const double & s) const;
+
+            virtual Dual f_0_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <typename Process_> class BCL2008FormFactorBase<Process_, 5u, false> :
@@ -105,6 +130,10 @@ namespace eos
             UsedParameter _f_plus_0, _b_plus_1, _b_plus_2, _b_plus_3, _b_plus_4;
             UsedParameter            _b_zero_1, _b_zero_2, _b_zero_3, _b_zero_4, _b_zero_5;
 
+            template <typename T_> T_ _f_p(const double & s) const;
+
+            template <typename T_> T_ _f_0(const double & s) const;
+
         protected:
             double _z(const double & s) const;
 
@@ -118,6 +147,14 @@ namespace eos
             virtual double f_t(const double &) const;
 
             virtual double f_plus_T(const double &) const;
+
+            virtual bool differentiable() const;
+
+            virtual Dual f_p_dual(const double & s) const;
+
+            virtual Dual f_0_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <typename Process_> class BCL2008FormFactorBase<Process_, 3u, true> :
@@ -134,10 +171,16 @@ namespace eos
              */
             UsedParameter _f_t_0,    _b_t_1,    _b_t_2;
 
+            template <typename T_> T_ _f_t(const double & s) const;
+
         public:
             BCL2008FormFactorBase(const Parameters & p, const Options & o);
 
             virtual double f_t(const double & s) const;
+
+            virtual Dual f_t_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <typename Process_> class BCL2008FormFactorBase<Process_, 4u, true> :
@@ -154,10 +197,16 @@ namespace eos
              */
             UsedParameter _f_t_0,    _b_t_1,    _b_t_2,    _b_t_3;
 
+            template <typename T_> T_ _f_t(const double & s) const;
+
         public:
             BCL2008FormFactorBase(const Parameters & p, const Options & o);
 
             virtual double f_t(const double & s) const;
+
+            virtual Dual f_t_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     template <typename Process_> class BCL2008FormFactorBase<Process_, 5u, true> :
@@ -174,10 +223,16 @@ namespace eos
              */
             UsedParameter _f_t_0,    _b_t_1,    _b_t_2,    _b_t_3,    _b_t_4;
 
+            template <typename T_> T_ _f_t(const double & s) const;
+
         public:
             BCL2008FormFactorBase(const Parameters & p, const Options & o);
 
             virtual double f_t(const double & s) const;
+
+            virtual Dual f_t_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
 
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2014, 2015, 2018 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -20,6 +21,9 @@
 #include <test/test.hh>
 #include <eos/form-factors/parametric-bcl2008-impl.hh>
 
+#include <cmath>
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -106,6 +110,20 @@ class BCL2008FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(1.45892, ff->f_0(10.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(1.91416, ff->f_0(15.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(2.80533, ff->f_0(20.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ 0.0, 5.0, 10.0, 15.0, 20.0, 26.0 };
+                    std::vector<FormFactorValues<PToP>> values(q2.size());
+                    ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_p, ff->f_p(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_0, ff->f_0(q2[i]), 1e-12);
+                        TEST_CHECK(std::isnan(values[i].f_t));
+                    }
+                }
             }
         }
 } bcl2008_form_factors_test;
@@ -256,6 +274,20 @@ class BCL2008K4FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(1.51330, ff->f_t(10.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(2.06777, ff->f_t(15.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(3.30001, ff->f_t(20.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ 0.0, 5.0, 10.0, 15.0, 20.0, 26.0 };
+                    std::vector<FormFactorValues<PToP>> values(q2.size());
+                    ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_p, ff->f_p(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_0, ff->f_0(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_t, ff->f_t(q2[i]), 1e-12);
+                    }
+                }
             }
         }
 } bcl2008_k4_form_factors_k4_test;
@@ -455,6 +487,20 @@ class BCL2008K5FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(1.53465, ff->f_t(10.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(2.10670, ff->f_t(15.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(3.36677, ff->f_t(20.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ 0.0, 5.0, 10.0, 15.0, 20.0, 26.0 };
+                    std::vector<FormFactorValues<PToP>> values(q2.size());
+                    ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_p, ff->f_p(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_0, ff->f_0(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_t, ff->f_t(q2[i]), 1e-12);
+                    }
+                }
             }
         }
 } bcl2008_k5_form_factors_k5_test;
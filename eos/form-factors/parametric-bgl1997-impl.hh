@@ -4,6 +4,7 @@
  * Copyright (c) 2020 Danny van Dyk
  * Copyright (c) 2020 Nico Gubernari
  * Copyright (c) 2020 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -262,6 +263,41 @@ namespace eos
         return 0.0;  //  TODO
     }
 
+    void
+    BGL1997FormFactors<BToDstar>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const
+    {
+        // read the parameters once for the entire grid
+        const double a_g[4]  = { _a_g[0](),  _a_g[1](),  _a_g[2](),  _a_g[3]()  };
+        const double a_f[4]  = { _a_f[0](),  _a_f[1](),  _a_f[2](),  _a_f[3]()  };
+        const double a_F1[4] = { _a_F1[0](), _a_F1[1](), _a_F1[2](), _a_F1[3]() };
+        const double a_F2[4] = { _a_F2[0](), _a_F2[1](), _a_F2[2](), _a_F2[3]() };
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = _z(s[i], _t_0), z2 = z * z, z3 = z * z2;
+
+            // resonances for 1^-, 1^+, and 0^-; f and F1 share the 1^+ resonances
+            const double blaschke_1m = _z(s[i], 6.329 * 6.329) * _z(s[i], 6.910 * 6.910) * _z(s[i], 7.020 * 7.020);
+            const double blaschke_1p = _z(s[i], 6.739 * 6.739) * _z(s[i], 6.750 * 6.750) * _z(s[i], 7.145 * 7.145) * _z(s[i], 7.150 * 7.150);
+            const double blaschke_0m = _z(s[i], 6.275 * 6.275) * _z(s[i], 6.871 * 6.871) * _z(s[i], 7.250 * 7.250);
+
+            const double g  = (a_g[0]  + a_g[1]  * z + a_g[2]  * z2 + a_g[3]  * z3) / _phi(s[i], _t_0, 96, 3, 3, 1, _chi_1m) / blaschke_1m;
+            const double f  = (a_f[0]  + a_f[1]  * z + a_f[2]  * z2 + a_f[3]  * z3) / _phi(s[i], _t_0, 24, 1, 1, 1, _chi_1p) / blaschke_1p;
+            const double F1 = (a_F1[0] + a_F1[1] * z + a_F1[2] * z2 + a_F1[3] * z3) / _phi(s[i], _t_0, 48, 1, 1, 2, _chi_1p) / blaschke_1p;
+            const double F2 = (a_F2[0] + a_F2[1] * z + a_F2[2] * z2 + a_F2[3] * z3) / _phi(s[i], _t_0, 64, 3, 3, 1, _chi_0m) / blaschke_0m;
+
+            out[i].v    = (_mB + _mV) / 2.0 * g;
+            out[i].a_0  = F2 / 2.0;
+            out[i].a_1  = 1.0 / (_mB + _mV) * f;
+            out[i].a_2  = (_mB + _mV) / eos::lambda(_mB2, _mV2, s[i]) * ((_mB2 - _mV2 - s[i]) * f - 2.0 * _mV * F1);
+            out[i].a_12 = F1 / (8.0 * _mB * _mV);
+            out[i].t_1  = 0.0;  //  TODO
+            out[i].t_2  = 0.0;  //  TODO
+            out[i].t_3  = 0.0;  //  TODO
+            out[i].t_23 = 0.0;  //  TODO
+        }
+    }
+
 
 
     std::string
@@ -301,30 +337,46 @@ namespace eos
         return new BGL1997FormFactors(parameters, options);
     }
 
-    double
-    BGL1997FormFactors<BToD>::f_p(const double & s) const
+    template <typename T_>
+    T_
+    BGL1997FormFactors<BToD>::_f_p(const double & s) const
     {
         // resonances for 1^-
         const double blaschke = _z(s, 6.329 * 6.329) * _z(s, 6.910 * 6.910) * _z(s, 7.020 * 7.020);
         const double phi      = _phi(s, _t_0, 48, 3, 3, 2, _chi_1m);
         const double z        = _z(s, _t_0);
-        const double series   = _a_f_p[0] + _a_f_p[1] * z + _a_f_p[2] * z * z + _a_f_p[3] * z * z * z;
+        const T_ series       = parameter_value<T_>(_a_f_p[0]) + parameter_value<T_>(_a_f_p[1]) * z
+                              + parameter_value<T_>(_a_f_p[2]) * z * z + parameter_value<T_>(_a_f_p[3]) * z * z * z;
 
         return series / phi / blaschke;
     }
 
-    double
-    BGL1997FormFactors<BToD>::f_0(const double & s) const
+    template <typename T_>
+    T_
+    BGL1997FormFactors<BToD>::_f_0(const double & s) const
     {
         // resonances for 0^+
         const double blaschke = _z(s, 6.704 * 6.704) * _z(s, 7.122 * 7.122);
         const double phi      = _phi(s, _t_0, 16, 1, 1, 1, _chi_0p);
         const double z        = _z(s, _t_0);
-        const double series   = _a_f_0[0] + _a_f_0[1] * z + _a_f_0[2] * z * z + _a_f_0[3] * z * z * z;
+        const T_ series       = parameter_value<T_>(_a_f_0[0]) + parameter_value<T_>(_a_f_0[1]) * z
+                              + parameter_value<T_>(_a_f_0[2]) * z * z + parameter_value<T_>(_a_f_0[3]) * z * z * z;
 
         return series / phi / blaschke;
     }
 
+    double
+    BGL1997FormFactors<BToD>::f_p(const double & s) const
+    {
+        return _f_p<double>(s);
+    }
+
+    double
+    BGL1997FormFactors<BToD>::f_0(const double & s) const
+    {
+        return _f_0<double>(s);
+    }
+
     double
     BGL1997FormFactors<BToD>::f_t(const double & /*s*/) const
     {
@@ -336,6 +388,51 @@ namespace eos
     {
         return 0.0; //  TODO
     }
+
+    bool
+    BGL1997FormFactors<BToD>::differentiable() const
+    {
+        return true;
+    }
+
+    Dual
+    BGL1997FormFactors<BToD>::f_p_dual(const double & s) const
+    {
+        return _f_p<Dual>(s);
+    }
+
+    Dual
+    BGL1997FormFactors<BToD>::f_0_dual(const double & s) const
+    {
+        return _f_0<Dual>(s);
+    }
+
+    Dual
+    BGL1997FormFactors<BToD>::f_t_dual(const double & /*s*/) const
+    {
+        return Dual(0.0); //  TODO
+    }
+
+    void
+    BGL1997FormFactors<BToD>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters once for the entire grid
+        const double a_f_p[4] = { _a_f_p[0](), _a_f_p[1](), _a_f_p[2](), _a_f_p[3]() };
+        const double a_f_0[4] = { _a_f_0[0](), _a_f_0[1](), _a_f_0[2](), _a_f_0[3]() };
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            const double z = _z(s[i], _t_0), z2 = z * z, z3 = z * z2;
+
+            // resonances for 1^- and 0^+
+            const double blaschke_1m = _z(s[i], 6.329 * 6.329) * _z(s[i], 6.910 * 6.910) * _z(s[i], 7.020 * 7.020);
+            const double blaschke_0p = _z(s[i], 6.704 * 6.704) * _z(s[i], 7.122 * 7.122);
+
+            out[i].f_p = (a_f_p[0] + a_f_p[1] * z + a_f_p[2] * z2 + a_f_p[3] * z3) / _phi(s[i], _t_0, 48, 3, 3, 2, _chi_1m) / blaschke_1m;
+            out[i].f_0 = (a_f_0[0] + a_f_0[1] * z + a_f_0[2] * z2 + a_f_0[3] * z3) / _phi(s[i], _t_0, 16, 1, 1, 1, _chi_0p) / blaschke_0p;
+            out[i].f_t = 0.0; //  TODO
+        }
+    }
 }
 
 #endif
@@ -4,6 +4,7 @@
  * Copyright (c) 2020 Danny van Dyk
  * Copyright (c) 2020 Nico Gubernari
  * Copyright (c) 2020 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -88,6 +89,8 @@ namespace eos
             virtual double f_para_T(const double & s) const;
             virtual double f_long_T(const double & s) const;
             virtual double f_long_T_Normalized(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const;
     };
 
 
@@ -105,6 +108,10 @@ namespace eos
 
             static std::string _par_name(const std::string & ff_name);
 
+            template <typename T_> T_ _f_p(const double & s) const;
+
+            template <typename T_> T_ _f_0(const double & s) const;
+
         public:
             BGL1997FormFactors(const Parameters &, const Options &);
             ~BGL1997FormFactors();
@@ -116,6 +123,14 @@ namespace eos
             virtual double f_t(const double & s) const;
 
             virtual double f_plus_T(const double & s) const;
+
+            virtual bool differentiable() const;
+
+            virtual Dual f_p_dual(const double & s) const;
+            virtual Dual f_0_dual(const double & s) const;
+            virtual Dual f_t_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 }
 
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2020 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -144,6 +145,26 @@ class BGL1997FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL( 0.176818, ff.F2(-2.0), eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.193605, ff.F2(+1.0), eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.213869, ff.F2(+4.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ -2.0, +1.0, +4.0, +8.0 };
+                    std::vector<FormFactorValues<PToV>> values(q2.size());
+                    ff.evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].v,    ff.v(q2[i]),    1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_0,  ff.a_0(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_1,  ff.a_1(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_2,  ff.a_2(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_12, ff.a_12(q2[i]), 1e-12);
+                        TEST_CHECK_EQUAL(values[i].t_1,  ff.t_1(q2[i]));
+                        TEST_CHECK_EQUAL(values[i].t_2,  ff.t_2(q2[i]));
+                        TEST_CHECK_EQUAL(values[i].t_3,  ff.t_3(q2[i]));
+                        TEST_CHECK_EQUAL(values[i].t_23, ff.t_23(q2[i]));
+                    }
+                }
             }
 
             /* B -> D FFs*/
@@ -185,6 +206,20 @@ class BGL1997FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL( 1.66529, ff.f_0(-2.0), eps);
                 TEST_CHECK_NEARLY_EQUAL( 1.68264, ff.f_0(+1.0), eps);
                 TEST_CHECK_NEARLY_EQUAL( 1.70431, ff.f_0(+4.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ -2.0, +1.0, +4.0, +8.0 };
+                    std::vector<FormFactorValues<PToP>> values(q2.size());
+                    ff.evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_p,  ff.f_p(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_0,  ff.f_0(q2[i]),  1e-12);
+                        TEST_CHECK_EQUAL(values[i].f_t,  ff.f_t(q2[i]));
+                    }
+                }
             }
         }
 } BGL1997_form_factor_test;
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2015 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -316,6 +317,60 @@ namespace eos
                 - _mB2 * lambda / (2 * pow(_mB, 3) * _mV * (_mB2 - _mV2)) * t_3(s);
     }
 
+    template <typename Process_>
+    void
+    BSZ2015FormFactors<Process_, PToV>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const
+    {
+        // read the parameters once for the entire grid
+        const double a_V[3]   = { _a_V[0](),                  _a_V[1](),   _a_V[2]()   };
+        const double a_A0[3]  = { _a_A0[0](),                 _a_A0[1](),  _a_A0[2]()  };
+        const double a_A1[3]  = { _a_A1[0](),                 _a_A1[1](),  _a_A1[2]()  };
+        const double a_A12[3] = { _kin_factor * _a_A0[0](),   _a_A12[0](), _a_A12[1]() };
+        const double a_T1[3]  = { _a_T1[0](),                 _a_T1[1](),  _a_T1[2]()  };
+        const double a_T2[3]  = { _a_T1[0](),                 _a_T2[0](),  _a_T2[1]()  };
+        const double a_T23[3] = { _a_T23[0](),                _a_T23[1](), _a_T23[2]() };
+
+        const double sqrt_tau_p_minus_tau_0 = std::sqrt(_tau_p - _tau_0);
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            // above the pair-production threshold z is complex-valued
+            if (s[i] > _tau_p)
+            {
+                FormFactors<PToV>::evaluate_all(s + i, 1, out + i);
+                continue;
+            }
+
+            const double sqrt_tau_p_minus_s = std::sqrt(_tau_p - s[i]);
+            const double dz  = (sqrt_tau_p_minus_s - sqrt_tau_p_minus_tau_0) / (sqrt_tau_p_minus_s + sqrt_tau_p_minus_tau_0) - _z_0;
+            const double dz2 = dz * dz;
+
+            const double pole_0m = 1.0 / (1.0 - s[i] / Process_::mR2_0m);
+            const double pole_1m = 1.0 / (1.0 - s[i] / Process_::mR2_1m);
+            const double pole_1p = 1.0 / (1.0 - s[i] / Process_::mR2_1p);
+
+            const double v    = pole_1m * (a_V[0]   + a_V[1]   * dz + a_V[2]   * dz2);
+            const double a_0  = pole_0m * (a_A0[0]  + a_A0[1]  * dz + a_A0[2]  * dz2);
+            const double a_1  = pole_1p * (a_A1[0]  + a_A1[1]  * dz + a_A1[2]  * dz2);
+            const double a_12 = pole_1p * (a_A12[0] + a_A12[1] * dz + a_A12[2] * dz2);
+            const double t_1  = pole_1m * (a_T1[0]  + a_T1[1]  * dz + a_T1[2]  * dz2);
+            const double t_2  = pole_1p * (a_T2[0]  + a_T2[1]  * dz + a_T2[2]  * dz2);
+            const double t_23 = pole_1p * (a_T23[0] + a_T23[1] * dz + a_T23[2] * dz2);
+
+            const double lambda = eos::lambda(_mB2, _mV2, s[i]);
+
+            out[i].v    = v;
+            out[i].a_0  = a_0;
+            out[i].a_1  = a_1;
+            out[i].a_2  = (power_of<2>(_mB + _mV) * (_mB2 - _mV2 - s[i]) * a_1 - 16.0 * _mB * _mV2 * (_mB + _mV) * a_12) / lambda;
+            out[i].a_12 = a_12;
+            out[i].t_1  = t_1;
+            out[i].t_2  = t_2;
+            out[i].t_3  = ((_mB2 - _mV2) * (_mB2 + 3.0 * _mV2 - s[i]) * t_2 - 8.0 * _mB * _mV2 * (_mB - _mV) * t_23) / lambda;
+            out[i].t_23 = t_23;
+        }
+    }
+
     template <typename Process_>
     double
     BSZ2015FormFactors<Process_, PToP>::_calc_tau_0(const double & m_B, const double & m_P)
@@ -354,6 +409,14 @@ namespace eos
                 (a_0 + a_1 * diff_z + a_2 * power_of<2>(diff_z));
     }
 
+    template <typename Process_>
+    Dual
+    BSZ2015FormFactors<Process_, PToP>::_calc_ff(const double & s, const double & m2_R, const std::array<Dual, 3> & a) const
+    {
+        const double diff_z = _calc_z(s) - _z_0;
+        return (a[0] + a[1] * diff_z + a[2] * power_of<2>(diff_z)) / (1.0 - s / m2_R);
+    }
+
     template <typename Process_>
     std::string
     BSZ2015FormFactors<Process_, PToP>::_par_name(const std::string & ff_name)
@@ -456,6 +519,68 @@ namespace eos
     {
         return real(f_plus_T(complex<double>(s)));
     }
+
+    template <typename Process_>
+    bool
+    BSZ2015FormFactors<Process_, PToP>::differentiable() const
+    {
+        return true;
+    }
+
+    template <typename Process_>
+    Dual
+    BSZ2015FormFactors<Process_, PToP>::f_p_dual(const double & s) const
+    {
+        return _calc_ff(s, Process_::m2_Br1m, std::array<Dual, 3>{{ _a_fp[0].dual(), _a_fp[1].dual(), _a_fp[2].dual() }});
+    }
+
+    template <typename Process_>
+    Dual
+    BSZ2015FormFactors<Process_, PToP>::f_t_dual(const double & s) const
+    {
+        return _calc_ff(s, Process_::m2_Br1m, std::array<Dual, 3>{{ _a_ft[0].dual(), _a_ft[1].dual(), _a_ft[2].dual() }});
+    }
+
+    template <typename Process_>
+    Dual
+    BSZ2015FormFactors<Process_, PToP>::f_0_dual(const double & s) const
+    {
+        // use equation of motion to replace f_0(0) by f_+(0)
+        return _calc_ff(s, Process_::m2_Br0p, std::array<Dual, 3>{{ _a_fp[0].dual(), _a_fz[1 - 1].dual(), _a_fz[2 - 1].dual() }});
+    }
+
+    template <typename Process_>
+    void
+    BSZ2015FormFactors<Process_, PToP>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters once for the entire grid; use equation of motion to replace f_0(0) by f_+(0)
+        const double a_fp[3] = { _a_fp[0](), _a_fp[1](), _a_fp[2]() };
+        const double a_f0[3] = { _a_fp[0](), _a_fz[0](), _a_fz[1]() };
+        const double a_ft[3] = { _a_ft[0](), _a_ft[1](), _a_ft[2]() };
+
+        const double sqrt_tau_p_minus_tau_0 = std::sqrt(_tau_p - _tau_0);
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            // above the pair-production threshold z is complex-valued
+            if (s[i] > _tau_p)
+            {
+                FormFactors<PToP>::evaluate_all(s + i, 1, out + i);
+                continue;
+            }
+
+            const double sqrt_tau_p_minus_s = std::sqrt(_tau_p - s[i]);
+            const double dz  = (sqrt_tau_p_minus_s - sqrt_tau_p_minus_tau_0) / (sqrt_tau_p_minus_s + sqrt_tau_p_minus_tau_0) - _z_0;
+            const double dz2 = dz * dz;
+
+            const double pole_1m = 1.0 / (1.0 - s[i] / Process_::m2_Br1m);
+            const double pole_0p = 1.0 / (1.0 - s[i] / Process_::m2_Br0p);
+
+            out[i].f_p = pole_1m * (a_fp[0] + a_fp[1] * dz + a_fp[2] * dz2);
+            out[i].f_0 = pole_0p * (a_f0[0] + a_f0[1] * dz + a_f0[2] * dz2);
+            out[i].f_t = pole_1m * (a_ft[0] + a_ft[1] * dz + a_ft[2] * dz2);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2015 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -110,6 +111,8 @@ namespace eos
             virtual double f_long_T(const double & s) const;
 
             virtual double f_long_T_Normalized(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const;
     };
 
     extern template class BSZ2015FormFactors<BToRho, PToV>;
@@ -142,6 +145,9 @@ namespace eos
             template <typename Parameter_>
             complex<double> _calc_ff(const complex<double> & s, const double & m2_R, const std::array<Parameter_, 3> & a) const;
 
+            // for real s below the pair-production threshold only
+            Dual _calc_ff(const double & s, const double & m2_R, const std::array<Dual, 3> & a) const;
+
             static std::string _par_name(const std::string & ff_name);
 
         public:
@@ -166,6 +172,16 @@ namespace eos
             virtual double f_0(const double & s) const;
 
             virtual double f_plus_T(const double & s) const;
+
+            virtual bool differentiable() const;
+
+            virtual Dual f_p_dual(const double & s) const;
+
+            virtual Dual f_t_dual(const double & s) const;
+
+            virtual Dual f_0_dual(const double & s) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     extern template class BSZ2015FormFactors<BToPi, PToP>;
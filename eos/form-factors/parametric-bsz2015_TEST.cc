@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2015 Frederik Beaujean
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,8 @@
 #include <test/test.hh>
 #include <eos/form-factors/parametric-bsz2015-impl.hh>
 
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -81,6 +84,20 @@ class BToPiBSZ2015FormFactorsTest :
                 TEST_CHECK_NEARLY_EQUAL(1.73442, ff->f_t(10.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(2.64425, ff->f_t(15.0), eps);
                 TEST_CHECK_NEARLY_EQUAL(4.99850, ff->f_t(20.0), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ 0.0, 5.0, 10.0, 15.0, 20.0, 26.0 };
+                    std::vector<FormFactorValues<PToP>> values(q2.size());
+                    ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_p, ff->f_p(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_0, ff->f_0(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].f_t, ff->f_t(q2[i]), 1e-12);
+                    }
+                }
             }
         }
 } b_to_pi_bsz2015_form_factors_test;
@@ -236,6 +253,26 @@ class BToKstarBSZ2015FormFactorsTest :
             TEST_CHECK_NEARLY_EQUAL(0.200925, ff->t_3(2.1), eps);
             TEST_CHECK_NEARLY_EQUAL(0.219004, ff->t_3(4.1), eps);
             TEST_CHECK_NEARLY_EQUAL(0.239587, ff->t_3(6.1), eps);
+
+            // batch evaluation agrees with the individual form factors
+            {
+                const std::vector<double> q2{ 0.1, 1.0, 2.1, 4.1, 6.1, 8.0, 12.0, 16.0, 19.0 };
+                std::vector<FormFactorValues<PToV>> values(q2.size());
+                ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                for (unsigned i = 0 ; i < q2.size() ; ++i)
+                {
+                    TEST_CHECK_RELATIVE_ERROR(values[i].v,    ff->v(q2[i]),    1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].a_0,  ff->a_0(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].a_1,  ff->a_1(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].a_2,  ff->a_2(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].a_12, ff->a_12(q2[i]), 1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].t_1,  ff->t_1(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].t_2,  ff->t_2(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].t_3,  ff->t_3(q2[i]),  1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].t_23, ff->t_23(q2[i]), 1e-12);
+                }
+            }
         }
 } b_to_kstar_bsz2015_form_factors_test;
 
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2013-2016, 2018 Danny van Dyk
  * Copyright (c) 2015 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -164,6 +165,52 @@ namespace eos
         return 0.;
     }
 
+    void
+    KMPW2010FormFactors<PToV>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const
+    {
+        const double mB = BToKstar::mB, mB2 = mB * mB;
+        const double mV = BToKstar::mV, mV2 = mV * mV;
+
+        // read the parameters once for the entire grid
+        const double f0_V  = _f0_V(),  b1_V  = _b1_V();
+        const double f0_A0 = _f0_A0(), b1_A0 = _b1_A0();
+        const double f0_A1 = _f0_A1(), b1_A1 = _b1_A1();
+        const double f0_A2 = _f0_A2(), b1_A2 = _b1_A2();
+        const double f0_T1 = _f0_T1(), b1_T1 = _b1_T1();
+        const double f0_T2 = _f0_T2(), b1_T2 = _b1_T2();
+        const double f0_T3 = _f0_T3(), b1_T3 = _b1_T3();
+
+        const double z0 = _calc_z(0.0);
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            // cf. [KMPW2010], Eq. (8.8), p. 30; all form factors share the same z dependence
+            const double zs = _calc_z(s[i]);
+            const double zeta = zs - z0 + 0.5 * (zs * zs - z0 * z0);
+
+            const double pole_0m = 1.0 / (1.0 - s[i] / _m_Bs2_0m);
+            const double pole_1m = 1.0 / (1.0 - s[i] / _m_Bs2_1m);
+            const double pole_1p = 1.0 / (1.0 - s[i] / _m_Bs2_1p);
+
+            const double a_1 = f0_A1 * pole_1p * (1.0 + b1_A1 * zeta);
+            const double a_2 = f0_A2 * pole_1p * (1.0 + b1_A2 * zeta);
+            const double t_2 = f0_T2 * pole_1p * (1.0 + b1_T2 * zeta);
+            const double t_3 = f0_T3 * pole_1p * (1.0 + b1_T3 * zeta);
+
+            const double lambda = eos::lambda(mB2, mV2, s[i]);
+
+            out[i].v    = f0_V  * pole_1m * (1.0 + b1_V  * zeta);
+            out[i].a_0  = f0_A0 * pole_0m * (1.0 + b1_A0 * zeta);
+            out[i].a_1  = a_1;
+            out[i].a_2  = a_2;
+            out[i].a_12 = ((mB + mV) * (mB + mV) * (mB2 - mV2 - s[i]) * a_1 - lambda * a_2) / (16.0 * mB * mV2 * (mB + mV));
+            out[i].t_1  = f0_T1 * pole_1m * (1.0 + b1_T1 * zeta);
+            out[i].t_2  = t_2;
+            out[i].t_3  = t_3;
+            out[i].t_23 = ((mB2 - mV2) * (mB2 + 3.0 * mV2 - s[i]) * t_2 - lambda * t_3) / (8.0 * mB * mV2 * (mB - mV));
+        }
+    }
+
     double
     KMPW2010FormFactors<PToP>::_calc_z(const double & s)
     {
@@ -217,6 +264,29 @@ namespace eos
     {
         return 0.0;
     }
+
+    void
+    KMPW2010FormFactors<PToP>::evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const
+    {
+        // read the parameters once for the entire grid
+        const double f0_p = _f0_p(), f0_t = _f0_t();
+        const double b1_p = _b1_p(), b1_0 = _b1_0(), b1_t = _b1_t();
+
+        const double z0 = _calc_z(0.0);
+
+        for (std::size_t i = 0 ; i < n ; ++i)
+        {
+            // cf. [KMPW2010], Eq. (8.8), p. 30; all form factors share the same z dependence
+            const double zs = _calc_z(s[i]);
+            const double zeta = zs - z0 + 0.5 * (zs * zs - z0 * z0);
+
+            const double pole = 1.0 / (1.0 - s[i] / _m_Bs2);
+
+            out[i].f_p = f0_p * pole * (1.0 + b1_p * zeta);
+            out[i].f_0 = f0_p * (1.0 + b1_0 * zeta);
+            out[i].f_t = f0_t * pole * (1.0 + b1_t * zeta);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2013-2016, 2018 Danny van Dyk
  * Copyright (c) 2015 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -82,6 +83,8 @@ namespace eos
             virtual double f_long_T(const double &) const;
 
             virtual double f_long_T_Normalized(const double &) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToV> * out) const;
     };
 
     extern template class KMPW2010FormFactors<PToV>;
@@ -110,6 +113,8 @@ namespace eos
             virtual double f_t(const double & s) const;
 
             virtual double f_plus_T(const double &) const;
+
+            virtual void evaluate_all(const double * s, const std::size_t & n, FormFactorValues<PToP> * out) const;
     };
 
     extern template class KMPW2010FormFactors<PToP>;
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2013-2016, 2018 Danny van Dyk
  * Copyright (c) 2015 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,8 @@
 #include <test/test.hh>
 #include <eos/form-factors/parametric-kmpw2010.hh>
 
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -119,6 +122,26 @@ class BToKstarKMPW2010FormFactorsTest:
                 TEST_CHECK_RELATIVE_ERROR(0.811519, ff->t_3(13.8), eps);
                 TEST_CHECK_RELATIVE_ERROR(1.01871 , ff->t_3(16.1), eps);
                 TEST_CHECK_RELATIVE_ERROR(1.29621 , ff->t_3(18.4), eps);
+
+                // batch evaluation agrees with the individual form factors
+                {
+                    const std::vector<double> q2{ 0.0, 2.3, 6.9, 11.5, 16.1, 18.4 };
+                    std::vector<FormFactorValues<PToV>> values(q2.size());
+                    ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                    for (unsigned i = 0 ; i < q2.size() ; ++i)
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(values[i].v,    ff->v(q2[i]),    1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_0,  ff->a_0(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_1,  ff->a_1(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_2,  ff->a_2(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].a_12, ff->a_12(q2[i]), 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].t_1,  ff->t_1(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].t_2,  ff->t_2(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].t_3,  ff->t_3(q2[i]),  1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(values[i].t_23, ff->t_23(q2[i]), 1e-12);
+                    }
+                }
             }
 
             // raised values
@@ -336,5 +359,19 @@ class BToKKMPW2010FormFactorsTest :
             TEST_CHECK_NEARLY_EQUAL(0.5946449022903, ff->f_0(16.1), eps);
             TEST_CHECK_NEARLY_EQUAL(0.6449812193912, ff->f_0(18.4), eps);
             TEST_CHECK_NEARLY_EQUAL(0.7011445924499, ff->f_0(20.7), eps);
+
+            // batch evaluation agrees with the individual form factors
+            {
+                const std::vector<double> q2{ 0.0, 2.3, 6.9, 11.5, 16.1, 20.7 };
+                std::vector<FormFactorValues<PToP>> values(q2.size());
+                ff->evaluate_all(q2.data(), q2.size(), values.data());
+
+                for (unsigned i = 0 ; i < q2.size() ; ++i)
+                {
+                    TEST_CHECK_RELATIVE_ERROR(values[i].f_p, ff->f_p(q2[i]), 1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].f_0, ff->f_0(q2[i]), 1e-12);
+                    TEST_CHECK_RELATIVE_ERROR(values[i].f_t, ff->f_t(q2[i]), 1e-12);
+                }
+            }
         }
 } b_to_k_kmpw2010_form_factors_test;
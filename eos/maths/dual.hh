@@ -0,0 +1,245 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_MATHS_DUAL_HH
+#define EOS_GUARD_EOS_MATHS_DUAL_HH 1
+
+#include <cmath>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Dual number for forward-mode automatic differentiation.
+     *
+     * A Dual holds a value and its gradient with respect to a fixed set of directions,
+     * e.g. the varied parameters of a fit. An empty gradient represents a constant,
+     * i.e., a vanishing gradient of arbitrary dimension. This keeps the arithmetic
+     * with constants cheap.
+     */
+    class Dual
+    {
+        public:
+            double value;
+
+            std::vector<double> gradient;
+
+            ///@name Basic Functions
+            ///@{
+            /// Constructor for a constant.
+            Dual(const double & value = 0.0) :
+                value(value)
+            {
+            }
+
+            /// Constructor for a value with a given gradient.
+            Dual(const double & value, const std::vector<double> & gradient) :
+                value(value),
+                gradient(gradient)
+            {
+            }
+
+            /*!
+             * Named constructor for one of the independent variables.
+             *
+             * @param value      The value of the variable.
+             * @param direction  The index of the variable among all directions.
+             * @param dimension  The number of directions.
+             */
+            static Dual variable(const double & value, const unsigned & direction, const unsigned & dimension)
+            {
+                Dual result(value, std::vector<double>(dimension, 0.0));
+                result.gradient[direction] = 1.0;
+
+                return result;
+            }
+            ///@}
+
+            /// Retrieve the derivative in the given direction.
+            double derivative(const unsigned & direction) const
+            {
+                return gradient.empty() ? 0.0 : gradient[direction];
+            }
+
+            ///@name Arithmetic
+            ///@{
+            Dual & operator+= (const Dual & rhs)
+            {
+                _axpy(1.0, rhs.gradient);
+                value += rhs.value;
+
+                return *this;
+            }
+
+            Dual & operator-= (const Dual & rhs)
+            {
+                _axpy(-1.0, rhs.gradient);
+                value -= rhs.value;
+
+                return *this;
+            }
+
+            Dual & operator*= (const Dual & rhs)
+            {
+                if (this == &rhs)
+                    return *this *= Dual(rhs);
+
+                // d(u v) = v du + u dv
+                _scale(rhs.value);
+                _axpy(value, rhs.gradient);
+                value *= rhs.value;
+
+                return *this;
+            }
+
+            Dual & operator/= (const Dual & rhs)
+            {
+                // d(u / v) = (du - (u / v) dv) / v
+                const double quotient = value / rhs.value;
+                _axpy(-quotient, rhs.gradient);
+                _scale(1.0 / rhs.value);
+                value = quotient;
+
+                return *this;
+            }
+
+            Dual & operator+= (const double & rhs)
+            {
+                value += rhs;
+
+                return *this;
+            }
+
+            Dual & operator-= (const double & rhs)
+            {
+                value -= rhs;
+
+                return *this;
+            }
+
+            Dual & operator*= (const double & rhs)
+            {
+                _scale(rhs);
+                value *= rhs;
+
+                return *this;
+            }
+
+            Dual & operator/= (const double & rhs)
+            {
+                _scale(1.0 / rhs);
+                value /= rhs;
+
+                return *this;
+            }
+            ///@}
+
+            /*!
+             * Apply a function with known derivative to this dual number.
+             *
+             * @param value       The value of the function.
+             * @param derivative  The derivative of the function at this dual number's value.
+             */
+            Dual chain(const double & value, const double & derivative) const
+            {
+                Dual result(value, gradient);
+                result._scale(derivative);
+
+                return result;
+            }
+
+            ///@name Operators and functions, found through argument-dependent lookup only
+            ///@{
+            // note: exp() is not provided, since eos::exp names the namespace of the expression parser
+            friend Dual operator+ (Dual lhs, const Dual & rhs) { return lhs += rhs; }
+            friend Dual operator- (Dual lhs, const Dual & rhs) { return lhs -= rhs; }
+            friend Dual operator* (Dual lhs, const Dual & rhs) { return lhs *= rhs; }
+            friend Dual operator/ (Dual lhs, const Dual & rhs) { return lhs /= rhs; }
+
+            friend Dual operator+ (Dual lhs, const double & rhs) { return lhs += rhs; }
+            friend Dual operator- (Dual lhs, const double & rhs) { return lhs -= rhs; }
+            friend Dual operator* (Dual lhs, const double & rhs) { return lhs *= rhs; }
+            friend Dual operator/ (Dual lhs, const double & rhs) { return lhs /= rhs; }
+
+            friend Dual operator+ (const double & lhs, Dual rhs) { return rhs += lhs; }
+            friend Dual operator- (const double & lhs, const Dual & rhs) { return rhs.chain(lhs - rhs.value, -1.0); }
+            friend Dual operator* (const double & lhs, Dual rhs) { return rhs *= lhs; }
+            friend Dual operator/ (const double & lhs, const Dual & rhs) { return rhs.chain(lhs / rhs.value, -lhs / (rhs.value * rhs.value)); }
+
+            friend Dual operator- (const Dual & x) { return x.chain(-x.value, -1.0); }
+
+            friend Dual log(const Dual & x)
+            {
+                return x.chain(std::log(x.value), 1.0 / x.value);
+            }
+
+            friend Dual sqrt(const Dual & x)
+            {
+                const double value = std::sqrt(x.value);
+
+                return x.chain(value, 0.5 / value);
+            }
+
+            friend Dual pow(const Dual & x, const double & a)
+            {
+                return x.chain(std::pow(x.value, a), a * std::pow(x.value, a - 1.0));
+            }
+
+            friend Dual pow(const Dual & x, const Dual & y)
+            {
+                if (y.gradient.empty())
+                    return pow(x, y.value);
+
+                // d(u^v) = v u^(v - 1) du + u^v log(u) dv
+                const double value = std::pow(x.value, y.value);
+                Dual result = x.chain(value, y.value * std::pow(x.value, y.value - 1.0));
+                result._axpy(value * std::log(x.value), y.gradient);
+
+                return result;
+            }
+            ///@}
+
+        private:
+            // gradient <- gradient + a * x
+            void _axpy(const double & a, const std::vector<double> & x)
+            {
+                if (x.empty())
+                    return;
+
+                if (gradient.empty())
+                    gradient.assign(x.size(), 0.0);
+
+                for (std::size_t i = 0 ; i < x.size() ; ++i)
+                {
+                    gradient[i] += a * x[i];
+                }
+            }
+
+            // gradient <- a * gradient
+            void _scale(const double & a)
+            {
+                for (auto & g : gradient)
+                {
+                    g *= a;
+                }
+            }
+    };
+}
+
+#endif
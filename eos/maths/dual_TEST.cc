@@ -0,0 +1,106 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/maths/dual.hh>
+#include <eos/maths/power-of.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class DualTest :
+    public TestCase
+{
+    public:
+        DualTest() :
+            TestCase("dual_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-13;
+
+            // arithmetic in two directions
+            {
+                const Dual x = Dual::variable(1.5, 0, 2);
+                const Dual y = Dual::variable(-0.5, 1, 2);
+
+                // f = x^2 y + 3 x / y - 2
+                const Dual f = x * x * y + 3.0 * x / y - 2.0;
+                TEST_CHECK_NEARLY_EQUAL(f.value,         1.5 * 1.5 * -0.5 + 3.0 * 1.5 / -0.5 - 2.0, eps);
+                TEST_CHECK_NEARLY_EQUAL(f.derivative(0), 2.0 * 1.5 * -0.5 + 3.0 / -0.5,              eps);
+                TEST_CHECK_NEARLY_EQUAL(f.derivative(1), 1.5 * 1.5 - 3.0 * 1.5 / 0.25,               eps);
+
+                // g = 1 / x - (y - x)
+                const Dual g = 1.0 / x - (y - x);
+                TEST_CHECK_NEARLY_EQUAL(g.value,         1.0 / 1.5 + 2.0,         eps);
+                TEST_CHECK_NEARLY_EQUAL(g.derivative(0), -1.0 / (1.5 * 1.5) + 1.0, eps);
+                TEST_CHECK_NEARLY_EQUAL(g.derivative(1), -1.0,                    eps);
+
+                // compound assignment, including aliasing
+                Dual h = x;
+                h *= h;
+                h -= -y;
+                TEST_CHECK_NEARLY_EQUAL(h.value,         2.25 - 0.5, eps);
+                TEST_CHECK_NEARLY_EQUAL(h.derivative(0), 3.0,        eps);
+                TEST_CHECK_NEARLY_EQUAL(h.derivative(1), 1.0,        eps);
+            }
+
+            // constants do not carry a gradient
+            {
+                const Dual c(2.0);
+                const Dual x = Dual::variable(0.3, 0, 1);
+
+                TEST_CHECK(c.gradient.empty());
+                TEST_CHECK(((c * c) + 1.0).gradient.empty());
+                TEST_CHECK_NEARLY_EQUAL(c.derivative(0),           0.0, eps);
+                TEST_CHECK_NEARLY_EQUAL((c * x).derivative(0),     2.0, eps);
+                TEST_CHECK_NEARLY_EQUAL((x - c * x).derivative(0), -1.0, eps);
+            }
+
+            // elementary functions, and power_of
+            {
+                const Dual x = Dual::variable(0.7, 0, 1);
+
+                TEST_CHECK_NEARLY_EQUAL(log(x).derivative(0),       1.0 / 0.7,                    eps);
+                TEST_CHECK_NEARLY_EQUAL(sqrt(x).derivative(0),      0.5 / std::sqrt(0.7),         eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(x, 2.5).derivative(0),  2.5 * std::pow(0.7, 1.5),     eps);
+                TEST_CHECK_NEARLY_EQUAL(power_of<3>(x).value,       0.7 * 0.7 * 0.7,              eps);
+                TEST_CHECK_NEARLY_EQUAL(power_of<3>(x).derivative(0), 3.0 * 0.7 * 0.7,            eps);
+                TEST_CHECK_NEARLY_EQUAL(power_of<0>(x).value,       1.0,                          eps);
+                TEST_CHECK_NEARLY_EQUAL(power_of<0>(x).derivative(0), 0.0,                        eps);
+            }
+
+            // powers with a variable exponent
+            {
+                const Dual x = Dual::variable(0.7, 0, 2);
+                const Dual y = Dual::variable(1.3, 1, 2);
+
+                TEST_CHECK_NEARLY_EQUAL(pow(x, y).value,           std::pow(0.7, 1.3),                  eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(x, y).derivative(0),   1.3 * std::pow(0.7, 0.3),            eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(x, y).derivative(1),   std::pow(0.7, 1.3) * std::log(0.7),  eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(x, Dual(2.0)).derivative(0), 2.0 * 0.7,                     eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(x, Dual(2.0)).derivative(1), 0.0,                           eps);
+                TEST_CHECK_NEARLY_EQUAL(pow(Dual(2.0), y).derivative(1), std::pow(2.0, 1.3) * std::log(2.0), eps);
+            }
+        }
+} dual_test;
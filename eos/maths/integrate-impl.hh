@@ -4,6 +4,7 @@
  * Copyright (c) 2010, 2011 Danny van Dyk
  * Copyright (c) 2011 Christian Wacker
  * Copyright (c) 2018 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -31,7 +32,8 @@
 
 namespace eos
 {
-    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b)
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<void (const std::vector<double> &, std::vector<std::array<double, k>> &)> & f,
+            unsigned n, const double & a, const double & b)
     {
         if (n & 0x1)
             n += 1;
@@ -39,59 +41,61 @@ namespace eos
         if (n < 16)
             n = 16;
 
-        // step width
-        double h = (b - a) / n;
-
         // evaluate function for every sampling point
-        std::vector<std::array<double, k>> y;
+        std::vector<double> x(n + 1);
         for (unsigned i = 0 ; i < n + 1 ; ++i)
         {
-            y.push_back(f(a + i * h));
+            x[i] = a + i * ((b - a) / n);
         }
+        std::vector<std::array<double, k>> y(n + 1);
+        f(x, y);
 
-        std::array<double, k> Q0; Q0.fill(0.0);
-        std::array<double, k> Q1; Q1.fill(0.0);
-        std::array<double, k> Q2; Q2.fill(0.0);
-
-        for (unsigned i = 0 ; i < n / 8 ; ++i)
+        while (true)
         {
-            Q0 = Q0 + y[8 * i] + 4.0 * y[8 * i + 4] + y[8 * i + 4];
-        }
-        for (unsigned i = 0 ; i < n / 4 ; ++i)
-        {
-            Q1 = Q1 + y[4 * i] + 4.0 * y[4 * i + 2] + y[4 * i + 4];
-        }
-        for (unsigned i = 0 ; i < n / 2 ; ++i)
-        {
-            Q2 = Q2 + y[2 * i] + 4.0 * y[2 * i + 1] + y[2 * i + 2];
-        }
+            // step width
+            double h = (b - a) / n;
 
-        Q0 = (h / 3.0 * 4.0) * Q0;
-        Q1 = (h / 3.0 * 2.0) * Q1;
-        Q2 = (h / 3.0) * Q2;
+            std::array<double, k> Q0; Q0.fill(0.0);
+            std::array<double, k> Q1; Q1.fill(0.0);
+            std::array<double, k> Q2; Q2.fill(0.0);
 
-        std::array<double, k> denom = Q0 + Q2 - 2.0 * Q1;
-        std::array<double, k> num = Q2 - Q1;
-        std::array<double, k> correction = divide(mult(num, num), denom);
+            for (unsigned i = 0 ; i < n / 8 ; ++i)
+            {
+                Q0 = Q0 + y[8 * i] + 4.0 * y[8 * i + 4] + y[8 * i + 4];
+            }
+            for (unsigned i = 0 ; i < n / 4 ; ++i)
+            {
+                Q1 = Q1 + y[4 * i] + 4.0 * y[4 * i + 2] + y[4 * i + 4];
+            }
+            for (unsigned i = 0 ; i < n / 2 ; ++i)
+            {
+                Q2 = Q2 + y[2 * i] + 4.0 * y[2 * i + 1] + y[2 * i + 2];
+            }
 
-        bool correction_valid = true;
-        for (unsigned i = 0 ; i < k ; ++i)
-        {
-            if (std::isnan(correction[i]))
+            Q0 = (h / 3.0 * 4.0) * Q0;
+            Q1 = (h / 3.0 * 2.0) * Q1;
+            Q2 = (h / 3.0) * Q2;
+
+            std::array<double, k> denom = Q0 + Q2 - 2.0 * Q1;
+            std::array<double, k> num = Q2 - Q1;
+            std::array<double, k> correction = divide(mult(num, num), denom);
+
+            bool correction_valid = true;
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                if (std::isnan(correction[i]))
+                {
+                    correction_valid = false;
+                    break;
+                }
+            }
+
+            if (!correction_valid)
             {
-                correction_valid = false;
-                break;
+                return Q2;
             }
-        }
 
-        if (!correction_valid)
-        {
-            return Q2;
-        }
-        else
-        {
             bool correction_small = true;
-
             for (unsigned i = 0 ; i < k ; ++i)
             {
                 if ((abs(correction[i] / Q2[i])) > 1.0)
@@ -105,19 +109,43 @@ namespace eos
             {
                 return Q2 - correction;
             }
-            else
+
+            // reintegrate with twice the number of data points, reusing the present ones
+            std::vector<double> x_mid(n);
+            for (unsigned i = 0 ; i < n ; ++i)
             {
-#if 0
-                std::cerr << "Q0 = " << Q0 << std::endl;
-                std::cerr << "Q1 = " << Q1 << std::endl;
-                std::cerr << "Q2 = " << Q2 << std::endl;
-                std::cerr << "Reintegrating with twice the number of data points" << std::endl;
-#endif
-                return integrate1D(f, 2 * n, a, b);
+                x_mid[i] = a + (2 * i + 1) * ((b - a) / (2 * n));
             }
+            std::vector<std::array<double, k>> y_mid(n);
+            f(x_mid, y_mid);
+
+            std::vector<std::array<double, k>> y_refined(2 * n + 1);
+            for (unsigned i = 0 ; i < n ; ++i)
+            {
+                y_refined[2 * i]     = y[i];
+                y_refined[2 * i + 1] = y_mid[i];
+            }
+            y_refined[2 * n] = y[n];
+
+            y.swap(y_refined);
+            n *= 2;
         }
     }
 
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b)
+    {
+        const std::function<void (const std::vector<double> &, std::vector<std::array<double, k>> &)> g =
+            [&f](const std::vector<double> & x, std::vector<std::array<double, k>> & y)
+            {
+                for (unsigned i = 0 ; i < x.size() ; ++i)
+                {
+                    y[i] = f(x[i]);
+                }
+            };
+
+        return integrate1D<k>(g, n, a, b);
+    }
+
     namespace cubature
     {
 
@@ -137,6 +165,44 @@ namespace eos
             return 0;
         }
 
+        template <size_t dim_, size_t fdim_>
+        int vector_integrand(unsigned ndim , const double *x, void *data,
+                      unsigned fdim , double *fval)
+        {
+            assert(ndim == dim_);
+            assert(fdim == fdim_);
+
+            auto& f = *static_cast<cubature::fvd<dim_, fdim_> *>(data);
+            std::array<double, dim_> args;
+            std::copy(x, x + dim_, args.data());
+            const std::array<double, fdim_> values = f(args);
+            std::copy(values.cbegin(), values.cend(), fval);
+
+            return 0;
+        }
+
+        template <size_t dim_, size_t fdim_>
+        int batched_integrand(unsigned ndim, size_t npt, const double *x, void *data,
+                      unsigned fdim, double *fval)
+        {
+            assert(ndim == dim_);
+            assert(fdim == fdim_);
+
+            auto& f = *static_cast<cubature::fvd_v<dim_, fdim_> *>(data);
+            std::vector<std::array<double, dim_>> args(npt);
+            for (size_t i = 0 ; i < npt ; ++i)
+            {
+                std::copy(x + i * dim_, x + (i + 1) * dim_, args[i].data());
+            }
+            std::vector<std::array<double, fdim_>> values(npt);
+            f(args, values);
+            for (size_t i = 0 ; i < npt ; ++i)
+            {
+                std::copy(values[i].cbegin(), values[i].cend(), fval + i * fdim_);
+            }
+
+            return 0;
+        }
     }
 
     template <size_t dim_>
@@ -159,6 +225,41 @@ namespace eos
         return res;
     }
 
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const cubature::fvd<dim_, fdim_> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config)
+    {
+        std::array<double, fdim_> res;
+        std::array<double, fdim_> err;
+        if (hcubature(fdim_, &cubature::vector_integrand<dim_, fdim_>,
+                      &const_cast<cubature::fvd<dim_, fdim_>&>(f), dim_, a.data(), b.data(),
+                      config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, res.data(), err.data()))
+        {
+            throw IntegrationError("hcubature failed");
+        }
+
+        return res;
+    }
+
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const cubature::fvd_v<dim_, fdim_> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config)
+    {
+        std::array<double, fdim_> res;
+        std::array<double, fdim_> err;
+        if (hcubature_v(fdim_, &cubature::batched_integrand<dim_, fdim_>,
+                        &const_cast<cubature::fvd_v<dim_, fdim_>&>(f), dim_, a.data(), b.data(),
+                        config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, res.data(), err.data()))
+        {
+            throw IntegrationError("hcubature_v failed");
+        }
+
+        return res;
+    }
 }
 
 #endif
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010 Danny van Dyk
  * Copyright (c) 2018 Danny van Dyk and Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -32,6 +33,7 @@
 
 #include <array>
 #include <functional>
+#include <vector>
 
 namespace eos
 {
@@ -52,6 +54,22 @@ namespace eos
     template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b);
     /// @}
 
+    /*!
+     * Numerically integrate vector-valued functions of one real-valued parameter,
+     * evaluating the integrand on batches of points.
+     *
+     * The integrand receives all sampling points of one refinement step at once,
+     * and must fill the i-th element of its second argument with the function value at the
+     * i-th point. Refining the result only evaluates the integrand at the new points.
+     *
+     * @param f      Batched integrand.
+     * @param n      Number of evaluations, must be a power of 2.
+     * @param a      Lower limit of the domain of integration.
+     * @param b      Upper limit of the domain of integration.
+     */
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<void (const std::vector<double> &, std::vector<std::array<double, k>> &)> & f,
+            unsigned n, const double & a, const double & b);
+
 namespace GSL
 {
     using fdd = std::function<double(const double &)>;
@@ -129,6 +147,12 @@ namespace cubature
     template <size_t dim_>
     using fdd = std::function<double(const std::array<double, dim_> &)>;
 
+    template <size_t dim_, size_t fdim_>
+    using fvd = std::function<std::array<double, fdim_>(const std::array<double, dim_> &)>;
+
+    template <size_t dim_, size_t fdim_>
+    using fvd_v = std::function<void (const std::vector<std::array<double, dim_>> &, std::vector<std::array<double, fdim_>> &)>;
+
     class Config
     {
     public:
@@ -158,6 +182,37 @@ namespace cubature
                      const std::array<double, dim_> &b,
                      const cubature::Config &config = cubature::Config());
 
+    /*!
+     * Numerically integrate vector-valued functions of one or more than one
+     * variable with cubature methods.
+     *
+     * All components are integrated on the same set of points, and the
+     * integration stops once the L2 norm of the error estimates meets the
+     * requested accuracy, relative to the L2 norm of the result. Components
+     * much smaller than the others therefore have larger relative errors.
+     * Use this for integrands that share expensive intermediate results.
+     */
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<std::array<double, fdim_>(const std::array<double, dim_> &)> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config = cubature::Config());
+
+    /*!
+     * Numerically integrate vector-valued functions of one or more than one
+     * variable with cubature methods, evaluating the integrand on batches of points.
+     *
+     * The integrand receives all points of one refinement step at once, and must
+     * fill the i-th element of its second argument with the function values at the
+     * i-th point. The accuracy is controlled as for the point-wise integrand above.
+     * Use this for integrands that can amortize setup costs across points.
+     */
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<void (const std::vector<std::array<double, dim_>> &, std::vector<std::array<double, fdim_>> &)> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config = cubature::Config());
+
     class IntegrationError :
         public Exception
     {
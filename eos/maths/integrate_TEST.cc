@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -111,5 +112,39 @@ class IntegrateTest :
             };
             auto q5 = integrate(cubature::fdd<dim>(f5lam), a_5, b_5, config_cubature);
             TEST_CHECK_RELATIVE_ERROR(q5, 1.0, eps);
+
+            // vector-valued integrand: the Morokoff test function and its first moment in args[0]
+            auto f6lam = [&f5lam](const std::array<double, dim> &args) -> std::array<double, 2> {
+                const double f5 = f5lam(args);
+                return { f5, args[0] * f5 };
+            };
+            auto q6 = integrate(cubature::fvd<dim, 2>(f6lam), a_5, b_5, config_cubature);
+            TEST_CHECK_RELATIVE_ERROR(q6[0], 1.0, eps);
+            TEST_CHECK_RELATIVE_ERROR(q6[1], 5.0 / 9.0, eps);
+
+            // batched vector-valued integrand agrees with the point-wise one
+            auto f7lam = [&f6lam](const std::vector<std::array<double, dim>> & args, std::vector<std::array<double, 2>> & values) {
+                for (size_t i = 0 ; i < args.size() ; ++i)
+                    values[i] = f6lam(args[i]);
+            };
+            auto q7 = integrate(cubature::fvd_v<dim, 2>(f7lam), a_5, b_5, config_cubature);
+            TEST_CHECK_NEARLY_EQUAL(q7[0], q6[0], 1.0e-10);
+            TEST_CHECK_NEARLY_EQUAL(q7[1], q6[1], 1.0e-10);
+
+            // batched one-dimensional integrand agrees with the point-wise one
+            auto f8 = [](const double & x) -> std::array<double, 2> { return { std::log(x), 1.0 / x }; };
+            const std::function<std::array<double, 2> (const double &)> f8obj(f8);
+            const std::function<void (const std::vector<double> &, std::vector<std::array<double, 2>> &)> f8batch =
+                [&f8](const std::vector<double> & x, std::vector<std::array<double, 2>> & y)
+                {
+                    for (size_t i = 0 ; i < x.size() ; ++i)
+                        y[i] = f8(x[i]);
+                };
+            auto q8 = integrate1D(f8obj, 16, 1.0, std::exp(1));
+            auto q8batch = integrate1D(f8batch, 16, 1.0, std::exp(1));
+            TEST_CHECK_NEARLY_EQUAL(q8batch[0], q8[0], 1.0e-14);
+            TEST_CHECK_NEARLY_EQUAL(q8batch[1], q8[1], 1.0e-14);
+            TEST_CHECK_RELATIVE_ERROR(q8batch[0], 1.0, eps);
+            TEST_CHECK_RELATIVE_ERROR(q8batch[1], 1.0, eps);
         }
 } model_test;
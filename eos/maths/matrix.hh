@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011 Danny van Dyk
  * Copyright (c) 2010 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -22,6 +23,9 @@
 #define EOS_GUARD_EOS_MATHS_MATRIX_HH 1
 
 #include <array>
+#include <cmath>
+#include <complex>
+#include <utility>
 
 namespace eos
 {
@@ -215,6 +219,83 @@ namespace eos
 
         return result;
     }
+
+    /* Linear systems */
+
+    /*
+     * LU decomposition of a square matrix with partial pivoting, P x = L U.
+     *
+     * The decomposition is performed in place; L has unit diagonal and is stored below the diagonal.
+     * Returns the row permutation, i.e., row i of P x is row p[i] of x.
+     */
+    template <typename T_, std::size_t n_>
+    std::array<std::size_t, n_> lu_decomposition(std::array<std::array<T_, n_>, n_> & x)
+    {
+        std::array<std::size_t, n_> p;
+        for (std::size_t i(0) ; i < n_ ; ++i)
+        {
+            p[i] = i;
+        }
+
+        for (std::size_t k(0) ; k < n_ ; ++k)
+        {
+            // find the pivot
+            std::size_t pivot = k;
+            for (std::size_t i(k + 1) ; i < n_ ; ++i)
+            {
+                if (std::abs(x[i][k]) > std::abs(x[pivot][k]))
+                    pivot = i;
+            }
+
+            if (pivot != k)
+            {
+                std::swap(x[pivot], x[k]);
+                std::swap(p[pivot], p[k]);
+            }
+
+            // eliminate below the pivot
+            for (std::size_t i(k + 1) ; i < n_ ; ++i)
+            {
+                x[i][k] /= x[k][k];
+                for (std::size_t j(k + 1) ; j < n_ ; ++j)
+                {
+                    x[i][j] -= x[i][k] * x[k][j];
+                }
+            }
+        }
+
+        return p;
+    }
+
+    /* solve x y = b for y, using the LU decomposition of x and its row permutation p */
+    template <typename T_, std::size_t n_>
+    std::array<T_, n_> lu_solve(const std::array<std::array<T_, n_>, n_> & lu, const std::array<std::size_t, n_> & p,
+            const std::array<T_, n_> & b)
+    {
+        std::array<T_, n_> result;
+
+        // forward substitution, L z = P b
+        for (std::size_t i(0) ; i < n_ ; ++i)
+        {
+            result[i] = b[p[i]];
+            for (std::size_t j(0) ; j < i ; ++j)
+            {
+                result[i] -= lu[i][j] * result[j];
+            }
+        }
+
+        // backward substitution, U y = z
+        for (std::size_t i(n_) ; i-- > 0 ; )
+        {
+            for (std::size_t j(i + 1) ; j < n_ ; ++j)
+            {
+                result[i] -= lu[i][j] * result[j];
+            }
+            result[i] /= lu[i][i];
+        }
+
+        return result;
+    }
 }
 
 #endif
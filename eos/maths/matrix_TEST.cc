@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -225,3 +226,66 @@ class MatrixMultiplicationTest :
             }
         }
 } matrix_multiplication_test;
+
+class MatrixLinearSystemTest :
+    public TestCase
+{
+    public:
+        MatrixLinearSystemTest() :
+            TestCase("matrix_linear_system_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            using std::array;
+
+            // real matrix with vanishing leading element, requires pivoting
+            {
+                using Matrix = array<array<double, 3>, 3>;
+                using Vector = array<double, 3>;
+
+                const Matrix A
+                {{
+                    {{0, 2, 1}},
+                    {{4, 5, 6}},
+                    {{7, 8, 10}}
+                }};
+                const Vector x {{1/2., -1/3., 1/4.}};
+                const Vector b = A * x;
+
+                Matrix lu = A;
+                const auto p = lu_decomposition(lu);
+                const Vector result = lu_solve(lu, p, b);
+
+                for (unsigned i = 0 ; i < 3 ; ++i)
+                {
+                    TEST_CHECK_NEARLY_EQUAL(result[i], x[i], 1e-14);
+                }
+            }
+
+            // complex matrix
+            {
+                using Matrix = array<array<complex<double>, 3>, 3>;
+                using Vector = array<complex<double>, 3>;
+
+                const Matrix A
+                {{
+                    {{complex<double>(1.0, -0.5), complex<double>(0.2,  0.1), complex<double>(0.0, -0.3)}},
+                    {{complex<double>(0.2,  0.1), complex<double>(2.0,  1.0), complex<double>(0.4,  0.0)}},
+                    {{complex<double>(0.0, -0.3), complex<double>(0.4,  0.0), complex<double>(0.5,  3.0)}}
+                }};
+                const Vector x {{complex<double>(1.0, 2.0), complex<double>(-0.5, 0.25), complex<double>(0.0, -1.0)}};
+                const Vector b = A * x;
+
+                Matrix lu = A;
+                const auto p = lu_decomposition(lu);
+                const Vector result = lu_solve(lu, p, b);
+
+                for (unsigned i = 0 ; i < 3 ; ++i)
+                {
+                    TEST_CHECK_NEARLY_EQUAL(result[i], x[i], 1e-14);
+                }
+            }
+        }
+} matrix_linear_system_test;
@@ -4,6 +4,7 @@
  * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2017 Danny van Dyk
  * Copyright (c) 2018 Ahmet Kokulu
  * Copyright (c) 2018, 2021 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -504,17 +505,19 @@ namespace implementation
     }
 
     SMComponent<components::DeltaBS1>::SMComponent(const Parameters & p, ParameterUser & u) :
-        _alpha_s_Z__deltabs1(p["QCD::alpha_s(MZ)"], u),
-        _mu_t__deltabs1(p["QCD::mu_t"], u),
-        _mu_b__deltabs1(p["QCD::mu_b"], u),
-        _mu_c__deltabs1(p["QCD::mu_c"], u),
-        _sw2__deltabs1(p["GSW::sin^2(theta)"], u),
-        _m_t_pole__deltabs1(p["mass::t(pole)"], u),
-        _m_W__deltabs1(p["mass::W"], u),
-        _m_Z__deltabs1(p["mass::Z"], u),
-        _mu_0c__deltabs1(p["b->s::mu_0c"], u),
-        _mu_0t__deltabs1(p["b->s::mu_0t"], u)
+        _wc_cache__deltabs1(p),
+        _alpha_s_Z__deltabs1(p["QCD::alpha_s(MZ)"], _wc_cache__deltabs1),
+        _mu_t__deltabs1(p["QCD::mu_t"], _wc_cache__deltabs1),
+        _mu_b__deltabs1(p["QCD::mu_b"], _wc_cache__deltabs1),
+        _mu_c__deltabs1(p["QCD::mu_c"], _wc_cache__deltabs1),
+        _sw2__deltabs1(p["GSW::sin^2(theta)"], _wc_cache__deltabs1),
+        _m_t_pole__deltabs1(p["mass::t(pole)"], _wc_cache__deltabs1),
+        _m_W__deltabs1(p["mass::W"], _wc_cache__deltabs1),
+        _m_Z__deltabs1(p["mass::Z"], _wc_cache__deltabs1),
+        _mu_0c__deltabs1(p["b->s::mu_0c"], _wc_cache__deltabs1),
+        _mu_0t__deltabs1(p["b->s::mu_0t"], _wc_cache__deltabs1)
     {
+        u.uses(_wc_cache__deltabs1);
     }
 
     /* b->s Wilson coefficients */
@@ -632,6 +635,12 @@ namespace implementation
          * In the SM there is lepton flavor universality.
          */
 
+        return _wc_cache__deltabs1(mu, [&] () { return _wilson_coefficients_b_to_s(mu); });
+    }
+
+    WilsonCoefficients<BToS>
+    SMComponent<components::DeltaBS1>::_wilson_coefficients_b_to_s(const double & mu) const
+    {
         // Calculation according to [BMU1999], Eq. (25), p. 7
 
         if (mu >= _mu_t__deltabs1)
@@ -697,22 +706,30 @@ namespace implementation
     }
 
     SMComponent<components::WET::SBSB>::SMComponent(const Parameters & p, ParameterUser & u) :
-        _G_Fermi__deltabs2(p["WET::G_Fermi"], u),
-        _alpha_s_Z__deltabs2(p["QCD::alpha_s(MZ)"], u),
-        _mu_t__deltabs2(p["QCD::mu_t"], u),
-        _mu_b__deltabs2(p["QCD::mu_b"], u),
-        _mu_c__deltabs2(p["QCD::mu_c"], u),
-        _sw2__deltabs2(p["GSW::sin^2(theta)"], u),
-        _m_t_pole__deltabs2(p["mass::t(pole)"], u),
-        _m_W__deltabs2(p["mass::W"], u),
-        _m_Z__deltabs2(p["mass::Z"], u),
-        _mu_0__deltabs2(p["sbsb::mu_0"], u),
-        _mu__deltabs2(p["sbsb::mu"], u)
-    {
+        _wc_cache__deltabs2(p),
+        _G_Fermi__deltabs2(p["WET::G_Fermi"], _wc_cache__deltabs2),
+        _alpha_s_Z__deltabs2(p["QCD::alpha_s(MZ)"], _wc_cache__deltabs2),
+        _mu_t__deltabs2(p["QCD::mu_t"], _wc_cache__deltabs2),
+        _mu_b__deltabs2(p["QCD::mu_b"], _wc_cache__deltabs2),
+        _mu_c__deltabs2(p["QCD::mu_c"], _wc_cache__deltabs2),
+        _sw2__deltabs2(p["GSW::sin^2(theta)"], _wc_cache__deltabs2),
+        _m_t_pole__deltabs2(p["mass::t(pole)"], _wc_cache__deltabs2),
+        _m_W__deltabs2(p["mass::W"], _wc_cache__deltabs2),
+        _m_Z__deltabs2(p["mass::Z"], _wc_cache__deltabs2),
+        _mu_0__deltabs2(p["sbsb::mu_0"], _wc_cache__deltabs2),
+        _mu__deltabs2(p["sbsb::mu"], _wc_cache__deltabs2)
+    {
+        u.uses(_wc_cache__deltabs2);
     }
 
     WilsonCoefficients<wc::SBSB>
     SMComponent<components::WET::SBSB>::wet_sbsb() const
+    {
+        return _wc_cache__deltabs2(std::tuple<>(), [&] () { return _wet_sbsb(); });
+    }
+
+    WilsonCoefficients<wc::SBSB>
+    SMComponent<components::WET::SBSB>::_wet_sbsb() const
     {
         if (_mu__deltabs2 >= _mu_t__deltabs2)
             throw InternalError("SMComponent<components::DeltaB1>::wilson_coefficients_sbsb: Evolution to mu >= mu_t is illdefined!");
@@ -863,21 +880,28 @@ namespace implementation
     }
 
     SMComponent<components::WET::SBNuNu>::SMComponent(const Parameters &  p , ParameterUser &  u) :
-        _alpha_s_Z__sbnunu(p["QCD::alpha_s(MZ)"], u),
-        _mu_t__sbnunu(p["QCD::mu_t"], u),
-        _sw2__sbnunu(p["GSW::sin^2(theta)"], u),
-        _m_t_pole__sbnunu(p["mass::t(pole)"], u),
-        _m_W__sbnunu(p["mass::W"], u),
-        _m_Z__sbnunu(p["mass::Z"], u),
-        _mu_0__sbnunu(p["sbnunu::mu_0"], u)
+        _wc_cache__sbnunu(p),
+        _alpha_s_Z__sbnunu(p["QCD::alpha_s(MZ)"], _wc_cache__sbnunu),
+        _mu_t__sbnunu(p["QCD::mu_t"], _wc_cache__sbnunu),
+        _sw2__sbnunu(p["GSW::sin^2(theta)"], _wc_cache__sbnunu),
+        _m_t_pole__sbnunu(p["mass::t(pole)"], _wc_cache__sbnunu),
+        _m_W__sbnunu(p["mass::W"], _wc_cache__sbnunu),
+        _m_Z__sbnunu(p["mass::Z"], _wc_cache__sbnunu),
+        _mu_0__sbnunu(p["sbnunu::mu_0"], _wc_cache__sbnunu)
     {
+        u.uses(_wc_cache__sbnunu);
     }
 
     WilsonCoefficients<wc::SBNuNu>
     SMComponent<components::WET::SBNuNu>::wet_sbnunu(const bool & /* cp_conjugate */) const
     {
         // SM Wilson coefficients are real so cp conjugation has no effect
+        return _wc_cache__sbnunu(std::tuple<>(), [&] () { return _wet_sbnunu(); });
+    }
 
+    WilsonCoefficients<wc::SBNuNu>
+    SMComponent<components::WET::SBNuNu>::_wet_sbnunu() const
+    {
         // calculate alpha_s
         static const double nf    = 5.0;
         static const auto & beta5 = QCD::beta_function_nf_5;
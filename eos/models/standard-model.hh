@@ -4,6 +4,7 @@
  * Copyright (c) 2010-2015, 2021 Danny van Dyk
  * Copyright (c) 2018 Ahmet Kokulu
  * Copyright (c) 2018 Christoph Bobeth
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -23,8 +24,11 @@
 #define EOS_GUARD_EOS_MODELS_STANDARD_MODEL_HH 1
 
 #include <eos/models/model.hh>
+#include <eos/utils/parameter-dependent-cache.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 
+#include <tuple>
+
 namespace eos
 {
     template <typename Tag> class SMComponent;
@@ -98,6 +102,9 @@ namespace eos
         public virtual ModelComponent<components::DeltaBS1>
     {
         private:
+            /* Evolved Wilson coefficients, keyed by the low scale */
+            ParameterDependentCache<double, WilsonCoefficients<BToS>> _wc_cache__deltabs1;
+
             /* QCD parameters */
             UsedParameter _alpha_s_Z__deltabs1;
             UsedParameter _mu_t__deltabs1;
@@ -116,6 +123,8 @@ namespace eos
             UsedParameter _mu_0c__deltabs1;
             UsedParameter _mu_0t__deltabs1;
 
+            WilsonCoefficients<BToS> _wilson_coefficients_b_to_s(const double & mu) const;
+
         public:
             SMComponent(const Parameters &, ParameterUser &);
 
@@ -127,6 +136,9 @@ namespace eos
         public virtual ModelComponent<components::WET::SBSB>
     {
         private:
+            /* Evolved Wilson coefficients */
+            ParameterDependentCache<std::tuple<>, WilsonCoefficients<wc::SBSB>> _wc_cache__deltabs2;
+
             /* Weak decay parameters */
             UsedParameter _G_Fermi__deltabs2;
 
@@ -150,6 +162,8 @@ namespace eos
             /* Low scale */
             UsedParameter _mu__deltabs2;
 
+            WilsonCoefficients<wc::SBSB> _wet_sbsb() const;
+
         public:
             SMComponent(const Parameters &, ParameterUser &);
 
@@ -180,6 +194,9 @@ namespace eos
     template <> class SMComponent<components::WET::SBNuNu> :
     public virtual ModelComponent<components::WET::SBNuNu>
     {
+            /* Matched Wilson coefficients */
+            ParameterDependentCache<std::tuple<>, WilsonCoefficients<wc::SBNuNu>> _wc_cache__sbnunu;
+
             /* QCD parameters */
             UsedParameter _alpha_s_Z__sbnunu;
             UsedParameter _mu_t__sbnunu;
@@ -195,6 +212,8 @@ namespace eos
             /* Matching scale */
             UsedParameter _mu_0__sbnunu;
 
+            WilsonCoefficients<wc::SBNuNu> _wet_sbnunu() const;
+
         public:
             SMComponent(const Parameters &, ParameterUser &);
 
@@ -5,6 +5,7 @@
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2014, 2018 Christoph Bobeth
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -85,65 +86,66 @@ namespace eos
 
     /* b->s Wilson coefficients */
     WilsonScanComponent<components::DeltaBS1>::WilsonScanComponent(const Parameters & p, const Options &, ParameterUser & u) :
-        _alpha_s_Z__deltabs1(p["QCD::alpha_s(MZ)"], u),
-        _mu_b__deltabs1(p["QCD::mu_b"], u),
-        _m_Z__deltabs1(p["mass::Z"], u),
-        _mu__deltabs1(p["sb::mu"], u),
+        _wc_cache__deltabs1(p),
+        _alpha_s_Z__deltabs1(p["QCD::alpha_s(MZ)"], _wc_cache__deltabs1),
+        _mu_b__deltabs1(p["QCD::mu_b"], _wc_cache__deltabs1),
+        _m_Z__deltabs1(p["mass::Z"], _wc_cache__deltabs1),
+        _mu__deltabs1(p["sb::mu"], _wc_cache__deltabs1),
         /* b->s */
-        _c1(p["b->s::c1"], u),
-        _c2(p["b->s::c2"], u),
-        _c3(p["b->s::c3"], u),
-        _c4(p["b->s::c4"], u),
-        _c5(p["b->s::c5"], u),
-        _c6(p["b->s::c6"], u),
-        _re_c7(p["b->s::Re{c7}"], u),
-        _im_c7(p["b->s::Im{c7}"], u),
-        _re_c7prime(p["b->s::Re{c7'}"], u),
-        _im_c7prime(p["b->s::Im{c7'}"], u),
-        _c8(p["b->s::c8"], u),
-        _c8prime(p["b->s::c8'"], u),
+        _c1(p["b->s::c1"], _wc_cache__deltabs1),
+        _c2(p["b->s::c2"], _wc_cache__deltabs1),
+        _c3(p["b->s::c3"], _wc_cache__deltabs1),
+        _c4(p["b->s::c4"], _wc_cache__deltabs1),
+        _c5(p["b->s::c5"], _wc_cache__deltabs1),
+        _c6(p["b->s::c6"], _wc_cache__deltabs1),
+        _re_c7(p["b->s::Re{c7}"], _wc_cache__deltabs1),
+        _im_c7(p["b->s::Im{c7}"], _wc_cache__deltabs1),
+        _re_c7prime(p["b->s::Re{c7'}"], _wc_cache__deltabs1),
+        _im_c7prime(p["b->s::Im{c7'}"], _wc_cache__deltabs1),
+        _c8(p["b->s::c8"], _wc_cache__deltabs1),
+        _c8prime(p["b->s::c8'"], _wc_cache__deltabs1),
         /* b->see */
-        _e_re_c9(p["b->see::Re{c9}"], u),
-        _e_im_c9(p["b->see::Im{c9}"], u),
-        _e_re_c10(p["b->see::Re{c10}"], u),
-        _e_im_c10(p["b->see::Im{c10}"], u),
-        _e_re_c9prime(p["b->see::Re{c9'}"], u),
-        _e_im_c9prime(p["b->see::Im{c9'}"], u),
-        _e_re_c10prime(p["b->see::Re{c10'}"], u),
-        _e_im_c10prime(p["b->see::Im{c10'}"], u),
-        _e_re_cS(p["b->see::Re{cS}"], u),
-        _e_im_cS(p["b->see::Im{cS}"], u),
-        _e_re_cSprime(p["b->see::Re{cS'}"], u),
-        _e_im_cSprime(p["b->see::Im{cS'}"], u),
-        _e_re_cP(p["b->see::Re{cP}"], u),
-        _e_im_cP(p["b->see::Im{cP}"], u),
-        _e_re_cPprime(p["b->see::Re{cP'}"], u),
-        _e_im_cPprime(p["b->see::Im{cP'}"], u),
-        _e_re_cT(p["b->see::Re{cT}"], u),
-        _e_im_cT(p["b->see::Im{cT}"], u),
-        _e_re_cT5(p["b->see::Re{cT5}"], u),
-        _e_im_cT5(p["b->see::Im{cT5}"], u),
+        _e_re_c9(p["b->see::Re{c9}"], _wc_cache__deltabs1),
+        _e_im_c9(p["b->see::Im{c9}"], _wc_cache__deltabs1),
+        _e_re_c10(p["b->see::Re{c10}"], _wc_cache__deltabs1),
+        _e_im_c10(p["b->see::Im{c10}"], _wc_cache__deltabs1),
+        _e_re_c9prime(p["b->see::Re{c9'}"], _wc_cache__deltabs1),
+        _e_im_c9prime(p["b->see::Im{c9'}"], _wc_cache__deltabs1),
+        _e_re_c10prime(p["b->see::Re{c10'}"], _wc_cache__deltabs1),
+        _e_im_c10prime(p["b->see::Im{c10'}"], _wc_cache__deltabs1),
+        _e_re_cS(p["b->see::Re{cS}"], _wc_cache__deltabs1),
+        _e_im_cS(p["b->see::Im{cS}"], _wc_cache__deltabs1),
+        _e_re_cSprime(p["b->see::Re{cS'}"], _wc_cache__deltabs1),
+        _e_im_cSprime(p["b->see::Im{cS'}"], _wc_cache__deltabs1),
+        _e_re_cP(p["b->see::Re{cP}"], _wc_cache__deltabs1),
+        _e_im_cP(p["b->see::Im{cP}"], _wc_cache__deltabs1),
+        _e_re_cPprime(p["b->see::Re{cP'}"], _wc_cache__deltabs1),
+        _e_im_cPprime(p["b->see::Im{cP'}"], _wc_cache__deltabs1),
+        _e_re_cT(p["b->see::Re{cT}"], _wc_cache__deltabs1),
+        _e_im_cT(p["b->see::Im{cT}"], _wc_cache__deltabs1),
+        _e_re_cT5(p["b->see::Re{cT5}"], _wc_cache__deltabs1),
+        _e_im_cT5(p["b->see::Im{cT5}"], _wc_cache__deltabs1),
         /* b->smumu */
-        _mu_re_c9(p["b->smumu::Re{c9}"], u),
-        _mu_im_c9(p["b->smumu::Im{c9}"], u),
-        _mu_re_c10(p["b->smumu::Re{c10}"], u),
-        _mu_im_c10(p["b->smumu::Im{c10}"], u),
-        _mu_re_c9prime(p["b->smumu::Re{c9'}"], u),
-        _mu_im_c9prime(p["b->smumu::Im{c9'}"], u),
-        _mu_re_c10prime(p["b->smumu::Re{c10'}"], u),
-        _mu_im_c10prime(p["b->smumu::Im{c10'}"], u),
-        _mu_re_cS(p["b->smumu::Re{cS}"], u),
-        _mu_im_cS(p["b->smumu::Im{cS}"], u),
-        _mu_re_cSprime(p["b->smumu::Re{cS'}"], u),
-        _mu_im_cSprime(p["b->smumu::Im{cS'}"], u),
-        _mu_re_cP(p["b->smumu::Re{cP}"], u),
-        _mu_im_cP(p["b->smumu::Im{cP}"], u),
-        _mu_re_cPprime(p["b->smumu::Re{cP'}"], u),
-        _mu_im_cPprime(p["b->smumu::Im{cP'}"], u),
-        _mu_re_cT(p["b->smumu::Re{cT}"], u),
-        _mu_im_cT(p["b->smumu::Im{cT}"], u),
-        _mu_re_cT5(p["b->smumu::Re{cT5}"], u),
-        _mu_im_cT5(p["b->smumu::Im{cT5}"], u),
+        _mu_re_c9(p["b->smumu::Re{c9}"], _wc_cache__deltabs1),
+        _mu_im_c9(p["b->smumu::Im{c9}"], _wc_cache__deltabs1),
+        _mu_re_c10(p["b->smumu::Re{c10}"], _wc_cache__deltabs1),
+        _mu_im_c10(p["b->smumu::Im{c10}"], _wc_cache__deltabs1),
+        _mu_re_c9prime(p["b->smumu::Re{c9'}"], _wc_cache__deltabs1),
+        _mu_im_c9prime(p["b->smumu::Im{c9'}"], _wc_cache__deltabs1),
+        _mu_re_c10prime(p["b->smumu::Re{c10'}"], _wc_cache__deltabs1),
+        _mu_im_c10prime(p["b->smumu::Im{c10'}"], _wc_cache__deltabs1),
+        _mu_re_cS(p["b->smumu::Re{cS}"], _wc_cache__deltabs1),
+        _mu_im_cS(p["b->smumu::Im{cS}"], _wc_cache__deltabs1),
+        _mu_re_cSprime(p["b->smumu::Re{cS'}"], _wc_cache__deltabs1),
+        _mu_im_cSprime(p["b->smumu::Im{cS'}"], _wc_cache__deltabs1),
+        _mu_re_cP(p["b->smumu::Re{cP}"], _wc_cache__deltabs1),
+        _mu_im_cP(p["b->smumu::Im{cP}"], _wc_cache__deltabs1),
+        _mu_re_cPprime(p["b->smumu::Re{cP'}"], _wc_cache__deltabs1),
+        _mu_im_cPprime(p["b->smumu::Im{cP'}"], _wc_cache__deltabs1),
+        _mu_re_cT(p["b->smumu::Re{cT}"], _wc_cache__deltabs1),
+        _mu_im_cT(p["b->smumu::Im{cT}"], _wc_cache__deltabs1),
+        _mu_re_cT5(p["b->smumu::Re{cT5}"], _wc_cache__deltabs1),
+        _mu_im_cT5(p["b->smumu::Im{cT5}"], _wc_cache__deltabs1),
 
 
         /* functions for b->sgamma */
@@ -174,10 +176,18 @@ namespace eos
         _mu_cT(std::bind(&wcimplementation::cartesian,       _mu_re_cT,       _mu_im_cT)),
         _mu_cT5(std::bind(&wcimplementation::cartesian,      _mu_re_cT5,      _mu_im_cT5))
     {
+        u.uses(_wc_cache__deltabs1);
     }
 
     WilsonCoefficients<BToS>
-    WilsonScanComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavor, const bool & cp_conjugate) const
+    WilsonScanComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & /*mu*/, const std::string & lepton_flavor, const bool & cp_conjugate) const
+    {
+        // the low scale is given by the parameter sb::mu, rather than by the argument mu
+        return _wc_cache__deltabs1(std::make_tuple(lepton_flavor, cp_conjugate), [&] () { return _wilson_coefficients_b_to_s(lepton_flavor, cp_conjugate); });
+    }
+
+    WilsonCoefficients<BToS>
+    WilsonScanComponent<components::DeltaBS1>::_wilson_coefficients_b_to_s(const std::string & lepton_flavor, const bool & cp_conjugate) const
     {
         std::function<complex<double> ()> c9,  c9prime;
         std::function<complex<double> ()> c10, c10prime;
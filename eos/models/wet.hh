@@ -5,6 +5,7 @@
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2014, 2018 Christoph Bobeth
  * Copyright (c) 2018 Ahmet Kokulu
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -36,6 +37,9 @@ namespace eos
         public virtual ModelComponent<components::DeltaBS1>
     {
         protected:
+            /* Wilson coefficients, keyed by lepton flavor and CP conjugation */
+            ParameterDependentCache<std::tuple<std::string, bool>, WilsonCoefficients<BToS>> _wc_cache__deltabs1;
+
             /* QCD parameters */
             UsedParameter _alpha_s_Z__deltabs1;
             UsedParameter _mu_b__deltabs1;
@@ -108,6 +112,8 @@ namespace eos
             std::function<complex<double> ()> _mu_cT;
             std::function<complex<double> ()> _mu_cT5;
 
+            WilsonCoefficients<BToS> _wilson_coefficients_b_to_s(const std::string & lepton_flavor, const bool & cp_conjugate) const;
+
         public:
             WilsonScanComponent(const Parameters &, const Options &, ParameterUser &);
 
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2019, 2021, 2022 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -157,6 +158,24 @@ namespace eos
         return result;
     }
 
+    template <typename Decay_, typename Tuple_, typename ... Args_>
+    std::pair<QualifiedName, ObservableEntryPtr> make_cacheable_observable(const char * name,
+            const char * latex,
+            const Unit & unit,
+            const typename Decay_::IntermediateResult * (Decay_::* prepare_fn)() const,
+            double (Decay_::* evaluate_fn)(const typename Decay_::IntermediateResult *, const Args_ & ...) const,
+            const Tuple_ & kinematics_names,
+            const Options & forced_options = Options{})
+    {
+        QualifiedName qn(name);
+
+        auto result = std::make_pair(qn, make_concrete_cacheable_observable_entry(qn, latex, unit, prepare_fn, evaluate_fn, kinematics_names, forced_options));
+
+        impl::observable_entries.insert(result);
+
+        return result;
+    }
+
     /* expressions involving observables */
 
     std::pair<QualifiedName, ObservableEntryPtr> make_expression_observable(const char * name,
@@ -5,6 +5,7 @@
  * Copyright (c) 2011 Christian Wacker
  * Copyright (c) 2018, 2019 Ahmet Kokulu
  * Copyright (c) 2018, 2019 Nico Gubernari
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -62,6 +63,12 @@ namespace eos
                 _entries->insert(group.begin(), group.end());
             }
         }
+
+        _index.reserve(_entries->size());
+        for (const auto & e : *_entries)
+        {
+            _index[e.first.str()] = e.second;
+        }
     }
 
     ObservableEntries::~ObservableEntries() = default;
@@ -70,6 +77,7 @@ namespace eos
     ObservableEntries::insert_or_assign(const QualifiedName & key, const std::shared_ptr<const ObservableEntry> & value)
     {
         auto result = _entries->insert_or_assign(key, value);
+        _index[key.str()] = value;
 
         if (! result.second)
         {
@@ -78,26 +86,41 @@ namespace eos
         }
     }
 
+    std::shared_ptr<const ObservableEntry>
+    ObservableEntries::find(const QualifiedName & name) const
+    {
+        auto i = _index.find(name.str());
+        if (_index.end() == i)
+            return nullptr;
+
+        return i->second;
+    }
+
+    bool
+    Observable::differentiable() const
+    {
+        return false;
+    }
+
+    Dual
+    Observable::evaluate_dual() const
+    {
+        throw InternalError("Observable '" + name().str() + "' does not support automatic differentiation");
+    }
+
     ObservablePtr
     Observable::make(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics, const Options & _options)
     {
-        const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> & observable_entries = ObservableEntries::instance()->entries();
-
         // check if 'name' matches a simple observable
+        if (auto entry = ObservableEntries::instance()->find(name))
         {
-            auto i = observable_entries.find(name);
-            if (observable_entries.end() != i)
-                return i->second->make(parameters, kinematics, name.options() + _options);
+            return entry->make(parameters, kinematics, name.options() + _options);
         }
 
         // check if 'name' matches a parameter
-        if (name.options().empty())
+        if (name.options().empty() && parameters.has(name))
         {
-            auto i = std::find_if(parameters.begin(), parameters.end(), [&] (const Parameter & p) { return p.name() == name.str(); });
-            if (parameters.end() != i)
-            {
-                return ObservablePtr(new ObservableStub(parameters, name));
-            }
+            return ObservablePtr(new ObservableStub(parameters, name));
         }
 
         return ObservablePtr();
@@ -274,13 +297,7 @@ namespace eos
     ObservableEntryPtr
     Observables::operator[] (const QualifiedName & qn) const
     {
-        const auto & observable_entries = ObservableEntries::instance()->entries();
-
-        auto i = observable_entries.find(qn);
-        if (i != observable_entries.end())
-            return i->second;
-
-        return ObservableEntryPtr(nullptr);
+        return ObservableEntries::instance()->find(qn);
     }
 
     Observables::ObservableIterator
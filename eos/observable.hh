@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2016-2019, 2022 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -32,6 +33,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace eos
 {
@@ -48,6 +50,18 @@ namespace eos
 
             virtual double evaluate() const = 0;
 
+            /*!
+             * Whether this observable can be evaluated through forward-mode automatic differentiation,
+             * i.e., whether evaluate_dual() is available.
+             */
+            virtual bool differentiable() const;
+
+            /*!
+             * Evaluate the observable together with its gradient with respect to the parameters
+             * that have been selected through Parameters::seed_gradient().
+             */
+            virtual Dual evaluate_dual() const;
+
             virtual Kinematics kinematics() = 0;
 
             virtual Parameters parameters() = 0;
@@ -249,6 +263,9 @@ namespace eos
         private:
             std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> * _entries;
 
+            // Maps the short names of all observables to their entries, for lookups in constant time
+            std::unordered_map<std::string, std::shared_ptr<const ObservableEntry>> _index;
+
             ObservableEntries();
 
             ~ObservableEntries();
@@ -258,6 +275,9 @@ namespace eos
 
             inline const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> & entries() const { return *_entries; }
 
+            /// Retrieve the entry for an observable by name, or a null pointer if no such observable exists.
+            std::shared_ptr<const ObservableEntry> find(const QualifiedName & name) const;
+
             void insert_or_assign(const QualifiedName & key, const std::shared_ptr<const ObservableEntry> & value);
     };
 }
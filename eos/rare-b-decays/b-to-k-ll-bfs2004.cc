@@ -5,6 +5,7 @@
  * Copyright (c) 2011 Christian Wacker
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -95,6 +96,25 @@ namespace eos
         {
             throw InvalidOptionValueError("qcdf-integrals", qcdf_integrals, "mixed, numerical, analytical");
         }
+
+        // Select the evaluation of the massive two-loop charm contributions
+        std::string charm_loops(o.get("charm-loops", "exact"));
+        if ("exact" == charm_loops)
+        {
+            charm_loop_f19 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F19_massive, mu, s, m_b, m_c); };
+            charm_loop_f27 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F27_massive, mu, s, m_b, m_c); };
+            charm_loop_f29 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F29_massive, mu, s, m_b, m_c); };
+        }
+        else if ("surrogate" == charm_loops)
+        {
+            charm_loop_f19 = &CharmLoops::F19_massive_surrogate;
+            charm_loop_f27 = &CharmLoops::F27_massive_surrogate;
+            charm_loop_f29 = &CharmLoops::F29_massive_surrogate;
+        }
+        else
+        {
+            throw InvalidOptionValueError("charm-loops", charm_loops, "exact, surrogate");
+        }
     }
 
     BToKDileptonAmplitudes<tag::BFS2004>::~BToKDileptonAmplitudes()
@@ -168,11 +188,11 @@ namespace eos
         complex<double> C1f_top_psd = 1.0 * (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
         // cf. [BHP2007], Eq. (B.2) and [BFS2001], Eqs. (38), p. 9
         complex<double> C1nf_top_psd = -(+1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                (wc.c2() - wc.c1() / 6.0) * charm_loop_f27(mu(), s, m_b_PS, m_c_pole)
                 + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                 + (m_B / (2.0 * m_b_PS)) * (
-                    wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                    + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                    wc.c1() * charm_loop_f19(mu(), s, m_b_PS, m_c_pole)
+                    + wc.c2() * charm_loop_f29(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
         /* parallel, up sector */
@@ -184,10 +204,10 @@ namespace eos
         // Use here FF_massive - FF_massless because FF_massless is defined with an extra '-'
         // compared to [S2004]
         complex<double> C1nf_up_psd = -(+1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                (wc.c2() - wc.c1() / 6.0) * (charm_loop_f27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                 + (m_B / (2.0 * m_b_PS)) * (
-                    wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                    + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                    wc.c1() * (charm_loop_f19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                    + wc.c2() * (charm_loop_f29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
         // compute the factorizing contributions
         complex<double> C_psd = C0_top_psd + lambda_hat_u * C0_up_psd
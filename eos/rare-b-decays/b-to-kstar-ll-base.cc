@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2015, 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -19,6 +20,7 @@
  */
 
 #include <eos/rare-b-decays/b-to-kstar-ll-base.hh>
+#include <eos/rare-b-decays/b-to-kstar-ll-impl.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/kinematic.hh>
 
@@ -55,6 +57,24 @@ namespace eos
     {
     }
 
+    BToKstarDilepton::Amplitudes
+    BToKstarDilepton::AmplitudeGenerator::amplitudes(const double & q2) const
+    {
+        return this->amplitudes(q2, model->wilson_coefficients_b_to_s(mu(), lepton_flavor, cp_conjugate));
+    }
+
+    void
+    BToKstarDilepton::AmplitudeGenerator::amplitudes(const std::vector<double> & q2, std::vector<BToKstarDilepton::Amplitudes> & result) const
+    {
+        const WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavor, cp_conjugate);
+
+        result.resize(q2.size());
+        for (unsigned i = 0 ; i < q2.size() ; ++i)
+        {
+            result[i] = this->amplitudes(q2[i], wc);
+        }
+    }
+
     double
     BToKstarDilepton::AmplitudeGenerator::beta_l(const double & s) const
     {
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2015, 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -26,6 +27,8 @@
 #include <eos/form-factors/mesonic.hh>
 #include <eos/rare-b-decays/b-to-kstar-ll.hh>
 
+#include <vector>
+
 namespace eos
 {
     class BToKstarDilepton::AmplitudeGenerator :
@@ -65,7 +68,14 @@ namespace eos
             virtual double H_long_corrections(const double & s) const = 0;
 
             virtual ~AmplitudeGenerator();
-            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2) const = 0;
+
+            // Amplitudes for a given set of Wilson coefficients, which do not depend on q2
+            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2, const WilsonCoefficients<BToS> & wc) const = 0;
+
+            BToKstarDilepton::Amplitudes amplitudes(const double & q2) const;
+
+            // Amplitudes at several values of q2, evaluating the Wilson coefficients only once
+            void amplitudes(const std::vector<double> & q2, std::vector<BToKstarDilepton::Amplitudes> & result) const;
     };
 
     struct BToKstarDilepton::DipoleFormFactors
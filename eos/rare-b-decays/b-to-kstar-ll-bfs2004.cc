@@ -5,6 +5,7 @@
  * Copyright (c) 2014 Christoph Bobeth
  * Copyright (c) 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -110,6 +111,25 @@ namespace eos
         {
             throw InvalidOptionValueError("qcdf-integrals", qcdf_integrals, "mixed, numerical, analytical");
         }
+
+        // Select the evaluation of the massive two-loop charm contributions
+        std::string charm_loops(o.get("charm-loops", "exact"));
+        if ("exact" == charm_loops)
+        {
+            charm_loop_f19 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F19_massive, mu, s, m_b, m_c); };
+            charm_loop_f27 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F27_massive, mu, s, m_b, m_c); };
+            charm_loop_f29 = [] (const double & mu, const double & s, const double & m_b, const double & m_c) { return memoise(CharmLoops::F29_massive, mu, s, m_b, m_c); };
+        }
+        else if ("surrogate" == charm_loops)
+        {
+            charm_loop_f19 = &CharmLoops::F19_massive_surrogate;
+            charm_loop_f27 = &CharmLoops::F27_massive_surrogate;
+            charm_loop_f29 = &CharmLoops::F29_massive_surrogate;
+        }
+        else
+        {
+            throw InvalidOptionValueError("charm-loops", charm_loops, "exact, surrogate");
+        }
     }
 
     BToKstarDileptonAmplitudes<tag::BFS2004>::~BToKstarDileptonAmplitudes()
@@ -185,10 +205,10 @@ namespace eos
         complex<double> C1f_top_perp_right = (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu()) - L - 4.0 * (1.0 - mu_f() / m_b_PS));
         // cf. [BFS2001], Eqs. (34), (37), p. 9
         complex<double> C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                (wc.c2() - wc.c1() / 6.0) * charm_loop_f27(mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                 + (s / (2.0 * m_b_PS * m_B)) * (
-                    wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                    + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                    wc.c1() * charm_loop_f19(mu(), s, m_b_PS, m_c_pole)
+                    + wc.c2() * charm_loop_f29(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
         /* perpendicular, up sector */
@@ -198,10 +218,10 @@ namespace eos
         // cf. [BFS2001], Eqs. (34), (37), p. 9
         // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
         complex<double> C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                (wc.c2() - wc.c1() / 6.0) * (charm_loop_f27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                 + (s / (2.0 * m_b_PS * m_B)) * (
-                    wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                    + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                    wc.c1() * (charm_loop_f19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                    + wc.c2() * (charm_loop_f29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
         /* parallel, top sector */
         // cf. [BFS2001], Eqs. (14), (15), p. 5, in comparison with \delta_{2,3} = 1
@@ -210,11 +230,11 @@ namespace eos
         complex<double> C1f_top_par = -1.0 * (c7eff - wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
         // cf. [BFS2001], Eqs. (38), p. 9
         complex<double> C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                (wc.c2() - wc.c1() / 6.0) * charm_loop_f27(mu(), s, m_b_PS, m_c_pole)
                 + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                 + (m_B / (2.0 * m_b_PS)) * (
-                    wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                    + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                    wc.c1() * charm_loop_f19(mu(), s, m_b_PS, m_c_pole)
+                    + wc.c2() * charm_loop_f29(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
         /* parallel, up sector */
@@ -224,10 +244,10 @@ namespace eos
         // cf. [BFS2004], last paragraph in Sec A.1, p. 24
         // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
         complex<double> C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                (wc.c2() - wc.c1() / 6.0) * (charm_loop_f27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                 + (m_B / (2.0 * m_b_PS)) * (
-                    wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                    + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                    wc.c1() * (charm_loop_f19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                    + wc.c2() * (charm_loop_f29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
         // compute the factorizing contributions
         complex<double> C_perp_left  = C0_top_perp_left  + lambda_hat_u * C0_up_perp
@@ -388,12 +408,10 @@ namespace eos
     // cf. [BHP2008], p. 20
     // cf. [BHvD2012], app B, eqs. (B13 - B19)
     BToKstarDilepton::Amplitudes
-    BToKstarDileptonAmplitudes<tag::BFS2004>::amplitudes(const double & s) const
+    BToKstarDileptonAmplitudes<tag::BFS2004>::amplitudes(const double & s, const WilsonCoefficients<BToS> & wc) const
     {
         BToKstarDilepton::Amplitudes result;
 
-        WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavor, cp_conjugate);
-
         const double
             shat = s_hat(s),
             mbhat = m_b_PS() / m_B,
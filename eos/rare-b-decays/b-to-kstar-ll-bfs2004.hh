@@ -5,6 +5,7 @@
  * Copyright (c) 2014 Christoph Bobeth
  * Copyright (c) 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -71,12 +72,17 @@ namespace eos
                     const double &, const double &, const double &, const double &,
                     const double &, const double &, const double &)> qcdf_dilepton_bottom_case;
 
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f19;
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f27;
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f29;
+
             std::string ff_relation;
 
             BToKstarDileptonAmplitudes(const Parameters & p, const Options & o);
             ~BToKstarDileptonAmplitudes();
 
-            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2) const;
+            using BToKstarDilepton::AmplitudeGenerator::amplitudes;
+            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2, const WilsonCoefficients<BToS> & wc) const;
 
             double m_b_PS() const;
             double mu_f() const;
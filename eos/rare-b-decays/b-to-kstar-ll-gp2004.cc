@@ -6,6 +6,7 @@
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2014 Christoph Bobeth
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -101,14 +102,12 @@ namespace eos
     }
 
     BToKstarDilepton::Amplitudes
-    BToKstarDileptonAmplitudes<tag::GP2004>::amplitudes(const double & s) const
+    BToKstarDileptonAmplitudes<tag::GP2004>::amplitudes(const double & s, const WilsonCoefficients<BToS> & wc) const
     {
         // compute J_i, [BHvD2010], p. 26, Eqs. (A1)-(A11)
         // TODO: possibly optimize the calculation
         BToKstarDilepton::Amplitudes result;
 
-        WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavor, cp_conjugate);
-
         const double m_B2 = m_B * m_B, m_Kstar2 = m_Kstar * m_Kstar, m2_diff = m_B2 - m_Kstar2;
         const double m_Kstarhat = m_Kstar / m_B;
         const double m_Kstarhat2 = power_of<2>(m_Kstarhat);
@@ -6,6 +6,7 @@
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2014 Christoph Bobeth
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -54,7 +55,8 @@ namespace eos
             BToKstarDileptonAmplitudes(const Parameters & p, const Options & o);
             ~BToKstarDileptonAmplitudes();
 
-            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2) const;
+            using BToKstarDilepton::AmplitudeGenerator::amplitudes;
+            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2, const WilsonCoefficients<BToS> & wc) const;
 
             inline complex<double> c7eff(const WilsonCoefficients<BToS> & wc, const double & q2) const;
             inline complex<double> c9eff(const WilsonCoefficients<BToS> & wc, const double & q2) const;
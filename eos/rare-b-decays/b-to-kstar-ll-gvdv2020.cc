@@ -240,12 +240,10 @@ namespace eos
     }
 
     BToKstarDilepton::Amplitudes
-    BToKstarDileptonAmplitudes<tag::GvDV2020>::amplitudes(const double & s) const
+    BToKstarDileptonAmplitudes<tag::GvDV2020>::amplitudes(const double & s, const WilsonCoefficients<BToS> & wc) const
     {
         BToKstarDilepton::Amplitudes result;
 
-        WilsonCoefficients<BToS> wc = model->wilson_coefficients_b_to_s(mu(), lepton_flavor, cp_conjugate);
-
         // local form factors
         const double
             ff_V  = form_factors->v(s),
@@ -57,7 +57,8 @@ namespace eos
             virtual double H_para_corrections(const double & s) const;
             virtual double H_long_corrections(const double & s) const;
 
-            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2) const;
+            using BToKstarDilepton::AmplitudeGenerator::amplitudes;
+            virtual BToKstarDilepton::Amplitudes amplitudes(const double & q2, const WilsonCoefficients<BToS> & wc) const;
     };
 }
 
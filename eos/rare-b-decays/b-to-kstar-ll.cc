@@ -5,6 +5,7 @@
  * Copyright (c) 2014 Christoph Bobeth
  * Copyright (c) 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -195,6 +196,18 @@ namespace eos
             return angular_coefficients_array(amplitude_generator->amplitudes(s), s);
         }
 
+        void differential_angular_coefficients_arrays(const std::vector<double> & s, std::vector<std::array<double, 12>> & result) const
+        {
+            // the Wilson coefficients are shared among all points
+            std::vector<BToKstarDilepton::Amplitudes> amplitudes;
+            amplitude_generator->amplitudes(s, amplitudes);
+
+            for (unsigned i = 0 ; i < s.size() ; ++i)
+            {
+                result[i] = angular_coefficients_array(amplitudes[i], s[i]);
+            }
+        }
+
         inline BToKstarDilepton::AngularCoefficients differential_angular_coefficients(const double & s) const
         {
             return BToKstarDilepton::AngularCoefficients(differential_angular_coefficients_array(s));
@@ -202,8 +215,8 @@ namespace eos
 
         BToKstarDilepton::AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton>::differential_angular_coefficients_array, this, std::placeholders::_1);
+            std::function<void (const std::vector<double> &, std::vector<std::array<double, 12>> &)> integrand =
+                    std::bind(&Implementation<BToKstarDilepton>::differential_angular_coefficients_arrays, this, std::placeholders::_1, std::placeholders::_2);
             std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
 
             return BToKstarDilepton::AngularCoefficients(integrated_angular_coefficients_array);
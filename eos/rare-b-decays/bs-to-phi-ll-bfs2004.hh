@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -64,6 +65,10 @@ namespace eos
                     const double &, const double &, const double &, const double &,
                     const double &, const double &, const double &)> qcdf_dilepton_bottom_case;
 
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f19;
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f27;
+            std::function<complex<double> (const double &, const double &, const double &, const double &)> charm_loop_f29;
+
             std::string ff_relation;
 
             BsToPhiDileptonAmplitudes(const Parameters & p, const Options & o);
@@ -5,6 +5,7 @@
  * Copyright (c) 2010 Christoph Bobeth
  * Copyright (c) 2022 Philip Lüghausen
  * Copyright (c) 2010, 2011 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -27,9 +28,11 @@
 #include <eos/utils/log.hh>
 #include <eos/utils/stringify.hh>
 
+#include <array>
 #include <cmath>
 #include <complex>
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include <gsl/gsl_spline.h>
@@ -330,175 +333,141 @@ namespace eos
     }
 
     /* Two-Loop functions for charm-quark loops */
-    // cf. [AAGW2001], Eq. (56), p. 20
-    complex<double>
-    CharmLoops::F17_massive(const double & mu, const double & s, const double & m_b, const double & m_c)
+    namespace impl
     {
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap1700[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-1.14266, -0.517135}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.20356, 1.59186}, {-5.21743, 1.86168}, {0.592593, 3.72337}, {0.395062, 0}, {0, 0}},
-            {{1.86366, -3.06235}, {-4.66347, 0}, {0, 3.72337}, {0.395062, 0}, {0, 0}},
-            {{-1.21131, 2.89595}, {2.99588, -2.48225}, {-4.14815, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1710[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.07503, 1.39626}, {-0.444444, 0.930842}, {0, 0}, {0, 0}, {0, 0}},
-            {{-25.9259, 5.78065}, {-3.40101, 13.0318}, {-4.4917, 3.72337}, {0.395062, 0}, {-0.395062, 0}},
-            {{11.4229, -15.2375}, {-34.0806, 11.1701}, {10.3704, 18.6168}, {2.37037, 0}, {0, 0}},
-            {{11.7509, 15.6984}, {18.9564, -24.8225}, {-14.6173, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1711[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{1.03704, 0.930842}, {0.592593, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-4.66347, 0}, {0, 7.44674}, {2.37037, 0}, {0, 0}, {0, 0}},
-            {{6.73754, 1.86168}, {1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1720[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.00555556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-19.4691, 1.59019}, {-11.6779, 0.930842}, {-2.96296, 0}, {-0.395062, 0}, {0, 0}},
-            {{-90.4953, 14.7788}, {14.9329, 22.3402}, {-24.438, 3.72337}, {1.18519, 0}, {-1.18519, 0}},
-            {{23.8816, -32.8021}, {-82.7915, 39.0954}, {32.2963, 44.6804}, {5.92593, 0}, {0, 0}},
-            {{38.1415, 34.8683}, {38.6436, -80.673}, {-41.5802, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1721[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{2.37037, 1.86168}, {1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-13.9904, 3.72337}, {2.37037, 22.3402}, {7.11111, 0}, {0, 0}, {0, 0}},
-            {{27.5428, 3.72337}, {2.37037, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1730[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.00010778, 0.00258567}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.946811, -0.0258567}, {0.488889, 0}, {0.0987654, 0}, {0, 0}, {0, 0}},
-            {{-41.9952, 1.63673}, {-30.2091, 0.930842}, {-6.22222, 0}, {-1.18519, 0}, {0, 0}},
-            {{-189.354, 25.8196}, {42.6566, 31.0281}, {-57.765, 3.72337}, {2.76543, 0}, {-2.37037, 0}},
-            {{45.1784, -52.4207}, {-145.181, 88.7403}, {70.9136, 81.9141}, {11.0617, 0}, {0, 0}},
-            {{77.3602, 54.2499}, {58.4491, -184.927}, {-96.0988, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap1731[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{3.85185, 2.79253}, {1.77778, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-27.3882, 13.0318}, {8.2963, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
-            {{69.4495, 1.86168}, {1.18519, -74.4674}, {-23.7037, 0}, {0, 0}, {0, 0}}
-        };
-
-        double m_c_hat = m_c / m_b, z = power_of<2>(m_c_hat);
-        double s_hat = s / power_of<2>(m_b);
-
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.0 < s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.00))
+        // Coefficients of the expansion of F_{1,2}{7,9} in s_hat, with F = sum_k s_hat^k (alpha[k] + beta[k] * log(s_hat))
+        struct CharmLoopExpansion
         {
-            log_s_hat.imag(+M_PI);
-        }
-        else
-        {
-            throw InternalError("CharmLoop::F17_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
-        }
-
-        const double rho17[4] = {
-            1.94955 * power_of<3>(m_c_hat), 11.6973 * m_c_hat, 70.1839 * m_c_hat, -3.8991 / m_c_hat + 159.863 * m_c_hat
+            std::array<complex<double>, 4> alpha;
+            std::array<complex<double>, 4> beta;
+
+            complex<double> operator() (const double & s_hat, const complex<double> & log_s_hat) const
+            {
+                complex<double> result = 0.0;
+                for (int k = 3 ; k >= 0 ; --k)
+                {
+                    result = result * s_hat + alpha[k] + beta[k] * log_s_hat;
+                }
+
+                return result;
+            }
         };
 
-        // real part
-        complex<double> r = -208.0 / 243.0 * log(mu / m_b);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 4 ; m++)
-                r = r + kap1700[l][m][0] * pow(z, l-3) * pow(log(m_c_hat), m);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1710[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+        // Sum over the coefficients kappa of one term s_hat^k log(s_hat)^j of [ABGW2001], Appendix B, as a polynomial in z and log(m_q_hat)
+        complex<double> kappa_sum(const double (& kappa)[7][5][2], const int & l_min_re, const int & m_max_re, const int & l_min_im, const int & m_max_im,
+                const double & z, const double & log_m_q_hat)
+        {
+            double re = 0.0, im = 0.0;
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1711[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            for (int l = l_min_re ; l < 7 ; l++)
+                for (int m = 0 ; m < m_max_re ; m++)
+                    re += kappa[l][m][0] * pow(z, l - 3) * pow(log_m_q_hat, m);
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1720[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            for (int l = l_min_im ; l < 7 ; l++)
+                for (int m = 0 ; m < m_max_im ; m++)
+                    im += kappa[l][m][1] * pow(z, l - 3) * pow(log_m_q_hat, m);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1721[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            return complex<double>(re, im);
+        }
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1730[l][m][0] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_c_hat), m);
+        // cf. [ABGW2001], Appendix B, pp. 34-38
+        CharmLoopExpansion f17_expansion(const double & m_q_hat)
+        {
+            static const double kap1700[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-1.14266, -0.517135}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.20356, 1.59186}, {-5.21743, 1.86168}, {0.592593, 3.72337}, {0.395062, 0}, {0, 0}},
+                {{1.86366, -3.06235}, {-4.66347, 0}, {0, 3.72337}, {0.395062, 0}, {0, 0}},
+                {{-1.21131, 2.89595}, {2.99588, -2.48225}, {-4.14815, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1731[l][m][0] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            static const double kap1710[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.07503, 1.39626}, {-0.444444, 0.930842}, {0, 0}, {0, 0}, {0, 0}},
+                {{-25.9259, 5.78065}, {-3.40101, 13.0318}, {-4.4917, 3.72337}, {0.395062, 0}, {-0.395062, 0}},
+                {{11.4229, -15.2375}, {-34.0806, 11.1701}, {10.3704, 18.6168}, {2.37037, 0}, {0, 0}},
+                {{11.7509, 15.6984}, {18.9564, -24.8225}, {-14.6173, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 0 ; l < 4; l++)
-            r = r + rho17[l] * pow(s_hat, l);
+            static const double kap1711[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{1.03704, 0.930842}, {0.592593, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-4.66347, 0}, {0, 7.44674}, {2.37037, 0}, {0, 0}, {0, 0}},
+                {{6.73754, 1.86168}, {1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}}
+            };
 
-        // imaginary part
-        complex<double> i = 0.0;
+            static const double kap1720[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.00555556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-19.4691, 1.59019}, {-11.6779, 0.930842}, {-2.96296, 0}, {-0.395062, 0}, {0, 0}},
+                {{-90.4953, 14.7788}, {14.9329, 22.3402}, {-24.438, 3.72337}, {1.18519, 0}, {-1.18519, 0}},
+                {{23.8816, -32.8021}, {-82.7915, 39.0954}, {32.2963, 44.6804}, {5.92593, 0}, {0, 0}},
+                {{38.1415, 34.8683}, {38.6436, -80.673}, {-41.5802, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1700[l][m][1] * pow(z, l-3) * pow(log(m_c_hat), m);
+            static const double kap1721[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{2.37037, 1.86168}, {1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-13.9904, 3.72337}, {2.37037, 22.3402}, {7.11111, 0}, {0, 0}, {0, 0}},
+                {{27.5428, 3.72337}, {2.37037, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1710[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            static const double kap1730[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.00010778, 0.00258567}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.946811, -0.0258567}, {0.488889, 0}, {0.0987654, 0}, {0, 0}, {0, 0}},
+                {{-41.9952, 1.63673}, {-30.2091, 0.930842}, {-6.22222, 0}, {-1.18519, 0}, {0, 0}},
+                {{-189.354, 25.8196}, {42.6566, 31.0281}, {-57.765, 3.72337}, {2.76543, 0}, {-2.37037, 0}},
+                {{45.1784, -52.4207}, {-145.181, 88.7403}, {70.9136, 81.9141}, {11.0617, 0}, {0, 0}},
+                {{77.3602, 54.2499}, {58.4491, -184.927}, {-96.0988, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1711[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            static const double kap1731[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{3.85185, 2.79253}, {1.77778, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-27.3882, 13.0318}, {8.2963, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
+                {{69.4495, 1.86168}, {1.18519, -74.4674}, {-23.7037, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1720[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            const double z = power_of<2>(m_q_hat), log_m_q_hat = std::log(m_q_hat);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1721[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            const double rho17[4] = {
+                1.94955 * power_of<3>(m_q_hat), 11.6973 * m_q_hat, 70.1839 * m_q_hat, -3.8991 / m_q_hat + 159.863 * m_q_hat
+            };
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1730[l][m][1] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_c_hat), m);
+            CharmLoopExpansion result;
+            result.alpha[0] = kappa_sum(kap1700, 3, 4, 3, 3, z, log_m_q_hat);
+            result.alpha[1] = kappa_sum(kap1710, 3, 5, 3, 3, z, log_m_q_hat);
+            result.beta[1] = kappa_sum(kap1711, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[2] = kappa_sum(kap1720, 2, 5, 3, 3, z, log_m_q_hat);
+            result.beta[2] = kappa_sum(kap1721, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[3] = kappa_sum(kap1730, 1, 5, 1, 3, z, log_m_q_hat);
+            result.beta[3] = kappa_sum(kap1731, 3, 3, 4, 2, z, log_m_q_hat);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1731[l][m][1] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_c_hat), m);
+            for (int l = 0 ; l < 4 ; l++)
+                result.alpha[l] += rho17[l];
 
-        return r + complex<double>(0.0, 1.0) * i;
-    }
+            return result;
+        }
 
-    namespace impl
-    {
-        complex<double> f27_0(const double & mu, const double & m_b, const double & m_q)
+        // cf. [ABGW2001], Appendix B, pp. 34-38
+        CharmLoopExpansion f27_expansion(const double & m_q_hat)
         {
-            static long double kap2700[7][5][2] = {
+            static const double kap2700[7][5][2] = {
                 {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
                 {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
                 {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
@@ -508,578 +477,549 @@ namespace eos
                 {{7.26787, -17.3757}, {-17.9753, 14.8935}, {24.8889, 0}, {0, 0}, {0, 0}}
             };
 
-            const double m_q_hat = m_q / m_b, z = power_of<2>(m_q_hat);
-
-            const long double rho27 = -11.6973 * power_of<3>(m_q_hat);
-
-            // real part
-            double r = 416.0 / 81.0 * log(mu / m_b);
-
-            for (int l = 3 ; l < 7 ; l++)
-                for (int m = 0 ; m < 4 ; m++)
-                    r = r + kap2700[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
-
-            r = r + rho27 ;
-
-            // imaginary part
-            double i = 0.0;
-
-            for (int l = 3 ; l < 7 ; l++)
-                for (int m = 0 ; m < 3 ; m++)
-                    i = i + kap2700[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
-
-            return complex<double>(r, i);
-        }
-    }
+            static const double kap2710[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{12.4502, -8.37758}, {2.66667, -5.58505}, {0, 0}, {0, 0}, {0, 0}},
+                {{155.555, -34.6839}, {20.4061, -78.1908}, {26.9502, -22.3402}, {-2.37037, 0}, {2.37037, 0}},
+                {{-68.5374, 91.4251}, {204.484, -67.0206}, {-62.2222, -111.701}, {-14.2222, 0}, {0, 0}},
+                {{-70.5057, -94.1903}, {-113.738, 148.935}, {87.7037, 0}, {0, 0}, {0, 0}}
+            };
 
-    // cf. [AAGW2001], Eq. (56), p. 20
-    complex<double>
-    CharmLoops::F27_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
-    {
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap2700[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{6.85597, 3.10281}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{13.2214, -9.55118}, {31.3046, -11.1701}, {-3.55556, -22.3402}, {-2.37037, 0}, {0, 0}},
-            {{-11.182, 18.3741}, {27.9808, 0}, {0, -22.3402}, {-2.37037, 0}, {0, 0}},
-            {{7.26787, -17.3757}, {-17.9753, 14.8935}, {24.8889, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2711[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-6.22222, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{27.9808, 0}, {0, -44.6804}, {-14.2222, 0}, {0, 0}, {0, 0}},
+                {{-40.4253, -11.1701}, {-7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2710[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{12.4502, -8.37758}, {2.66667, -5.58505}, {0, 0}, {0, 0}, {0, 0}},
-            {{155.555, -34.6839}, {20.4061, -78.1908}, {26.9502, -22.3402}, {-2.37037, 0}, {2.37037, 0}},
-            {{-68.5374, 91.4251}, {204.484, -67.0206}, {-62.2222, -111.701}, {-14.2222, 0}, {0, 0}},
-            {{-70.5057, -94.1903}, {-113.738, 148.935}, {87.7037, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2720[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0333333, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{116.815, -9.54113}, {70.0677, -5.58505}, {17.7778, 0}, {2.37037, 0}, {0, 0}},
+                {{542.972, -88.6728}, {-89.5971, -134.041}, {146.628, -22.3402}, {-7.11111, 0}, {7.11111, 0}},
+                {{-143.29, 196.813}, {496.749, -234.572}, {-193.778, -268.083}, {-35.5556, 0}, {0, 0}},
+                {{-228.849, -209.21}, {-231.862, 484.038}, {249.481, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2711[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-6.22222, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{27.9808, 0}, {0, -44.6804}, {-14.2222, 0}, {0, 0}, {0, 0}},
-            {{-40.4253, -11.1701}, {-7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2721[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-14.2222, -11.1701}, {-7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{83.9424, -22.3402}, {-14.2222, -134.041}, {-42.6667, 0}, {0, 0}, {0, 0}},
+                {{-165.257, -22.3402}, {-14.2222, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2720[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0333333, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{116.815, -9.54113}, {70.0677, -5.58505}, {17.7778, 0}, {2.37037, 0}, {0, 0}},
-            {{542.972, -88.6728}, {-89.5971, -134.041}, {146.628, -22.3402}, {-7.11111, 0}, {7.11111, 0}},
-            {{-143.29, 196.813}, {496.749, -234.572}, {-193.778, -268.083}, {-35.5556, 0}, {0, 0}},
-            {{-228.849, -209.21}, {-231.862, 484.038}, {249.481, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2730[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.000646678, -0.015514}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-5.68087, 0.15514}, {-2.93333, 0}, {-0.592593, 0}, {0, 0}, {0, 0}},
+                {{251.971, -9.82039}, {181.255, -5.58505}, {37.3333, 0}, {7.11111, 0}, {0, 0}},
+                {{1136.13, -154.918}, {-255.94, -186.168}, {346.59, -22.3402}, {-16.5926, 0}, {14.2222, 0}},
+                {{-271.07, 314.524}, {871.089, -532.442}, {-425.481, -491.485}, {-66.3704, 0}, {0, 0}},
+                {{-464.161, -325.499}, {-350.695, 1109.56}, {576.593, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2721[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-14.2222, -11.1701}, {-7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{83.9424, -22.3402}, {-14.2222, -134.041}, {-42.6667, 0}, {0, 0}, {0, 0}},
-            {{-165.257, -22.3402}, {-14.2222, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2731[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-23.1111, -16.7552}, {-10.6667, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{164.329, -78.1908}, {-49.7778, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}},
+                {{-416.697, -11.1701}, {-7.11111, 446.804}, {142.222, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2730[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.000646678, -0.015514}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-5.68087, 0.15514}, {-2.93333, 0}, {-0.592593, 0}, {0, 0}, {0, 0}},
-            {{251.971, -9.82039}, {181.255, -5.58505}, {37.3333, 0}, {7.11111, 0}, {0, 0}},
-            {{1136.13, -154.918}, {-255.94, -186.168}, {346.59, -22.3402}, {-16.5926, 0}, {14.2222, 0}},
-            {{-271.07, 314.524}, {871.089, -532.442}, {-425.481, -491.485}, {-66.3704, 0}, {0, 0}},
-            {{-464.161, -325.499}, {-350.695, 1109.56}, {576.593, 0}, {0, 0}, {0, 0}}
-        };
+            const double z = power_of<2>(m_q_hat), log_m_q_hat = std::log(m_q_hat);
 
-        static double kap2731[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-23.1111, -16.7552}, {-10.6667, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{164.329, -78.1908}, {-49.7778, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}},
-            {{-416.697, -11.1701}, {-7.11111, 446.804}, {142.222, 0}, {0, 0}, {0, 0}}
-        };
+            const double rho27[4] = {
+                -11.6973 * power_of<3>(m_q_hat), -70.1839 * m_q_hat, -421.103 * m_q_hat, 23.3946 / m_q_hat - 959.179 * m_q_hat
+            };
 
-        double m_q_hat = m_q / m_b, z = power_of<2>(m_q_hat);
-        double s_hat = s / m_b / m_b;
+            CharmLoopExpansion result;
+            result.alpha[0] = kappa_sum(kap2700, 3, 4, 3, 3, z, log_m_q_hat);
+            result.alpha[1] = kappa_sum(kap2710, 3, 5, 3, 3, z, log_m_q_hat);
+            result.beta[1] = kappa_sum(kap2711, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[2] = kappa_sum(kap2720, 2, 5, 3, 3, z, log_m_q_hat);
+            result.beta[2] = kappa_sum(kap2721, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[3] = kappa_sum(kap2730, 1, 5, 1, 3, z, log_m_q_hat);
+            result.beta[3] = kappa_sum(kap2731, 3, 3, 4, 2, z, log_m_q_hat);
 
-        const double rho27[4] = {
-            -11.6973 * power_of<3>(m_q_hat), -70.1839 * m_q_hat, -421.103 * m_q_hat, 23.3946 / m_q_hat - 959.179 * m_q_hat
-        };
+            for (int l = 0 ; l < 4 ; l++)
+                result.alpha[l] += rho27[l];
 
-        if (s_hat == 0)
-        {
-            return impl::f27_0(mu, m_b, m_q);
+            return result;
         }
 
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.0 < s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.00))
-        {
-            log_s_hat.imag(+M_PI);
-        }
-        else
+        // cf. [ABGW2001], Appendix B, pp. 34-38
+        CharmLoopExpansion f19_expansion(const double & m_q_hat)
         {
-            throw InternalError("CharmLoop::F27_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
-        }
-
-        // real part
-        complex<double> r = 416.0 / 81.0 * log(mu / m_b);
+            static const double kap1900[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-4.61812, 3.67166}, {5.62963, 1.86168}, {0, 0}, {0, 0}, {0, 0}},
+                {{14.4621, -16.2155}, {9.59321, -11.1701}, {-1.18519, -7.44674}, {-0.790123, 0}, {0, 0}},
+                {{-16.0864, 26.7517}, {54.2439, -14.8935}, {-15.4074, -29.787}, {-3.95062, 0}, {0, 0}},
+                {{-14.73, -23.6892}, {-28.5761, 34.7514}, {20.1481, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 4 ; m++)
-                r = r + kap2700[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1901[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0493827, -0.103427}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.592593, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{4.95977, -1.86168}, {-1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}},
+                {{-9.20287, -1.65483}, {-1.0535, 9.92898}, {3.16049, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2710[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1910[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.48507, -0.186168}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{4.47441, -0.310281}, {1.48148, -1.86168}, {0, 0}, {0, 0}, {0, 0}},
+                {{71.3855, -30.7987}, {8.47677, -33.5103}, {12.5389, -7.44674}, {-0.790123, 0}, {0.790123, 0}},
+                {{-18.1301, 66.1439}, {149.596, -67.0206}, {-49.1852, -81.9141}, {-11.0617, 0}, {0, 0}},
+                {{-72.89, -63.7828}, {-68.135, 134.041}, {63.6049, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2711[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1911[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.66667, -1.86168}, {-1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{18.6539, -7.44674}, {-4.74074, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}},
+                {{-41.6104, -3.72337}, {-2.37037, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2720[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1920[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.403158, -0.0199466}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0613169, 0.0620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{37.1282, -1.36524}, {22.0621, -1.86168}, {5.33333, 0}, {0.790123, 0}, {0, 0}},
+                {{212.74, -52.2081}, {-21.9215, -52.1272}, {57.1724, -7.44674}, {-2.37037, 0}, {2.37037, 0}},
+                {{-44.6829, 108.713}, {272.015, -163.828}, {-119.111, -156.382}, {-21.3333, 0}, {0, 0}},
+                {{-137.203, -106.832}, {-99.437, 330.139}, {168.889, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2721[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1921[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-5.33333, -3.72337}, {-2.37037, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{40.786, -22.3402}, {-14.2222, -67.0206}, {-21.3333, 0}, {0, 0}, {0, 0}},
+                {{-111.356, 0}, {0, 119.148}, {37.9259, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2730[l][m][0] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1930[7][5][2] = {
+                {{-0.0759415, -0.00295505}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.00480894, 0.00369382}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-1.81002, 0.0871741}, {-0.919459, 0}, {-0.197531, 0}, {0, 0}, {0, 0}},
+                {{79.7475, -1.72206}, {57.3171, -1.86168}, {11.2593, 0}, {2.37037, 0}, {0, 0}},
+                {{425.579, -76.6479}, {-68.8016, -69.5029}, {129.357, -7.44674}, {-5.53086, 0}, {4.74074, 0}},
+                {{-87.8946, 148.481}, {417.612, -311.522}, {-227.16, -253.189}, {-34.7654, 0}, {0, 0}},
+                {{-279.268, -135.118}, {-146.853, 652.831}, {331.259, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2731[l][m][0] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap1931[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0219479, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-8.2963, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{70.2698, -49.6449}, {-31.6049, -119.148}, {-37.9259, 0}, {0, 0}, {0, 0}},
+                {{-231.893, 18.6168}, {11.8519, 248.225}, {79.0123, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 0 ; l < 4; l++)
-            r = r + rho27[l] * pow(s_hat, l);
+            const double z = power_of<2>(m_q_hat), log_m_q_hat = std::log(m_q_hat);
 
-        // imaginary part
-        complex<double> i = 0.0;
+            const double rho19[4] = {
+                3.8991 * power_of<3>(m_q_hat), -23.3946 * m_q_hat, -140.368 * m_q_hat, 7.79821 / m_q_hat - 319.726 * m_q_hat
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2700[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+            CharmLoopExpansion result;
+            result.alpha[0] = kappa_sum(kap1900, 3, 4, 3, 3, z, log_m_q_hat);
+            result.beta[0] = kappa_sum(kap1901, 3, 3, 3, 2, z, log_m_q_hat);
+            result.alpha[1] = kappa_sum(kap1910, 2, 5, 2, 3, z, log_m_q_hat);
+            result.beta[1] = kappa_sum(kap1911, 4, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[2] = kappa_sum(kap1920, 1, 5, 1, 3, z, log_m_q_hat);
+            result.beta[2] = kappa_sum(kap1921, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[3] = kappa_sum(kap1930, 0, 5, 0, 3, z, log_m_q_hat);
+            result.beta[3] = kappa_sum(kap1931, 3, 3, 4, 2, z, log_m_q_hat);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2710[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 0 ; l < 4 ; l++)
+                result.alpha[l] += rho19[l];
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2711[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            return result;
+        }
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2720[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        // cf. [ABGW2001], Appendix B, pp. 34-38
+        CharmLoopExpansion f29_expansion(const double & m_q_hat)
+        {
+            static const double kap2900[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-24.2913, -22.0299}, {-23.1111, -11.1701}, {0, 0}, {0, 0}, {0, 0}},
+                {{-86.7723, 97.2931}, {-57.5593, 67.0206}, {7.11111, 44.6804}, {4.74074, 0}, {0, 0}},
+                {{96.5187, -160.51}, {-325.463, 89.3609}, {92.4444, 178.722}, {23.7037, 0}, {0, 0}},
+                {{88.3801, 142.135}, {171.457, -208.509}, {-120.889, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2721[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap2901[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.296296, 0.620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{3.55556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-29.7586, 11.1701}, {7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
+                {{55.2172, 9.92898}, {6.32099, -59.5739}, {-18.963, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2730[l][m][1] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap2910[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.8462, 1.11701}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-26.8464, 1.86168}, {-8.88889, 11.1701}, {0, 0}, {0, 0}, {0, 0}},
+                {{-428.313, 184.792}, {-50.8606, 201.062}, {-75.2337, 44.6804}, {4.74074, 0}, {-4.74074, 0}},
+                {{108.781, -396.864}, {-897.575, 402.124}, {295.111, 491.485}, {66.3704, 0}, {0, 0}},
+                {{437.34, 382.697}, {408.81, -804.248}, {-381.63, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2731[l][m][1] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static const double kap2911[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{16., 11.1701}, {7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-111.923, 44.6804}, {28.4444, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}},
+                {{249.663, 22.3402}, {14.2222, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}}
+            };
 
-        return r + complex<double>(0.0, 1.0) * i;
-    }
+            static const double kap2920[7][5][2] = {{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0132191, 0.11968}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.367901, -0.372337}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-222.769, 8.19141}, {-132.372, 11.1701}, {-32., 0}, {-4.74074, 0}, {0, 0}},
+                {{-1276.44, 313.249}, {131.529, 312.763}, {-343.034, 44.6804}, {14.2222, 0}, {-14.2222, 0}},
+                {{268.098, -652.279}, {-1632.09, 982.969}, {714.667, 938.289}, {128., 0}, {0, 0}},
+                {{823.218, 640.989}, {596.622, -1980.83}, {-1013.33, 0}, {0, 0}, {0, 0}}
+            };
 
-    // cf. [AAGW2001], Eq. (54), p. 19
-    complex<double>
-    CharmLoops::F19_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
-    {
-        // F19(s) diverges for s -> 0. However, s * F19(s) -> 0 for s -> 0.
-        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
-            throw InternalError("CharmLoops::F19_massive: F19 diverges for s -> 0. Check that F19 enters via 's * F19(s)' and replace by zero.");
+            static const double kap2921[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{32., 22.3402}, {14.2222, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-244.716, 134.041}, {85.3333, 402.124}, {128., 0}, {0, 0}, {0, 0}},
+                {{668.137, 0}, {0, -714.887}, {-227.556, 0}, {0, 0}, {0, 0}}
+            };
 
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap1900[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-4.61812, 3.67166}, {5.62963, 1.86168}, {0, 0}, {0, 0}, {0, 0}},
-            {{14.4621, -16.2155}, {9.59321, -11.1701}, {-1.18519, -7.44674}, {-0.790123, 0}, {0, 0}},
-            {{-16.0864, 26.7517}, {54.2439, -14.8935}, {-15.4074, -29.787}, {-3.95062, 0}, {0, 0}},
-            {{-14.73, -23.6892}, {-28.5761, 34.7514}, {20.1481, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2930[7][5][2] = {
+                {{-0.0142243, 0.0177303}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0288536, -0.0221629}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{10.8601, -0.523045}, {5.51675, 0}, {1.18519, 0}, {0, 0}, {0, 0}},
+                {{-478.485, 10.3323}, {-343.902, 11.1701}, {-67.5556, 0}, {-14.2222, 0}, {0, 0}},
+                {{-2553.47, 459.887}, {412.809, 417.017}, {-776.143, 44.6804}, {33.1852, 0}, {-28.4444, 0}},
+                {{527.368, -890.889}, {-2505.67, 1869.13}, {1362.96, 1519.13}, {208.593, 0}, {0, 0}},
+                {{1675.61, 810.709}, {881.117, -3916.98}, {-1987.56, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap1901[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0493827, -0.103427}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.592593, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{4.95977, -1.86168}, {-1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}},
-            {{-9.20287, -1.65483}, {-1.0535, 9.92898}, {3.16049, 0}, {0, 0}, {0, 0}}
-        };
+            static const double kap2931[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.131687, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{49.7778, 33.5103}, {21.3333, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-421.619, 297.87}, {189.63, 714.887}, {227.556, 0}, {0, 0}, {0, 0}},
+                {{1391.36, -111.701}, {-71.1111, -1489.35}, {-474.074, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap1910[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.48507, -0.186168}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{4.47441, -0.310281}, {1.48148, -1.86168}, {0, 0}, {0, 0}, {0, 0}},
-            {{71.3855, -30.7987}, {8.47677, -33.5103}, {12.5389, -7.44674}, {-0.790123, 0}, {0.790123, 0}},
-            {{-18.1301, 66.1439}, {149.596, -67.0206}, {-49.1852, -81.9141}, {-11.0617, 0}, {0, 0}},
-            {{-72.89, -63.7828}, {-68.135, 134.041}, {63.6049, 0}, {0, 0}, {0, 0}}
-        };
+            const double z = power_of<2>(m_q_hat), log_m_q_hat = std::log(m_q_hat);
 
-        static double kap1911[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.66667, -1.86168}, {-1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{18.6539, -7.44674}, {-4.74074, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}},
-            {{-41.6104, -3.72337}, {-2.37037, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
-        };
+            const double rho29[4] = {
+                -23.3946 * power_of<3>(m_q_hat), 140.368 * m_q_hat, 842.206 * m_q_hat, -46.7892 / m_q_hat + 1918.36 * m_q_hat
+            };
 
-        static double kap1920[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.403158, -0.0199466}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0613169, 0.0620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{37.1282, -1.36524}, {22.0621, -1.86168}, {5.33333, 0}, {0.790123, 0}, {0, 0}},
-            {{212.74, -52.2081}, {-21.9215, -52.1272}, {57.1724, -7.44674}, {-2.37037, 0}, {2.37037, 0}},
-            {{-44.6829, 108.713}, {272.015, -163.828}, {-119.111, -156.382}, {-21.3333, 0}, {0, 0}},
-            {{-137.203, -106.832}, {-99.437, 330.139}, {168.889, 0}, {0, 0}, {0, 0}}
-        };
+            CharmLoopExpansion result;
+            result.alpha[0] = kappa_sum(kap2900, 3, 4, 3, 3, z, log_m_q_hat);
+            result.beta[0] = kappa_sum(kap2901, 3, 3, 3, 2, z, log_m_q_hat);
+            result.alpha[1] = kappa_sum(kap2910, 2, 5, 2, 3, z, log_m_q_hat);
+            result.beta[1] = kappa_sum(kap2911, 4, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[2] = kappa_sum(kap2920, 1, 5, 1, 3, z, log_m_q_hat);
+            result.beta[2] = kappa_sum(kap2921, 3, 3, 4, 2, z, log_m_q_hat);
+            result.alpha[3] = kappa_sum(kap2930, 0, 5, 0, 3, z, log_m_q_hat);
+            result.beta[3] = kappa_sum(kap2931, 3, 3, 4, 2, z, log_m_q_hat);
 
-        static double kap1921[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-5.33333, -3.72337}, {-2.37037, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{40.786, -22.3402}, {-14.2222, -67.0206}, {-21.3333, 0}, {0, 0}, {0, 0}},
-            {{-111.356, 0}, {0, 119.148}, {37.9259, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 0 ; l < 4 ; l++)
+                result.alpha[l] += rho29[l];
 
-        static double kap1930[7][5][2] = {
-            {{-0.0759415, -0.00295505}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.00480894, 0.00369382}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-1.81002, 0.0871741}, {-0.919459, 0}, {-0.197531, 0}, {0, 0}, {0, 0}},
-            {{79.7475, -1.72206}, {57.3171, -1.86168}, {11.2593, 0}, {2.37037, 0}, {0, 0}},
-            {{425.579, -76.6479}, {-68.8016, -69.5029}, {129.357, -7.44674}, {-5.53086, 0}, {4.74074, 0}},
-            {{-87.8946, 148.481}, {417.612, -311.522}, {-227.16, -253.189}, {-34.7654, 0}, {0, 0}},
-            {{-279.268, -135.118}, {-146.853, 652.831}, {331.259, 0}, {0, 0}, {0, 0}}
-        };
+            return result;
+        }
 
-        static double kap1931[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0219479, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-8.2963, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{70.2698, -49.6449}, {-31.6049, -119.148}, {-37.9259, 0}, {0, 0}, {0, 0}},
-            {{-231.893, 18.6168}, {11.8519, 248.225}, {79.0123, 0}, {0, 0}, {0, 0}}
+        /*
+         * Chebyshev interpolation of the coefficients of a CharmLoopExpansion in m_q_hat.
+         *
+         * The dependence on s_hat and mu is analytic and kept exact. Outside of the interpolation
+         * range, the surrogate falls back to the exact expansion.
+         */
+        class CharmLoopSurrogate
+        {
+            public:
+                static constexpr double m_q_hat_min = 0.15;
+                static constexpr double m_q_hat_max = 0.50;
+                static constexpr unsigned degree = 32;
+
+            private:
+                CharmLoopExpansion (* _expansion)(const double &);
+
+                // Chebyshev coefficients, indexed as [j][k]; k < 4 refers to alpha[k], k >= 4 to beta[k - 4]
+                std::array<std::array<complex<double>, 8>, degree + 1> _c;
+
+            public:
+                CharmLoopSurrogate(CharmLoopExpansion (* expansion)(const double &)) :
+                    _expansion(expansion)
+                {
+                    static constexpr unsigned n = degree + 1;
+
+                    // evaluate the exact expansion at the Chebyshev nodes
+                    std::array<double, n> theta;
+                    std::array<std::array<complex<double>, 8>, n> values;
+                    for (unsigned i = 0 ; i < n ; ++i)
+                    {
+                        theta[i] = M_PI * (i + 0.5) / n;
+                        const CharmLoopExpansion e = expansion(0.5 * (m_q_hat_max + m_q_hat_min) + 0.5 * (m_q_hat_max - m_q_hat_min) * std::cos(theta[i]));
+                        for (unsigned k = 0 ; k < 4 ; ++k)
+                        {
+                            values[i][k]     = e.alpha[k];
+                            values[i][k + 4] = e.beta[k];
+                        }
+                    }
+
+                    for (unsigned j = 0 ; j < n ; ++j)
+                    {
+                        _c[j].fill(0.0);
+                        for (unsigned i = 0 ; i < n ; ++i)
+                        {
+                            const double t = (j == 0 ? 1.0 : 2.0) / n * std::cos(j * theta[i]);
+                            for (unsigned k = 0 ; k < 8 ; ++k)
+                                _c[j][k] += t * values[i][k];
+                        }
+                    }
+                }
+
+                CharmLoopExpansion operator() (const double & m_q_hat) const
+                {
+                    if ((m_q_hat < m_q_hat_min) || (m_q_hat_max < m_q_hat))
+                        return _expansion(m_q_hat);
+
+                    const double x = (2.0 * m_q_hat - m_q_hat_max - m_q_hat_min) / (m_q_hat_max - m_q_hat_min);
+
+                    // all eight coefficients share the same Chebyshev polynomials
+                    std::array<double, degree + 1> t;
+                    t[0] = 1.0;
+                    t[1] = x;
+                    for (unsigned j = 2 ; j <= degree ; ++j)
+                        t[j] = 2.0 * x * t[j - 1] - t[j - 2];
+
+                    CharmLoopExpansion result;
+                    result.alpha.fill(0.0);
+                    result.beta.fill(0.0);
+                    for (unsigned j = 0 ; j <= degree ; ++j)
+                    {
+                        for (unsigned k = 0 ; k < 4 ; ++k)
+                        {
+                            result.alpha[k] += t[j] * _c[j][k];
+                            result.beta[k]  += t[j] * _c[j][k + 4];
+                        }
+                    }
+
+                    return result;
+                }
         };
 
-        double m_q_hat = m_q / m_b, z = power_of<2>(m_q_hat);
-        double s_hat = s / m_b / m_b;
-
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.000 <= s_hat) && (s_hat <= 0.45))
+        const CharmLoopSurrogate & f17_surrogate()
         {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.000))
-        {
-            log_s_hat.imag(+M_PI);
-        }
-        else
-        {
-            throw InternalError("CharmLoop::F19_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
+            static const CharmLoopSurrogate result(&f17_expansion);
+
+            return result;
         }
 
-        const double rho19[4] = {
-            3.8991 * power_of<3>(m_q_hat), -23.3946 * m_q_hat, -140.368 * m_q_hat, 7.79821 / m_q_hat - 319.726 * m_q_hat
-        };
+        const CharmLoopSurrogate & f27_surrogate()
+        {
+            static const CharmLoopSurrogate result(&f27_expansion);
 
-        // real part
-        complex<double> r = (-1424.0 / 729.0 + 64.0 / 27.0 * log(m_q_hat)) * log(mu/m_b)
-            - 16.0 / 243.0 * log(mu/m_b) * log_s_hat
-            + (16.0 / 1215.0 - 32.0 / 135.0 /power_of<2>(m_q_hat)) * log(mu/m_b) * s_hat
-            + (4.0 / 2835.0 - 8.0 / 315.0 /power_of<4>(m_q_hat)) * log(mu/m_b) * s_hat * s_hat
-            + (16.0 / 76545.0 - 32.0 /8505.0 / power_of<6>(m_q_hat)) * log(mu/m_b) * power_of<3>(s_hat)
-            - 256.0 / 243.0 * power_of<2>(log(mu/m_b));
+            return result;
+        }
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0  ; m < 4  ; m++)
-                r = r + kap1900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+        const CharmLoopSurrogate & f19_surrogate()
+        {
+            static const CharmLoopSurrogate result(&f19_expansion);
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1901[l][m][0] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            return result;
+        }
 
-        for (int l = 2  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1910[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        const CharmLoopSurrogate & f29_surrogate()
+        {
+            static const CharmLoopSurrogate result(&f29_expansion);
 
-        for (int l = 4  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1911[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            return result;
+        }
 
-        for (int l = 1  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1920[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        complex<double> log_s_hat(const std::string & name, const double & s_hat)
+        {
+            complex<double> result = { std::log(std::abs(s_hat)), 0.0 };
+            if ((0.0 < s_hat) && (s_hat <= 0.45))
+            {
+                result.imag(0.0);
+            }
+            else if ((-0.45 <= s_hat) && (s_hat <= -0.00))
+            {
+                result.imag(+M_PI);
+            }
+            else
+            {
+                throw InternalError("CharmLoop::" + name + " used outside its domain of validity, s_hat = " + stringify(s_hat));
+            }
+
+            return result;
+        }
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1921[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        // cf. [AAGW2001], Eq. (56), p. 20
+        template <typename Expansion_>
+        complex<double> f17(const double & mu, const double & s, const double & m_b, const double & m_c, const Expansion_ & expansion)
+        {
+            const double s_hat = s / power_of<2>(m_b);
+            const complex<double> log_s_hat = impl::log_s_hat("F17_massive", s_hat);
 
-        for (int l = 0  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1930[l][m][0] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
+            return -208.0 / 243.0 * log(mu / m_b) + expansion(m_c / m_b)(s_hat, log_s_hat);
+        }
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1931[l][m][0] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        // cf. [AAGW2001], Eq. (56), p. 20
+        template <typename Expansion_>
+        complex<double> f27(const double & mu, const double & s, const double & m_b, const double & m_q, const Expansion_ & expansion)
+        {
+            const double s_hat = s / m_b / m_b;
 
-        for (int l = 0  ; l < 4; l++)
-            r = r + rho19[l] * pow(s_hat, l);
+            if (s_hat == 0)
+            {
+                return 416.0 / 81.0 * log(mu / m_b) + expansion(m_q / m_b).alpha[0];
+            }
 
-        // imaginary part
-        complex<double> i = 16.0 / 243.0 * M_PI * log(mu/m_b);
+            const complex<double> log_s_hat = impl::log_s_hat("F27_massive", s_hat);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+            return 416.0 / 81.0 * log(mu / m_b) + expansion(m_q / m_b)(s_hat, log_s_hat);
+        }
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1901[l][m][1] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        // cf. [AAGW2001], Eq. (54), p. 19
+        template <typename Expansion_>
+        complex<double> f19(const double & mu, const double & s, const double & m_b, const double & m_q, const Expansion_ & expansion)
+        {
+            // F19(s) diverges for s -> 0. However, s * F19(s) -> 0 for s -> 0.
+            if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
+                throw InternalError("CharmLoops::F19_massive: F19 diverges for s -> 0. Check that F19 enters via 's * F19(s)' and replace by zero.");
+
+            const double m_q_hat = m_q / m_b;
+            const double s_hat = s / m_b / m_b;
+            const complex<double> log_s_hat = impl::log_s_hat("F19_massive", s_hat);
+
+            // mu-dependent real part
+            complex<double> r = (-1424.0 / 729.0 + 64.0 / 27.0 * log(m_q_hat)) * log(mu/m_b)
+                - 16.0 / 243.0 * log(mu/m_b) * log_s_hat
+                + (16.0 / 1215.0 - 32.0 / 135.0 /power_of<2>(m_q_hat)) * log(mu/m_b) * s_hat
+                + (4.0 / 2835.0 - 8.0 / 315.0 /power_of<4>(m_q_hat)) * log(mu/m_b) * s_hat * s_hat
+                + (16.0 / 76545.0 - 32.0 /8505.0 / power_of<6>(m_q_hat)) * log(mu/m_b) * power_of<3>(s_hat)
+                - 256.0 / 243.0 * power_of<2>(log(mu/m_b));
+
+            // mu-dependent imaginary part
+            complex<double> i = 16.0 / 243.0 * M_PI * log(mu/m_b);
+
+            return r + complex<double>(0.0, 1.0) * i + expansion(m_q_hat)(s_hat, log_s_hat);
+        }
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1910[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        // cf. [AAGW2001], Eq. (54), p. 19
+        template <typename Expansion_>
+        complex<double> f29(const double & mu, const double & s, const double & m_b, const double & m_q, const Expansion_ & expansion)
+        {
+            // F29(s) diverges for s -> 0. However, s * F29(s) -> 0 for s -> 0.
+            if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
+                throw InternalError("CharmLoops::F29_massive: F29 diverges for s -> 0. Check that F29 enters via 's * F29(s)' and replace by zero.");
+
+            const double m_q_hat = m_q / m_b;
+            const double s_hat = s / m_b / m_b;
+            const complex<double> log_s_hat = impl::log_s_hat("F29_massive", s_hat);
+
+            // mu-dependent real part
+            complex<double> r = (256.0 / 243.0 - 128.0 / 9.0 * log(m_q_hat)) * log(mu / m_b)
+                + 32.0 / 81.0 * log(mu / m_b) * log_s_hat
+                + (-32.0 / 405.0 + 64.0 / 45 / power_of<2>(m_q_hat)) * log(mu / m_b) * s_hat
+                + (-8.0 / 945.0 + 16.0 / 105 / power_of<4>(m_q_hat)) * log(mu / m_b) * s_hat * s_hat
+                + (-32.0 / 25515.0 + 64.0 / 2835 / power_of<6>(m_q_hat)) * log(mu / m_b) * power_of<3>(s_hat)
+                + 512.0 / 81.0 * power_of<2>(log(mu / m_b));
+
+            // mu-dependent imaginary part
+            complex<double> i = - 32.0 / 81.0 * M_PI * log(mu/m_b);
+
+            return r + complex<double>(0.0, 1.0) * i + expansion(m_q_hat)(s_hat, log_s_hat);
+        }
+    }
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1911[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F17_massive(const double & mu, const double & s, const double & m_b, const double & m_c)
+    {
+        return impl::f17(mu, s, m_b, m_c, &impl::f17_expansion);
+    }
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1920[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F17_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_c)
+    {
+        return impl::f17(mu, s, m_b, m_c, impl::f17_surrogate());
+    }
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1921[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F27_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        return impl::f27(mu, s, m_b, m_q, &impl::f27_expansion);
+    }
 
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1930[l][m][1] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F27_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        return impl::f27(mu, s, m_b, m_q, impl::f27_surrogate());
+    }
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1931[l][m][1] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F19_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        return impl::f19(mu, s, m_b, m_q, &impl::f19_expansion);
+    }
 
-        return r + complex<double>(0.0, 1.0) * i;
+    complex<double>
+    CharmLoops::F19_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        return impl::f19(mu, s, m_b, m_q, impl::f19_surrogate());
     }
 
-    // cf. [AAGW2001], Eq. (54), p. 19
     complex<double>
     CharmLoops::F29_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
     {
-        // F29(s) diverges for s -> 0. However, s * F29(s) -> 0 for s -> 0.
-        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
-            throw InternalError("CharmLoops::F29_massive: F29 diverges for s -> 0. Check that F29 enters via 's * F29(s)' and replace by zero.");
-
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap2900[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-24.2913, -22.0299}, {-23.1111, -11.1701}, {0, 0}, {0, 0}, {0, 0}},
-            {{-86.7723, 97.2931}, {-57.5593, 67.0206}, {7.11111, 44.6804}, {4.74074, 0}, {0, 0}},
-            {{96.5187, -160.51}, {-325.463, 89.3609}, {92.4444, 178.722}, {23.7037, 0}, {0, 0}},
-            {{88.3801, 142.135}, {171.457, -208.509}, {-120.889, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2901[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.296296, 0.620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{3.55556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-29.7586, 11.1701}, {7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
-            {{55.2172, 9.92898}, {6.32099, -59.5739}, {-18.963, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2910[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.8462, 1.11701}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-26.8464, 1.86168}, {-8.88889, 11.1701}, {0, 0}, {0, 0}, {0, 0}},
-            {{-428.313, 184.792}, {-50.8606, 201.062}, {-75.2337, 44.6804}, {4.74074, 0}, {-4.74074, 0}},
-            {{108.781, -396.864}, {-897.575, 402.124}, {295.111, 491.485}, {66.3704, 0}, {0, 0}},
-            {{437.34, 382.697}, {408.81, -804.248}, {-381.63, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2911[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{16., 11.1701}, {7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-111.923, 44.6804}, {28.4444, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}},
-            {{249.663, 22.3402}, {14.2222, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2920[7][5][2] = {{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0132191, 0.11968}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.367901, -0.372337}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-222.769, 8.19141}, {-132.372, 11.1701}, {-32., 0}, {-4.74074, 0}, {0, 0}},
-            {{-1276.44, 313.249}, {131.529, 312.763}, {-343.034, 44.6804}, {14.2222, 0}, {-14.2222, 0}},
-            {{268.098, -652.279}, {-1632.09, 982.969}, {714.667, 938.289}, {128., 0}, {0, 0}},
-            {{823.218, 640.989}, {596.622, -1980.83}, {-1013.33, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2921[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{32., 22.3402}, {14.2222, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-244.716, 134.041}, {85.3333, 402.124}, {128., 0}, {0, 0}, {0, 0}},
-            {{668.137, 0}, {0, -714.887}, {-227.556, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2930[7][5][2] = {
-            {{-0.0142243, 0.0177303}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0288536, -0.0221629}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{10.8601, -0.523045}, {5.51675, 0}, {1.18519, 0}, {0, 0}, {0, 0}},
-            {{-478.485, 10.3323}, {-343.902, 11.1701}, {-67.5556, 0}, {-14.2222, 0}, {0, 0}},
-            {{-2553.47, 459.887}, {412.809, 417.017}, {-776.143, 44.6804}, {33.1852, 0}, {-28.4444, 0}},
-            {{527.368, -890.889}, {-2505.67, 1869.13}, {1362.96, 1519.13}, {208.593, 0}, {0, 0}},
-            {{1675.61, 810.709}, {881.117, -3916.98}, {-1987.56, 0}, {0, 0}, {0, 0}}
-        };
-
-        static double kap2931[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.131687, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{49.7778, 33.5103}, {21.3333, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-421.619, 297.87}, {189.63, 714.887}, {227.556, 0}, {0, 0}, {0, 0}},
-            {{1391.36, -111.701}, {-71.1111, -1489.35}, {-474.074, 0}, {0, 0}, {0, 0}}
-        };
-
-        double m_q_hat = m_q / m_b, z = power_of<2>(m_q_hat);
-        double s_hat = s / m_b / m_b;
-
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.000 <= s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.000))
-        {
-            log_s_hat.imag(+M_PI);
-        }
-        else
-        {
-            throw InternalError("CharmLoop::F29_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
-        }
-
-        const double rho29[4] = {
-            -23.3946 * power_of<3>(m_q_hat), 140.368 * m_q_hat, 842.206 * m_q_hat, -46.7892 / m_q_hat + 1918.36 * m_q_hat
-        };
-
-        // real part
-        complex<double> r = (256.0 / 243.0 - 128.0 / 9.0 * log(m_q_hat)) * log(mu / m_b)
-            + 32.0 / 81.0 * log(mu / m_b) * log_s_hat
-            + (-32.0 / 405.0 + 64.0 / 45 / power_of<2>(m_q_hat)) * log(mu / m_b) * s_hat
-            + (-8.0 / 945.0 + 16.0 / 105 / power_of<4>(m_q_hat)) * log(mu / m_b) * s_hat * s_hat
-            + (-32.0 / 25515.0 + 64.0 / 2835 / power_of<6>(m_q_hat)) * log(mu / m_b) * power_of<3>(s_hat)
-            + 512.0 / 81.0 * power_of<2>(log(mu / m_b));
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 4 ; m++)
-                r = r + kap2900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2901[l][m][0] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2910[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2911[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2920[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2921[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2930[l][m][0] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2931[l][m][0] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 0 ; l < 4; l++)
-            r = r + rho29[l] * pow(s_hat, l);
-
-        // imaginary part
-        complex<double> i = - 32.0 / 81.0 * M_PI * log(mu/m_b);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2901[l][m][1] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2910[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2911[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2920[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2921[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2930[l][m][1] * power_of<3>(s_hat) * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2931[l][m][1] * power_of<3>(s_hat) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        return impl::f29(mu, s, m_b, m_q, &impl::f29_expansion);
+    }
 
-        return r + complex<double>(0.0, 1.0) * i;
+    complex<double>
+    CharmLoops::F29_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        return impl::f29(mu, s, m_b, m_q, impl::f29_surrogate());
     }
 
     // cf. [AAGW2001], eqs. (48) and (49), p. 18
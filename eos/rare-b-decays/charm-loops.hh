@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2014 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -77,6 +78,12 @@ namespace eos
         static complex<double> F29_massive(const double & mu, const double & s, const double & m_b, const double & m_c);
         static complex<double> delta_F29_massive(const double & mu, const double & s, const double & m_c);
 
+        // massive case as above, with the dependence on m_c / m_b interpolated by Chebyshev polynomials for 0.15 <= m_c / m_b <= 0.50
+        static complex<double> F17_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_c);
+        static complex<double> F19_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_c);
+        static complex<double> F27_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_c);
+        static complex<double> F29_massive_surrogate(const double & mu, const double & s, const double & m_b, const double & m_c);
+
         // helper functions for F8j, cf. [BFS2001], Eqs. (29) and (84), pp. 8 and 30
         static complex<double> B0(const double & s, const double & m_q);
         static complex<double> C0(const double & s, const double & m_q);
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2017 Danny van Dyk
  * Copyright (c) 2010, 2011 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -22,6 +23,8 @@
 #include <eos/rare-b-decays/charm-loops.hh>
 
 #include <cmath>
+#include <utility>
+#include <vector>
 
 using namespace test;
 using namespace eos;
@@ -500,3 +503,71 @@ class CharmlessTest :
             }
         }
 } charmless_test;
+
+class SurrogateTest :
+    public TestCase
+{
+    public:
+        SurrogateTest() :
+            TestCase("surrogate_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            typedef complex<double> (* Function)(const double &, const double &, const double &, const double &);
+
+            static const std::vector<std::pair<Function, Function>> functions
+            {
+                { &CharmLoops::F17_massive, &CharmLoops::F17_massive_surrogate },
+                { &CharmLoops::F19_massive, &CharmLoops::F19_massive_surrogate },
+                { &CharmLoops::F27_massive, &CharmLoops::F27_massive_surrogate },
+                { &CharmLoops::F29_massive, &CharmLoops::F29_massive_surrogate },
+            };
+
+            /* Compare the surrogates with the exact functions across the box of typical inputs */
+            {
+                static const double eps = 1e-7;
+
+                for (const auto & f : functions)
+                {
+                    for (double mu = 2.0 ; mu <= 8.5 ; mu += 1.3)
+                    {
+                        for (double m_b = 4.2 ; m_b <= 4.9 ; m_b += 0.35)
+                        {
+                            for (double m_c = 0.9 ; m_c <= 1.8 ; m_c += 0.15)
+                            {
+                                for (double s = -7.5 ; s <= 7.5 ; s += 0.5)
+                                {
+                                    if (std::abs(s) < 0.1)
+                                        continue;
+
+                                    const complex<double> exact = f.first(mu, s, m_b, m_c);
+                                    const complex<double> surrogate = f.second(mu, s, m_b, m_c);
+                                    TEST_CHECK_NEARLY_EQUAL(0.0, std::abs(surrogate - exact) / std::abs(exact), eps);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            /* F27 at s = 0 */
+            {
+                static const double mu = 4.2, m_b = 4.6, m_c = 1.5, eps = 1e-8;
+
+                TEST_CHECK_NEARLY_EQUAL(real(CharmLoops::F27_massive(mu, 0.0, m_b, m_c)), real(CharmLoops::F27_massive_surrogate(mu, 0.0, m_b, m_c)), eps);
+                TEST_CHECK_NEARLY_EQUAL(imag(CharmLoops::F27_massive(mu, 0.0, m_b, m_c)), imag(CharmLoops::F27_massive_surrogate(mu, 0.0, m_b, m_c)), eps);
+            }
+
+            /* Fall back to the exact functions outside of the interpolation range */
+            {
+                static const double mu = 4.2, s = 6.0, m_b = 4.6, m_c = 0.5;
+
+                for (const auto & f : functions)
+                {
+                    TEST_CHECK_EQUAL(f.first(mu, s, m_b, m_c), f.second(mu, s, m_b, m_c));
+                }
+            }
+        }
+} surrogate_test;
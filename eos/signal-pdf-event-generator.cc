@@ -0,0 +1,451 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/signal-pdf-event-generator.hh>
+#include <eos/utils/density.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <gsl/gsl_rng.h>
+
+namespace eos
+{
+    namespace impl
+    {
+        /*
+         * Separable importance grid. Each kinematic variable is split into bins of
+         * equal probability but varying width, such that the density of the grid is
+         * large where the PDF is large.
+         */
+        struct ImportanceGrid
+        {
+            unsigned dim;
+
+            unsigned bins;
+
+            // bin edges, dim * (bins + 1) entries
+            std::vector<double> edges;
+
+            ImportanceGrid(const std::vector<ParameterDescription> & descriptions, const unsigned & bins) :
+                dim(descriptions.size()),
+                bins(bins),
+                edges(dim * (bins + 1))
+            {
+                for (unsigned d = 0 ; d < dim ; ++d)
+                {
+                    const double min = descriptions[d].min, max = descriptions[d].max;
+                    for (unsigned i = 0 ; i <= bins ; ++i)
+                    {
+                        edges[d * (bins + 1) + i] = min + (max - min) * i / bins;
+                    }
+                }
+            }
+
+            // map a point u from the unit hypercube to the kinematic ranges; returns the logarithm of the jacobian
+            double map(const double * u, double * x, unsigned * k) const
+            {
+                double result = 0.0;
+                for (unsigned d = 0 ; d < dim ; ++d)
+                {
+                    const double * e = edges.data() + d * (bins + 1);
+                    const double y = u[d] * bins;
+                    const unsigned i = std::min(static_cast<unsigned>(y), bins - 1);
+                    const double width = e[i + 1] - e[i];
+
+                    x[d] = e[i] + (y - i) * width;
+                    k[d] = i;
+                    result += std::log(bins * width);
+                }
+
+                return result;
+            }
+
+            // redistribute the bin edges of each variable, such that each new bin holds the same share of the weights
+            void refine(const std::vector<double> & weights, const double & damping)
+            {
+                std::vector<double> smooth(bins), r(bins), updated(bins + 1);
+                for (unsigned d = 0 ; d < dim ; ++d)
+                {
+                    const double * w = weights.data() + d * bins;
+                    double * e = edges.data() + d * (bins + 1);
+
+                    // average neighbouring bins to suppress fluctuations
+                    double sum = 0.0;
+                    for (unsigned i = 0 ; i < bins ; ++i)
+                    {
+                        const unsigned lo = (i > 0) ? i - 1 : i, hi = (i + 1 < bins) ? i + 1 : i;
+                        double s = 0.0;
+                        for (unsigned j = lo ; j <= hi ; ++j)
+                        {
+                            s += w[j];
+                        }
+                        smooth[i] = s / (hi - lo + 1);
+                        sum += smooth[i];
+                    }
+
+                    if (! (sum > 0.0))
+                        continue;
+
+                    // damped importance of each bin, following the VEGAS algorithm
+                    double total = 0.0;
+                    for (unsigned i = 0 ; i < bins ; ++i)
+                    {
+                        const double f = smooth[i] / sum;
+                        if (f <= 0.0)
+                            r[i] = 0.0;
+                        else if (f >= 1.0)
+                            r[i] = 1.0;
+                        else
+                            r[i] = std::pow((1.0 - f) / std::log(1.0 / f), damping);
+
+                        total += r[i];
+                    }
+
+                    if (! (total > 0.0))
+                        continue;
+
+                    const double step = total / bins;
+                    updated[0] = e[0];
+                    updated[bins] = e[bins];
+                    double accumulated = 0.0;
+                    unsigned j = 0;
+                    for (unsigned i = 1 ; i < bins ; ++i)
+                    {
+                        const double target = i * step;
+                        while ((j + 1 < bins) && (accumulated + r[j] < target))
+                        {
+                            accumulated += r[j];
+                            ++j;
+                        }
+
+                        const double fraction = (r[j] > 0.0) ? std::min(1.0, (target - accumulated) / r[j]) : 0.0;
+                        updated[i] = e[j] + fraction * (e[j + 1] - e[j]);
+                    }
+
+                    std::copy(updated.cbegin(), updated.cend(), e);
+                }
+            }
+        };
+
+        /*
+         * An independent stream of events, with its own clone of the PDF
+         * and its own random number generator.
+         */
+        struct EventStream
+        {
+            DensityPtr pdf;
+
+            std::vector<ParameterDescription> descriptions;
+
+            std::shared_ptr<gsl_rng> rng;
+
+            std::vector<double> u;
+
+            EventStream(const SignalPDFPtr & pdf, const unsigned long & seed) :
+                pdf(pdf->clone(pdf->parameters())),
+                descriptions(this->pdf->begin(), this->pdf->end()),
+                rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free),
+                u(descriptions.size())
+            {
+                gsl_rng_set(rng.get(), seed);
+            }
+
+            // draw one point from the importance grid; returns the logarithm of its weight
+            double draw(const ImportanceGrid & grid, double * x, unsigned * k)
+            {
+                for (auto & v : u)
+                {
+                    v = gsl_rng_uniform(rng.get());
+                }
+
+                const double log_jacobian = grid.map(u.data(), x, k);
+
+                for (unsigned d = 0 ; d < descriptions.size() ; ++d)
+                {
+                    descriptions[d].parameter->set(x[d]);
+                }
+
+                try
+                {
+                    return pdf->evaluate() + log_jacobian;
+                }
+                catch (eos::Exception & e)
+                {
+                    Log::instance()->message("SignalPDFEventGenerator", ll_error)
+                        << "Exception encountered when evaluating the PDF: " << e.what();
+                }
+
+                return -std::numeric_limits<double>::infinity();
+            }
+        };
+    }
+
+    SignalPDFEventGenerator::Config::Config() :
+        number_of_streams(1, std::numeric_limits<unsigned>::max(), 8),
+        number_of_bins(1, std::numeric_limits<unsigned>::max(), 50),
+        number_of_adaptations(0, std::numeric_limits<unsigned>::max(), 5),
+        adaptation_samples(1, std::numeric_limits<unsigned>::max(), 20000),
+        damping(0.0, std::numeric_limits<double>::max(), 1.5),
+        safety_factor(1.0, std::numeric_limits<double>::max(), 1.2),
+        seed(0)
+    {
+    }
+
+    template <>
+    struct Implementation<SignalPDFEventGenerator>
+    {
+        SignalPDFEventGenerator::Config config;
+
+        std::vector<impl::EventStream> streams;
+
+        unsigned dim;
+
+        impl::ImportanceGrid grid;
+
+        // logarithm of the envelope of the weights
+        double log_envelope;
+
+        double integral;
+
+        double acceptance_rate;
+
+        std::size_t number_of_overweight_events;
+
+        Implementation(const SignalPDFPtr & pdf, const SignalPDFEventGenerator::Config & config) :
+            config(config),
+            streams(make_streams(pdf, config)),
+            dim(streams.front().descriptions.size()),
+            grid(streams.front().descriptions, config.number_of_bins),
+            log_envelope(-std::numeric_limits<double>::infinity()),
+            integral(0.0),
+            acceptance_rate(0.0),
+            number_of_overweight_events(0)
+        {
+            if (0 == dim)
+                throw InternalError("SignalPDFEventGenerator: the PDF has no kinematic variables");
+
+            adapt();
+        }
+
+        static std::vector<impl::EventStream> make_streams(const SignalPDFPtr & pdf, const SignalPDFEventGenerator::Config & config)
+        {
+            if (! pdf)
+                throw InternalError("SignalPDFEventGenerator: no PDF provided");
+
+            // create the clones sequentially, before running the streams concurrently
+            std::vector<impl::EventStream> result;
+            result.reserve(config.number_of_streams);
+            for (unsigned s = 0 ; s < config.number_of_streams ; ++s)
+            {
+                result.emplace_back(pdf, config.seed + s);
+            }
+
+            return result;
+        }
+
+        // first index of the events handled by stream s
+        std::size_t offset(const std::size_t & s, const std::size_t & n) const
+        {
+            return n / streams.size() * s + std::min(s, n % streams.size());
+        }
+
+        void adapt()
+        {
+            const unsigned bins = config.number_of_bins;
+            const std::size_t n = config.adaptation_samples;
+
+            grid = impl::ImportanceGrid(streams.front().descriptions, bins);
+
+            std::vector<double> log_weights(n);
+            std::vector<unsigned> indices(n * dim);
+            for (unsigned a = 0 ; a <= config.number_of_adaptations ; ++a)
+            {
+                ThreadPool::instance()->parallel_for(0, streams.size(), [&, this](const std::size_t & s)
+                {
+                    std::vector<double> x(dim);
+                    for (std::size_t i = offset(s, n), i_end = offset(s + 1, n) ; i < i_end ; ++i)
+                    {
+                        log_weights[i] = streams[s].draw(grid, x.data(), indices.data() + i * dim);
+                    }
+                });
+
+                const double log_max = *std::max_element(log_weights.cbegin(), log_weights.cend());
+                if (! std::isfinite(log_max))
+                    throw InternalError("SignalPDFEventGenerator: the PDF vanishes at all " + stringify(n) + " adaptation samples");
+
+                // accumulate the weights relative to the largest weight, to avoid under- and overflows
+                std::vector<double> bin_weights(dim * bins, 0.0);
+                double sum = 0.0;
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    const double w = std::exp(log_weights[i] - log_max);
+                    for (unsigned d = 0 ; d < dim ; ++d)
+                    {
+                        bin_weights[d * bins + indices[i * dim + d]] += w;
+                    }
+                    sum += w;
+                }
+
+                integral = std::exp(log_max) * sum / n;
+
+                if (a < config.number_of_adaptations)
+                {
+                    grid.refine(bin_weights, config.damping);
+
+                    Log::instance()->message("SignalPDFEventGenerator", ll_informational)
+                        << "Adaptation " << a << ": integral estimate is " << integral
+                        << ", efficiency is " << 100.0 * sum / n << "%";
+                }
+                else
+                {
+                    // the last pass only determines the envelope
+                    log_envelope = log_max + std::log(double(config.safety_factor));
+
+                    Log::instance()->message("SignalPDFEventGenerator", ll_informational)
+                        << "Final grid: integral estimate is " << integral
+                        << ", expected acceptance rate is " << 100.0 * sum / n / config.safety_factor << "%";
+                }
+            }
+        }
+
+        void generate(double * events, const std::size_t & n)
+        {
+            std::vector<std::size_t> tries(streams.size(), 0), overweight(streams.size(), 0);
+
+            ThreadPool::instance()->parallel_for(0, streams.size(), [&, this](const std::size_t & s)
+            {
+                auto & stream = streams[s];
+                std::vector<unsigned> k(dim);
+                for (std::size_t i = offset(s, n), i_end = offset(s + 1, n) ; i < i_end ; )
+                {
+                    double * x = events + i * dim;
+                    const double log_weight = stream.draw(grid, x, k.data());
+                    ++tries[s];
+
+                    if (log_weight > log_envelope)
+                        ++overweight[s];
+
+                    if (std::log(gsl_rng_uniform_pos(stream.rng.get())) > log_weight - log_envelope)
+                        continue;
+
+                    ++i;
+                }
+            });
+
+            std::size_t total_tries = 0;
+            number_of_overweight_events = 0;
+            for (std::size_t s = 0 ; s < streams.size() ; ++s)
+            {
+                total_tries += tries[s];
+                number_of_overweight_events += overweight[s];
+            }
+            acceptance_rate = (total_tries > 0) ? double(n) / total_tries : 0.0;
+
+            if (number_of_overweight_events > 0)
+            {
+                Log::instance()->message("SignalPDFEventGenerator", ll_warning)
+                    << number_of_overweight_events << " events exceeded the envelope; consider a larger safety factor or more adaptation samples";
+            }
+        }
+
+        void generate_weighted(double * events, double * weights, const std::size_t & n)
+        {
+            ThreadPool::instance()->parallel_for(0, streams.size(), [&, this](const std::size_t & s)
+            {
+                auto & stream = streams[s];
+                std::vector<unsigned> k(dim);
+                for (std::size_t i = offset(s, n), i_end = offset(s + 1, n) ; i < i_end ; ++i)
+                {
+                    weights[i] = std::exp(stream.draw(grid, events + i * dim, k.data()));
+                }
+            });
+        }
+    };
+
+    SignalPDFEventGenerator::SignalPDFEventGenerator(const SignalPDFPtr & pdf, const Config & config) :
+        PrivateImplementationPattern<SignalPDFEventGenerator>(new Implementation<SignalPDFEventGenerator>(pdf, config))
+    {
+    }
+
+    SignalPDFEventGenerator::~SignalPDFEventGenerator()
+    {
+    }
+
+    void
+    SignalPDFEventGenerator::adapt()
+    {
+        _imp->adapt();
+    }
+
+    void
+    SignalPDFEventGenerator::generate(double * events, const std::size_t & n)
+    {
+        _imp->generate(events, n);
+    }
+
+    void
+    SignalPDFEventGenerator::generate_weighted(double * events, double * weights, const std::size_t & n)
+    {
+        _imp->generate_weighted(events, weights, n);
+    }
+
+    unsigned
+    SignalPDFEventGenerator::dimension() const
+    {
+        return _imp->dim;
+    }
+
+    std::vector<std::string>
+    SignalPDFEventGenerator::variables() const
+    {
+        std::vector<std::string> result;
+        for (const auto & d : _imp->streams.front().descriptions)
+        {
+            result.push_back(d.parameter->name());
+        }
+
+        return result;
+    }
+
+    double
+    SignalPDFEventGenerator::integral() const
+    {
+        return _imp->integral;
+    }
+
+    double
+    SignalPDFEventGenerator::acceptance_rate() const
+    {
+        return _imp->acceptance_rate;
+    }
+
+    std::size_t
+    SignalPDFEventGenerator::number_of_overweight_events() const
+    {
+        return _imp->number_of_overweight_events;
+    }
+}
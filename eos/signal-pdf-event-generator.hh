@@ -0,0 +1,139 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_SIGNAL_PDF_EVENT_GENERATOR_HH
+#define EOS_GUARD_EOS_SIGNAL_PDF_EVENT_GENERATOR_HH 1
+
+#include <eos/signal-pdf.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Generates independent events from a SignalPDF within the kinematic ranges of the PDF.
+     *
+     * The generator builds a separable, VEGAS-style importance grid for the PDF at the current
+     * parameter point, and uses the grid as the envelope for accept-reject sampling. The events
+     * are generated by several independent streams, each with its own clone of the PDF and its
+     * own random number generator, which are distributed across the ThreadPool. For a given seed
+     * the events do not depend on the scheduling of the streams.
+     */
+    class SignalPDFEventGenerator :
+        public PrivateImplementationPattern<SignalPDFEventGenerator>
+    {
+        public:
+            struct Config
+            {
+                /// Number of independent streams of events.
+                VerifiedRange<unsigned> number_of_streams;
+
+                /// Number of bins of the importance grid per kinematic variable.
+                VerifiedRange<unsigned> number_of_bins;
+
+                /// Number of adaptations of the importance grid.
+                VerifiedRange<unsigned> number_of_adaptations;
+
+                /// Number of samples used in each adaptation, across all streams.
+                VerifiedRange<unsigned> adaptation_samples;
+
+                /// Damping exponent of the grid adaptation; smaller values adapt more slowly.
+                VerifiedRange<double> damping;
+
+                /// Factor by which the largest weight in the last adaptation is increased to obtain the envelope.
+                VerifiedRange<double> safety_factor;
+
+                /// Seed for the random number generators; stream i uses seed + i.
+                unsigned long seed;
+
+                /// Constructor.
+                Config();
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor. Builds the importance grid at the current parameter point.
+             *
+             * @param pdf     The PDF from which events shall be generated.
+             * @param config  The configuration of the generator.
+             */
+            SignalPDFEventGenerator(const SignalPDFPtr & pdf, const Config & config);
+
+            /// Destructor.
+            ~SignalPDFEventGenerator();
+            ///@}
+
+            /*!
+             * Rebuild the importance grid and the envelope.
+             *
+             * Must be called after any change of the PDF's parameters.
+             */
+            void adapt();
+
+            ///@name Generation
+            ///@{
+            /*!
+             * Generate unweighted events through accept-reject sampling.
+             *
+             * @param events  Buffer of n * dimension() values, which receives the events
+             *                row-major with one event per row.
+             * @param n       The number of events.
+             */
+            void generate(double * events, const std::size_t & n);
+
+            /*!
+             * Generate weighted events from the importance grid, without rejection.
+             *
+             * The weights are the ratio of the PDF and the density of the importance grid,
+             * such that their mean estimates the integral of the PDF over the kinematic ranges.
+             *
+             * @param events   Buffer of n * dimension() values, which receives the events
+             *                 row-major with one event per row.
+             * @param weights  Buffer of n values, which receives the weights.
+             * @param n        The number of events.
+             */
+            void generate_weighted(double * events, double * weights, const std::size_t & n);
+            ///@}
+
+            ///@name Accessors
+            ///@{
+            /// Retrieve the number of kinematic variables.
+            unsigned dimension() const;
+
+            /// Retrieve the names of the kinematic variables, in the order of the columns of the events.
+            std::vector<std::string> variables() const;
+
+            /// Retrieve the estimate of the integral of the PDF from the last adaptation.
+            double integral() const;
+
+            /// Retrieve the acceptance rate of the last call to generate().
+            double acceptance_rate() const;
+
+            /// Retrieve the number of events in the last call to generate() whose weight exceeded the envelope.
+            std::size_t number_of_overweight_events() const;
+            ///@}
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/signal-pdf-event-generator.hh>
+
+#include <cmath>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class SignalPDFEventGeneratorTest :
+    public TestCase
+{
+    public:
+        SignalPDFEventGeneratorTest() :
+            TestCase("signal_pdf_event_generator_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // PDF ~ 9 + 8 z + 9 z^2 on [-1, +1], with integral 24, <z> = 2/9 and <z^2> = 2/5
+            Parameters p = Parameters::Defaults();
+            Kinematics k
+            {
+                { "z_min", -1.0 }, { "z_max", +1.0 }
+            };
+            auto pdf = SignalPDF::make("Test::Legendre1D", p, k, Options());
+
+            SignalPDFEventGenerator::Config config;
+            config.seed = 1701;
+
+            /* unweighted events */
+            {
+                SignalPDFEventGenerator generator(pdf, config);
+                TEST_CHECK_EQUAL(1u, generator.dimension());
+                TEST_CHECK_EQUAL("z", generator.variables().front());
+                TEST_CHECK_RELATIVE_ERROR(24.0, generator.integral(), 1.0e-2);
+
+                const std::size_t n = 100000;
+                std::vector<double> events(n, -2.0);
+                generator.generate(events.data(), n);
+
+                double mean = 0.0, second_moment = 0.0;
+                for (const auto & z : events)
+                {
+                    TEST_CHECK((-1.0 <= z) && (z <= +1.0));
+                    mean += z / n;
+                    second_moment += z * z / n;
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(2.0 / 9.0, mean,          1.0e-2);
+                TEST_CHECK_NEARLY_EQUAL(2.0 / 5.0, second_moment, 1.0e-2);
+                TEST_CHECK(generator.acceptance_rate() > 0.5);
+                TEST_CHECK_EQUAL(0u, generator.number_of_overweight_events());
+            }
+
+            /* weighted events */
+            {
+                SignalPDFEventGenerator generator(pdf, config);
+
+                const std::size_t n = 100000;
+                std::vector<double> events(n), weights(n);
+                generator.generate_weighted(events.data(), weights.data(), n);
+
+                double sum = 0.0, mean = 0.0;
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    sum += weights[i];
+                    mean += weights[i] * events[i];
+                }
+                mean /= sum;
+
+                TEST_CHECK_RELATIVE_ERROR(24.0, sum / n, 1.0e-2);
+                TEST_CHECK_NEARLY_EQUAL(2.0 / 9.0, mean, 1.0e-2);
+            }
+
+            /* reproducibility */
+            {
+                SignalPDFEventGenerator generator1(pdf, config);
+                SignalPDFEventGenerator generator2(pdf, config);
+
+                std::vector<double> events1(1000), events2(1000);
+                generator1.generate(events1.data(), events1.size());
+                generator2.generate(events2.data(), events2.size());
+                TEST_CHECK(events1 == events2);
+            }
+        }
+} signal_pdf_event_generator_test;
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011, 2013-2019 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -29,6 +30,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <map>
 
@@ -58,6 +60,15 @@ namespace eos
 {
     namespace implementation
     {
+        // number of snapshots of the observable cache in a batch of predictions, cf. LogLikelihoodBlock::evaluate_batch()
+        static std::size_t batch_size(const ObservableCache & cache, const std::vector<double> & predictions, const std::string & block)
+        {
+            if (0 != predictions.size() % cache.size())
+                throw InternalError(block + ": size of the batch of predictions is not a multiple of the size of the observable cache");
+
+            return predictions.size() / cache.size();
+        }
+
         struct GaussianBlock :
             public LogLikelihoodBlock
         {
@@ -119,9 +130,8 @@ namespace eos
                 return result;
             }
 
-            virtual double evaluate() const
+            double log_pdf(const double & value) const
             {
-                double value = cache[id];
                 double sigma = 0.0;
 
                 // allow for asymmetric Gaussian uncertainty
@@ -135,6 +145,37 @@ namespace eos
                 return norm - power_of<2>(chi) / 2.0;
             }
 
+            virtual double evaluate() const
+            {
+                return log_pdf(cache[id]);
+            }
+
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                const std::size_t n = batch_size(cache, predictions, "GaussianBlock");
+                const std::size_t width = cache.size();
+
+                std::vector<double> result(n);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    result[k] = log_pdf(predictions[k * width + id]);
+                }
+
+                return result;
+            }
+
+            virtual Dual evaluate_dual() const
+            {
+                const Dual & value = cache.dual(id);
+
+                // allow for asymmetric Gaussian uncertainty
+                const double sigma = (value.value > mode) ? sigma_upper : sigma_lower;
+
+                const Dual chi = (value - mode) / sigma;
+
+                return norm - power_of<2>(chi) / 2.0;
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -307,13 +348,32 @@ namespace eos
                     return 1.0 - gsl_sf_gamma_inc_Q(alpha, z);
             }
 
-            virtual double evaluate() const
+            double log_pdf(const double & x) const
             {
-                double value = (cache[id] - nu) / lambda;
+                double value = (x - nu) / lambda;
 
                 return norm + alpha * value - std::exp(value);
             }
 
+            virtual double evaluate() const
+            {
+                return log_pdf(cache[id]);
+            }
+
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                const std::size_t n = batch_size(cache, predictions, "LogGammaBlock");
+                const std::size_t width = cache.size();
+
+                std::vector<double> result(n);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    result[k] = log_pdf(predictions[k * width + id]);
+                }
+
+                return result;
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -540,14 +600,33 @@ namespace eos
                     return 1.0 - gsl_sf_gamma_inc_Q(alpha, w);
             }
 
-            virtual double evaluate() const
+            double log_pdf(const double & x) const
             {
                 // standardized transform
-                const double z = (cache[id] - physical_limit) / theta;
+                const double z = (x - physical_limit) / theta;
 
                 return norm + (alpha * beta - 1) * std::log(z) - std::pow(z, beta);
             }
 
+            virtual double evaluate() const
+            {
+                return log_pdf(cache[id]);
+            }
+
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                const std::size_t n = batch_size(cache, predictions, "AmorosoBlock");
+                const std::size_t width = cache.size();
+
+                std::vector<double> result(n);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    result[k] = log_pdf(predictions[k * width + id]);
+                }
+
+                return result;
+            }
+
             inline double mode() const
             {
                 return physical_limit + theta * std::pow(alpha - 1 / beta, 1 / beta);
@@ -729,19 +808,15 @@ namespace eos
                 return LogLikelihoodBlockPtr(new MixtureBlock(clones, weights, test_stat));
             }
 
-            double evaluate() const
+            // weighted sum of the components' likelihoods, given the logarithms of the latter
+            double log_sum(const std::vector<double> & values) const
             {
                 // find biggest element
-                auto v = temp.begin();
-
-                for (auto c = components.cbegin() ; c != components.cend() ; ++c, ++v)
-                    *v = (**c).evaluate();
-
-                auto max_val = std::max_element(temp.cbegin(), temp.cend());
+                auto max_val = std::max_element(values.cbegin(), values.cend());
                 double ret_val = 0;
 
                 // computed weighted sum, renormalize exponents
-                v = temp.begin();
+                auto v = values.cbegin();
                 for (auto w = weights.cbegin(); w != weights.cend() ; ++w, ++v)
                 {
                     ret_val += *w * std::exp(*v - *max_val);
@@ -752,6 +827,36 @@ namespace eos
                 return ret_val;
             }
 
+            double evaluate() const
+            {
+                auto v = temp.begin();
+
+                for (auto c = components.cbegin() ; c != components.cend() ; ++c, ++v)
+                    *v = (**c).evaluate();
+
+                return log_sum(temp);
+            }
+
+            std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                std::vector<std::vector<double>> batches;
+                for (const auto & component : components)
+                    batches.push_back(component->evaluate_batch(predictions));
+
+                const std::size_t n = batches.front().size();
+                std::vector<double> result(n);
+                std::vector<double> values(components.size());
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    for (std::size_t c = 0 ; c < components.size() ; ++c)
+                        values[c] = batches[c][k];
+
+                    result[k] = log_sum(values);
+                }
+
+                return result;
+            }
+
             unsigned number_of_observations() const
             {
                 return components.front()->number_of_observations();
@@ -781,6 +886,41 @@ namespace eos
             }
         };
 
+        // contiguous storage for doubles, aligned to cache lines and zero-initialized
+        class AlignedBuffer
+        {
+            private:
+                // capacity in doubles, rounded up to full cache lines; never zero
+                const std::size_t _capacity;
+
+                double * _data;
+
+            public:
+                // number of doubles per cache line
+                static constexpr std::size_t stride = 64 / sizeof(double);
+
+                explicit AlignedBuffer(const std::size_t & size) :
+                    _capacity(stride * std::max<std::size_t>(1, (size + stride - 1) / stride)),
+                    _data(static_cast<double *>(std::aligned_alloc(64, _capacity * sizeof(double))))
+                {
+                    if (! _data)
+                        throw InternalError("AlignedBuffer: memory allocation failed");
+
+                    std::fill(_data, _data + _capacity, 0.0);
+                }
+
+                AlignedBuffer(const AlignedBuffer &) = delete;
+                AlignedBuffer & operator= (const AlignedBuffer &) = delete;
+
+                ~AlignedBuffer()
+                {
+                    std::free(_data);
+                }
+
+                double * data() { return _data; }
+                const double * data() const { return _data; }
+        };
+
         struct MultivariateGaussianBlock :
             public LogLikelihoodBlock
         {
@@ -804,8 +944,15 @@ namespace eos
             gsl_matrix * _chol;
             gsl_matrix * _covariance_inv;
 
+            // leading dimension of the whitened response matrix, padded to a full cache line
+            const unsigned _ld;
+
+            // whitened response matrix L^-1 R and whitened mean L^-1 mean, with L the cholesky matrix
+            AlignedBuffer _whitened_response;
+            AlignedBuffer _whitened_mean;
+
             // temporary storage for evaluation
-            gsl_vector * _observables;
+            mutable AlignedBuffer _predictions;
             gsl_vector * _measurements;
             gsl_vector * _measurements_2;
 
@@ -822,7 +969,10 @@ namespace eos
                 _norm(compute_norm()),
                 _chol(gsl_matrix_alloc(covariance->size1, covariance->size2)),
                 _covariance_inv(gsl_matrix_alloc(covariance->size1, covariance->size2)),
-                _observables(gsl_vector_alloc(_dim_pred)),
+                _ld(AlignedBuffer::stride * ((_dim_pred + AlignedBuffer::stride - 1) / AlignedBuffer::stride)),
+                _whitened_response(_dim_meas * _ld),
+                _whitened_mean(_dim_meas),
+                _predictions(_dim_pred),
                 _measurements(gsl_vector_alloc(_dim_meas)),
                 _measurements_2(gsl_vector_alloc(_dim_meas))
             {
@@ -851,6 +1001,8 @@ namespace eos
                         gsl_matrix_set(_chol, i, j, 0.0);
                     }
                 }
+
+                whiten();
             }
 
             virtual ~MultivariateGaussianBlock()
@@ -862,7 +1014,6 @@ namespace eos
 
                 gsl_vector_free(_measurements_2);
                 gsl_vector_free(_measurements);
-                gsl_vector_free(_observables);
                 gsl_vector_free(_mean);
             }
 
@@ -928,6 +1079,42 @@ namespace eos
                 }
             }
 
+            // whiten response matrix and mean by forward substitution with the cholesky matrix,
+            // such that chi^2 = |L^-1 R x - L^-1 mean|^2 = |W x - w|^2
+            void whiten()
+            {
+                double * W = _whitened_response.data();
+                double * w = _whitened_mean.data();
+
+                for (unsigned i = 0 ; i < _dim_meas ; ++i)
+                {
+                    const double l_ii = gsl_matrix_get(_chol, i, i);
+
+                    double * W_i = W + i * _ld;
+                    for (unsigned j = 0 ; j < _dim_pred ; ++j)
+                    {
+                        W_i[j] = gsl_matrix_get(_response, i, j);
+                    }
+                    w[i] = gsl_vector_get(_mean, i);
+
+                    for (unsigned k = 0 ; k < i ; ++k)
+                    {
+                        const double l_ik = gsl_matrix_get(_chol, i, k);
+                        const double * W_k = W + k * _ld;
+                        for (unsigned j = 0 ; j < _dim_pred ; ++j)
+                        {
+                            W_i[j] -= l_ik * W_k[j];
+                        }
+                        w[i] -= l_ik * w[k];
+                    }
+
+                    for (unsigned j = 0 ; j < _dim_pred ; ++j)
+                    {
+                        W_i[j] /= l_ii;
+                    }
+                    w[i] /= l_ii;
+                }
+            }
 
             virtual LogLikelihoodBlockPtr clone(ObservableCache cache) const
             {
@@ -978,25 +1165,28 @@ namespace eos
 
             double chi_square() const
             {
-                // read observable values from cache, and subtract mean
+                // read observable values from cache
+                double * x = _predictions.data();
                 for (auto i = 0u ; i < _dim_pred ; ++i)
                 {
-                    gsl_vector_set(_observables, i, _cache[_ids[i]]);
+                    x[i] = _cache[_ids[i]];
                 }
 
-                // prepare for centering
-                //   measurements <- mean
-                gsl_vector_memcpy(_measurements, _mean);
-
-                // apply response matrix and center the gaussian:
-                //   measurements <- R * observables - measurements
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _response, _observables, -1.0, _measurements);
-
-                // observables <- inv(covariance) * measurements
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _measurements, 0.0, _measurements_2);
-
-                double result;
-                gsl_blas_ddot(_measurements, _measurements_2, &result);
+                // apply whitened response matrix, center, and accumulate the squared norm in one pass:
+                //   chi^2 <- |W * x - w|^2
+                const double * W = _whitened_response.data();
+                const double * w = _whitened_mean.data();
+                double result = 0.0;
+                for (auto i = 0u ; i < _dim_meas ; ++i)
+                {
+                    const double * W_i = W + i * _ld;
+                    double z = -w[i];
+                    for (auto j = 0u ; j < _dim_pred ; ++j)
+                    {
+                        z += W_i[j] * x[j];
+                    }
+                    result += z * z;
+                }
 
                 return result;
             }
@@ -1006,6 +1196,75 @@ namespace eos
                 return _norm - 0.5 * chi_square();
             }
 
+            virtual Dual evaluate_dual() const
+            {
+                // chi^2 = |W * x - w|^2, cf. chi_square()
+                const double * W = _whitened_response.data();
+                const double * w = _whitened_mean.data();
+                Dual chi_squared(0.0);
+                for (auto i = 0u ; i < _dim_meas ; ++i)
+                {
+                    const double * W_i = W + i * _ld;
+                    Dual z(-w[i]);
+                    for (auto j = 0u ; j < _dim_pred ; ++j)
+                    {
+                        z += W_i[j] * _cache.dual(_ids[j]);
+                    }
+                    chi_squared += z * z;
+                }
+
+                return _norm - 0.5 * chi_squared;
+            }
+
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                const std::size_t n = batch_size(_cache, predictions, "MultivariateGaussianBlock");
+                const std::size_t width = _cache.size();
+
+                std::vector<double> result(n, _norm);
+                if (0 == n)
+                    return result;
+
+                // gather the predictions of our observables, with one sample per row
+                std::vector<double> x(n * _dim_pred);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    for (auto j = 0u ; j < _dim_pred ; ++j)
+                    {
+                        x[k * _dim_pred + j] = predictions[k * width + _ids[j]];
+                    }
+                }
+
+                // Z <- -1 w^T, i.e., every row of Z holds the negative whitened mean
+                std::vector<double> residuals(n * _dim_meas);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    for (auto i = 0u ; i < _dim_meas ; ++i)
+                    {
+                        residuals[k * _dim_meas + i] = -_whitened_mean.data()[i];
+                    }
+                }
+
+                // Z <- X * W^T + Z, with one sample per row of X
+                gsl_matrix_const_view X = gsl_matrix_const_view_array(x.data(), n, _dim_pred);
+                gsl_matrix_const_view W = gsl_matrix_const_view_array_with_tda(_whitened_response.data(), _dim_meas, _dim_pred, _ld);
+                gsl_matrix_view Z = gsl_matrix_view_array(residuals.data(), n, _dim_meas);
+                gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &X.matrix, &W.matrix, 1.0, &Z.matrix);
+
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    const double * z = residuals.data() + k * _dim_meas;
+                    double chi_squared = 0.0;
+                    for (auto i = 0u ; i < _dim_meas ; ++i)
+                    {
+                        chi_squared += z[i] * z[i];
+                    }
+                    result[k] -= 0.5 * chi_squared;
+                }
+
+                return result;
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -1088,15 +1347,8 @@ namespace eos
                 return result;
             }
 
-            virtual double evaluate() const
+            double log_pdf(const double & saturation) const
             {
-                double saturation = 0.0;
-
-                for (auto i : ids)
-                {
-                    saturation += cache[i];
-                }
-
                 if (saturation < 0.0)
                 {
                     throw InternalError("Contribution to the uniform bound must be positive; found to be negative!");
@@ -1119,6 +1371,39 @@ namespace eos
                 }
             }
 
+            virtual double evaluate() const
+            {
+                double saturation = 0.0;
+
+                for (auto i : ids)
+                {
+                    saturation += cache[i];
+                }
+
+                return log_pdf(saturation);
+            }
+
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const
+            {
+                const std::size_t n = batch_size(cache, predictions, "UniformBoundBlock");
+                const std::size_t width = cache.size();
+
+                std::vector<double> result(n);
+                for (std::size_t k = 0 ; k < n ; ++k)
+                {
+                    double saturation = 0.0;
+
+                    for (auto i : ids)
+                    {
+                        saturation += predictions[k * width + i];
+                    }
+
+                    result[k] = log_pdf(saturation);
+                }
+
+                return result;
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return 0.0;
@@ -1158,6 +1443,12 @@ namespace eos
     {
     }
 
+    Dual
+    LogLikelihoodBlock::evaluate_dual() const
+    {
+        throw InternalError("LogLikelihoodBlock::evaluate_dual() not implemented for '" + this->as_string() + "'");
+    }
+
     LogLikelihoodBlockPtr
     LogLikelihoodBlock::Gaussian(ObservableCache cache, const ObservablePtr & observable,
             const double & min, const double & central, const double & max,
@@ -1414,6 +1705,55 @@ namespace eos
 
             return result;
         }
+
+        std::vector<double> log_likelihood_batch(const std::vector<double> & predictions) const
+        {
+            if (0 == cache.size())
+                throw InternalError("LogLikelihood::evaluate_batch: the number of samples in the batch is undefined for a likelihood without observables");
+
+            std::vector<double> result(predictions.size() / cache.size(), 0.0);
+
+            // loop over all likelihood blocks
+            for (const auto & constraint : constraints)
+            {
+                for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b)
+                {
+                    const std::vector<double> llh = (*b)->evaluate_batch(predictions);
+                    for (std::size_t k = 0 ; k < result.size() ; ++k)
+                    {
+                        result[k] += llh[k];
+                    }
+                }
+            }
+
+            for (auto & r : result)
+            {
+                if (! std::isfinite(r))
+                    r = -std::numeric_limits<double>::infinity();
+            }
+
+            return result;
+        }
+
+        Dual log_likelihood_dual() const
+        {
+            Dual result(0.0);
+
+            // loop over all likelihood blocks
+            for (const auto & constraint : constraints)
+            {
+                for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b)
+                {
+                    Dual llh = (*b)->evaluate_dual();
+                    if (! std::isfinite(llh.value))
+                        return Dual(-std::numeric_limits<double>::infinity());
+
+                    result += llh;
+                }
+            }
+
+            return result;
+        }
     };
 
     LogLikelihood::LogLikelihood(const Parameters & parameters) :
@@ -1518,4 +1858,18 @@ namespace eos
 
         return _imp->log_likelihood();
     }
+
+    std::vector<double>
+    LogLikelihood::evaluate_batch(const std::vector<double> & predictions) const
+    {
+        return _imp->log_likelihood_batch(predictions);
+    }
+
+    Dual
+    LogLikelihood::evaluate_dual() const
+    {
+        _imp->cache.update_gradients();
+
+        return _imp->log_likelihood_dual();
+    }
 }
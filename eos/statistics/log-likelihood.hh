@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011, 2013, 2014, 2017 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -35,6 +36,7 @@
 #include <gsl/gsl_vector.h>
 
 #include <cmath>
+#include <vector>
 
 namespace eos
 {
@@ -61,6 +63,26 @@ namespace eos
             /// Compute the logarithm of the likelihood for this block.
             virtual double evaluate() const = 0;
 
+            /*!
+             * Compute the logarithm of the likelihood for this block for a batch of
+             * predictions, rather than for the values currently held by the observable cache.
+             *
+             * @param predictions The predictions of all observables in the block's observable cache,
+             *                    stored row-major with one row per sample; the columns follow the
+             *                    ObservableCache::Id of the observables.
+             */
+            virtual std::vector<double> evaluate_batch(const std::vector<double> & predictions) const = 0;
+
+            /*!
+             * Compute the logarithm of the likelihood for this block together with its gradient
+             * with respect to the parameters selected through Parameters::seed_gradient().
+             * The gradients of the predictions are taken from the observable cache, cf.
+             * ObservableCache::update_gradients().
+             *
+             * @note Only the Gaussian and multivariate Gaussian blocks support gradients.
+             */
+            virtual Dual evaluate_dual() const;
+
             /// The number of experimental observations (not observables!) used in this block.
             virtual unsigned number_of_observations() const = 0;
 
@@ -398,6 +420,24 @@ namespace eos
              * @note: all observables are recalculated
              */
             double operator()() const;
+
+            /*!
+             * Evaluate the log likelihood for a batch of predictions, rather than for the values
+             * currently held by the observable cache. Samples for which any block yields a
+             * non-finite value yield -inf.
+             *
+             * @param predictions The predictions of all observables in the observable cache,
+             *                    stored row-major with one row per sample; the columns follow the
+             *                    ObservableCache::Id of the observables.
+             */
+            std::vector<double> evaluate_batch(const std::vector<double> & predictions) const;
+
+            /*!
+             * Evaluate the log likelihood together with its gradient with respect to the parameters
+             * selected through Parameters::seed_gradient().
+             * @note: all observables are recalculated
+             */
+            Dual evaluate_dual() const;
             ///@}
     };
 
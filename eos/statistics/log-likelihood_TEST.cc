@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011, 2013, 2015, 2016 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -88,6 +89,28 @@ namespace eos
                     p["mass::tau"] = 2.28;
 
                     TEST_CHECK_NEARLY_EQUAL(llh(), -10.11630282317536, eps);
+
+                    // batched evaluation over snapshots of the observable cache
+                    ObservableCache cache = llh.observable_cache();
+                    TEST_CHECK_EQUAL(3u, cache.size());
+
+                    std::vector<double> predictions{ cache[0], cache[1], cache[2] };
+                    p["mass::b(MSbar)"] = 4.25;
+                    p["mass::c"] = 1.82;
+                    p["mass::tau"] = 2.0;
+                    const double at_modes = llh();
+                    predictions.insert(predictions.end(), { cache[0], cache[1], cache[2] });
+
+                    const auto batch = llh.evaluate_batch(predictions);
+                    TEST_CHECK_EQUAL(2u, batch.size());
+                    TEST_CHECK_NEARLY_EQUAL(batch[0], -10.11630282317536, eps);
+                    TEST_CHECK_NEARLY_EQUAL(batch[1], at_modes,           eps);
+
+                    // the cache is left untouched
+                    TEST_CHECK_EQUAL(cache[0], 4.25);
+
+                    const std::vector<double> incomplete{ 4.2, 1.5 };
+                    TEST_CHECK_THROWS(InternalError, llh.evaluate_batch(incomplete));
                 }
 
                 // clone test
@@ -313,6 +336,12 @@ namespace eos
                     // away from the mode, pdf falls more rapidly where uncertainty is smaller
                     TEST_CHECK(pdf_max < pdf_min);
 
+                    // batched evaluation
+                    auto batch = log_gamma->evaluate_batch({ central + 0.2, central - 0.2 });
+                    TEST_CHECK_EQUAL(2u, batch.size());
+                    TEST_CHECK_RELATIVE_ERROR(batch[0], pdf_max, eps);
+                    TEST_CHECK_RELATIVE_ERROR(batch[1], pdf_min, eps);
+
                     // construct with known parameters (expect no exception)
                     auto log_gamma_manual = LogLikelihoodBlock::LogGamma(cache, obs, min, central, max, 3.8305604649e-01, 6.8790736808e-02);
                     TEST_CHECK_RELATIVE_ERROR(log_gamma->evaluate(), log_gamma_manual->evaluate(), low_eps);
@@ -459,6 +488,11 @@ namespace eos
                         p["mass::b(MSbar)"] = 3.112559;
                         cache.update();
                         TEST_CHECK_RELATIVE_ERROR(amoroso->evaluate(), std::log(1.332261877086652e-01), 1e-8);
+
+                        // batched evaluation
+                        auto batch = amoroso->evaluate_batch({ 3.112559 });
+                        TEST_CHECK_EQUAL(1u, batch.size());
+                        TEST_CHECK_RELATIVE_ERROR(batch[0], amoroso->evaluate(), eps);
                     }
 
                     // use 2012 LHCblimit on B_s -> mu mu
@@ -543,6 +577,19 @@ namespace eos
                     cache.update();
                     TEST_CHECK_NEARLY_EQUAL(block->evaluate(),-4.597666149, 1e-8);
 
+                    /* batched evaluation */
+                    {
+                        auto batch = block->evaluate_batch({ 4.35, 1.2, 4.6, 1.3, 4.6, 1.3 });
+                        TEST_CHECK_EQUAL(3u, batch.size());
+                        TEST_CHECK_NEARLY_EQUAL(batch[0], 1.30077135, 1e-8);
+                        TEST_CHECK_NEARLY_EQUAL(batch[1], -4.597666149, 1e-8);
+                        TEST_CHECK_NEARLY_EQUAL(batch[2], block->evaluate(), 1e-13);
+
+                        TEST_CHECK(block->evaluate_batch({ }).empty());
+                        const std::vector<double> incomplete{ 4.35, 1.2, 4.6 };
+                        TEST_CHECK_THROWS(InternalError, block->evaluate_batch(incomplete));
+                    }
+
                     /* test sampling */
                     gsl_rng* rng = gsl_rng_alloc(gsl_rng_mt19937);
                     gsl_rng_set(rng, 1243);
@@ -654,6 +701,12 @@ namespace eos
 
                     // ratio of pdfs at mode given by weight ratio
                     TEST_CHECK_RELATIVE_ERROR(pdf_favored, pdf_suppressed + std::log(weights[0] / weights[1]), 1e-12);
+
+                    // batched evaluation; both components share the cache's single observable
+                    auto batch = m->evaluate_batch({ 4.0, -4.0 });
+                    TEST_CHECK_EQUAL(2u, batch.size());
+                    TEST_CHECK_RELATIVE_ERROR(batch[0], pdf_suppressed, eps);
+                    TEST_CHECK_RELATIVE_ERROR(batch[1], pdf_favored,    eps);
                 }
             }
     } log_likelihood_test;
@@ -24,6 +24,12 @@
 #include <eos/utils/log.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
 
 #include <gsl/gsl_cdf.h>
 
@@ -117,6 +123,149 @@ namespace eos
         return log_posterior();
     }
 
+    void
+    LogPosterior::evaluate_batch(const double * points, const std::size_t & n, const std::size_t & dim, double * out) const
+    {
+        if (dim != _parameter_descriptions.size())
+            throw InternalError("LogPosterior::evaluate_batch: dimension of the points (" + stringify(dim) + ") does not match the number of varied parameters (" + stringify(_parameter_descriptions.size()) + ")");
+
+        if (0 == n)
+            return;
+
+        // use one contiguous chunk of points per worker thread
+        const std::size_t workers = std::min<std::size_t>(ThreadPool::instance()->number_of_threads(), n);
+        const std::size_t chunk_size = (n + workers - 1) / workers;
+
+        std::function<void (const std::size_t &)> f = [&](const std::size_t & w) {
+            const std::size_t begin = w * chunk_size;
+            const std::size_t end = std::min(begin + chunk_size, n);
+            if (begin >= end)
+                return;
+
+            // each worker uses an independent log(posterior), including its own Parameters and ObservableCache
+            std::unique_ptr<LogPosterior> clone(private_clone());
+            const auto & descriptions = clone->_parameter_descriptions;
+            ObservableCache cache = clone->_log_likelihood.observable_cache();
+            const std::size_t width = cache.size();
+
+            auto set_parameters = [&] (const std::size_t & i) {
+                const double * point = points + i * dim;
+
+                for (std::size_t j = 0 ; j < dim ; ++j)
+                {
+                    descriptions[j].parameter->set(point[j]);
+                }
+            };
+
+            // evaluate the observables and the prior point by point, and collect the predictions
+            std::vector<double> predictions((end - begin) * width);
+            for (std::size_t i = begin ; i < end ; ++i)
+            {
+                set_parameters(i);
+
+                try
+                {
+                    cache.update();
+                    for (std::size_t k = 0 ; k < width ; ++k)
+                    {
+                        predictions[(i - begin) * width + k] = cache[k];
+                    }
+                    out[i] = clone->log_prior();
+                }
+                catch (eos::Exception & e)
+                {
+                    Log::instance()->message("LogPosterior::evaluate_batch", ll_error)
+                        << "Exception encountered when evaluating the log(posterior) for point #" << i << ": " << e.what();
+                    out[i] = -std::numeric_limits<double>::infinity();
+                }
+            }
+
+            if (0 == width)
+                return;
+
+            // evaluate the likelihood blocks for all points of the chunk at once
+            std::vector<double> llh;
+            try
+            {
+                llh = clone->_log_likelihood.evaluate_batch(predictions);
+            }
+            catch (eos::Exception &)
+            {
+                // some blocks reject unphysical predictions; fall back to point-by-point evaluation
+                // to confine the failure to the affected points
+                for (std::size_t i = begin ; i < end ; ++i)
+                {
+                    if (-std::numeric_limits<double>::infinity() == out[i])
+                        continue;
+
+                    set_parameters(i);
+
+                    try
+                    {
+                        out[i] += clone->_log_likelihood();
+                    }
+                    catch (eos::Exception & e)
+                    {
+                        Log::instance()->message("LogPosterior::evaluate_batch", ll_error)
+                            << "Exception encountered when evaluating the log(posterior) for point #" << i << ": " << e.what();
+                        out[i] = -std::numeric_limits<double>::infinity();
+                    }
+                }
+
+                return;
+            }
+
+            for (std::size_t i = begin ; i < end ; ++i)
+            {
+                out[i] += llh[i - begin];
+            }
+        };
+        ThreadPool::instance()->parallel_for(0, workers, f);
+    }
+
+    double
+    LogPosterior::evaluate_with_gradient(std::vector<double> & gradient) const
+    {
+        if (_priors.empty())
+            throw InternalError("LogPosterior::evaluate_with_gradient(): prior is undefined");
+
+        // Parameters is a handle; the copy shares the values with our own object
+        Parameters parameters(_parameters);
+
+        std::vector<unsigned> ids;
+        for (const auto & d : _parameter_descriptions)
+        {
+            ids.push_back(parameters[d.parameter->name()].id());
+        }
+
+        parameters.seed_gradient(ids);
+
+        Dual result(0.0);
+        try
+        {
+            result = _log_likelihood.evaluate_dual();
+            for (const auto & _prior : _priors)
+            {
+                result += _prior->evaluate_dual();
+            }
+        }
+        catch (...)
+        {
+            parameters.seed_gradient({ });
+            throw;
+        }
+
+        parameters.seed_gradient({ });
+
+        gradient.resize(ids.size());
+        for (unsigned i = 0 ; i < ids.size() ; ++i)
+        {
+            gradient[i] = result.derivative(i);
+        }
+
+        return result.value;
+    }
+
     Density::Iterator
     LogPosterior::begin() const
     {
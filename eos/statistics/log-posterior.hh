@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -66,6 +67,34 @@ namespace eos
 
             virtual double evaluate() const;
 
+            /*!
+             * Evaluate the log(posterior) for a batch of parameter points.
+             *
+             * The points are distributed across the ThreadPool, and each worker
+             * evaluates its share of the points on an independent clone of this
+             * log(posterior). The worker evaluates the observables point by point,
+             * and the likelihood blocks for all of its points at once, cf.
+             * LogLikelihood::evaluate_batch(). Points for which the evaluation fails yield -inf.
+             *
+             * @param points  Row-major array of n points. The components of each point
+             *                follow the order of the varied parameters.
+             * @param n       Number of points.
+             * @param dim     Dimension of each point; must match the number of varied parameters.
+             * @param out     Array of (at least) n elements that receives the values of the log(posterior).
+             */
+            void evaluate_batch(const double * points, const std::size_t & n, const std::size_t & dim, double * out) const;
+
+            /*!
+             * Evaluate the log(posterior) together with its gradient with respect to the varied parameters.
+             *
+             * The gradient is obtained through forward-mode automatic differentiation for all
+             * observables that support it, and through finite differences for all others,
+             * cf. ObservableCache::update_gradients().
+             *
+             * @param gradient  Receives the gradient. The components follow the order of the varied parameters.
+             */
+            double evaluate_with_gradient(std::vector<double> & gradient) const;
+
             virtual Iterator begin() const;
             virtual Iterator end() const;
             ///@}
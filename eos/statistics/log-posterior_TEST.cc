@@ -122,6 +122,47 @@ class LogPosteriorTest :
                 TEST_CHECK_EQUAL(log_posterior.log_prior(), clone->log_prior());
             }
 
+            // batch evaluation
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                const std::vector<double> points{ 4.112, 4.2, 4.3, 4.35, 4.4, 4.5, 4.6, 4.7, 4.8 };
+                std::vector<double> results(points.size(), 0.0);
+
+                log_posterior.evaluate_batch(points.data(), points.size(), 1, results.data());
+
+                auto clone = log_posterior.old_clone();
+                MutablePtr p = (*clone)[0];
+                for (unsigned i = 0 ; i < points.size() ; ++i)
+                {
+                    p->set(points[i]);
+                    TEST_CHECK_RELATIVE_ERROR(results[i], clone->evaluate(), eps);
+                }
+
+                // mismatch of the points' dimension
+                TEST_CHECK_THROWS(InternalError, log_posterior.evaluate_batch(points.data(), 4, 2, results.data()));
+            }
+
+            // gradient
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                MutablePtr p = log_posterior[0];
+                p->set(4.35);
+
+                std::vector<double> gradient;
+                const double value = log_posterior.evaluate_with_gradient(gradient);
+
+                TEST_CHECK_RELATIVE_ERROR(value, log_posterior.evaluate(), eps);
+                TEST_CHECK_EQUAL(gradient.size(), 1u);
+
+                // posterior is Gaussian with central value 4.3 and variance 0.005
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], -(4.35 - 4.3) / 0.005, 1e-6);
+
+                // differentiation is disabled afterwards
+                TEST_CHECK(log_posterior.parameters().gradient_ids().empty());
+            }
+
             // nuisance properties.nuisance())
             {
                 LogPosterior log_posterior = make_log_posterior(false);
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -107,6 +108,11 @@ namespace eos
                     return _value;
                 }
 
+                virtual Dual evaluate_dual() const
+                {
+                    return Dual(_value);
+                }
+
                 virtual LogPriorPtr clone(const Parameters & parameters) const
                 {
                     return LogPriorPtr(new priors::Flat(parameters, _name, _range));
@@ -230,6 +236,16 @@ namespace eos
                     return norm - 0.5 * power_of<2>((x - _central) / sigma);
                 }
 
+                virtual Dual evaluate_dual() const
+                {
+                    const Dual x = _parameters[_name].dual();
+
+                    const double sigma = (x.value < _central) ? _sigma_lower : _sigma_upper;
+                    const double norm  = (x.value < _central) ? _norm_lower  : _norm_upper;
+
+                    return norm - 0.5 * power_of<2>((x - _central) / sigma);
+                }
+
                 virtual LogPriorPtr clone(const Parameters & parameters) const
                 {
                     return LogPriorPtr(new priors::Gauss(parameters, _name, _range, _lower, _central, _upper));
@@ -317,6 +333,16 @@ namespace eos
                     return 1.0 / (2.0 * _ln_lambda * x);
                 }
 
+                virtual Dual evaluate_dual() const
+                {
+                    const Dual x = _parameters[_name].dual();
+
+                    if ((x.value < _min) || (_max < x.value))
+                        return Dual(-std::numeric_limits<double>::infinity());
+
+                    return 1.0 / (2.0 * _ln_lambda * x);
+                }
+
                 virtual LogPriorPtr clone(const Parameters & parameters) const
                 {
                     return LogPriorPtr(new priors::Scale(parameters, _name, _range, _mu_0, _lambda));
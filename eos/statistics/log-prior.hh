@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -90,6 +91,12 @@ namespace eos
              */
             virtual double operator() () const = 0;
 
+            /*!
+             * Evaluate the natural logarithm of the prior together with its gradient
+             * with respect to the parameters selected through Parameters::seed_gradient().
+             */
+            virtual Dual evaluate_dual() const = 0;
+
             /*!
              * Evaluate the inverse cumulative density function of the prior.
              *
@@ -0,0 +1,470 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/markov-chain-sampler.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+namespace eos
+{
+    namespace impl
+    {
+        /*
+         * A single adaptive Markov chain. The chain operates on the varied parameters
+         * rescaled to the interval [-1, +1], and uses its own clone of the log(posterior).
+         */
+        struct AdaptiveMarkovChain
+        {
+            // parameters of the adaptation, as used by Analysis.sample
+            static constexpr double scale_factor_multiplier = 1.5;
+            static constexpr double scale_factor_min = 1.0e-4;
+            static constexpr double scale_factor_max = 1.0e+2;
+            static constexpr double acceptance_min = 0.15;
+            static constexpr double acceptance_max = 0.35;
+            static constexpr double damping = 0.5;
+
+            LogPosteriorPtr log_posterior;
+
+            std::vector<ParameterDescription> descriptions;
+
+            unsigned dim;
+
+            std::shared_ptr<gsl_rng> rng;
+
+            // current point and its log(posterior)
+            std::vector<double> current;
+            double current_value;
+
+            // covariance of the proposal, before scaling, and the Cholesky factor of the scaled covariance
+            std::vector<double> unscaled_covariance;
+            std::vector<double> cholesky;
+            double scale_factor;
+
+            unsigned adaptations;
+
+            // scratch space for the proposal
+            std::vector<double> proposal;
+            std::vector<double> z;
+
+            AdaptiveMarkovChain(const LogPosterior & log_posterior, const double & covariance_scale, const unsigned long & seed) :
+                log_posterior(log_posterior.old_clone()),
+                descriptions(this->log_posterior->parameter_descriptions()),
+                dim(descriptions.size()),
+                rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free),
+                current(dim, 0.0),
+                current_value(-std::numeric_limits<double>::infinity()),
+                unscaled_covariance(dim * dim, 0.0),
+                cholesky(dim * dim, 0.0),
+                scale_factor(2.38 * 2.38 / dim),
+                adaptations(1),
+                proposal(dim, 0.0),
+                z(dim, 0.0)
+            {
+                gsl_rng_set(rng.get(), seed);
+
+                // each rescaled parameter is assumed to be uniformly distributed on [-1, +1], with variance 1/3
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    unscaled_covariance[i * dim + i] = 1.0 / 3.0 * covariance_scale;
+                }
+
+                // the initial proposal is not scaled
+                decompose(unscaled_covariance);
+            }
+
+            double to_parameter(const unsigned & i, const double & x) const
+            {
+                return (descriptions[i].max - descriptions[i].min) * x / 2.0 + (descriptions[i].max + descriptions[i].min) / 2.0;
+            }
+
+            double from_parameter(const unsigned & i, const double & p) const
+            {
+                return (2.0 * p - descriptions[i].max - descriptions[i].min) / (descriptions[i].max - descriptions[i].min);
+            }
+
+            double evaluate(const std::vector<double> & x)
+            {
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    if ((x[i] < -1.0) || (x[i] > +1.0))
+                        return -std::numeric_limits<double>::infinity();
+                }
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    descriptions[i].parameter->set(to_parameter(i, x[i]));
+                }
+
+                try
+                {
+                    return log_posterior->log_posterior();
+                }
+                catch (eos::Exception & e)
+                {
+                    Log::instance()->message("MarkovChainSampler", ll_error)
+                        << "Exception encountered when evaluating the log(posterior): " << e.what();
+                }
+
+                return -std::numeric_limits<double>::infinity();
+            }
+
+            void start(const std::vector<double> & x)
+            {
+                current = x;
+                current_value = evaluate(current);
+            }
+
+            void start_randomly()
+            {
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    current[i] = gsl_ran_flat(rng.get(), -1.0, +1.0);
+                }
+                current_value = evaluate(current);
+            }
+
+            // compute the Cholesky factor of the proposal's covariance; returns false if it is not positive definite
+            bool decompose(const std::vector<double> & covariance)
+            {
+                std::vector<double> l(dim * dim, 0.0);
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        double sum = covariance[i * dim + j];
+                        for (unsigned k = 0 ; k < j ; ++k)
+                        {
+                            sum -= l[i * dim + k] * l[j * dim + k];
+                        }
+
+                        if (i == j)
+                        {
+                            if (! (sum > 0.0))
+                                return false;
+
+                            l[i * dim + i] = std::sqrt(sum);
+                        }
+                        else
+                        {
+                            l[i * dim + j] = sum / l[j * dim + j];
+                        }
+                    }
+                }
+
+                cholesky.swap(l);
+
+                return true;
+            }
+
+            // perform one Metropolis step; returns true if the proposal was accepted
+            bool step()
+            {
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    z[i] = gsl_ran_ugaussian(rng.get());
+                }
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    double delta = 0.0;
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        delta += cholesky[i * dim + j] * z[j];
+                    }
+                    proposal[i] = current[i] + delta;
+                }
+
+                const double proposal_value = evaluate(proposal);
+
+                if (-std::numeric_limits<double>::infinity() == proposal_value)
+                    return false;
+
+                if ((proposal_value < current_value) && (std::log(gsl_rng_uniform_pos(rng.get())) > proposal_value - current_value))
+                    return false;
+
+                current.swap(proposal);
+                current_value = proposal_value;
+
+                return true;
+            }
+
+            // adapt the proposal to the points of the last prerun
+            void adapt(const std::vector<double> & points, const unsigned & accepted)
+            {
+                const unsigned n = points.size() / dim;
+                if (n < 2)
+                    return;
+
+                std::vector<double> mean(dim, 0.0);
+                for (unsigned k = 0 ; k < n ; ++k)
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        mean[i] += points[k * dim + i] / n;
+                    }
+                }
+
+                const double damping_factor = 1.0 / std::pow(adaptations, damping);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j < dim ; ++j)
+                    {
+                        double covariance = 0.0;
+                        for (unsigned k = 0 ; k < n ; ++k)
+                        {
+                            covariance += (points[k * dim + i] - mean[i]) * (points[k * dim + j] - mean[j]);
+                        }
+                        covariance /= (n - 1);
+
+                        unscaled_covariance[i * dim + j] = (1.0 - damping_factor) * unscaled_covariance[i * dim + j] + damping_factor * covariance;
+                    }
+                }
+
+                const double acceptance_rate = double(accepted) / n;
+                if (acceptance_rate > acceptance_max)
+                {
+                    scale_factor = std::min(scale_factor * scale_factor_multiplier, scale_factor_max);
+                }
+                else if (acceptance_rate < acceptance_min)
+                {
+                    scale_factor = std::max(scale_factor / scale_factor_multiplier, scale_factor_min);
+                }
+
+                ++adaptations;
+
+                std::vector<double> scaled_covariance(unscaled_covariance);
+                for (auto & c : scaled_covariance)
+                {
+                    c *= scale_factor;
+                }
+
+                if (! decompose(scaled_covariance))
+                {
+                    Log::instance()->message("MarkovChainSampler", ll_warning)
+                        << "Adapted covariance is not positive definite; keeping the previous proposal";
+                }
+            }
+        };
+    }
+
+    MarkovChainSampler::Config::Config() :
+        number_of_chains(1, std::numeric_limits<unsigned>::max(), 4),
+        samples(1, std::numeric_limits<unsigned>::max(), 1000),
+        stride(1, std::numeric_limits<unsigned>::max(), 5),
+        prerun_samples(2, std::numeric_limits<unsigned>::max(), 150),
+        number_of_preruns(0, std::numeric_limits<unsigned>::max(), 3),
+        covariance_scale(0.0, std::numeric_limits<double>::max(), 0.1),
+        seed(0)
+    {
+    }
+
+    template <>
+    struct Implementation<MarkovChainSampler>
+    {
+        MarkovChainSampler::Config config;
+
+        unsigned dim;
+
+        std::vector<impl::AdaptiveMarkovChain> chains;
+
+        std::vector<std::vector<double>> start_points;
+
+        std::vector<double> samples;
+
+        std::vector<double> log_posterior_values;
+
+        std::vector<double> acceptance_rates;
+
+        Implementation(const LogPosterior & log_posterior, const MarkovChainSampler::Config & config) :
+            config(config),
+            dim(log_posterior.parameter_descriptions().size()),
+            start_points(config.number_of_chains)
+        {
+            if (0 == dim)
+                throw InternalError("MarkovChainSampler: the log(posterior) has no varied parameters");
+
+            if (! (config.covariance_scale > 0.0))
+                throw InternalError("MarkovChainSampler: the scale of the initial covariance must be positive");
+
+            // create the clones sequentially, before running the chains concurrently
+            chains.reserve(config.number_of_chains);
+            for (unsigned c = 0 ; c < config.number_of_chains ; ++c)
+            {
+                chains.emplace_back(log_posterior, config.covariance_scale, config.seed + c);
+            }
+        }
+
+        void set_start_point(const unsigned & chain, const std::vector<double> & point)
+        {
+            if (chain >= chains.size())
+                throw InternalError("MarkovChainSampler: chain index " + stringify(chain) + " is out of range");
+
+            if (point.size() != dim)
+                throw InternalError("MarkovChainSampler: dimension of the start point (" + stringify(point.size())
+                        + ") does not match the number of varied parameters (" + stringify(dim) + ")");
+
+            std::vector<double> x(dim);
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                x[i] = chains[chain].from_parameter(i, point[i]);
+
+                if ((x[i] < -1.0) || (x[i] > +1.0))
+                    throw InternalError("MarkovChainSampler: start point is outside the range of parameter '"
+                            + chains[chain].descriptions[i].parameter->name() + "'");
+            }
+
+            start_points[chain] = x;
+        }
+
+        void run_chain(const unsigned & c)
+        {
+            auto & chain = chains[c];
+
+            if (start_points[c].empty())
+            {
+                chain.start_randomly();
+            }
+            else
+            {
+                chain.start(start_points[c]);
+            }
+
+            // preruns, each followed by an adaptation of the proposal
+            std::vector<double> points(config.prerun_samples * dim);
+            for (unsigned r = 0 ; r < config.number_of_preruns ; ++r)
+            {
+                unsigned accepted = 0;
+                for (unsigned k = 0 ; k < config.prerun_samples ; ++k)
+                {
+                    accepted += chain.step();
+                    std::copy(chain.current.cbegin(), chain.current.cend(), points.begin() + k * dim);
+                }
+
+                Log::instance()->message("MarkovChainSampler", ll_informational)
+                    << "Chain " << c << ", prerun " << r << ": acceptance rate is " << 100.0 * accepted / config.prerun_samples << "%";
+
+                chain.adapt(points, accepted);
+            }
+
+            // main run, keeping every stride-th point
+            const unsigned n = config.samples;
+            double * samples = this->samples.data() + std::size_t(c) * n * dim;
+            double * values = this->log_posterior_values.data() + std::size_t(c) * n;
+            unsigned accepted = 0;
+            for (unsigned k = 0 ; k < n * config.stride ; ++k)
+            {
+                accepted += chain.step();
+
+                if (0 != k % config.stride)
+                    continue;
+
+                const unsigned s = k / config.stride;
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    samples[s * dim + i] = chain.to_parameter(i, chain.current[i]);
+                }
+                values[s] = chain.current_value;
+            }
+
+            acceptance_rates[c] = double(accepted) / (n * config.stride);
+
+            Log::instance()->message("MarkovChainSampler", ll_informational)
+                << "Chain " << c << ", main run: acceptance rate is " << 100.0 * acceptance_rates[c] << "%";
+        }
+
+        void run()
+        {
+            const unsigned n = config.samples;
+            samples.assign(chains.size() * n * dim, 0.0);
+            log_posterior_values.assign(chains.size() * n, 0.0);
+            acceptance_rates.assign(chains.size(), 0.0);
+
+            ThreadPool::instance()->parallel_for(0, chains.size(), [this](const std::size_t & c) { run_chain(c); });
+        }
+    };
+
+    MarkovChainSampler::MarkovChainSampler(const LogPosterior & log_posterior, const Config & config) :
+        PrivateImplementationPattern<MarkovChainSampler>(new Implementation<MarkovChainSampler>(log_posterior, config))
+    {
+    }
+
+    MarkovChainSampler::~MarkovChainSampler()
+    {
+    }
+
+    void
+    MarkovChainSampler::set_start_point(const unsigned & chain, const std::vector<double> & point)
+    {
+        _imp->set_start_point(chain, point);
+    }
+
+    void
+    MarkovChainSampler::run()
+    {
+        _imp->run();
+    }
+
+    unsigned
+    MarkovChainSampler::number_of_chains() const
+    {
+        return _imp->chains.size();
+    }
+
+    unsigned
+    MarkovChainSampler::number_of_samples() const
+    {
+        return _imp->config.samples;
+    }
+
+    unsigned
+    MarkovChainSampler::dimension() const
+    {
+        return _imp->dim;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::samples() const
+    {
+        return _imp->samples;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::log_posterior_values() const
+    {
+        return _imp->log_posterior_values;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::acceptance_rates() const
+    {
+        return _imp->acceptance_rates;
+    }
+}
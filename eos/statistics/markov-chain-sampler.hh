@@ -0,0 +1,125 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_MARKOV_CHAIN_SAMPLER_HH
+#define EOS_GUARD_EOS_STATISTICS_MARKOV_CHAIN_SAMPLER_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Samples a LogPosterior with several independent adaptive Markov chains.
+     *
+     * Each chain runs on its own clone of the log(posterior), and the chains are
+     * distributed across the ThreadPool. The chains use a local Gaussian proposal,
+     * whose covariance is adapted after each prerun, following the adaptive
+     * Metropolis algorithm as used by Analysis.sample. The samples of the preruns
+     * are discarded.
+     */
+    class MarkovChainSampler :
+        public PrivateImplementationPattern<MarkovChainSampler>
+    {
+        public:
+            struct Config
+            {
+                /// Number of independent chains.
+                VerifiedRange<unsigned> number_of_chains;
+
+                /// Number of samples that each chain returns.
+                VerifiedRange<unsigned> samples;
+
+                /// Number of steps between two returned samples.
+                VerifiedRange<unsigned> stride;
+
+                /// Number of steps in each prerun.
+                VerifiedRange<unsigned> prerun_samples;
+
+                /// Number of preruns, each followed by an adaptation of the proposal.
+                VerifiedRange<unsigned> number_of_preruns;
+
+                /// Scale factor for the initial covariance of the proposal.
+                VerifiedRange<double> covariance_scale;
+
+                /// Seed for the random number generators; chain i uses seed + i.
+                unsigned long seed;
+
+                /// Constructor, using the same defaults as Analysis.sample.
+                Config();
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior  The log(posterior) that shall be sampled.
+             * @param config         The configuration of the chains.
+             */
+            MarkovChainSampler(const LogPosterior & log_posterior, const Config & config);
+
+            /// Destructor.
+            ~MarkovChainSampler();
+            ///@}
+
+            ///@name Sampling
+            ///@{
+            /*!
+             * Set the starting point of one chain.
+             *
+             * Chains without an explicit starting point start from a point drawn
+             * uniformly from the ranges of the varied parameters.
+             *
+             * @param chain  The index of the chain.
+             * @param point  The starting point, in the order of the varied parameters.
+             */
+            void set_start_point(const unsigned & chain, const std::vector<double> & point);
+
+            /// Run the preruns and the main run of all chains.
+            void run();
+            ///@}
+
+            ///@name Accessors
+            ///@{
+            /// Retrieve the number of chains.
+            unsigned number_of_chains() const;
+
+            /// Retrieve the number of samples per chain.
+            unsigned number_of_samples() const;
+
+            /// Retrieve the number of varied parameters.
+            unsigned dimension() const;
+
+            /// Retrieve the samples as a row-major array of shape (chains, samples, dimension).
+            const std::vector<double> & samples() const;
+
+            /// Retrieve the values of the log(posterior) for each sample as a row-major array of shape (chains, samples).
+            const std::vector<double> & log_posterior_values() const;
+
+            /// Retrieve the acceptance rate of each chain in its main run.
+            const std::vector<double> & acceptance_rates() const;
+            ///@}
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/markov-chain-sampler.hh>
+#include <eos/maths/power-of.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class MarkovChainSamplerTest :
+    public TestCase
+{
+    public:
+        MarkovChainSamplerTest() :
+            TestCase("markov_chain_sampler_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // sample a one-dimensional Gaussian posterior with mean 4.3 and standard deviation 0.0707
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                MarkovChainSampler::Config config;
+                config.number_of_chains = 4;
+                config.samples = 5000;
+                config.stride = 5;
+                config.seed = 1234;
+
+                MarkovChainSampler sampler(log_posterior, config);
+                sampler.set_start_point(0, { 4.3 });
+                sampler.run();
+
+                TEST_CHECK_EQUAL(sampler.number_of_chains(), 4u);
+                TEST_CHECK_EQUAL(sampler.number_of_samples(), 5000u);
+                TEST_CHECK_EQUAL(sampler.dimension(), 1u);
+
+                const auto & samples = sampler.samples();
+                const auto & values = sampler.log_posterior_values();
+                TEST_CHECK_EQUAL(samples.size(), 4u * 5000u);
+                TEST_CHECK_EQUAL(values.size(), 4u * 5000u);
+
+                for (unsigned c = 0 ; c < 4 ; ++c)
+                {
+                    double mean = 0.0, variance = 0.0;
+                    for (unsigned k = 0 ; k < 5000 ; ++k)
+                    {
+                        mean += samples[c * 5000 + k] / 5000;
+                    }
+                    for (unsigned k = 0 ; k < 5000 ; ++k)
+                    {
+                        variance += power_of<2>(samples[c * 5000 + k] - mean) / 4999;
+                    }
+
+                    TEST_CHECK_NEARLY_EQUAL(mean,                4.3,                  0.01);
+                    TEST_CHECK_NEARLY_EQUAL(std::sqrt(variance), 0.070710678118654752, 0.01);
+
+                    TEST_CHECK(sampler.acceptance_rates()[c] > 0.1);
+                    TEST_CHECK(sampler.acceptance_rates()[c] < 0.9);
+                }
+
+                // the stored values of the log(posterior) belong to the stored samples
+                for (unsigned k : { 0u, 1234u, 19999u })
+                {
+                    log_posterior.parameter_descriptions()[0].parameter->set(samples[k]);
+                    TEST_CHECK_NEARLY_EQUAL(values[k], log_posterior.log_posterior(), 1.0e-10);
+                }
+
+                // chains are reproducible for a fixed seed, irrespective of the threads they ran on
+                MarkovChainSampler other(log_posterior, config);
+                other.set_start_point(0, { 4.3 });
+                other.run();
+                TEST_CHECK(samples == other.samples());
+            }
+
+            // invalid start points
+            {
+                LogPosterior log_posterior = make_log_posterior(true);
+
+                MarkovChainSampler sampler(log_posterior, MarkovChainSampler::Config());
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(0, { 5.0 }));
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(0, { 4.0, 4.0 }));
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(4, { 4.0 }));
+            }
+        }
+} markov_chain_sampler_test;
@@ -0,0 +1,777 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/no-u-turn-sampler.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+namespace eos
+{
+    namespace impl
+    {
+        /*
+         * A point in phase space, together with the log(posterior) and its gradient at its position.
+         */
+        struct PhaseSpacePoint
+        {
+            std::vector<double> position;
+            std::vector<double> momentum;
+            std::vector<double> gradient;
+            double log_posterior;
+        };
+
+        /*
+         * A balanced binary tree of leapfrog steps, cf. [HG:2014A], algorithm 6.
+         */
+        struct Trajectory
+        {
+            PhaseSpacePoint minus, plus, proposal;
+
+            // number of points within the slice
+            double n;
+
+            // false once the trajectory made a U-turn or diverged
+            bool valid;
+
+            bool divergent;
+
+            // sum and number of the acceptance probabilities, used for the adaptation of the step size
+            double alpha;
+            unsigned n_alpha;
+        };
+
+        /*
+         * Adaptation of the step size through dual averaging, cf. [HG:2014A], algorithm 5.
+         */
+        struct DualAveraging
+        {
+            static constexpr double gamma = 0.05;
+            static constexpr double t0 = 10.0;
+            static constexpr double kappa = 0.75;
+
+            const double delta;
+
+            double mu, h_bar, log_step_size, log_step_size_bar;
+
+            unsigned m;
+
+            DualAveraging(const double & delta) :
+                delta(delta)
+            {
+                restart(1.0);
+            }
+
+            void restart(const double & step_size)
+            {
+                mu = std::log(10.0 * step_size);
+                h_bar = 0.0;
+                log_step_size = std::log(step_size);
+                log_step_size_bar = 0.0;
+                m = 0;
+            }
+
+            void update(const double & acceptance)
+            {
+                ++m;
+
+                const double eta = 1.0 / (m + t0);
+                h_bar = (1.0 - eta) * h_bar + eta * (delta - acceptance);
+                log_step_size = mu - std::sqrt(double(m)) / gamma * h_bar;
+
+                const double w = std::pow(double(m), -kappa);
+                log_step_size_bar = w * log_step_size + (1.0 - w) * log_step_size_bar;
+            }
+        };
+
+        /*
+         * A single chain of the No-U-Turn Sampler. The chain operates on the varied parameters
+         * rescaled to the interval [-1, +1], and uses its own clone of the log(posterior).
+         */
+        struct NoUTurnChain
+        {
+            // trajectories whose energy error exceeds this value are considered divergent
+            static constexpr double maximum_energy_error = 1000.0;
+
+            LogPosteriorPtr log_posterior;
+
+            std::vector<ParameterDescription> descriptions;
+
+            unsigned dim;
+
+            const unsigned maximum_tree_depth;
+
+            std::shared_ptr<gsl_rng> rng;
+
+            PhaseSpacePoint current;
+
+            double step_size;
+
+            DualAveraging adaptation;
+
+            // inverse mass matrix, i.e. the estimated covariance of the rescaled parameters, and its Cholesky factor
+            std::vector<double> inverse_metric;
+            std::vector<double> cholesky;
+
+            unsigned divergences;
+
+            // scratch space
+            std::vector<double> gradient;
+            std::vector<double> velocity;
+
+            NoUTurnChain(const LogPosterior & log_posterior, const NoUTurnSampler::Config & config, const unsigned long & seed) :
+                log_posterior(log_posterior.old_clone()),
+                descriptions(this->log_posterior->parameter_descriptions()),
+                dim(descriptions.size()),
+                maximum_tree_depth(config.maximum_tree_depth),
+                rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free),
+                step_size(1.0),
+                adaptation(config.target_acceptance),
+                inverse_metric(dim * dim, 0.0),
+                cholesky(dim * dim, 0.0),
+                divergences(0),
+                velocity(dim, 0.0)
+            {
+                gsl_rng_set(rng.get(), seed);
+
+                // start from a unit metric
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    inverse_metric[i * dim + i] = 1.0;
+                    cholesky[i * dim + i] = 1.0;
+                }
+
+                current.position.assign(dim, 0.0);
+                current.momentum.assign(dim, 0.0);
+                current.gradient.assign(dim, 0.0);
+                current.log_posterior = -std::numeric_limits<double>::infinity();
+            }
+
+            double to_parameter(const unsigned & i, const double & x) const
+            {
+                return (descriptions[i].max - descriptions[i].min) * x / 2.0 + (descriptions[i].max + descriptions[i].min) / 2.0;
+            }
+
+            double from_parameter(const unsigned & i, const double & p) const
+            {
+                return (2.0 * p - descriptions[i].max - descriptions[i].min) / (descriptions[i].max - descriptions[i].min);
+            }
+
+            // evaluate the log(posterior) and its gradient with respect to the rescaled parameters
+            void evaluate(PhaseSpacePoint & point)
+            {
+                point.log_posterior = -std::numeric_limits<double>::infinity();
+                point.gradient.assign(dim, 0.0);
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    if ((point.position[i] < -1.0) || (point.position[i] > +1.0))
+                        return;
+                }
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    descriptions[i].parameter->set(to_parameter(i, point.position[i]));
+                }
+
+                try
+                {
+                    const double value = log_posterior->evaluate_with_gradient(gradient);
+
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        if (! std::isfinite(gradient[i]))
+                            return;
+                    }
+
+                    // chain rule for the rescaling to [-1, +1]
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        point.gradient[i] = gradient[i] * (descriptions[i].max - descriptions[i].min) / 2.0;
+                    }
+                    point.log_posterior = value;
+                }
+                catch (eos::Exception & e)
+                {
+                    Log::instance()->message("NoUTurnSampler", ll_error)
+                        << "Exception encountered when evaluating the log(posterior): " << e.what();
+                }
+            }
+
+            // velocity <- M^-1 momentum
+            void update_velocity(const std::vector<double> & momentum)
+            {
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    double v = 0.0;
+                    for (unsigned j = 0 ; j < dim ; ++j)
+                    {
+                        v += inverse_metric[i * dim + j] * momentum[j];
+                    }
+                    velocity[i] = v;
+                }
+            }
+
+            double kinetic_energy(const std::vector<double> & momentum)
+            {
+                update_velocity(momentum);
+
+                double result = 0.0;
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    result += momentum[i] * velocity[i];
+                }
+
+                return 0.5 * result;
+            }
+
+            // the logarithm of the joint density of position and momentum, i.e., the negative Hamiltonian
+            double joint(const PhaseSpacePoint & point)
+            {
+                if (-std::numeric_limits<double>::infinity() == point.log_posterior)
+                    return -std::numeric_limits<double>::infinity();
+
+                return point.log_posterior - kinetic_energy(point.momentum);
+            }
+
+            // draw the momentum from N(0, M), with M^-1 = L L^T, as L^-T z
+            void draw_momentum(std::vector<double> & momentum)
+            {
+                momentum.resize(dim);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    momentum[i] = gsl_ran_ugaussian(rng.get());
+                }
+
+                for (unsigned i = dim ; i-- > 0 ; )
+                {
+                    double sum = momentum[i];
+                    for (unsigned j = i + 1 ; j < dim ; ++j)
+                    {
+                        sum -= cholesky[j * dim + i] * momentum[j];
+                    }
+                    momentum[i] = sum / cholesky[i * dim + i];
+                }
+            }
+
+            PhaseSpacePoint leapfrog(const PhaseSpacePoint & start, const double & epsilon)
+            {
+                PhaseSpacePoint result(start);
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    result.momentum[i] += 0.5 * epsilon * start.gradient[i];
+                }
+
+                update_velocity(result.momentum);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    result.position[i] += epsilon * velocity[i];
+                }
+
+                evaluate(result);
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    result.momentum[i] += 0.5 * epsilon * result.gradient[i];
+                }
+
+                return result;
+            }
+
+            // true as long as the trajectory between both ends does not make a U-turn
+            bool no_u_turn(const PhaseSpacePoint & minus, const PhaseSpacePoint & plus)
+            {
+                double projection_minus = 0.0, projection_plus = 0.0;
+
+                update_velocity(minus.momentum);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    projection_minus += (plus.position[i] - minus.position[i]) * velocity[i];
+                }
+
+                update_velocity(plus.momentum);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    projection_plus += (plus.position[i] - minus.position[i]) * velocity[i];
+                }
+
+                return (projection_minus >= 0.0) && (projection_plus >= 0.0);
+            }
+
+            Trajectory build_tree(const PhaseSpacePoint & start, const double & log_u, const int & direction, const unsigned & depth, const double & joint_0)
+            {
+                if (0 == depth)
+                {
+                    PhaseSpacePoint point = leapfrog(start, direction * step_size);
+                    const double joint_1 = joint(point);
+
+                    const bool divergent = ! (log_u < maximum_energy_error + joint_1);
+                    const double alpha = std::isfinite(joint_1) ? std::min(1.0, std::exp(joint_1 - joint_0)) : 0.0;
+
+                    return Trajectory{ point, point, point, (log_u <= joint_1) ? 1.0 : 0.0, ! divergent, divergent, alpha, 1 };
+                }
+
+                Trajectory result = build_tree(start, log_u, direction, depth - 1, joint_0);
+                if (! result.valid)
+                    return result;
+
+                Trajectory other = build_tree((direction < 0) ? result.minus : result.plus, log_u, direction, depth - 1, joint_0);
+                if (direction < 0)
+                {
+                    result.minus = std::move(other.minus);
+                }
+                else
+                {
+                    result.plus = std::move(other.plus);
+                }
+
+                if ((other.n > 0.0) && (gsl_rng_uniform(rng.get()) < other.n / (result.n + other.n)))
+                {
+                    result.proposal = std::move(other.proposal);
+                }
+
+                result.n += other.n;
+                result.alpha += other.alpha;
+                result.n_alpha += other.n_alpha;
+                result.divergent = result.divergent || other.divergent;
+                result.valid = other.valid && no_u_turn(result.minus, result.plus);
+
+                return result;
+            }
+
+            // perform one NUTS transition; returns the average acceptance probability of the trajectory
+            double step()
+            {
+                draw_momentum(current.momentum);
+
+                const double joint_0 = joint(current);
+                const double log_u = joint_0 + std::log(gsl_rng_uniform_pos(rng.get()));
+
+                PhaseSpacePoint minus(current), plus(current);
+                PhaseSpacePoint proposal(current);
+                double n = 1.0, alpha = 0.0;
+                unsigned n_alpha = 0;
+                bool divergent = false;
+
+                for (unsigned depth = 0 ; depth < maximum_tree_depth ; ++depth)
+                {
+                    const int direction = (gsl_rng_uniform(rng.get()) < 0.5) ? -1 : +1;
+
+                    Trajectory tree = build_tree((direction < 0) ? minus : plus, log_u, direction, depth, joint_0);
+                    if (direction < 0)
+                    {
+                        minus = std::move(tree.minus);
+                    }
+                    else
+                    {
+                        plus = std::move(tree.plus);
+                    }
+
+                    alpha += tree.alpha;
+                    n_alpha += tree.n_alpha;
+                    divergent = divergent || tree.divergent;
+
+                    if (! tree.valid)
+                        break;
+
+                    if (gsl_rng_uniform(rng.get()) < tree.n / n)
+                    {
+                        proposal = std::move(tree.proposal);
+                    }
+
+                    n += tree.n;
+
+                    if (! no_u_turn(minus, plus))
+                        break;
+                }
+
+                current = std::move(proposal);
+                divergences += divergent;
+
+                return (n_alpha > 0) ? alpha / n_alpha : 0.0;
+            }
+
+            // find a step size for which a single leapfrog step has an acceptance probability of about 1/2, cf. [HG:2014A], algorithm 4
+            void initialize_step_size()
+            {
+                static const unsigned maximum_iterations = 100;
+
+                step_size = 1.0;
+
+                draw_momentum(current.momentum);
+                const double joint_0 = joint(current);
+
+                double delta = joint(leapfrog(current, step_size)) - joint_0;
+                const double a = (delta > std::log(0.5)) ? +1.0 : -1.0;
+                for (unsigned i = 0 ; (i < maximum_iterations) && (a * delta > -a * std::log(2.0)) ; ++i)
+                {
+                    step_size *= std::pow(2.0, a);
+                    delta = joint(leapfrog(current, step_size)) - joint_0;
+                }
+
+                adaptation.restart(step_size);
+            }
+
+            void start(const std::vector<double> & x)
+            {
+                current.position = x;
+                evaluate(current);
+            }
+
+            void start_randomly()
+            {
+                // avoid starting outside of the support of the log(posterior)
+                static const unsigned maximum_attempts = 100;
+
+                for (unsigned attempt = 0 ; attempt < maximum_attempts ; ++attempt)
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        current.position[i] = gsl_ran_flat(rng.get(), -1.0, +1.0);
+                    }
+                    evaluate(current);
+
+                    if (std::isfinite(current.log_posterior))
+                        return;
+                }
+            }
+
+            // estimate the inverse mass matrix from the points of the warmup, regularized towards a small multiple of the unit matrix
+            void adapt_metric(const std::vector<double> & points, const bool & dense)
+            {
+                const unsigned n = points.size() / dim;
+                if (n < 2)
+                    return;
+
+                std::vector<double> mean(dim, 0.0);
+                for (unsigned k = 0 ; k < n ; ++k)
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        mean[i] += points[k * dim + i] / n;
+                    }
+                }
+
+                std::vector<double> covariance(dim * dim, 0.0);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        if ((i != j) && (! dense))
+                            continue;
+
+                        double c = 0.0;
+                        for (unsigned k = 0 ; k < n ; ++k)
+                        {
+                            c += (points[k * dim + i] - mean[i]) * (points[k * dim + j] - mean[j]);
+                        }
+                        c = c / (n - 1) * n / (n + 5.0);
+
+                        covariance[i * dim + j] = c;
+                        covariance[j * dim + i] = c;
+                    }
+
+                    covariance[i * dim + i] += 1.0e-3 * 5.0 / (n + 5.0);
+                }
+
+                std::vector<double> l(dim * dim, 0.0);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        double sum = covariance[i * dim + j];
+                        for (unsigned k = 0 ; k < j ; ++k)
+                        {
+                            sum -= l[i * dim + k] * l[j * dim + k];
+                        }
+
+                        if (i == j)
+                        {
+                            if (! (sum > 0.0))
+                            {
+                                Log::instance()->message("NoUTurnSampler", ll_warning)
+                                    << "Estimated covariance is not positive definite; keeping the previous mass matrix";
+                                return;
+                            }
+
+                            l[i * dim + i] = std::sqrt(sum);
+                        }
+                        else
+                        {
+                            l[i * dim + j] = sum / l[j * dim + j];
+                        }
+                    }
+                }
+
+                inverse_metric.swap(covariance);
+                cholesky.swap(l);
+            }
+        };
+    }
+
+    NoUTurnSampler::Config::Config() :
+        number_of_chains(1, std::numeric_limits<unsigned>::max(), 4),
+        samples(1, std::numeric_limits<unsigned>::max(), 1000),
+        warmup_samples(0, std::numeric_limits<unsigned>::max(), 500),
+        target_acceptance(0.0, 1.0, 0.8),
+        maximum_tree_depth(1, 30, 10),
+        dense_mass_matrix(false),
+        seed(0)
+    {
+    }
+
+    template <>
+    struct Implementation<NoUTurnSampler>
+    {
+        NoUTurnSampler::Config config;
+
+        unsigned dim;
+
+        std::vector<impl::NoUTurnChain> chains;
+
+        std::vector<std::vector<double>> start_points;
+
+        std::vector<double> samples;
+
+        std::vector<double> log_posterior_values;
+
+        std::vector<double> acceptance_rates;
+
+        std::vector<double> step_sizes;
+
+        std::vector<unsigned> divergences;
+
+        Implementation(const LogPosterior & log_posterior, const NoUTurnSampler::Config & config) :
+            config(config),
+            dim(log_posterior.parameter_descriptions().size()),
+            start_points(config.number_of_chains)
+        {
+            if (0 == dim)
+                throw InternalError("NoUTurnSampler: the log(posterior) has no varied parameters");
+
+            if (! (config.target_acceptance > 0.0) || ! (config.target_acceptance < 1.0))
+                throw InternalError("NoUTurnSampler: the target acceptance must lie between 0 and 1");
+
+            // create the clones sequentially, before running the chains concurrently
+            chains.reserve(config.number_of_chains);
+            for (unsigned c = 0 ; c < config.number_of_chains ; ++c)
+            {
+                chains.emplace_back(log_posterior, config, config.seed + c);
+            }
+        }
+
+        void set_start_point(const unsigned & chain, const std::vector<double> & point)
+        {
+            if (chain >= chains.size())
+                throw InternalError("NoUTurnSampler: chain index " + stringify(chain) + " is out of range");
+
+            if (point.size() != dim)
+                throw InternalError("NoUTurnSampler: dimension of the start point (" + stringify(point.size())
+                        + ") does not match the number of varied parameters (" + stringify(dim) + ")");
+
+            std::vector<double> x(dim);
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                x[i] = chains[chain].from_parameter(i, point[i]);
+
+                if ((x[i] < -1.0) || (x[i] > +1.0))
+                    throw InternalError("NoUTurnSampler: start point is outside the range of parameter '"
+                            + chains[chain].descriptions[i].parameter->name() + "'");
+            }
+
+            start_points[chain] = x;
+        }
+
+        void run_chain(const unsigned & c)
+        {
+            auto & chain = chains[c];
+
+            if (start_points[c].empty())
+            {
+                chain.start_randomly();
+            }
+            else
+            {
+                chain.start(start_points[c]);
+            }
+
+            if (! std::isfinite(chain.current.log_posterior))
+                throw InternalError("NoUTurnSampler: chain " + stringify(c) + " cannot start outside the support of the log(posterior)");
+
+            chain.initialize_step_size();
+
+            // warmup: adapt the step size throughout; estimate the mass matrix from a window in the middle
+            // of the warmup, and restart the adaptation of the step size afterwards
+            const unsigned warmup = config.warmup_samples;
+            const unsigned window_begin = warmup * 15 / 100;
+            unsigned window_end = warmup - warmup / 10;
+            if (window_end < window_begin + 20)
+                window_end = window_begin;
+
+            std::vector<double> points;
+            points.reserve((window_end - window_begin) * dim);
+            double accepted = 0.0;
+            for (unsigned k = 0 ; k < warmup ; ++k)
+            {
+                const double acceptance = chain.step();
+                accepted += acceptance;
+
+                chain.adaptation.update(acceptance);
+                chain.step_size = std::exp(chain.adaptation.log_step_size);
+
+                if ((window_begin <= k) && (k < window_end))
+                {
+                    points.insert(points.end(), chain.current.position.cbegin(), chain.current.position.cend());
+                }
+
+                if ((window_begin < window_end) && (k + 1 == window_end))
+                {
+                    chain.adapt_metric(points, config.dense_mass_matrix);
+                    chain.initialize_step_size();
+                }
+            }
+
+            if (warmup > 0)
+            {
+                chain.step_size = std::exp(chain.adaptation.log_step_size_bar);
+
+                Log::instance()->message("NoUTurnSampler", ll_informational)
+                    << "Chain " << c << ", warmup: average acceptance probability is " << 100.0 * accepted / warmup
+                    << "%, adapted step size is " << chain.step_size;
+            }
+
+            // main run
+            const unsigned n = config.samples;
+            double * samples = this->samples.data() + std::size_t(c) * n * dim;
+            double * values = this->log_posterior_values.data() + std::size_t(c) * n;
+            accepted = 0.0;
+            chain.divergences = 0;
+            for (unsigned k = 0 ; k < n ; ++k)
+            {
+                accepted += chain.step();
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    samples[k * dim + i] = chain.to_parameter(i, chain.current.position[i]);
+                }
+                values[k] = chain.current.log_posterior;
+            }
+
+            acceptance_rates[c] = accepted / n;
+            step_sizes[c] = chain.step_size;
+            divergences[c] = chain.divergences;
+
+            Log::instance()->message("NoUTurnSampler", ll_informational)
+                << "Chain " << c << ", main run: average acceptance probability is " << 100.0 * acceptance_rates[c]
+                << "%, " << divergences[c] << " divergent transitions";
+        }
+
+        void run()
+        {
+            const unsigned n = config.samples;
+            samples.assign(chains.size() * n * dim, 0.0);
+            log_posterior_values.assign(chains.size() * n, 0.0);
+            acceptance_rates.assign(chains.size(), 0.0);
+            step_sizes.assign(chains.size(), 0.0);
+            divergences.assign(chains.size(), 0);
+
+            ThreadPool::instance()->parallel_for(0, chains.size(), [this](const std::size_t & c) { run_chain(c); });
+        }
+    };
+
+    NoUTurnSampler::NoUTurnSampler(const LogPosterior & log_posterior, const Config & config) :
+        PrivateImplementationPattern<NoUTurnSampler>(new Implementation<NoUTurnSampler>(log_posterior, config))
+    {
+    }
+
+    NoUTurnSampler::~NoUTurnSampler()
+    {
+    }
+
+    void
+    NoUTurnSampler::set_start_point(const unsigned & chain, const std::vector<double> & point)
+    {
+        _imp->set_start_point(chain, point);
+    }
+
+    void
+    NoUTurnSampler::run()
+    {
+        _imp->run();
+    }
+
+    unsigned
+    NoUTurnSampler::number_of_chains() const
+    {
+        return _imp->chains.size();
+    }
+
+    unsigned
+    NoUTurnSampler::number_of_samples() const
+    {
+        return _imp->config.samples;
+    }
+
+    unsigned
+    NoUTurnSampler::dimension() const
+    {
+        return _imp->dim;
+    }
+
+    const std::vector<double> &
+    NoUTurnSampler::samples() const
+    {
+        return _imp->samples;
+    }
+
+    const std::vector<double> &
+    NoUTurnSampler::log_posterior_values() const
+    {
+        return _imp->log_posterior_values;
+    }
+
+    const std::vector<double> &
+    NoUTurnSampler::acceptance_rates() const
+    {
+        return _imp->acceptance_rates;
+    }
+
+    const std::vector<double> &
+    NoUTurnSampler::step_sizes() const
+    {
+        return _imp->step_sizes;
+    }
+
+    const std::vector<unsigned> &
+    NoUTurnSampler::divergences() const
+    {
+        return _imp->divergences;
+    }
+}
@@ -0,0 +1,134 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_NO_U_TURN_SAMPLER_HH
+#define EOS_GUARD_EOS_STATISTICS_NO_U_TURN_SAMPLER_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Samples a LogPosterior with several independent chains of the No-U-Turn Sampler (NUTS),
+     * a variant of Hamiltonian Monte Carlo.
+     *
+     * Each chain runs on its own clone of the log(posterior), and the chains are
+     * distributed across the ThreadPool. The gradients of the log(posterior) are obtained
+     * from LogPosterior::evaluate_with_gradient. During the warmup, the step size is adapted
+     * through dual averaging, and the mass matrix is estimated from the warmup samples.
+     * The samples of the warmup are discarded.
+     *
+     * See also [HG:2014A], algorithms 5 and 6.
+     */
+    class NoUTurnSampler :
+        public PrivateImplementationPattern<NoUTurnSampler>
+    {
+        public:
+            struct Config
+            {
+                /// Number of independent chains.
+                VerifiedRange<unsigned> number_of_chains;
+
+                /// Number of samples that each chain returns.
+                VerifiedRange<unsigned> samples;
+
+                /// Number of warmup steps, during which the step size and the mass matrix are adapted.
+                VerifiedRange<unsigned> warmup_samples;
+
+                /// Average acceptance probability targeted by the adaptation of the step size.
+                VerifiedRange<double> target_acceptance;
+
+                /// Maximal depth of the trajectory's binary tree, i.e., at most 2^depth leapfrog steps per sample.
+                VerifiedRange<unsigned> maximum_tree_depth;
+
+                /// If true, adapt a dense mass matrix; otherwise adapt a diagonal mass matrix.
+                bool dense_mass_matrix;
+
+                /// Seed for the random number generators; chain i uses seed + i.
+                unsigned long seed;
+
+                /// Constructor.
+                Config();
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior  The log(posterior) that shall be sampled.
+             * @param config         The configuration of the chains.
+             */
+            NoUTurnSampler(const LogPosterior & log_posterior, const Config & config);
+
+            /// Destructor.
+            ~NoUTurnSampler();
+            ///@}
+
+            ///@name Sampling
+            ///@{
+            /*!
+             * Set the starting point of one chain.
+             *
+             * Chains without an explicit starting point start from a point drawn
+             * uniformly from the ranges of the varied parameters.
+             *
+             * @param chain  The index of the chain.
+             * @param point  The starting point, in the order of the varied parameters.
+             */
+            void set_start_point(const unsigned & chain, const std::vector<double> & point);
+
+            /// Run the warmup and the main run of all chains.
+            void run();
+            ///@}
+
+            ///@name Accessors
+            ///@{
+            /// Retrieve the number of chains.
+            unsigned number_of_chains() const;
+
+            /// Retrieve the number of samples per chain.
+            unsigned number_of_samples() const;
+
+            /// Retrieve the number of varied parameters.
+            unsigned dimension() const;
+
+            /// Retrieve the samples as a row-major array of shape (chains, samples, dimension).
+            const std::vector<double> & samples() const;
+
+            /// Retrieve the values of the log(posterior) for each sample as a row-major array of shape (chains, samples).
+            const std::vector<double> & log_posterior_values() const;
+
+            /// Retrieve the average acceptance probability of each chain in its main run.
+            const std::vector<double> & acceptance_rates() const;
+
+            /// Retrieve the adapted step size of each chain.
+            const std::vector<double> & step_sizes() const;
+
+            /// Retrieve the number of divergent trajectories of each chain in its main run.
+            const std::vector<unsigned> & divergences() const;
+            ///@}
+    };
+}
+
+#endif
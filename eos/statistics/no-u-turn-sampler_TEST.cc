@@ -0,0 +1,186 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/constraint.hh>
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/no-u-turn-sampler.hh>
+#include <eos/maths/power-of.hh>
+
+#include <array>
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class NoUTurnSamplerTest :
+    public TestCase
+{
+    public:
+        NoUTurnSamplerTest() :
+            TestCase("no_u_turn_sampler_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // sample a one-dimensional Gaussian posterior with mean 4.3 and standard deviation 0.0707
+            for (bool dense : { false, true })
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                NoUTurnSampler::Config config;
+                config.number_of_chains = 4;
+                config.samples = 2000;
+                config.warmup_samples = 300;
+                config.dense_mass_matrix = dense;
+                config.seed = 1234;
+
+                NoUTurnSampler sampler(log_posterior, config);
+                sampler.set_start_point(0, { 4.3 });
+                sampler.run();
+
+                TEST_CHECK_EQUAL(sampler.number_of_chains(), 4u);
+                TEST_CHECK_EQUAL(sampler.number_of_samples(), 2000u);
+                TEST_CHECK_EQUAL(sampler.dimension(), 1u);
+
+                const auto & samples = sampler.samples();
+                const auto & values = sampler.log_posterior_values();
+                TEST_CHECK_EQUAL(samples.size(), 4u * 2000u);
+                TEST_CHECK_EQUAL(values.size(), 4u * 2000u);
+
+                for (unsigned c = 0 ; c < 4 ; ++c)
+                {
+                    double mean = 0.0, variance = 0.0;
+                    for (unsigned k = 0 ; k < 2000 ; ++k)
+                    {
+                        mean += samples[c * 2000 + k] / 2000;
+                    }
+                    for (unsigned k = 0 ; k < 2000 ; ++k)
+                    {
+                        variance += power_of<2>(samples[c * 2000 + k] - mean) / 1999;
+                    }
+
+                    TEST_CHECK_NEARLY_EQUAL(mean,                4.3,                  0.01);
+                    TEST_CHECK_NEARLY_EQUAL(std::sqrt(variance), 0.070710678118654752, 0.01);
+
+                    TEST_CHECK(sampler.acceptance_rates()[c] > 0.6);
+                    TEST_CHECK(sampler.step_sizes()[c] > 0.0);
+                    TEST_CHECK_EQUAL(sampler.divergences()[c], 0u);
+                }
+
+                // the stored values of the log(posterior) belong to the stored samples
+                for (unsigned k : { 0u, 1234u, 7999u })
+                {
+                    log_posterior.parameter_descriptions()[0].parameter->set(samples[k]);
+                    TEST_CHECK_NEARLY_EQUAL(values[k], log_posterior.log_posterior(), 1.0e-10);
+                }
+
+                // chains are reproducible for a fixed seed, irrespective of the threads they ran on
+                NoUTurnSampler other(log_posterior, config);
+                other.set_start_point(0, { 4.3 });
+                other.run();
+                TEST_CHECK(samples == other.samples());
+            }
+
+            // sample a two-dimensional, strongly correlated Gaussian posterior with a dense mass matrix
+            {
+                Parameters parameters = Parameters::Defaults();
+
+                const std::array<double, 2> mean{ 1.3, 4.2 }, sigma{ 0.05, 0.1 };
+                const double rho = 0.9;
+                const std::array<std::array<double, 2>, 2> covariance{{
+                    {{ sigma[0] * sigma[0],       rho * sigma[0] * sigma[1] }},
+                    {{ rho * sigma[0] * sigma[1], sigma[1] * sigma[1]       }}
+                }};
+
+                LogLikelihood llh(parameters);
+                const std::array<ObservablePtr, 2> observables{
+                    ObservablePtr(new ObservableStub(parameters, "mass::c")),
+                    ObservablePtr(new ObservableStub(parameters, "mass::b(MSbar)"))
+                };
+                llh.add(Constraint("test::correlated", std::vector<ObservablePtr>(observables.begin(), observables.end()),
+                    std::vector<LogLikelihoodBlockPtr>{ LogLikelihoodBlock::MultivariateGaussian(llh.observable_cache(), observables, mean, covariance) }));
+
+                LogPosterior log_posterior(llh);
+                log_posterior.add(LogPrior::Flat(parameters, "mass::c",        ParameterRange{ 1.0, 1.6 }));
+                log_posterior.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 3.7, 4.7 }));
+
+                NoUTurnSampler::Config config;
+                config.number_of_chains = 4;
+                config.samples = 2000;
+                config.warmup_samples = 500;
+                config.dense_mass_matrix = true;
+                config.seed = 4321;
+
+                NoUTurnSampler sampler(log_posterior, config);
+                for (unsigned c = 0 ; c < 4 ; ++c)
+                {
+                    sampler.set_start_point(c, { 1.3, 4.2 });
+                }
+                sampler.run();
+
+                TEST_CHECK_EQUAL(sampler.dimension(), 2u);
+
+                const auto & samples = sampler.samples();
+                TEST_CHECK_EQUAL(samples.size(), 4u * 2000u * 2u);
+
+                const unsigned n = 4 * 2000;
+                std::array<double, 2> m{ 0.0, 0.0 };
+                for (unsigned k = 0 ; k < n ; ++k)
+                {
+                    m[0] += samples[2 * k + 0] / n;
+                    m[1] += samples[2 * k + 1] / n;
+                }
+
+                double var_0 = 0.0, var_1 = 0.0, cov_01 = 0.0;
+                for (unsigned k = 0 ; k < n ; ++k)
+                {
+                    var_0  += power_of<2>(samples[2 * k + 0] - m[0]) / (n - 1);
+                    var_1  += power_of<2>(samples[2 * k + 1] - m[1]) / (n - 1);
+                    cov_01 += (samples[2 * k + 0] - m[0]) * (samples[2 * k + 1] - m[1]) / (n - 1);
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(m[0],                               mean[0],  0.005);
+                TEST_CHECK_NEARLY_EQUAL(m[1],                               mean[1],  0.01);
+                TEST_CHECK_NEARLY_EQUAL(std::sqrt(var_0),                   sigma[0], 0.005);
+                TEST_CHECK_NEARLY_EQUAL(std::sqrt(var_1),                   sigma[1], 0.01);
+                TEST_CHECK_NEARLY_EQUAL(cov_01 / std::sqrt(var_0 * var_1), rho,      0.03);
+
+                for (unsigned c = 0 ; c < 4 ; ++c)
+                {
+                    TEST_CHECK(sampler.acceptance_rates()[c] > 0.6);
+                    TEST_CHECK_EQUAL(sampler.divergences()[c], 0u);
+                }
+            }
+
+            // invalid configurations and start points
+            {
+                LogPosterior log_posterior = make_log_posterior(true);
+
+                NoUTurnSampler sampler(log_posterior, NoUTurnSampler::Config());
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(0, { 5.0 }));
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(0, { 4.0, 4.0 }));
+                TEST_CHECK_THROWS(InternalError, sampler.set_start_point(4, { 4.0 }));
+
+                NoUTurnSampler::Config config;
+                TEST_CHECK_THROWS(VerifiedRangeOverflow, config.target_acceptance = 1.5);
+            }
+        }
+} no_u_turn_sampler_test;
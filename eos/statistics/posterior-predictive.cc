@@ -0,0 +1,136 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/posterior-predictive.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eos
+{
+    template <>
+    struct Implementation<PosteriorPredictive>
+    {
+        ObservableCache cache;
+
+        std::vector<std::string> parameter_names;
+
+        Implementation(const ObservableCache & cache, const std::vector<std::string> & parameter_names) :
+            cache(cache),
+            parameter_names(parameter_names)
+        {
+            // fail early on unknown parameters
+            Parameters parameters = cache.parameters();
+            for (const auto & name : parameter_names)
+            {
+                parameters[name];
+            }
+        }
+
+        void evaluate(const double * samples, const std::size_t & begin, const std::size_t & end, double * out) const
+        {
+            // each worker uses an independent cache, including its own Parameters and observables
+            Parameters p = cache.parameters().clone();
+            ObservableCache c = cache.clone(p);
+
+            std::vector<Parameter> parameters;
+            for (const auto & name : parameter_names)
+            {
+                parameters.push_back(p[name]);
+            }
+
+            const std::size_t dim = parameters.size();
+            const std::size_t m = c.size();
+
+            for (std::size_t i = begin ; i < end ; ++i)
+            {
+                const double * sample = samples + i * dim;
+                for (std::size_t j = 0 ; j < dim ; ++j)
+                {
+                    parameters[j] = sample[j];
+                }
+
+                c.update();
+
+                double * predictions = out + i * m;
+                bool valid = true;
+                for (std::size_t k = 0 ; k < m ; ++k)
+                {
+                    predictions[k] = c[k];
+                    valid = valid && (! std::isnan(predictions[k]));
+                }
+
+                if (valid)
+                    continue;
+
+                Log::instance()->message("PosteriorPredictive::evaluate", ll_error)
+                    << "Skipping predictions for sample #" << i << " due to an evaluation error";
+                std::fill(predictions, predictions + m, std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+    };
+
+    PosteriorPredictive::PosteriorPredictive(const ObservableCache & cache, const std::vector<std::string> & parameters) :
+        PrivateImplementationPattern<PosteriorPredictive>(new Implementation<PosteriorPredictive>(cache, parameters))
+    {
+    }
+
+    PosteriorPredictive::~PosteriorPredictive()
+    {
+    }
+
+    void
+    PosteriorPredictive::evaluate(const double * samples, const std::size_t & n, const std::size_t & dim, double * out) const
+    {
+        if (dim != _imp->parameter_names.size())
+            throw InternalError("PosteriorPredictive::evaluate: dimension of the samples (" + stringify(dim) + ") does not match the number of parameters (" + stringify(_imp->parameter_names.size()) + ")");
+
+        if (0 == n)
+            return;
+
+        // use one contiguous slice of samples per thread; the calling thread takes part, too
+        const std::size_t workers = std::min<std::size_t>(ThreadPool::instance()->number_of_threads() + 1, n);
+        const std::size_t slice = (n + workers - 1) / workers;
+
+        ThreadPool::instance()->parallel_for(0, workers, [&] (const std::size_t & w)
+        {
+            const std::size_t begin = w * slice, end = std::min(begin + slice, n);
+            if (begin < end)
+                _imp->evaluate(samples, begin, end, out);
+        });
+    }
+
+    unsigned
+    PosteriorPredictive::dimension() const
+    {
+        return _imp->parameter_names.size();
+    }
+
+    unsigned
+    PosteriorPredictive::number_of_observables() const
+    {
+        return _imp->cache.size();
+    }
+}
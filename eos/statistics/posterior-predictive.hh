@@ -0,0 +1,83 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_POSTERIOR_PREDICTIVE_HH
+#define EOS_GUARD_EOS_STATISTICS_POSTERIOR_PREDICTIVE_HH 1
+
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Evaluates the predictions of a set of observables for a batch of posterior samples.
+     *
+     * The samples are distributed across the ThreadPool. Each worker evaluates its share
+     * of the samples on an independent clone of the ObservableCache, such that cacheable
+     * observables share their intermediate results within each worker, and observables
+     * whose parameters do not change from one sample to the next are not re-evaluated.
+     */
+    class PosteriorPredictive :
+        public PrivateImplementationPattern<PosteriorPredictive>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param cache       The cache of the observables that shall be predicted.
+             * @param parameters  The names of the parameters, in the order of the components of each sample.
+             */
+            PosteriorPredictive(const ObservableCache & cache, const std::vector<std::string> & parameters);
+
+            /// Destructor.
+            ~PosteriorPredictive();
+            ///@}
+
+            /*!
+             * Evaluate the predictions for a batch of samples.
+             *
+             * If any observable cannot be evaluated for a sample, all predictions for that
+             * sample are NaN.
+             *
+             * @param samples  Row-major array of n samples of dimension dim.
+             * @param n        Number of samples.
+             * @param dim      Dimension of each sample; must match the number of parameters.
+             * @param out      Row-major array of n * number_of_observables() elements that receives
+             *                 the predictions. The columns follow the ObservableCache::Id of the observables.
+             */
+            void evaluate(const double * samples, const std::size_t & n, const std::size_t & dim, double * out) const;
+
+            ///@name Accessors
+            ///@{
+            /// Retrieve the number of parameters per sample.
+            unsigned dimension() const;
+
+            /// Retrieve the number of independent predictions per sample.
+            unsigned number_of_observables() const;
+            ///@}
+    };
+}
+
+#endif
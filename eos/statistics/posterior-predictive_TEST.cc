@@ -0,0 +1,150 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/observable.hh>
+#include <eos/statistics/posterior-predictive.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/observable_stub.hh>
+
+#include <cmath>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+namespace
+{
+    // Returns the square root of a parameter, and fails for negative values
+    class SquareRootObservable :
+        public Observable
+    {
+        private:
+            QualifiedName _name;
+
+            Parameters _parameters;
+
+            Kinematics _kinematics;
+
+            UsedParameter _x;
+
+        public:
+            SquareRootObservable(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics) :
+                _name(name),
+                _parameters(parameters),
+                _kinematics(kinematics),
+                _x(parameters[name.str()], *this)
+            {
+            }
+
+            virtual const QualifiedName & name() const
+            {
+                return _name;
+            }
+
+            virtual double evaluate() const
+            {
+                if (_x() < 0.0)
+                    throw InternalError("SquareRootObservable: negative argument");
+
+                return std::sqrt(_x());
+            }
+
+            virtual Kinematics kinematics()
+            {
+                return _kinematics;
+            }
+
+            virtual Parameters parameters()
+            {
+                return _parameters;
+            }
+
+            virtual Options options()
+            {
+                return Options();
+            }
+
+            virtual ObservablePtr clone() const
+            {
+                return ObservablePtr(new SquareRootObservable(_name, _parameters.clone(), _kinematics.clone()));
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                return ObservablePtr(new SquareRootObservable(_name, parameters, _kinematics.clone()));
+            }
+    };
+}
+
+class PosteriorPredictiveTest :
+    public TestCase
+{
+    public:
+        PosteriorPredictiveTest() :
+            TestCase("posterior_predictive_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // predict two observables for a batch of samples
+            {
+                Parameters parameters = Parameters::Defaults();
+                ObservableCache cache(parameters);
+                const auto id_c = cache.add(ObservablePtr(new ObservableStub(parameters, "mass::c")));
+                const auto id_b = cache.add(ObservablePtr(new SquareRootObservable("mass::b(MSbar)", parameters, Kinematics())));
+
+                PosteriorPredictive predictive(cache, std::vector<std::string>{ "mass::b(MSbar)", "mass::c" });
+                TEST_CHECK_EQUAL(predictive.dimension(), 2u);
+                TEST_CHECK_EQUAL(predictive.number_of_observables(), 2u);
+
+                const std::size_t n = 101;
+                std::vector<double> samples(2 * n), out(2 * n);
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    samples[2 * i + 0] = 4.0 + 0.01 * i;
+                    samples[2 * i + 1] = 1.0 + 0.01 * i;
+                }
+                // the second observable fails for this sample
+                samples[2 * 50] = -1.0;
+
+                predictive.evaluate(samples.data(), n, 2, out.data());
+
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    if (50 == i)
+                    {
+                        TEST_CHECK(std::isnan(out[2 * i + id_c]));
+                        TEST_CHECK(std::isnan(out[2 * i + id_b]));
+                        continue;
+                    }
+
+                    TEST_CHECK_NEARLY_EQUAL(out[2 * i + id_c], 1.0 + 0.01 * i,            1e-14);
+                    TEST_CHECK_NEARLY_EQUAL(out[2 * i + id_b], std::sqrt(4.0 + 0.01 * i), 1e-14);
+                }
+
+                // the original parameters remain unchanged
+                TEST_CHECK_EQUAL(parameters["mass::c"](), Parameters::Defaults()["mass::c"]());
+
+                // mismatch of dimensions
+                TEST_CHECK_THROWS(InternalError, predictive.evaluate(samples.data(), n, 3, out.data()));
+            }
+        }
+} posterior_predictive_test;
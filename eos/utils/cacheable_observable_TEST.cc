@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -33,6 +34,8 @@ using namespace eos;
 
 namespace eos
 {
+    // number of calls to TestCacheableObservableProvider::prepare_shared()
+    unsigned prepare_shared_calls = 0;
 
     class TestCacheableObservableProvider :
         public ParameterUser,
@@ -59,6 +62,11 @@ namespace eos
             double evaluate1(const IntermediateResult *) const;
             double evaluate2(const IntermediateResult *) const;
 
+            // Observables with an intermediate result that does not depend on the kinematics
+            const IntermediateResult * prepare_shared() const;
+
+            double evaluate_shared(const IntermediateResult *, const double & q2) const;
+
             /*!
              * References used in the computation of our observables.
              */
@@ -95,6 +103,18 @@ namespace eos
             return &_intermediate_result;
         }
 
+        const IntermediateResult * prepare_shared()
+        {
+            ++prepare_shared_calls;
+
+            _intermediate_result.a = 2.0;
+            _intermediate_result.b = m_B;
+
+            _intermediate_result.q2 = 0.0;
+
+            return &_intermediate_result;
+        }
+
         double evaluate1(const IntermediateResult * intermediate_result)
         {
             return intermediate_result->b - intermediate_result->a * intermediate_result->q2;
@@ -133,6 +153,18 @@ namespace eos
         return _imp->evaluate2(ir);
     }
 
+    const TestCacheableObservableProvider::IntermediateResult *
+    TestCacheableObservableProvider::prepare_shared() const
+    {
+        return _imp->prepare_shared();
+    }
+
+    double
+    TestCacheableObservableProvider::evaluate_shared(const TestCacheableObservableProvider::IntermediateResult * ir, const double & q2) const
+    {
+        return ir->b - ir->a * q2;
+    }
+
     /*!
     * Construct the same observable as a regular observable
     */
@@ -305,5 +337,81 @@ class CacheableObservableTest :
 
         }
 
+        // intermediate results that do not depend on the kinematics are shared across kinematics
+        {
+            Parameters p = Parameters::Defaults();
+            p["mass::B_u"] = 5.27934;
+
+            using TestCacheableObservable = class ConcreteCacheableObservable<TestCacheableObservableProvider, double>;
+
+            auto make = [] (const Parameters & p, const double & q2)
+            {
+                return ObservablePtr(new TestCacheableObservable("test::shared_observable(q2)", p, Kinematics({{"q2", q2}}), Options(),
+                    [] (const TestCacheableObservableProvider * d, const double &) { return d->prepare_shared(); },
+                    &TestCacheableObservableProvider::evaluate_shared,
+                    std::make_tuple("q2"),
+                    true
+                ));
+            };
+
+            ObservableCache cache(p);
+            std::vector<ObservableCache::Id> ids;
+            for (double q2 : { 1.0, 2.0, 3.0, 4.0 })
+            {
+                ids.push_back(cache.add(make(p, q2)));
+            }
+            TEST_CHECK_EQUAL(cache.size(), 4u);
+
+            prepare_shared_calls = 0;
+            cache.update();
+            TEST_CHECK_EQUAL(prepare_shared_calls, 1u);
+
+            TEST_CHECK_NEARLY_EQUAL(cache[ids[0]], 5.27934 - 2.0 * 1.0, 1.0e-12);
+            TEST_CHECK_NEARLY_EQUAL(cache[ids[1]], 5.27934 - 2.0 * 2.0, 1.0e-12);
+            TEST_CHECK_NEARLY_EQUAL(cache[ids[2]], 5.27934 - 2.0 * 3.0, 1.0e-12);
+            TEST_CHECK_NEARLY_EQUAL(cache[ids[3]], 5.27934 - 2.0 * 4.0, 1.0e-12);
+
+            // changing the parameters triggers a single new preparation
+            p["mass::B_u"] = 5.0;
+            prepare_shared_calls = 0;
+            cache.update();
+            TEST_CHECK_EQUAL(prepare_shared_calls, 1u);
+            TEST_CHECK_NEARLY_EQUAL(cache[ids[3]], 5.0 - 2.0 * 4.0, 1.0e-12);
+
+            // uncached evaluation yields the same result
+            TEST_CHECK_NEARLY_EQUAL(make(p, 3.0)->evaluate(), 5.0 - 2.0 * 3.0, 1.0e-12);
+        }
+
+        // gradients leave the intermediate results at the present parameter point
+        {
+            Parameters p = Parameters::Defaults();
+            p["mass::B_u"] = 5.27934;
+            p.seed_gradient({ p["mass::B_u"].id() });
+
+            using TestCacheableObservable = class ConcreteCacheableObservable<TestCacheableObservableProvider, double>;
+
+            auto make = [] (const Parameters & p, const QualifiedName & name)
+            {
+                return ObservablePtr(new TestCacheableObservable(name, p, Kinematics({{"q2", 2.0}}), Options(),
+                    &TestCacheableObservableProvider::prepare,
+                    &TestCacheableObservableProvider::evaluate1,
+                    std::make_tuple("q2")
+                ));
+            };
+
+            ObservableCache cache(p);
+            auto id_cacheable = cache.add(make(p, "test::cacheable_observable1(q2)"));
+            auto id_cached    = cache.add(make(p, "test::cacheable_observable2(q2)"));
+            cache.update_gradients();
+
+            TEST_CHECK_NEARLY_EQUAL(cache.dual(id_cacheable).derivative(0), 1.0,                5.0e-6);
+            TEST_CHECK_NEARLY_EQUAL(cache.dual(id_cached).derivative(0),    1.0,                5.0e-6);
+            TEST_CHECK_EQUAL(cache[id_cacheable],                           5.27934 - 2.0 * 2.0);
+            TEST_CHECK_EQUAL(cache[id_cached],                              5.27934 - 2.0 * 2.0);
+
+            // the cached observable reads the intermediate result of the cacheable observable
+            TEST_CHECK_EQUAL(cache.observable(id_cached)->evaluate(),       5.27934 - 2.0 * 2.0);
+        }
+
     }
 } cacheable_observable_test;
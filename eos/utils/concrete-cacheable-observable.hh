@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2021 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -55,10 +56,14 @@ namespace eos
 
             std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> _prepare_fn;
 
-            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> _evaluate_fn;
+            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> _evaluate_fn;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
+            bool _kinematics_independent;
+
+            std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple;
+
         public:
             ConcreteCachedObservable(const QualifiedName & name,
                     const Parameters & parameters,
@@ -67,8 +72,9 @@ namespace eos
                     const std::shared_ptr<Decay_> & decay,
                     const typename Decay_::IntermediateResult * intermediate_result,
                     const std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> & prepare_fn,
-                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> & evaluate_fn,
-                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> & evaluate_fn,
+                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
+                    const bool & kinematics_independent) :
                 _name(name),
                 _parameters(parameters),
                 _kinematics(kinematics),
@@ -77,7 +83,9 @@ namespace eos
                 _intermediate_result(intermediate_result),
                 _prepare_fn(prepare_fn),
                 _evaluate_fn(evaluate_fn),
-                _kinematics_names(kinematics_names)
+                _kinematics_names(kinematics_names),
+                _kinematics_independent(kinematics_independent),
+                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
                 uses(*_decay);
                 uses(Decay_::references);
@@ -92,7 +100,9 @@ namespace eos
 
             virtual double evaluate() const
             {
-                return _evaluate_fn(_decay.get(), _intermediate_result);
+                std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values = _argument_tuple;
+
+                return std::apply([this] (const Decay_ * decay, const auto & ... args) { return _evaluate_fn(decay, _intermediate_result, args ...); }, values);
             };
 
             virtual Parameters parameters()
@@ -112,12 +122,12 @@ namespace eos
 
             virtual ObservablePtr clone() const
             {
-                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, _parameters.clone(), _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, _parameters.clone(), _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
 
             virtual ObservablePtr clone(const Parameters & parameters) const
             {
-                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, parameters, _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, parameters, _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
     };
 
@@ -138,10 +148,13 @@ namespace eos
 
             std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> _prepare_fn;
 
-            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> _evaluate_fn;
+            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> _evaluate_fn;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
+            // Does the intermediate result depend on the kinematics?
+            bool _kinematics_independent;
+
             std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, KinematicVariable>::Type ...> _argument_tuple;
 
         public:
@@ -150,8 +163,9 @@ namespace eos
                     const Kinematics & kinematics,
                     const Options & options,
                     const std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> & prepare_fn,
-                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> & evaluate_fn,
-                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> & evaluate_fn,
+                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
+                    const bool & kinematics_independent) :
                 _name(name),
                 _parameters(parameters),
                 _kinematics(kinematics),
@@ -160,12 +174,26 @@ namespace eos
                 _prepare_fn(prepare_fn),
                 _evaluate_fn(evaluate_fn),
                 _kinematics_names(kinematics_names),
+                _kinematics_independent(kinematics_independent),
                 _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
                 uses(*_decay);
                 uses(Decay_::references);
             }
 
+            ConcreteCacheableObservable(const QualifiedName & name,
+                    const Parameters & parameters,
+                    const Kinematics & kinematics,
+                    const Options & options,
+                    const std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> & prepare_fn,
+                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> & evaluate_fn,
+                    const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names) :
+                ConcreteCacheableObservable(name, parameters, kinematics, options, prepare_fn,
+                        [evaluate_fn] (const Decay_ * decay, const typename Decay_::IntermediateResult * intermediate_result, const Args_ & ...) { return evaluate_fn(decay, intermediate_result); },
+                        kinematics_names, false)
+            {
+            }
+
             ~ConcreteCacheableObservable() = default;
 
             virtual const QualifiedName & name() const
@@ -179,7 +207,7 @@ namespace eos
 
                 const typename Decay_::IntermediateResult * intermediate_result = std::apply(_prepare_fn, values);
 
-                return _evaluate_fn(_decay.get(), intermediate_result);
+                return std::apply([this, intermediate_result] (const Decay_ * decay, const auto & ... args) { return _evaluate_fn(decay, intermediate_result, args ...); }, values);
             };
 
             virtual const CacheableObservable::IntermediateResult * prepare() const
@@ -189,9 +217,12 @@ namespace eos
                 return std::apply(_prepare_fn, values);
             }
 
-            virtual double evaluate(const CacheableObservable::IntermediateResult * intermediate_result) const
+            virtual double evaluate(const CacheableObservable::IntermediateResult * _intermediate_result) const
             {
-                return _evaluate_fn(_decay.get(), static_cast<const typename Decay_::IntermediateResult *>(intermediate_result));
+                auto intermediate_result = static_cast<const typename Decay_::IntermediateResult *>(_intermediate_result);
+                std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values = _argument_tuple;
+
+                return std::apply([this, intermediate_result] (const Decay_ * decay, const auto & ... args) { return _evaluate_fn(decay, intermediate_result, args ...); }, values);
             }
 
             virtual Parameters parameters()
@@ -218,7 +249,11 @@ namespace eos
                 if (other->_parameters != this->_parameters)
                     return { nullptr };
 
-                if (other->_kinematics != this->_kinematics)
+                if (other->_kinematics_independent != this->_kinematics_independent)
+                    return { nullptr };
+
+                // an intermediate result that does not depend on the kinematics can be shared across kinematics
+                if ((! _kinematics_independent) && (other->_kinematics != this->_kinematics))
                     return { nullptr };
 
                 if (other->_options != this->_options)
@@ -231,17 +266,17 @@ namespace eos
                  */
                 std::tuple<const Decay_ *, typename impl::ConvertTo<Args_, double>::Type ...> values = other->_argument_tuple;
 
-                return ObservablePtr(new ConcreteCachedObservable<Decay_, Args_ ...>(_name, _parameters, _kinematics, _options, other->_decay, std::apply(other->_prepare_fn, values), _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCachedObservable<Decay_, Args_ ...>(_name, _parameters, _kinematics, _options, other->_decay, std::apply(other->_prepare_fn, values), _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
 
             virtual ObservablePtr clone() const
             {
-                return ObservablePtr(new ConcreteCacheableObservable(_name, _parameters.clone(), _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCacheableObservable(_name, _parameters.clone(), _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
 
             virtual ObservablePtr clone(const Parameters & parameters) const
             {
-                return ObservablePtr(new ConcreteCacheableObservable(_name, parameters, _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCacheableObservable(_name, parameters, _kinematics.clone(), _options, _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
     };
 
@@ -258,19 +293,22 @@ namespace eos
 
             std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> _prepare_fn;
 
-            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> _evaluate_fn;
+            std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> _evaluate_fn;
 
             std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> _kinematics_names;
 
             std::array<const std::string, sizeof...(Args_)> _kinematics_names_array;
 
+            bool _kinematics_independent;
+
             Options _forced_options;
 
         public:
             ConcreteCacheableObservableEntry(const QualifiedName & name, const std::string & latex, const Unit & unit,
                     const std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)> & prepare_fn,
-                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)> & evaluate_fn,
+                    const std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)> & evaluate_fn,
                     const std::tuple<typename impl::ConvertTo<Args_, const char *>::Type ...> & kinematics_names,
+                    const bool & kinematics_independent,
                     const Options & forced_options) :
                 _name(name),
                 _latex(latex),
@@ -279,6 +317,7 @@ namespace eos
                 _evaluate_fn(evaluate_fn),
                 _kinematics_names(kinematics_names),
                 _kinematics_names_array(impl::make_array<const std::string>(kinematics_names)),
+                _kinematics_independent(kinematics_independent),
                 _forced_options(forced_options)
             {
             }
@@ -333,7 +372,7 @@ namespace eos
                             << "Observable '" << _name << "' forces option key '" << key << "' to value '" << _forced_options[key] << "', overriding user-provided value '" << options[key] << "'";
                     }
                 }
-                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, parameters, kinematics, options + _forced_options, _prepare_fn, _evaluate_fn, _kinematics_names));
+                return ObservablePtr(new ConcreteCacheableObservable<Decay_, Args_ ...>(_name, parameters, kinematics, options + _forced_options, _prepare_fn, _evaluate_fn, _kinematics_names, _kinematics_independent));
             }
 
             virtual std::ostream & insert(std::ostream & os) const
@@ -362,8 +401,34 @@ namespace eos
         return std::make_shared<ConcreteCacheableObservableEntry<Decay_, Args_ ...>>(name, latex,
                 unit,
                 std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)>(std::mem_fn(prepare_fn)),
-                std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *)>(std::mem_fn(evaluate_fn)),
-                kinematics_names, forced_options);
+                std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)>(
+                    [evaluate_fn] (const Decay_ * decay, const typename Decay_::IntermediateResult * intermediate_result, const Args_ & ...) { return (decay->*evaluate_fn)(intermediate_result); }
+                ),
+                kinematics_names, false, forced_options);
+    }
+
+    /*
+     * Variant for intermediate results that do not depend on the kinematics, e.g. a differential spectrum
+     * covering the entire phase space. Observables of this kind share a single intermediate result across
+     * all kinematics, and are evaluated from the intermediate result and their own kinematics.
+     */
+    template <typename Decay_, typename Tuple_, typename ... Args_>
+    ObservableEntryPtr make_concrete_cacheable_observable_entry(const QualifiedName & name, const std::string & latex,
+            const Unit & unit,
+            const typename Decay_::IntermediateResult * (Decay_::* prepare_fn)() const,
+            double (Decay_::* evaluate_fn)(const typename Decay_::IntermediateResult *, const Args_ & ...) const,
+            const Tuple_ & kinematics_names,
+            const Options & forced_options)
+    {
+        static_assert(sizeof...(Args_) == impl::TupleSize<Tuple_>::size, "Need as many function arguments as kinematics names!");
+
+        return std::make_shared<ConcreteCacheableObservableEntry<Decay_, Args_ ...>>(name, latex,
+                unit,
+                std::function<const typename Decay_::IntermediateResult * (const Decay_ *, const Args_ & ...)>(
+                    [prepare_fn] (const Decay_ * decay, const Args_ & ...) { return (decay->*prepare_fn)(); }
+                ),
+                std::function<double (const Decay_ *, const typename Decay_::IntermediateResult *, const Args_ & ...)>(std::mem_fn(evaluate_fn)),
+                kinematics_names, true, forced_options);
     }
 }
 
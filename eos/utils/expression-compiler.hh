@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_EXPRESSION_COMPILER_HH
+#define EOS_GUARD_EOS_UTILS_EXPRESSION_COMPILER_HH 1
+
+#include <eos/maths/dual.hh>
+#include <eos/utils/expression-fwd.hh>
+#include <eos/utils/observable_cache.hh>
+
+#include <cmath>
+#include <vector>
+
+namespace eos::exp
+{
+    // Linear, register-based program that evaluates an expression tree over the predictions of an ObservableCache
+    class CompiledExpression
+    {
+        public:
+            enum class OpCode
+            {
+                constant,   // r[target] = value
+                load,       // r[target] = predictions[slot]
+                copy,       // r[target] = r[source]
+                sum,        // r[target] = r[target] + r[source]
+                difference, // r[target] = r[target] - r[source]
+                product,    // r[target] = r[target] * r[source]
+                ratio,      // r[target] = r[target] / r[source]
+                power       // r[target] = r[target] ^ r[source]
+            };
+
+            struct Instruction
+            {
+                OpCode op;
+                unsigned target;
+                unsigned source;
+                ObservableCache::Id slot;
+                double value;
+            };
+
+            std::vector<Instruction> instructions;
+
+            // Number of registers required by the program; the result is found in register 0
+            unsigned registers = 0;
+
+            // Ids of all cached observables that the program reads
+            std::vector<ObservableCache::Id> slots;
+
+            double evaluate(const double * predictions) const
+            {
+                // most expressions require only a handful of registers
+                double fixed[16];
+                std::vector<double> dynamic;
+                double * r = fixed;
+                if (registers > 16)
+                {
+                    dynamic.resize(registers);
+                    r = dynamic.data();
+                }
+
+                for (const auto & i : instructions)
+                {
+                    switch (i.op)
+                    {
+                        case OpCode::constant:   r[i.target] = i.value;                            break;
+                        case OpCode::load:       r[i.target] = predictions[i.slot];                break;
+                        case OpCode::copy:       r[i.target] = r[i.source];                        break;
+                        case OpCode::sum:        r[i.target] = r[i.target] + r[i.source];          break;
+                        case OpCode::difference: r[i.target] = r[i.target] - r[i.source];          break;
+                        case OpCode::product:    r[i.target] = r[i.target] * r[i.source];          break;
+                        case OpCode::ratio:      r[i.target] = r[i.target] / r[i.source];          break;
+                        case OpCode::power:      r[i.target] = std::pow(r[i.target], r[i.source]); break;
+                    }
+                }
+
+                return r[0];
+            }
+
+            // Evaluate the program over dual numbers, which propagates the gradients of the predictions by the chain rule
+            Dual evaluate_dual(const Dual * duals) const
+            {
+                std::vector<Dual> r(registers);
+
+                for (const auto & i : instructions)
+                {
+                    switch (i.op)
+                    {
+                        case OpCode::constant:   r[i.target] = Dual(i.value);                 break;
+                        case OpCode::load:       r[i.target] = duals[i.slot];                 break;
+                        case OpCode::copy:       r[i.target] = r[i.source];                   break;
+                        case OpCode::sum:        r[i.target] += r[i.source];                  break;
+                        case OpCode::difference: r[i.target] -= r[i.source];                  break;
+                        case OpCode::product:    r[i.target] *= r[i.source];                  break;
+                        case OpCode::ratio:      r[i.target] /= r[i.source];                  break;
+                        case OpCode::power:      r[i.target] = pow(r[i.target], r[i.source]); break;
+                    }
+                }
+
+                return r[0];
+            }
+    };
+
+    // Visit the expression tree of cached observables, and lower it into a CompiledExpression
+    class ExpressionCompiler
+    {
+        public:
+            // Result of compiling a subtree: either a constant value, or the register that holds the value
+            struct Operand
+            {
+                bool is_constant = false;
+                double value = 0.0;
+                unsigned reg = 0;
+            };
+
+        private:
+            CompiledExpression & _program;
+
+            // The next free register; registers are allocated like a stack
+            unsigned _next;
+
+            unsigned allocate();
+
+            // Ensure that the operand is held in a register
+            unsigned materialize(const Operand & operand);
+
+        public:
+            ExpressionCompiler(CompiledExpression & program);
+            ~ExpressionCompiler() = default;
+
+            Operand visit(const BinaryExpression & e);
+
+            Operand visit(const ConstantExpression & e);
+
+            Operand visit(const ObservableNameExpression & e);
+
+            Operand visit(const ObservableExpression & e);
+
+            Operand visit(const CachedObservableExpression & e);
+
+            // Compile an expression into the program
+            static CompiledExpression compile(const Expression & e);
+    };
+}
+
+#endif
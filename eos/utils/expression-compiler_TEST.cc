@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+
+#include <eos/observable.hh>
+#include <eos/maths/dual.hh>
+#include <eos/utils/expression.hh>
+#include <eos/utils/expression-compiler.hh>
+#include <eos/utils/expression-evaluator.hh>
+#include <eos/utils/expression-observable.hh>
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/observable_stub.hh>
+
+#include <cmath>
+#include <vector>
+
+using namespace test;
+using namespace eos::exp;
+using namespace eos;
+
+class ExpressionCompilerTest :
+    public TestCase
+{
+    public:
+        ExpressionCompilerTest() :
+            TestCase("expression_compiler_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-14;
+
+            // compiled programs agree with the evaluation of the tree
+            {
+                Parameters p = Parameters::Defaults();
+                ObservableCache cache(p);
+                auto id_a = cache.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+                auto id_b = cache.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")));
+                cache.update();
+
+                std::vector<double> predictions{ cache[id_a], cache[id_b] };
+                const double a = predictions[id_a], b = predictions[id_b];
+
+                Expression e_a = CachedObservableExpression(cache, id_a, KinematicsSpecification());
+                Expression e_b = CachedObservableExpression(cache, id_b, KinematicsSpecification());
+                ExpressionEvaluator evaluator;
+
+                // ((a + b) * 2) / ((a - 1) ^ 2)
+                Expression e1 = BinaryExpression('/',
+                        BinaryExpression('*', BinaryExpression('+', e_a, e_b), ConstantExpression(2.0)),
+                        BinaryExpression('^', BinaryExpression('-', e_a, ConstantExpression(1.0)), ConstantExpression(2.0)));
+                CompiledExpression c1 = ExpressionCompiler::compile(e1);
+                TEST_CHECK_RELATIVE_ERROR(c1.evaluate(predictions.data()), e1.accept_returning<double>(evaluator), eps);
+                TEST_CHECK_RELATIVE_ERROR(c1.evaluate(predictions.data()), (a + b) * 2.0 / std::pow(a - 1.0, 2.0), eps);
+                TEST_CHECK_EQUAL(c1.slots.size(), 2u);
+
+                // constant left-hand side
+                Expression e2 = BinaryExpression('-', ConstantExpression(2.0), BinaryExpression('/', e_a, e_b));
+                CompiledExpression c2 = ExpressionCompiler::compile(e2);
+                TEST_CHECK_RELATIVE_ERROR(c2.evaluate(predictions.data()), 2.0 - a / b, eps);
+
+                // constant subexpressions are folded
+                Expression e3 = BinaryExpression('*', BinaryExpression('+', ConstantExpression(2.0), ConstantExpression(3.0)), ConstantExpression(4.0));
+                CompiledExpression c3 = ExpressionCompiler::compile(e3);
+                TEST_CHECK_EQUAL(c3.instructions.size(), 1u);
+                TEST_CHECK_EQUAL(c3.registers, 1u);
+                TEST_CHECK_EQUAL(c3.evaluate(predictions.data()), 20.0);
+
+                // deeply nested expressions require more registers than are available on the stack
+                Expression e4 = e_b;
+                double value = b;
+                for (unsigned i = 0 ; i < 20 ; ++i)
+                {
+                    e4 = BinaryExpression('-', e_a, e4);
+                    value = a - value;
+                }
+                CompiledExpression c4 = ExpressionCompiler::compile(e4);
+                TEST_CHECK(c4.registers > 16u);
+                TEST_CHECK_RELATIVE_ERROR(c4.evaluate(predictions.data()), value, eps);
+                TEST_CHECK_EQUAL(c4.slots.size(), 2u);
+
+                // only cached observables can be compiled
+                Expression e5 = ObservableNameExpression("mass::c", KinematicsSpecification());
+                TEST_CHECK_THROWS(InternalError, ExpressionCompiler::compile(e5));
+            }
+
+            // expression observables that rely on other expression observables
+            {
+                Expression ratio = BinaryExpression('/',
+                        ObservableNameExpression("mass::c", KinematicsSpecification()),
+                        ObservableNameExpression("mass::b(MSbar)", KinematicsSpecification()));
+                ObservableEntries::instance()->insert_or_assign("test::ratio",
+                        std::make_shared<ExpressionObservableEntry>("test::ratio", "", Unit::None(), ratio, Options()));
+
+                Parameters p = Parameters::Defaults();
+                Kinematics k;
+                Expression twice = BinaryExpression('*', ConstantExpression(2.0), ObservableNameExpression("test::ratio", KinematicsSpecification()));
+                Expression sum = BinaryExpression('+', ObservableNameExpression("test::ratio", KinematicsSpecification()), ObservableNameExpression("mass::c", KinematicsSpecification()));
+
+                ObservableCache cache(p);
+                auto id_twice = cache.add(ObservablePtr(new ExpressionObservable("test::twice", p, k, Options(), twice)));
+                auto id_sum   = cache.add(ObservablePtr(new ExpressionObservable("test::sum", p, k, Options(), sum)));
+
+                cache.update();
+                TEST_CHECK_RELATIVE_ERROR(cache[id_twice], 2.0 * p["mass::c"]() / p["mass::b(MSbar)"](), eps);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_sum],   p["mass::c"]() / p["mass::b(MSbar)"]() + p["mass::c"](), eps);
+
+                p["mass::c"] = 1.5;
+                cache.update();
+                TEST_CHECK_RELATIVE_ERROR(cache[id_twice], 2.0 * 1.5 / p["mass::b(MSbar)"](), eps);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_sum],   1.5 / p["mass::b(MSbar)"]() + 1.5, eps);
+
+                // clones evaluate independently
+                Parameters p2 = p.clone();
+                ObservableCache clone = cache.clone(p2);
+                p2["mass::c"] = 1.0;
+                clone.update();
+                TEST_CHECK_RELATIVE_ERROR(clone[id_twice], 2.0 / p2["mass::b(MSbar)"](), eps);
+                TEST_CHECK_RELATIVE_ERROR(cache[id_twice], 2.0 * 1.5 / p["mass::b(MSbar)"](), eps);
+            }
+
+            // gradients of expression observables follow from the gradients of their operands
+            {
+                static const double eps_gradient = 1.0e-7;
+
+                Parameters p = Parameters::Defaults();
+                p.seed_gradient({ p["mass::c"].id(), p["mass::b(MSbar)"].id(), p["mass::tau"].id() });
+                Kinematics k;
+
+                // (c / b)^c
+                Expression power = BinaryExpression('^',
+                        BinaryExpression('/', ObservableNameExpression("mass::c", KinematicsSpecification()), ObservableNameExpression("mass::b(MSbar)", KinematicsSpecification())),
+                        ObservableNameExpression("mass::c", KinematicsSpecification()));
+                Expression twice = BinaryExpression('*', ConstantExpression(2.0), ObservableNameExpression("test::ratio", KinematicsSpecification()));
+
+                ObservableCache cache(p);
+                auto id_power = cache.add(ObservablePtr(new ExpressionObservable("test::power", p, k, Options(), power)));
+                auto id_twice = cache.add(ObservablePtr(new ExpressionObservable("test::twice", p, k, Options(), twice)));
+                cache.update_gradients();
+
+                const double c = p["mass::c"](), b = p["mass::b(MSbar)"](), r = c / b;
+
+                const Dual & d_power = cache.dual(id_power);
+                TEST_CHECK_RELATIVE_ERROR(d_power.value,         std::pow(r, c),                       eps);
+                TEST_CHECK_RELATIVE_ERROR(d_power.derivative(0), std::pow(r, c) * (std::log(r) + 1.0), eps_gradient);
+                TEST_CHECK_RELATIVE_ERROR(d_power.derivative(1), std::pow(r, c) * (-c / b),            eps_gradient);
+                TEST_CHECK_EQUAL(d_power.derivative(2),          0.0);
+
+                const Dual & d_twice = cache.dual(id_twice);
+                TEST_CHECK_RELATIVE_ERROR(d_twice.value,         2.0 * r,             eps);
+                TEST_CHECK_RELATIVE_ERROR(d_twice.derivative(0), 2.0 / b,             eps_gradient);
+                TEST_CHECK_RELATIVE_ERROR(d_twice.derivative(1), -2.0 * c / (b * b),  eps_gradient);
+                TEST_CHECK_EQUAL(d_twice.derivative(2),          0.0);
+
+                // the parameters and predictions are unchanged
+                TEST_CHECK_EQUAL(p["mass::c"](),        c);
+                TEST_CHECK_EQUAL(p["mass::b(MSbar)"](), b);
+                TEST_CHECK_EQUAL(cache[id_power],       std::pow(r, c));
+            }
+        }
+} expression_compiler_test;
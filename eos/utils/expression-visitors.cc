@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,7 @@
 #include <eos/utils/expression.hh>
 #include <eos/utils/expression-cacher.hh>
 #include <eos/utils/expression-cloner.hh>
+#include <eos/utils/expression-compiler.hh>
 #include <eos/utils/expression-evaluator.hh>
 #include <eos/utils/expression-kinematic-reader.hh>
 #include <eos/utils/expression-maker.hh>
@@ -31,6 +33,7 @@
 #include <eos/utils/parameters.hh>
 #include <eos/utils/qualified-name.hh>
 
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -517,4 +520,131 @@ namespace eos::exp
 
         return e;
     }
+
+    /*
+     * ExpressionCompiler
+     */
+
+    ExpressionCompiler::ExpressionCompiler(CompiledExpression & program) :
+        _program(program),
+        _next(0)
+    {
+    }
+
+    unsigned
+    ExpressionCompiler::allocate()
+    {
+        unsigned result = _next++;
+        _program.registers = std::max(_program.registers, _next);
+
+        return result;
+    }
+
+    unsigned
+    ExpressionCompiler::materialize(const Operand & operand)
+    {
+        if (! operand.is_constant)
+            return operand.reg;
+
+        unsigned result = allocate();
+        _program.instructions.push_back({ CompiledExpression::OpCode::constant, result, 0, 0, operand.value });
+
+        return result;
+    }
+
+    ExpressionCompiler::Operand
+    ExpressionCompiler::visit(const BinaryExpression & e)
+    {
+        CompiledExpression::OpCode op;
+        switch (e.op)
+        {
+            case '+': op = CompiledExpression::OpCode::sum;        break;
+            case '-': op = CompiledExpression::OpCode::difference; break;
+            case '*': op = CompiledExpression::OpCode::product;    break;
+            case '/': op = CompiledExpression::OpCode::ratio;      break;
+            case '^': op = CompiledExpression::OpCode::power;      break;
+            default:
+                throw InternalError("Unknown binary operator '" + std::string(1, e.op) + "' encountered in ExpressionCompiler::visit");
+        }
+
+        Operand lhs = e.lhs.accept_returning<Operand>(*this);
+        Operand rhs = e.rhs.accept_returning<Operand>(*this);
+
+        // fold constant subexpressions
+        if (lhs.is_constant && rhs.is_constant)
+        {
+            Operand result;
+            result.is_constant = true;
+            result.value = BinaryExpression::Method(e.op)(lhs.value, rhs.value);
+
+            return result;
+        }
+
+        // the registers of the left-hand side precede those of the right-hand side, unless
+        // the left-hand side is a constant; the result is kept in the lowest register
+        const unsigned target = materialize(lhs);
+        const unsigned source = materialize(rhs);
+        _program.instructions.push_back({ op, target, source, 0, 0.0 });
+
+        Operand result;
+        result.reg = std::min(target, source);
+        if (result.reg != target)
+        {
+            _program.instructions.push_back({ CompiledExpression::OpCode::copy, result.reg, target, 0, 0.0 });
+        }
+        _next = result.reg + 1;
+
+        return result;
+    }
+
+    ExpressionCompiler::Operand
+    ExpressionCompiler::visit(const ConstantExpression & e)
+    {
+        Operand result;
+        result.is_constant = true;
+        result.value = e.value;
+
+        return result;
+    }
+
+    ExpressionCompiler::Operand
+    ExpressionCompiler::visit(const ObservableNameExpression &)
+    {
+        throw InternalError("Encountered ObservableNameExpression in ExpressionCompiler::visit");
+    }
+
+    ExpressionCompiler::Operand
+    ExpressionCompiler::visit(const ObservableExpression &)
+    {
+        throw InternalError("Encountered ObservableExpression in ExpressionCompiler::visit");
+    }
+
+    ExpressionCompiler::Operand
+    ExpressionCompiler::visit(const CachedObservableExpression & e)
+    {
+        Operand result;
+        result.reg = allocate();
+        _program.instructions.push_back({ CompiledExpression::OpCode::load, result.reg, 0, e.id, 0.0 });
+        _program.slots.push_back(e.id);
+
+        return result;
+    }
+
+    CompiledExpression
+    ExpressionCompiler::compile(const Expression & e)
+    {
+        CompiledExpression result;
+        ExpressionCompiler compiler(result);
+
+        Operand operand = e.accept_returning<Operand>(compiler);
+        if (operand.is_constant)
+        {
+            compiler.materialize(operand);
+        }
+
+        std::sort(result.slots.begin(), result.slots.end());
+        result.slots.erase(std::unique(result.slots.begin(), result.slots.end()), result.slots.end());
+
+        return result;
+    }
 }
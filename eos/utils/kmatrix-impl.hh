@@ -2,6 +2,7 @@
  * Copyright (c) 2019 Stephan Kürten
  * Copyright (c) 2019 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,15 +22,10 @@
 #define EOS_GUARD_EOS_UTILS_KMATRIX_IMPL_HH 1
 
 #include <eos/maths/complex.hh>
+#include <eos/maths/matrix.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/kmatrix.hh>
 
-#include <gsl/gsl_blas.h>
-#include <gsl/gsl_complex.h>
-#include <gsl/gsl_complex_math.h>
-#include <gsl/gsl_linalg.h>
-#include <gsl/gsl_matrix.h>
-
 #include <limits>
 
 namespace eos
@@ -42,12 +38,7 @@ namespace eos
         _channels(channels),
         _resonances(resonances),
         _bkgcst(bkgcst),
-        _prefix(prefix),
-        _Khat(gsl_matrix_complex_calloc(nchannels_, nchannels_)),
-        _That(gsl_matrix_complex_calloc(nchannels_, nchannels_)),
-        _tmp_1(gsl_matrix_complex_calloc(nchannels_, nchannels_)),
-        _tmp_2(gsl_matrix_complex_calloc(nchannels_, nchannels_)),
-        _perm(gsl_permutation_calloc(nchannels_))
+        _prefix(prefix)
     {
         // Perform size checks
         if (channels.size() != nchannels_)
@@ -58,42 +49,6 @@ namespace eos
             throw InternalError("The array of background constants is not square.");
         if (resonances.size() != nresonances_)
             throw InternalError("The size of the resonances array does not match nresonances_.");
-
-        // Perform pointer checks
-        if (_Khat == nullptr)
-            throw std::bad_alloc();
-        if (_That == nullptr)
-            throw std::bad_alloc();
-        if (_tmp_1 == nullptr)
-            throw std::bad_alloc();
-        if (_tmp_2 == nullptr)
-            throw std::bad_alloc();
-        if (_perm == nullptr)
-            throw std::bad_alloc();
-    }
-
-    template <unsigned nchannels_, unsigned nresonances_>
-    KMatrix<nchannels_, nresonances_>::~KMatrix()
-    {
-        if (_perm)
-            gsl_permutation_free(_perm);
-        _perm = nullptr;
-
-        if (_tmp_1)
-            gsl_matrix_complex_free(_tmp_1);
-        _tmp_1 = nullptr;
-
-        if (_tmp_2)
-            gsl_matrix_complex_free(_tmp_2);
-        _tmp_2 = nullptr;
-
-        if (_That)
-            gsl_matrix_complex_free(_That);
-        _That = nullptr;
-
-        if (_Khat)
-            gsl_matrix_complex_free(_Khat);
-        _Khat = nullptr;
     }
 
 
@@ -146,20 +101,20 @@ namespace eos
         const double s = adapt_s(_s);
 
         ///////////////////
-        //1. Fill tmp1 = rho matrix
+        // 1. Fill rho
         ///////////////////
-        gsl_matrix_complex_set_zero(_tmp_1);
-        gsl_matrix_complex_set_zero(_tmp_2);
-
+        std::array<complex<double>, nchannels_> rho;
         for (size_t i = 0 ; i < nchannels_ ; ++i)
         {
-            complex<double> rhoentry = channels[i]->rho(s);
-            gsl_matrix_complex_set(_tmp_1,  i,  i, gsl_complex_rect(rhoentry.real(), rhoentry.imag()));
+            rho[i] = channels[i]->rho(s);
         }
 
         ///////////////////
         // 2. Fill Khat
         ///////////////////
+        // Khat contains the normalized K-matrix entries
+        // as described in [CBHKSS:1995A].
+        std::array<std::array<complex<double>, nchannels_>, nchannels_> Khat;
         for (size_t i = 0 ; i < nchannels_ ; ++i)
         {
             for (size_t j = 0 ; j < nchannels_ ; ++j)
@@ -177,48 +132,29 @@ namespace eos
 
                 }
 
-                gsl_matrix_complex_set(_Khat, i, j, gsl_complex_rect(entry.real(), entry.imag()));
+                Khat[i][j] = entry;
             }
         }
 
         ///////////////////
-        // 3. Compute That
-        ///////////////////
-        static const gsl_complex one  = gsl_complex_rect(1.0, 0.0);
-        static const gsl_complex minusi  = gsl_complex_rect(0.0, -1.0);
-        static const gsl_complex zero = gsl_complex_rect(0.0, 0.0);
-
-        // 3a. Set 1.0 to the diagonal elements of tmp_2
-        for (unsigned i = 0 ; i < nchannels_ ; ++i)
-        {
-            gsl_matrix_complex_set(_tmp_2, i, i, one);
-        }
-
-        // 3b. multiply -i*rho with Khat from the right and add tmp_2
-        // -> tmp_2 = -i * tmp_1 * Khat + one * tmp_2 ; no transpose anywhere
-        gsl_blas_zgemm(CblasNoTrans, CblasNoTrans, minusi, _tmp_1, _Khat, one, _tmp_2);
-
-        // 3c. invert tmp_2 and assign the result to tmp_1
-        int signum = 0;
-        gsl_permutation_init(_perm);
-        gsl_linalg_complex_LU_decomp(_tmp_2, _perm, &signum);
-        gsl_linalg_complex_LU_invert(_tmp_2, _perm, _tmp_1);
-
-        // 3d. calculate That = Khat / (1 - i rho * Khat) + zero * That
-        //                    = Khat * tmp_1 + zero * That
-        gsl_blas_zgemm(CblasNoTrans, CblasNoTrans, one, _Khat, _tmp_1, zero, _That);
-
-
-        ///////////////////
-        // 4. Extract T matrix row
+        // 3. Compute the row of That
         ///////////////////
+        // The requested row t of That = Khat * (1 - i rho Khat)^(-1) solves t * (1 - i rho Khat) = Khat[rowindex],
+        // or equivalently (1 - i rho Khat)^T t^T = Khat[rowindex]^T. Hence we only need to decompose the transpose
+        // of (1 - i rho Khat) once and solve for a single right-hand side, rather than inverting the full matrix.
+        std::array<std::array<complex<double>, nchannels_>, nchannels_> m;
         for (size_t i = 0 ; i < nchannels_ ; ++i)
         {
-            gsl_complex value = gsl_matrix_complex_get(_That, rowindex, i);
-            complex<double> cvalue(GSL_REAL(value), GSL_IMAG(value));
-            tmatrixrow[i] = cvalue;
+            for (size_t j = 0 ; j < nchannels_ ; ++j)
+            {
+                m[i][j] = complex<double>(0.0, -1.0) * rho[j] * Khat[j][i];
+            }
+            m[i][i] += 1.0;
         }
 
+        const auto perm = lu_decomposition(m);
+        tmatrixrow = lu_solve(m, perm, Khat[rowindex]);
+
         return tmatrixrow;
     }
 
@@ -2,6 +2,7 @@
  * Copyright (c) 2019 Stephan Kürten
  * Copyright (c) 2019 Danny van Dyk
  * Copyright (c) 2021 Méril Reboud
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -25,12 +26,6 @@
 #include <eos/utils/exception.hh>
 #include <eos/utils/parameters.hh>
 
-#include <gsl/gsl_blas.h>
-#include <gsl/gsl_complex.h>
-#include <gsl/gsl_complex_math.h>
-#include <gsl/gsl_linalg.h>
-#include <gsl/gsl_matrix.h>
-
 #include <array>
 #include <memory>
 #include <vector>
@@ -52,31 +47,18 @@ namespace eos
 
             const std::string & _prefix;
 
-            // Khat contains the normalized K-matrix entries
-            // as described in [CBHKSS:1995A].
-            gsl_matrix_complex * _Khat;
-            // That is defined as T = (1-i*rho*K)^(-1)*K
-            gsl_matrix_complex * _That;
-
-            // Two temporary matrices and a permutation are needed to evaluate That
-            gsl_matrix_complex * _tmp_1;
-            gsl_matrix_complex * _tmp_2;
-            gsl_permutation * _perm;
-
             // Constructor
             KMatrix(std::initializer_list<std::shared_ptr<KMatrix::Channel>> channels,
                 std::initializer_list<std::shared_ptr<KMatrix::Resonance>> resonances,
                 std::vector<std::vector<Parameter>> bkgcst,
                 const std::string & prefix);
 
-            // Destuctor
-            ~KMatrix();
-
             // Adapt s to avoid resonnances masses
             double adapt_s(const double s) const;
 
             // Return rowindex^th row of the T matrix defined as T = (1-i*rho*K)^(-1)*K
             // rowindex corresponds to the initial channel
+            // All intermediate matrices live on the stack, so this function is re-entrant.
             std::array<complex<double>, nchannels_> tmatrix_row(unsigned rowindex, const double s) const;
 
             // Return the K matrix partial and total widths of a resonance.
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011-2022 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * Based upon 'paludis/util/log.cc', which is
  *
@@ -136,10 +137,11 @@ namespace eos
         {
         }
 
-        void message(const std::string & id, const LogLevel & l, const std::string & m)
+        // write the message to the stream; returns false if the message is filtered out
+        bool message(const std::string & id, const LogLevel & l, const std::string & m)
         {
             if (l > log_level)
-                return;
+                return false;
 
             *stream << program_name << '@' << ::time(0) << ": ";
 
@@ -174,13 +176,9 @@ namespace eos
             }
             while (false);
 
-            // forward message to all callbacks
-            for (auto & c : callbacks)
-            {
-                c(id, l, m);
-            }
-
             *stream << m << std::endl;
+
+            return true;
         }
     };
 
@@ -238,9 +236,23 @@ namespace eos
     void
     Log::_message(const std::string & id, const LogLevel & l, const std::string & m)
     {
-        Lock ll(_imp->mutex);
+        std::vector<std::function<void (const std::string &, const LogLevel &, const std::string &)>> callbacks;
+
+        {
+            Lock ll(_imp->mutex);
+
+            if (! _imp->message(id, l, m))
+                return;
 
-        _imp->message(id, l, m);
+            callbacks = _imp->callbacks;
+        }
+
+        // forward the message to all callbacks without holding the lock, since callbacks can acquire
+        // further locks, e.g. the Python GIL, whose holder might in turn log a message
+        for (auto & c : callbacks)
+        {
+            c(id, l, m);
+        }
     }
 
     LogMessageHandler
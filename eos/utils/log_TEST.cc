@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2011 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,12 @@
 #include <eos/utils/exception.hh>
 #include <eos/utils/log.hh>
 
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -107,3 +114,47 @@ class LogLevelTest :
             }
         }
 } log_level_test;
+
+class LogCallbackTest :
+    public TestCase
+{
+    public:
+        LogCallbackTest() :
+            TestCase("log_callback_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            std::stringstream stream;
+            const LogLevel log_level = Log::instance()->get_log_level();
+            Log::instance()->set_log_stream(&stream);
+            Log::instance()->set_log_level(ll_error);
+
+            // callbacks may wait for other threads that log messages, as the Python bindings do when they acquire the GIL
+            static std::vector<std::string> messages;
+            Log::instance()->register_callback([] (const std::string & id, const LogLevel &, const std::string & m)
+            {
+                messages.push_back(id + ": " + m);
+
+                if ("outer" == id)
+                {
+                    std::thread t([] () { Log::instance()->message("inner", ll_error) << "from another thread"; });
+                    t.join();
+                }
+            });
+
+            Log::instance()->message("outer", ll_error) << "from the test";
+
+            TEST_CHECK_EQUAL(2u,                           messages.size());
+            TEST_CHECK_EQUAL("outer: from the test",       messages[0]);
+            TEST_CHECK_EQUAL("inner: from another thread", messages[1]);
+
+            // messages below the log level are not forwarded
+            Log::instance()->message("filtered", ll_debug) << "not forwarded";
+            TEST_CHECK_EQUAL(2u, messages.size());
+
+            Log::instance()->set_log_level(log_level);
+            Log::instance()->set_log_stream(&std::cerr);
+        }
+} log_callback_test;
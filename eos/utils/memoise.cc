@@ -16,13 +16,23 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/destringify.hh>
+#include <eos/utils/exception.hh>
 #include <eos/utils/memoise.hh>
 
+#include <cstdlib>
+
 namespace eos
 {
     MemoisationControl::MemoisationControl() :
-        _mutex(new Mutex)
+        _mutex(new Mutex),
+        _capacity(100000u)
     {
+        const char * env_capacity = std::getenv("EOS_MEMOISATION_CAPACITY");
+        if (env_capacity)
+        {
+            set_capacity(destringify<unsigned long>(env_capacity));
+        }
     }
 
     MemoisationControl::~MemoisationControl()
@@ -48,4 +58,19 @@ namespace eos
             _clear_function();
         }
     }
+
+    unsigned long
+    MemoisationControl::capacity() const
+    {
+        return _capacity;
+    }
+
+    void
+    MemoisationControl::set_capacity(const unsigned long & capacity)
+    {
+        if (0 == capacity)
+            throw InternalError("MemoisationControl::set_capacity: capacity must be positive");
+
+        _capacity = capacity;
+    }
 }
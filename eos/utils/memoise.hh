@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2013, 2022 Danny van Dyk
  * Copyright (c) 2010 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,81 +22,283 @@
 #ifndef EOS_GUARD_EOS_UTILS_MEMOISE_HH
 #define EOS_GUARD_EOS_UTILS_MEMOISE_HH 1
 
+#include <eos/utils/condition_variable.hh>
 #include <eos/utils/instantiation_policy.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/lock.hh>
 #include <eos/utils/mutex.hh>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <functional>
-#include <tuple>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
-/* We are using a custom std::hash for tuple<FunctionPtr, double, ..., double> */
-namespace std
+namespace eos
 {
-    template <typename U_> static uint64_t __hash_one(const U_ & u)
+    namespace implementation
     {
-        static_assert(sizeof(U_) == sizeof(uint32_t) || sizeof(U_) == sizeof(uint64_t), "Need to specialize __hash_one for non 32- and 64-bit data types");
+        template <typename T_> struct ResultOf;
 
-        if (sizeof(U_) == sizeof(int64_t))
+        template <typename Result_, typename Class_, typename ... Args_>
+        struct ResultOf<Result_ (Class_::*) (Args_ ...)>
         {
-            return *reinterpret_cast<const uint64_t *>(&u);
-        }
-        else if (sizeof(U_) == sizeof(int32_t))
+            using Type = Result_;
+        };
+
+        template <typename Result_, typename ... Args_>
+        struct ResultOf<Result_ (*) (Args_ ...)>
         {
-            return static_cast<uint64_t>(*reinterpret_cast<const uint32_t *>(&u));
-        }
-    }
+            using Type = Result_;
+        };
 
-    template <unsigned n_, typename ... T_>
-    struct __TupleHasher
-    {
-        static uint64_t hash(const std::tuple<T_ ...> & t)
+        /*!
+         * Bit pattern of one component of a memoisation key.
+         *
+         * Keys are compared bitwise, i.e., 0.0 and -0.0 are distinct keys,
+         * while a NaN argument matches a bitwise-identical NaN.
+         */
+        template <typename T_>
+        inline uint64_t memoisation_word(const T_ & t)
         {
-            return __TupleHasher<n_ - 1, T_ ...>::hash(t) ^ __hash_one<decltype(std::get<n_>(t))>(std::get<n_>(t));
+            static_assert(std::is_trivially_copyable<T_>::value && sizeof(T_) <= sizeof(uint64_t),
+                    "Memoisation keys must consist of trivially copyable types of at most 64 bits");
+
+            uint64_t result = 0;
+            std::memcpy(&result, &t, sizeof(T_));
+
+            return result;
         }
-    };
 
-    template <typename ... T_>
-    struct __TupleHasher<0, T_ ...>
-    {
-        static uint64_t hash(const std::tuple<T_ ...> & t)
+        /*
+         * Multiply-and-fold of two 64-bit words, as in wyhash.
+         *
+         * The full 128-bit product is assembled from 32-bit halves, since ISO C++ lacks a 128-bit integer type.
+         */
+        inline uint64_t memoisation_mum(const uint64_t & a, const uint64_t & b)
         {
-            return __hash_one<decltype(std::get<0>(t))>(std::get<0>(t));
+            const uint64_t a_lo = a & 0xffffffffull, a_hi = a >> 32;
+            const uint64_t b_lo = b & 0xffffffffull, b_hi = b >> 32;
+
+            const uint64_t lo_lo = a_lo * b_lo;
+            const uint64_t hi_lo = a_hi * b_lo;
+            const uint64_t lo_hi = a_lo * b_hi;
+            const uint64_t hi_hi = a_hi * b_hi;
+
+            // sum of the middle terms and the carry out of the low word; cannot overflow
+            const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffull) + lo_hi;
+
+            const uint64_t lo = (cross << 32) | (lo_lo & 0xffffffffull);
+            const uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+
+            return lo ^ hi;
         }
-    };
 
-    template <typename ... T_>
-    struct hash<std::tuple<T_ ...>>
-    {
-        size_t operator() (const std::tuple<T_ ...> & t) const
+        /*!
+         * 64-bit hash of a fixed-length sequence of key words.
+         *
+         * Each word is folded into the state with a full 64x64->128 bit multiplication,
+         * so that every input bit affects both the high bits (used to select a shard) and
+         * the low bits (used to select a slot) of the result.
+         */
+        template <std::size_t n_>
+        inline uint64_t memoisation_hash(const std::array<uint64_t, n_> & words)
         {
-            return __TupleHasher<sizeof...(T_) - 1, T_ ...>::hash(t);
-        }
-    };
-}
+            static const uint64_t secret[3] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull };
 
-namespace eos
-{
-    namespace implementation
-    {
-        template <typename T_> struct ResultOf;
+            uint64_t h = secret[0];
+            for (const auto & w : words)
+            {
+                h = memoisation_mum(h ^ secret[1], w ^ secret[2]);
+            }
 
-        template <typename Result_, typename Class_, typename ... Args_>
-        struct ResultOf<Result_ (Class_::*) (Args_ ...)>
-        {
-            using Type = Result_;
-        };
+            return memoisation_mum(h ^ secret[0], n_ ^ secret[1]);
+        }
 
-        template <typename Result_, typename ... Args_>
-        struct ResultOf<Result_ (*) (Args_ ...)>
+        /*!
+         * Flat open-addressing hash table for fixed-length keys of 64-bit words.
+         *
+         * Uses linear probing in a power-of-two sized array with a maximal load factor of 1/2.
+         * Deletion shifts the subsequent entries of the cluster backwards, so that no tombstones
+         * are needed and the probe lengths do not degrade under CLOCK eviction.
+         */
+        template <std::size_t n_, typename Value_>
+        class MemoisationTable
         {
-            using Type = Result_;
+            public:
+                using Key = std::array<uint64_t, n_>;
+
+            private:
+                struct Slot
+                {
+                    Key key;
+
+                    uint64_t hash;
+
+                    Value_ value;
+
+                    bool occupied = false;
+                };
+
+                std::vector<Slot> _slots;
+
+                std::size_t _size = 0;
+
+                std::size_t home(const uint64_t & hash) const
+                {
+                    return hash & (_slots.size() - 1);
+                }
+
+                // distance of slot idx from the home slot of its entry
+                std::size_t displacement(const std::size_t & idx) const
+                {
+                    return (idx - home(_slots[idx].hash)) & (_slots.size() - 1);
+                }
+
+                std::size_t locate(const Key & key, const uint64_t & hash) const
+                {
+                    for (std::size_t idx = home(hash) ; ; idx = (idx + 1) & (_slots.size() - 1))
+                    {
+                        const Slot & slot = _slots[idx];
+
+                        if (! slot.occupied)
+                            return _slots.size();
+
+                        if ((slot.hash == hash) && (slot.key == key))
+                            return idx;
+                    }
+                }
+
+                void place(Slot && slot)
+                {
+                    std::size_t idx = home(slot.hash);
+                    while (_slots[idx].occupied)
+                    {
+                        idx = (idx + 1) & (_slots.size() - 1);
+                    }
+
+                    _slots[idx] = std::move(slot);
+                }
+
+                void grow()
+                {
+                    std::vector<Slot> slots(std::max<std::size_t>(16, 2 * _slots.size()));
+                    std::swap(slots, _slots);
+
+                    for (auto & slot : slots)
+                    {
+                        if (slot.occupied)
+                            place(std::move(slot));
+                    }
+                }
+
+            public:
+                Value_ * find(const Key & key, const uint64_t & hash)
+                {
+                    if (_slots.empty())
+                        return nullptr;
+
+                    std::size_t idx = locate(key, hash);
+
+                    return (_slots.size() == idx) ? nullptr : &_slots[idx].value;
+                }
+
+                /// Insert a key that is not yet present in the table.
+                Value_ & insert(const Key & key, const uint64_t & hash, const Value_ & value)
+                {
+                    if (2 * (_size + 1) > _slots.size())
+                        grow();
+
+                    std::size_t idx = home(hash);
+                    while (_slots[idx].occupied)
+                    {
+                        idx = (idx + 1) & (_slots.size() - 1);
+                    }
+
+                    _slots[idx] = Slot{ key, hash, value, true };
+                    ++_size;
+
+                    return _slots[idx].value;
+                }
+
+                bool erase(const Key & key, const uint64_t & hash)
+                {
+                    if (_slots.empty())
+                        return false;
+
+                    std::size_t idx = locate(key, hash);
+                    if (_slots.size() == idx)
+                        return false;
+
+                    // backward-shift deletion: move each subsequent entry of the cluster into the hole,
+                    // unless its home slot lies between the hole and its present slot
+                    const std::size_t mask = _slots.size() - 1;
+                    for (std::size_t next = (idx + 1) & mask ; _slots[next].occupied ; next = (next + 1) & mask)
+                    {
+                        if (displacement(next) < ((next - idx) & mask))
+                            continue;
+
+                        _slots[idx] = std::move(_slots[next]);
+                        idx = next;
+                    }
+
+                    _slots[idx].occupied = false;
+                    --_size;
+
+                    return true;
+                }
+
+                void clear()
+                {
+                    for (auto & slot : _slots)
+                    {
+                        slot.occupied = false;
+                    }
+
+                    _size = 0;
+                }
+
+                std::size_t size() const
+                {
+                    return _size;
+                }
+
+                /// Add the number of entries that are found after (k + 1) probes to histogram[k].
+                void probe_lengths(std::vector<unsigned long> & histogram) const
+                {
+                    for (std::size_t idx = 0 ; idx < _slots.size() ; ++idx)
+                    {
+                        if (! _slots[idx].occupied)
+                            continue;
+
+                        const std::size_t k = displacement(idx);
+                        if (histogram.size() <= k)
+                            histogram.resize(k + 1, 0);
+
+                        ++histogram[k];
+                    }
+                }
         };
     }
 
+    /*!
+     * Counters that describe the efficiency of a memoisation table.
+     */
+    struct MemoisationStatistics
+    {
+        /// Number of lookups that were answered from the table.
+        unsigned long hits = 0;
+
+        /// Number of lookups that required an evaluation of the memoised function.
+        unsigned long misses = 0;
+
+        /// Number of entries that were evicted to make room for new ones.
+        unsigned long evictions = 0;
+    };
+
     class MemoisationControl :
         public InstantiationPolicy<MemoisationControl, Singleton>
     {
@@ -104,6 +307,8 @@ namespace eos
 
             std::vector<std::function<void ()>> _clear_functions;
 
+            std::atomic<unsigned long> _capacity;
+
         public:
             MemoisationControl();
 
@@ -112,67 +317,261 @@ namespace eos
             void register_clear_function(const std::function<void ()> & clear_function);
 
             void clear();
+
+            /*!
+             * Retrieve the maximal number of entries per memoised signature.
+             *
+             * Defaults to 100000, or the value of the environment variable EOS_MEMOISATION_CAPACITY.
+             */
+            unsigned long capacity() const;
+
+            /*!
+             * Set the maximal number of entries per memoised signature.
+             *
+             * @param capacity  The new maximal number of entries; must be positive.
+             */
+            void set_capacity(const unsigned long & capacity);
     };
 
+    /*!
+     * Memoiser keeps the results of all calls to functions with a common signature.
+     *
+     * The table is split into shards, each protected by its own lock. The memoised
+     * function is evaluated outside of the lock, and concurrent requests for the same
+     * key wait for the first evaluation to complete. Once a shard exceeds its share of
+     * MemoisationControl::capacity(), entries are evicted according to the CLOCK algorithm.
+     *
+     * Within each shard, the memoisations are kept in a flat open-addressing table,
+     * keyed on the bit patterns of the function pointer and the parameters.
+     */
     template <typename Result_, typename ... Params_>
     class Memoiser :
         public InstantiationPolicy<Memoiser<Result_, Params_ ...>, Singleton>
     {
         public:
             using FunctionType = Result_(*)(const Params_ & ...);
-            using KeyType = std::tuple<FunctionType, Params_...>;
+
+            /// The key consists of the bit patterns of the function pointer and of all parameters.
+            using KeyType = std::array<uint64_t, 1 + sizeof...(Params_)>;
+
+            static constexpr unsigned number_of_shards = 32;
 
         private:
-            Mutex * const _mutex;
+            struct Entry
+            {
+                Result_ result;
 
-            std::unordered_map<KeyType, Result_> _memoisations;
+                // false as long as the result is being computed
+                bool ready;
 
-        public:
-            Memoiser() :
-                _mutex(new Mutex)
+                // CLOCK reference bit
+                bool referenced;
+            };
+
+            struct ClockEntry
             {
-                MemoisationControl::instance()->register_clear_function(std::bind(&Memoiser<Result_, Params_ ...>::clear, this));
+                KeyType key;
+
+                uint64_t hash;
+            };
+
+            struct Shard
+            {
+                Mutex mutex;
+
+                ConditionVariable completion;
+
+                implementation::MemoisationTable<1 + sizeof...(Params_), Entry> memoisations;
+
+                // keys in order of insertion, traversed by the CLOCK hand
+                std::vector<ClockEntry> clock;
+
+                std::size_t hand = 0;
+
+                MemoisationStatistics statistics;
+            };
+
+            mutable std::array<Shard, number_of_shards> _shards;
+
+            // the low bits of the hash select the slot within the shard, the high bits select the shard
+            Shard & shard(const uint64_t & hash)
+            {
+                return _shards[(hash >> 32) % number_of_shards];
             }
 
-            ~Memoiser()
+            // make room for a new key; requires the shard's lock to be held
+            static void insert(Shard & s, const KeyType & key, const uint64_t & hash)
             {
-                delete _mutex;
+                const std::size_t capacity = std::max(1ul, MemoisationControl::instance()->capacity() / number_of_shards);
+
+                if (s.clock.size() < capacity)
+                {
+                    s.clock.push_back(ClockEntry{ key, hash });
+                    return;
+                }
+
+                // entries that are still being computed cannot be evicted; give up after two revolutions
+                for (std::size_t n = 0 ; n < 2 * s.clock.size() ; ++n)
+                {
+                    s.hand = (s.hand + 1) % s.clock.size();
+
+                    ClockEntry & c = s.clock[s.hand];
+                    Entry * e = s.memoisations.find(c.key, c.hash);
+                    if (nullptr != e)
+                    {
+                        if (! e->ready)
+                            continue;
+
+                        if (e->referenced)
+                        {
+                            e->referenced = false;
+                            continue;
+                        }
+
+                        s.memoisations.erase(c.key, c.hash);
+                        ++s.statistics.evictions;
+                    }
+
+                    c = ClockEntry{ key, hash };
+                    return;
+                }
+
+                s.clock.push_back(ClockEntry{ key, hash });
             }
 
+        public:
+            Memoiser()
+            {
+                MemoisationControl::instance()->register_clear_function(std::bind(&Memoiser<Result_, Params_ ...>::clear, this));
+            }
+
+            ~Memoiser() = default;
+
             Result_ operator() (const FunctionType & f, const Params_ & ... p)
             {
-                Lock l(*_mutex);
+                const KeyType key{ implementation::memoisation_word(f), implementation::memoisation_word(p) ... };
+                const uint64_t hash = implementation::memoisation_hash(key);
+                Shard & s = shard(hash);
+
+                {
+                    Lock l(s.mutex);
+
+                    while (true)
+                    {
+                        Entry * e = s.memoisations.find(key, hash);
+
+                        if (nullptr == e)
+                            break;
 
-                KeyType key(f, p ...);
-                auto i = _memoisations.find(key);
+                        if (e->ready)
+                        {
+                            ++s.statistics.hits;
+                            e->referenced = true;
 
-                if (_memoisations.end() != i)
-                    return i->second;
+                            return e->result;
+                        }
 
-                Result_ result = f(p ...);
+                        // another thread is computing the result
+                        s.completion.wait(s.mutex);
+                    }
 
-                if (_memoisations.size() > 100000u)
+                    ++s.statistics.misses;
+                    insert(s, key, hash);
+                    s.memoisations.insert(key, hash, Entry{ Result_(), false, true });
+                }
+
+                Result_ result;
+                try
                 {
-                    _memoisations.clear();
+                    result = f(p ...);
                 }
+                catch (...)
+                {
+                    Lock l(s.mutex);
 
-                _memoisations.insert(std::pair<KeyType, Result_>(key, result));
+                    s.memoisations.erase(key, hash);
+                    s.completion.broadcast();
+
+                    throw;
+                }
+
+                {
+                    Lock l(s.mutex);
+
+                    // the entry is gone if the memoisations have been cleared in the meantime
+                    Entry * e = s.memoisations.find(key, hash);
+                    if (nullptr != e)
+                    {
+                        e->result = result;
+                        e->ready  = true;
+                    }
+
+                    s.completion.broadcast();
+                }
 
                 return result;
             }
 
             void clear()
             {
-                Lock l(*_mutex);
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
 
-                _memoisations.clear();
+                    s.memoisations.clear();
+                    s.clock.clear();
+                    s.hand = 0;
+                    s.completion.broadcast();
+                }
             }
 
             unsigned number_of_memoisations() const
             {
-                Lock l(*_mutex);
+                unsigned result = 0;
 
-                return _memoisations.size();
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    result += s.memoisations.size();
+                }
+
+                return result;
+            }
+
+            MemoisationStatistics statistics() const
+            {
+                MemoisationStatistics result;
+
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    result.hits      += s.statistics.hits;
+                    result.misses    += s.statistics.misses;
+                    result.evictions += s.statistics.evictions;
+                }
+
+                return result;
+            }
+
+            /*!
+             * Retrieve the distribution of probe lengths across all shards.
+             *
+             * Element k of the result is the number of memoisations that are found after (k + 1) probes.
+             */
+            std::vector<unsigned long> probe_lengths() const
+            {
+                std::vector<unsigned long> result;
+
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    s.memoisations.probe_lengths(result);
+                }
+
+                return result;
             }
     };
 
@@ -187,6 +586,12 @@ namespace eos
     {
         return Memoiser<typename implementation::ResultOf<FunctionType_>::Type, Params ...>::instance()->number_of_memoisations();
     }
+
+    template <typename FunctionType_, typename ... Params>
+    MemoisationStatistics memoisation_statistics(FunctionType_, const Params & ...)
+    {
+        return Memoiser<typename implementation::ResultOf<FunctionType_>::Type, Params ...>::instance()->statistics();
+    }
 }
 
 #endif
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -19,8 +20,15 @@
 
 #include <test/test.hh>
 #include <eos/utils/memoise.hh>
+#include <eos/utils/thread_pool.hh>
 
+#include <atomic>
+#include <cmath>
 #include <complex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
 
 using namespace test;
 using namespace eos;
@@ -44,6 +52,51 @@ class MemoiseTest :
             return std::complex<double>(x, y);
         }
 
+        static std::atomic<unsigned> f3_evaluations;
+
+        static double f3(const double & x)
+        {
+            ++f3_evaluations;
+            usleep(10000);
+
+            return 2.0 * x;
+        }
+
+        static double f4(const double & x, const double & y, const double & z)
+        {
+            return x + y + z;
+        }
+
+        // stand-ins with the signatures of CharmLoops::F{1,2}{7,9}_massive(mu, s, m_b, m_c)
+        static std::complex<double> charm17(const double & mu, const double & s, const double & m_b, const double & m_c) { return { mu + s, m_b * m_c }; }
+        static std::complex<double> charm27(const double & mu, const double & s, const double & m_b, const double & m_c) { return { mu - s, m_b * m_c }; }
+        static std::complex<double> charm19(const double & mu, const double & s, const double & m_b, const double & m_c) { return { mu * s, m_b + m_c }; }
+        static std::complex<double> charm29(const double & mu, const double & s, const double & m_b, const double & m_c) { return { mu / s, m_b - m_c }; }
+
+        // stand-ins with the signatures of Bremsstrahlung::itau_2{2,7,8,9}(s_hat, z)
+        static std::complex<double> itau22(const double & s_hat, const double & z) { return { s_hat, z }; }
+        static std::complex<double> itau27(const double & s_hat, const double & z) { return { z, s_hat }; }
+        static std::complex<double> itau28(const double & s_hat, const double & z) { return { s_hat + z, 0.0 }; }
+        static std::complex<double> itau29(const double & s_hat, const double & z) { return { 0.0, s_hat + z }; }
+
+        // the memoisations of one Memoiser are found after few probes on average, and none is displaced far from its home slot
+        template <typename Memoiser_>
+        static void check_probe_lengths(const unsigned long & expected_entries)
+        {
+            auto histogram = Memoiser_::instance()->probe_lengths();
+
+            unsigned long entries = 0, probes = 0;
+            for (unsigned k = 0 ; k < histogram.size() ; ++k)
+            {
+                entries += histogram[k];
+                probes  += (k + 1) * histogram[k];
+            }
+
+            TEST_CHECK_EQUAL(entries, expected_entries);
+            TEST_CHECK(double(probes) / entries < 2.0);
+            TEST_CHECK(histogram.size() <= 32);
+        }
+
         virtual void run() const
         {
             /* f1 */
@@ -104,5 +157,109 @@ class MemoiseTest :
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f1, 0.0, 0.0));
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f2, 0.0, 0.0));
             }
+
+            /* Statistics */
+            {
+                auto before = memoisation_statistics(f1, 0.0, 0.0);
+
+                TEST_CHECK_EQUAL(0.25, memoise(f1, 1.0, 4.0));
+                TEST_CHECK_EQUAL(0.25, memoise(f1, 1.0, 4.0));
+                TEST_CHECK_EQUAL(0.25, memoise(f1, 1.0, 4.0));
+
+                auto after = memoisation_statistics(f1, 0.0, 0.0);
+                TEST_CHECK_EQUAL(after.misses - before.misses, 1);
+                TEST_CHECK_EQUAL(after.hits - before.hits,     2);
+            }
+
+            /* Concurrent requests for the same key evaluate the function only once */
+            {
+                std::vector<Ticket> tickets;
+                std::vector<double> results(16, 0.0);
+                for (unsigned i = 0 ; i < results.size() ; ++i)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue([&results, i] () { results[i] = memoise(f3, 3.0); }));
+                }
+
+                for (auto & t : tickets)
+                {
+                    t.wait();
+                }
+
+                TEST_CHECK_EQUAL(1, f3_evaluations);
+                for (const auto & r : results)
+                {
+                    TEST_CHECK_EQUAL(6.0, r);
+                }
+            }
+
+            /* Bounded capacity */
+            {
+                const auto capacity = MemoisationControl::instance()->capacity();
+                const unsigned long budget = Memoiser<double, double, double, double>::number_of_shards * 4;
+                MemoisationControl::instance()->set_capacity(budget);
+
+                for (unsigned i = 0 ; i < 10000 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(i + 3.0, memoise(f4, double(i), 1.0, 2.0));
+                }
+
+                TEST_CHECK(number_of_memoisations(f4, 0.0, 0.0, 0.0) <= budget);
+                TEST_CHECK(memoisation_statistics(f4, 0.0, 0.0, 0.0).evictions > 0);
+
+                MemoisationControl::instance()->set_capacity(capacity);
+                TEST_CHECK_THROWS(InternalError, MemoisationControl::instance()->set_capacity(0));
+            }
+
+            /*
+             * Probe lengths for the key patterns of inclusive-b-to-s-dilepton.cc:
+             * (F_massive, mu, s, m_b, m_c) and (itau, s_hat, z) on a grid of s values,
+             * for a set of parameter points with varying quark masses.
+             */
+            {
+                using CharmLoopsMemoiser = Memoiser<std::complex<double>, double, double, double, double>;
+                using BremsstrahlungMemoiser = Memoiser<std::complex<double>, double, double>;
+                CharmLoopsMemoiser::instance()->clear();
+                BremsstrahlungMemoiser::instance()->clear();
+
+                const auto charm = { charm17, charm27, charm19, charm29 };
+                const auto itau  = { itau22, itau27, itau28, itau29 };
+                const double mu = 4.2;
+
+                unsigned long charm_entries = 0, bremsstrahlung_entries = 0;
+                for (unsigned round = 0 ; round < 2 ; ++round)
+                {
+                    for (unsigned point = 0 ; point < 32 ; ++point)
+                    {
+                        const double m_b = 4.18 + 0.03 * std::sin(point);
+                        const double m_c = 1.27 + 0.02 * std::cos(3.0 * point);
+                        const double z   = (m_c / m_b) * (m_c / m_b);
+
+                        for (unsigned i = 0 ; i < 64 ; ++i)
+                        {
+                            const double s     = 1.0 + 5.0 * i / 63.0;
+                            const double s_hat = s / (m_b * m_b);
+
+                            for (auto f : charm)
+                            {
+                                TEST_CHECK(f(mu, s, m_b, m_c) == memoise(f, mu, s, m_b, m_c));
+                                if (0 == round)
+                                    ++charm_entries;
+                            }
+
+                            for (auto f : itau)
+                            {
+                                TEST_CHECK(f(s_hat, z) == memoise(f, s_hat, z));
+                                if (0 == round)
+                                    ++bremsstrahlung_entries;
+                            }
+                        }
+                    }
+                }
+
+                check_probe_lengths<CharmLoopsMemoiser>(charm_entries);
+                check_probe_lengths<BremsstrahlungMemoiser>(bremsstrahlung_entries);
+            }
         }
 } memoise_test;
+
+std::atomic<unsigned> MemoiseTest::f3_evaluations(0);
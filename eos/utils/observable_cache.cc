@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011, 2016, 2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -19,6 +20,7 @@
  */
 
 #include <eos/utils/expression-cacher.hh>
+#include <eos/utils/expression-compiler.hh>
 #include <eos/utils/expression-observable.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/observable_cache.hh>
@@ -28,10 +30,15 @@
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
 #include <limits>
-#include <map>
+#include <memory>
+#include <set>
 #include <tuple>
 #include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 namespace eos
@@ -56,17 +63,84 @@ namespace eos
         std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> regular_observables;
 
         // Contains each cacheable observable and its associated index
-        std::multimap<std::type_index, std::tuple<CacheableObservable *, ObservableCache::Id>> cacheable_observables;
+        std::vector<std::tuple<CacheableObservable *, ObservableCache::Id>> cacheable_observables;
 
-        // Contains each cached observable and its associated index
-        std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> cached_observables;
+        // Maps the hashed identity of each observable to its index, cf. identity_hash()
+        std::unordered_multimap<std::size_t, ObservableCache::Id> observable_index;
+
+        // Contains the hashed identity under which each observable is found in observable_index
+        std::vector<std::size_t> observable_identities;
+
+        // Maps the hashed type, options and kinematic variable names of each cacheable observable to its position in cacheable_observables, cf. cacheable_hash()
+        std::unordered_multimap<std::size_t, std::size_t> cacheable_index;
+
+        // Contains each cached observable, its associated index, and the index of the cacheable observable that it is cached from
+        std::vector<std::tuple<ObservablePtr, ObservableCache::Id, ObservableCache::Id>> cached_observables;
 
         // Contains each expression observable and its associated index
         std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> expression_observables;
 
+        // Contains the compiled program of each expression observable, in the order of expression_observables
+        std::vector<exp::CompiledExpression> expression_programs;
+
+        // Contains the positions within expression_observables, grouped into levels. Expression observables
+        // only rely on expression observables in lower levels, and are independent of each other within a level.
+        std::vector<std::vector<std::size_t>> expression_levels;
+
+        // Maps the index of each expression observable to its level
+        std::unordered_map<ObservableCache::Id, unsigned> expression_level;
+
         // Contains values of all observables
         std::vector<double> predictions;
 
+        // Contains values and gradients of all observables, cf. ObservableCache::update_gradients()
+        std::vector<Dual> duals;
+
+        // Records the inputs of an observable at the time of its last evaluation
+        struct Dependencies
+        {
+            // Ids of all parameters used by the observable
+            std::vector<Parameter::Id> parameter_ids;
+
+            // Values of the observable's kinematic variables
+            std::vector<double> kinematics;
+
+            // Version of the parameters
+            Parameters::Version version = 0;
+
+            // Whether the last evaluation produced a valid prediction
+            bool valid = false;
+        };
+
+        // Contains the dependencies of all observables
+        std::vector<Dependencies> dependencies;
+
+        // Clones of the parameters and of the observables that do not support automatic differentiation,
+        // which update_gradients() varies to obtain central differences; one set per worker thread
+        struct FiniteDifferences
+        {
+            Parameters parameters;
+
+            ObservableCache cache;
+
+            // The clones of the observables, and their ids within the cache
+            std::vector<ObservablePtr> observables;
+            std::vector<ObservableCache::Id> ids;
+
+            FiniteDifferences(const Parameters & parameters) :
+                parameters(parameters),
+                cache(parameters)
+            {
+            }
+        };
+
+        // Kept across calls to update_gradients(), and created anew only when the observables or the parameters change
+        std::vector<std::unique_ptr<FiniteDifferences>> finite_differences;
+
+        // The observables and the number of parameters that finite_differences was created for
+        std::vector<ObservableCache::Id> finite_differences_observables;
+        std::size_t finite_differences_parameters = 0;
+
         Implementation(const Parameters & parameters) :
             parameters(parameters)
         {
@@ -99,19 +173,180 @@ namespace eos
             return true;
         }
 
+        static std::size_t combine(const std::size_t & seed, const std::size_t & value)
+        {
+            return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+        }
+
+        // Hash of the names of the kinematic variables, independent of the order of their declaration
+        static std::size_t kinematic_names_hash(const std::size_t & seed, const Kinematics & kinematics)
+        {
+            std::size_t names = 0;
+            for (const auto & k : kinematics)
+            {
+                names += std::hash<std::string>()(k.name());
+            }
+
+            return combine(seed, names);
+        }
+
+        // Hash of the names and values of the kinematic variables, independent of the order of their declaration
+        static std::size_t kinematics_hash(const std::size_t & seed, const Kinematics & kinematics)
+        {
+            // values that compare equal hash equally, including 0.0 and -0.0
+            std::size_t variables = 0;
+            for (const auto & k : kinematics)
+            {
+                const double value = k.evaluate();
+                variables += combine(std::hash<std::string>()(k.name()), std::hash<double>()(0.0 == value ? 0.0 : value));
+            }
+
+            return combine(seed, variables);
+        }
+
+        // Hash of the properties compared by identical_observables(), i.e., name, kinematics and options
+        static std::size_t identity_hash(const ObservablePtr & observable)
+        {
+            std::size_t result = std::hash<std::string>()(observable->name().str());
+            result = kinematics_hash(result, observable->kinematics());
+            result = combine(result, std::hash<std::string>()(observable->options().as_string()));
+
+            return result;
+        }
+
+        void insert_identity(const std::size_t & identity, const ObservableCache::Id & idx)
+        {
+            observable_index.insert(std::make_pair(identity, idx));
+            observable_identities.resize(idx + 1);
+            observable_identities[idx] = identity;
+        }
+
+        // Move an observable whose kinematics have changed to the position of its new identity within observable_index
+        void update_identity(const ObservableCache::Id & idx)
+        {
+            const std::size_t identity = identity_hash(observables[idx]);
+            if (identity == observable_identities[idx])
+                return;
+
+            auto range = observable_index.equal_range(observable_identities[idx]);
+            for (auto i = range.first ; i != range.second ; ++i)
+            {
+                if (idx == i->second)
+                {
+                    observable_index.erase(i);
+                    break;
+                }
+            }
+
+            insert_identity(identity, idx);
+        }
+
+        // Hash of the properties that make_cached_observable() requires to agree between two cacheable observables,
+        // i.e., type, options, and names of the kinematic variables
+        static std::size_t cacheable_hash(CacheableObservable * observable)
+        {
+            std::size_t result = std::hash<std::type_index>()(std::type_index(typeid(*observable)));
+            result = combine(result, std::hash<std::string>()(observable->options().as_string()));
+            result = kinematic_names_hash(result, observable->kinematics());
+
+            return result;
+        }
+
+        static std::vector<double> kinematic_values(const ObservablePtr & observable)
+        {
+            std::vector<double> result;
+            for (const auto & k : observable->kinematics())
+            {
+                result.push_back(k.evaluate());
+            }
+
+            return result;
+        }
+
+        void push_back(const ObservablePtr & observable)
+        {
+            observables.push_back(observable);
+            predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+            duals.push_back(Dual(std::numeric_limits<double>::quiet_NaN()));
+
+            Dependencies d;
+            for (auto i = observable->begin(), i_end = observable->end() ; i != i_end ; ++i)
+            {
+                d.parameter_ids.push_back(*i);
+            }
+            dependencies.push_back(std::move(d));
+        }
+
+        // Determine if the observable's inputs have changed since its last evaluation
+        bool stale(const ObservableCache::Id & idx)
+        {
+            auto & d = dependencies[idx];
+
+            auto kinematics = kinematic_values(observables[idx]);
+            if (kinematics != d.kinematics)
+            {
+                d.kinematics = std::move(kinematics);
+                update_identity(idx);
+                return true;
+            }
+
+            if (! d.valid)
+                return true;
+
+            // we cannot distinguish an observable that does not use any parameter
+            // from an observable that does not record its parameters
+            if (d.parameter_ids.empty())
+                return true;
+
+            for (const auto & id : d.parameter_ids)
+            {
+                if (parameters.version(id) > d.version)
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Evaluate an observable, and record the version of the parameters it is current with
+        void evaluate(Observable * o, const ObservableCache::Id & idx, const Parameters::Version & version, const char * kind)
+        {
+            try
+            {
+                predictions[idx] = o->evaluate();
+                dependencies[idx].version = version;
+                dependencies[idx].valid   = true;
+            }
+            catch (eos::Exception & e)
+            {
+                Log::instance()->message("ObservableCache::update", ll_error)
+                    << "Exception encountered when evaluating " << kind << " observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
+                    << e.what();
+                predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+                dependencies[idx].valid = false;
+            }
+        }
+
         ObservableCache::Id add(const ObservablePtr & observable, const ObservableCache & cache)
         {
             if (observable->parameters() != parameters)
                 throw InternalError("ObservableSet::add(): Mismatch of Parameters between different observables detected.");
 
-            // compare each observable for options, kinematics and name
-            unsigned index = 0;
-            for (auto i = observables.begin(), i_end = observables.end() ; i != i_end ; ++i, ++index)
+            // look up only those observables whose name, kinematics and options hash equally,
+            // and compare them for options, kinematics and name
+            //
+            // Kinematics are mutable. An observable is moved to its new position within the index
+            // once update() notices that its kinematics have changed. Until then, an identical
+            // observable can be added a second time, which costs only a redundant evaluation.
+            const std::size_t identity = identity_hash(observable);
+            auto candidates = observable_index.equal_range(identity);
+            for (auto i = candidates.first, i_end = candidates.second ; i != i_end ; ++i)
             {
-                if (identical_observables(*i, observable))
-                    return index;
+                if (identical_observables(observables[i->second], observable))
+                    return i->second;
             }
 
+            ObservableCache::Id index = observables.size();
+
             CacheableObservable * cacheable_observable = dynamic_cast<CacheableObservable *>(observable.get());
             ExpressionObservable * expression_observable = dynamic_cast<ExpressionObservable *>(observable.get());
 
@@ -126,53 +361,70 @@ namespace eos
                 // ensure that the new index is correct, since the ExpressionCacher is capable to modify our cache
                 index = observables.size();
 
-                observables.push_back(cached_expression_observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+                push_back(cached_expression_observable);
+                insert_identity(identity, index);
+
+                // compile the expression; the expression observables it relies on have been added before
+                auto program = exp::ExpressionCompiler::compile(static_cast<ExpressionObservable *>(cached_expression_observable.get())->expression());
+                unsigned level = 0;
+                for (const auto & slot : program.slots)
+                {
+                    auto l = expression_level.find(slot);
+                    if (expression_level.end() != l)
+                        level = std::max(level, l->second + 1);
+                }
+
+                if (expression_levels.size() <= level)
+                    expression_levels.resize(level + 1);
+
+                expression_levels[level].push_back(expression_observables.size());
+                expression_level[index] = level;
                 expression_observables.push_back(std::make_tuple(cached_expression_observable, index));
+                expression_programs.push_back(std::move(program));
 
                 return index;
             }
             else if (nullptr != cacheable_observable) // is the new observable cacheable?
             {
-                std::type_index type_index(typeid(*cacheable_observable));
+                const std::size_t cacheable = cacheable_hash(cacheable_observable);
 
-                // have we encountered this type of cacheable observable before?
-                auto range = cacheable_observables.equal_range(type_index);
+                // have we encountered this type of cacheable observable with the same options and kinematic variables before?
+                auto range = cacheable_index.equal_range(cacheable);
                 for (auto c = range.first, c_end = range.second ; c != c_end ; ++c)
                 {
-                    // have we encountered this cacheable observable with the same properties before?
-                    if (std::get<0>(c->second)->kinematics() != cacheable_observable->kinematics())
-                        continue;
+                    const auto & other = cacheable_observables[c->second];
 
-                    if (std::get<0>(c->second)->options() != cacheable_observable->options())
+                    // have we encountered this cacheable observable with compatible properties before?
+                    // make_cached_observable() decides which properties must agree, e.g., the options and,
+                    // unless the intermediate result is independent of them, the kinematics.
+                    ObservablePtr cached_observable = cacheable_observable->make_cached_observable(std::get<0>(other));
+                    if (! cached_observable)
                         continue;
 
                     // yes! cache it...
-                    ObservablePtr cached_observable = cacheable_observable->make_cached_observable(std::get<0>(c->second));
-                    if (! cached_observable)
-                        throw InternalError("make_cached_observable() failed");
 
                     // add the newly created cached observable
-                    observables.push_back(cached_observable);
-                    predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                    cached_observables.push_back(std::make_tuple(cached_observable, index));
+                    push_back(cached_observable);
+                    cached_observables.push_back(std::make_tuple(cached_observable, index, std::get<1>(other)));
+                    insert_identity(identity, index);
 
                     return index;
                 }
 
                 // else add this new cacheable observable
-                observables.push_back(observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                cacheable_observables.insert(std::make_pair(type_index, std::make_tuple(cacheable_observable, index)));
+                push_back(observable);
+                cacheable_index.insert(std::make_pair(cacheable, cacheable_observables.size()));
+                cacheable_observables.push_back(std::make_tuple(cacheable_observable, index));
+                insert_identity(identity, index);
 
                 return index;
             }
             else
             {
                 // add this new regular observable
-                observables.push_back(observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+                push_back(observable);
                 regular_observables.push_back(std::make_tuple(observable, index));
+                insert_identity(identity, index);
 
                 return index;
             }
@@ -199,123 +451,259 @@ namespace eos
     void
     ObservableCache::update()
     {
-        // parallelize the evaluation of the observables
-        std::vector<Ticket> cacheable_tickets;
-        cacheable_tickets.reserve(_imp->cacheable_observables.size());
+        // all observables evaluated in this update are current with respect to this version
+        const Parameters::Version version = _imp->parameters.version();
 
-        // evaluate all cacheable observables in parallel
-        for (auto co : _imp->cacheable_observables)
-        {
-            auto f = [=]() {
-                auto & o   = std::get<0>(co.second);
-                auto & idx = std::get<1>(co.second);
-                try
-                {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating cacheable observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+        // determine which observables need to be re-evaluated, since their inputs have changed
+        std::vector<char> evaluate(_imp->observables.size(), false);
 
-                }
-            };
-            cacheable_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
-        }
+        // stale observables that can be evaluated in parallel, and their kinds
+        std::vector<std::tuple<Observable *, ObservableCache::Id, const char *>> stale;
+        stale.reserve(_imp->observables.size());
 
-        std::vector<Ticket> regular_tickets;
-        regular_tickets.reserve(_imp->regular_observables.size());
+        std::function<void (const std::size_t &)> f = [&](const std::size_t & i) {
+            _imp->evaluate(std::get<0>(stale[i]), std::get<1>(stale[i]), version, std::get<2>(stale[i]));
+        };
 
-        // evaluate all regular observables in parallel
-        for (auto ro : _imp->regular_observables)
+        // evaluate all stale cacheable and regular observables in parallel
+        for (auto co : _imp->cacheable_observables)
         {
-            auto f = [=]() {
-                auto & o   = std::get<0>(ro);
-                auto & idx = std::get<1>(ro);
-                try
-                {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating regular observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+            const auto & idx = std::get<1>(co);
+            if (! _imp->stale(idx))
+                continue;
 
-                }
-            };
-            regular_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
+            evaluate[idx] = true;
+            stale.emplace_back(std::get<0>(co), idx, "cacheable");
         }
 
-        // await completion of the cacheable observables
-        for (auto ticket : cacheable_tickets)
+        for (auto ro : _imp->regular_observables)
         {
-            ticket.wait();
+            const auto & idx = std::get<1>(ro);
+            if (! _imp->stale(idx))
+                continue;
+
+            evaluate[idx] = true;
+            stale.emplace_back(std::get<0>(ro).get(), idx, "regular");
         }
 
-        std::vector<Ticket> cached_tickets;
-        cached_tickets.reserve(_imp->cached_observables.size());
+        ThreadPool::instance()->parallel_for(0, stale.size(), f);
 
-        // evaluate all cached observables in parallel
+        // evaluate all stale cached observables in parallel, once all cacheable observables are complete
+        stale.clear();
         for (auto co : _imp->cached_observables)
         {
-            auto f = [=]() {
-                auto & o   = std::get<0>(co);
-                auto & idx = std::get<1>(co);
-                try
-                {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating cached observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+            const auto & idx    = std::get<1>(co);
+            const auto & source = std::get<2>(co);
 
-                }
-            };
-            cached_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
+            // the intermediate result changes whenever the cacheable observable is re-evaluated
+            if ((! _imp->stale(idx)) && (! evaluate[source]))
+                continue;
+
+            stale.emplace_back(std::get<0>(co).get(), idx, "cached");
         }
 
-        // await completion of the regular observables
-        for (auto ticket : regular_tickets)
+        ThreadPool::instance()->parallel_for(0, stale.size(), f);
+
+        // evaluate all expression observables through their compiled programs, level by level
+        //
+        // An expression observable can rely on other expression observables, which
+        // reside in lower levels. Within each level, the expression observables are
+        // independent of each other and are evaluated in parallel; small levels are
+        // evaluated by the calling thread alone.
+        // Expression observables are evaluated very quickly. For this reason, they
+        // are not subject to dependency tracking.
+        std::size_t level_index = 0;
+        std::function<void (const std::size_t &)> g = [&](const std::size_t & i) {
+            const auto & pos = _imp->expression_levels[level_index][i];
+            _imp->predictions[std::get<1>(_imp->expression_observables[pos])] = _imp->expression_programs[pos].evaluate(_imp->predictions.data());
+        };
+
+        for (level_index = 0 ; level_index < _imp->expression_levels.size() ; ++level_index)
         {
-            ticket.wait();
+            ThreadPool::instance()->parallel_for(0, _imp->expression_levels[level_index].size(), g, 256);
         }
+    }
+
+    void
+    ObservableCache::update_gradients()
+    {
+        update();
+
+        auto & imp = *_imp;
+        const std::vector<Parameter::Id> directions = imp.parameters.gradient_ids();
+        const unsigned dimension = directions.size();
+        const double nan = std::numeric_limits<double>::quiet_NaN();
 
-        // await completion of the cached observables
-        for (auto ticket : cached_tickets)
+        // split the observables by their support for automatic differentiation; expression observables
+        // are differentiated by the chain rule, once the gradients of their operands are known
+        std::vector<ObservableCache::Id> differentiable, numerical;
+        for (ObservableCache::Id idx = 0 ; idx < imp.observables.size() ; ++idx)
         {
-            ticket.wait();
+            if (imp.expression_level.count(idx) > 0)
+                continue;
+
+            if (imp.observables[idx]->differentiable())
+                differentiable.push_back(idx);
+            else
+                numerical.push_back(idx);
         }
 
-        // evaluate all expression observables in a serial fashion
-        //
-        // This is necessary, since an expression observable can rely on
-        // another expression observable, which would be located earlier in
-        // the sequence.
-        // Serial evaluation ensures that no race conditions arise.
-        // There is not reason to optimize this, since expression observables
-        // are evaluated very quickly.
-        for (auto eo : _imp->expression_observables)
-        {
-            auto & o   = std::get<0>(eo);
-            auto & idx = std::get<1>(eo);
+        std::function<void (const std::size_t &)> f = [&](const std::size_t & i) {
+            const auto & idx = differentiable[i];
+            const auto & o   = imp.observables[idx];
             try
             {
-                _imp->predictions[idx] = o->evaluate();
+                imp.duals[idx] = o->evaluate_dual();
             }
             catch (eos::Exception & e)
             {
-                Log::instance()->message("ObservableCache::update", ll_error)
-                    << "Exception encountered when evaluating expression observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
+                Log::instance()->message("ObservableCache::update_gradients", ll_error)
+                    << "Exception encountered when differentiating observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
                     << e.what();
-                _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+                imp.duals[idx] = Dual(nan, std::vector<double>(dimension, nan));
+            }
+        };
+        ThreadPool::instance()->parallel_for(0, differentiable.size(), f);
+
+        if ((0 == dimension) || numerical.empty())
+        {
+            for (const auto & idx : numerical)
+            {
+                imp.duals[idx] = Dual(imp.predictions[idx]);
+            }
+        }
+        else
+        {
+            // determine the parameters that the remaining observables depend on
+            std::set<Parameter::Id> used;
+            bool use_all = false;
+            for (const auto & idx : numerical)
+            {
+                const auto & ids = imp.dependencies[idx].parameter_ids;
+
+                // some observables do not record their parameters
+                if (ids.empty())
+                    use_all = true;
+
+                used.insert(ids.begin(), ids.end());
+            }
+
+            for (const auto & idx : numerical)
+            {
+                imp.duals[idx] = Dual(imp.predictions[idx], std::vector<double>(dimension, 0.0));
+            }
+
+            // the directions that any of the remaining observables depend on
+            std::vector<unsigned> varied;
+            for (unsigned k = 0 ; k < dimension ; ++k)
+            {
+                if (use_all || (used.count(directions[k]) > 0))
+                    varied.push_back(k);
+            }
+
+            // central differences, with a step size that is suitable for both small and vanishing parameters;
+            // the directions are shared among the worker threads, each of which varies its own clones of
+            // the parameters and of the remaining observables, so that our own predictions remain intact
+            static const double step = std::cbrt(std::numeric_limits<double>::epsilon());
+            const std::size_t workers = std::min<std::size_t>(ThreadPool::instance()->number_of_threads(), varied.size());
+            const std::size_t chunk_size = workers > 0 ? (varied.size() + workers - 1) / workers : 0;
+
+            // the clones are kept across calls; discard them if they no longer match our observables and parameters
+            const std::size_t number_of_parameters = std::distance(imp.parameters.begin(), imp.parameters.end());
+            if ((numerical != imp.finite_differences_observables) || (number_of_parameters != imp.finite_differences_parameters))
+            {
+                imp.finite_differences.clear();
+                imp.finite_differences_observables = numerical;
+                imp.finite_differences_parameters  = number_of_parameters;
             }
+
+            if (imp.finite_differences.size() < workers)
+                imp.finite_differences.resize(workers);
+
+            std::function<void (const std::size_t &)> h = [&](const std::size_t & w) {
+                const std::size_t begin = w * chunk_size;
+                const std::size_t end = std::min(begin + chunk_size, varied.size());
+                if (begin >= end)
+                    return;
+
+                auto & fd = imp.finite_differences[w];
+                if (! fd)
+                {
+                    fd.reset(new Implementation<ObservableCache>::FiniteDifferences(imp.parameters.clone()));
+                    for (const auto & idx : numerical)
+                    {
+                        fd->observables.push_back(imp.observables[idx]->clone(fd->parameters));
+                        fd->ids.push_back(fd->cache.add(fd->observables.back()));
+                    }
+                }
+                else
+                {
+                    // synchronise the clones with the current parameters and kinematics; only genuine
+                    // changes are applied, so that the cache re-evaluates only the affected observables
+                    for (const auto & p : imp.parameters)
+                    {
+                        fd->parameters[p.id()].set(p.evaluate());
+                    }
+
+                    for (std::size_t i = 0 ; i < numerical.size() ; ++i)
+                    {
+                        Kinematics target = fd->observables[i]->kinematics();
+                        for (const auto & source : imp.observables[numerical[i]]->kinematics())
+                        {
+                            KinematicVariable t = target[source.name()];
+                            if (t.evaluate() != source.evaluate())
+                                t = source.evaluate();
+                        }
+                    }
+                }
+
+                ObservableCache & cache = fd->cache;
+                const auto & ids = fd->ids;
+
+                std::vector<double> plus(numerical.size());
+                for (std::size_t v = begin ; v < end ; ++v)
+                {
+                    const unsigned & k = varied[v];
+
+                    Parameter p = fd->parameters[directions[k]];
+                    const Parameter original = imp.parameters[directions[k]];
+                    const double x = p.evaluate();
+                    double scale = std::max(std::abs(x), 1.0e-3 * std::abs(original.max() - original.min()));
+                    if (0.0 == scale)
+                        scale = 1.0;
+
+                    const double x_plus = x + step * scale, x_minus = x - step * scale;
+
+                    p.set(x_plus);
+                    cache.update();
+                    for (std::size_t i = 0 ; i < numerical.size() ; ++i)
+                    {
+                        plus[i] = cache[ids[i]];
+                    }
+
+                    p.set(x_minus);
+                    cache.update();
+                    for (std::size_t i = 0 ; i < numerical.size() ; ++i)
+                    {
+                        imp.duals[numerical[i]].gradient[k] = (plus[i] - cache[ids[i]]) / (x_plus - x_minus);
+                    }
+
+                    p.set(x);
+                }
+            };
+            ThreadPool::instance()->parallel_for(0, workers, h);
+        }
+
+        // differentiate the expression observables through their compiled programs, level by level
+        std::size_t level_index = 0;
+        std::function<void (const std::size_t &)> g = [&](const std::size_t & i) {
+            const auto & pos = imp.expression_levels[level_index][i];
+            imp.duals[std::get<1>(imp.expression_observables[pos])] = imp.expression_programs[pos].evaluate_dual(imp.duals.data());
+        };
+
+        for (level_index = 0 ; level_index < imp.expression_levels.size() ; ++level_index)
+        {
+            ThreadPool::instance()->parallel_for(0, imp.expression_levels[level_index].size(), g, 256);
         }
     }
 
@@ -331,6 +719,12 @@ namespace eos
         return _imp->predictions[id];
     }
 
+    const Dual &
+    ObservableCache::dual(const ObservableCache::Id & id) const
+    {
+        return _imp->duals[id];
+    }
+
     ObservablePtr
     ObservableCache::observable(const ObservableCache::Id & id) const
     {
@@ -364,7 +758,7 @@ namespace eos
         {
             // cloning cached observables creates independent *cacheable* observables
             // adding them back creates new and independent cached observables
-            result._imp->add((*o)->clone(parameters), *this);
+            result._imp->add((*o)->clone(parameters), result);
         }
 
         result.update();
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -56,9 +57,27 @@ namespace eos
              */
             Id add(const ObservablePtr & observable);
 
-            /// Update the predictions for all observables.
+            /*!
+             * Update the predictions for all observables.
+             *
+             * Observables whose parameters and kinematic variables are unchanged
+             * since their last successful evaluation are not re-evaluated.
+             */
             void update();
 
+            /*!
+             * Update the predictions for all observables together with their gradients
+             * with respect to the parameters selected through Parameters::seed_gradient().
+             *
+             * Observables that support automatic differentiation are evaluated through
+             * Observable::evaluate_dual(). For all other observables, the gradient is
+             * obtained from central differences. The selected parameters are shared among
+             * the threads of the ThreadPool. Each thread varies its parameters in turn on its
+             * own clones of the Parameters and of these observables. The clones are kept
+             * for subsequent calls, and are synchronised with the current parameters and kinematics.
+             */
+            void update_gradients();
+
             /// Retrieve the cache's common Parameters object.
             Parameters parameters() const;
 
@@ -76,6 +95,13 @@ namespace eos
              */
             double operator[] (const ObservableCache::Id & id) const;
 
+            /*!
+             * Retrieve the prediction for a given observable and its gradient, as obtained by the last call to update_gradients().
+             *
+             * @param id The unique ObservableCache::Id whose associated observable's prediction shall be retrieved.
+             */
+            const Dual & dual(const ObservableCache::Id & id) const;
+
             /// Retrieve the number of independent predictions from the cache.
             unsigned size() const;
 
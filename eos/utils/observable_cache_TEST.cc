@@ -0,0 +1,357 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/observable.hh>
+#include <eos/utils/observable_cache.hh>
+
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+namespace
+{
+    // Returns the sum of two parameters, and counts its evaluations
+    class CountingObservable :
+        public Observable
+    {
+        private:
+            QualifiedName _name;
+
+            Parameters _parameters;
+
+            Kinematics _kinematics;
+
+            UsedParameter _a;
+
+            UsedParameter _b;
+
+            KinematicVariable _q2;
+
+        public:
+            mutable unsigned evaluations;
+
+            // number of requests for the kinematics, e.g. to compare against other observables
+            unsigned kinematics_requests;
+
+            CountingObservable(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics) :
+                _name(name),
+                _parameters(parameters),
+                _kinematics(kinematics),
+                _a(parameters["mass::c"], *this),
+                _b(parameters["mass::b(MSbar)"], *this),
+                _q2(kinematics["q2"]),
+                evaluations(0),
+                kinematics_requests(0)
+            {
+            }
+
+            virtual const QualifiedName & name() const
+            {
+                return _name;
+            }
+
+            virtual double evaluate() const
+            {
+                ++evaluations;
+
+                return _a() + _b() + _q2();
+            }
+
+            virtual Kinematics kinematics()
+            {
+                ++kinematics_requests;
+
+                return _kinematics;
+            }
+
+            virtual Parameters parameters()
+            {
+                return _parameters;
+            }
+
+            virtual Options options()
+            {
+                return Options();
+            }
+
+            virtual ObservablePtr clone() const
+            {
+                return ObservablePtr(new CountingObservable(_name, _parameters.clone(), _kinematics.clone()));
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                return ObservablePtr(new CountingObservable(_name, parameters, _kinematics.clone()));
+            }
+    };
+
+    // Returns the product of two parameters and a kinematic variable, and counts its clones
+    class ProductObservable :
+        public Observable
+    {
+        private:
+            QualifiedName _name;
+
+            Parameters _parameters;
+
+            Kinematics _kinematics;
+
+            UsedParameter _a;
+
+            UsedParameter _b;
+
+            KinematicVariable _q2;
+
+        public:
+            static unsigned clones;
+
+            ProductObservable(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics) :
+                _name(name),
+                _parameters(parameters),
+                _kinematics(kinematics),
+                _a(parameters["mass::c"], *this),
+                _b(parameters["mass::b(MSbar)"], *this),
+                _q2(kinematics["q2"])
+            {
+            }
+
+            virtual const QualifiedName & name() const
+            {
+                return _name;
+            }
+
+            virtual double evaluate() const
+            {
+                return _a() * _b() * _q2();
+            }
+
+            virtual Kinematics kinematics()
+            {
+                return _kinematics;
+            }
+
+            virtual Parameters parameters()
+            {
+                return _parameters;
+            }
+
+            virtual Options options()
+            {
+                return Options();
+            }
+
+            virtual ObservablePtr clone() const
+            {
+                ++clones;
+
+                return ObservablePtr(new ProductObservable(_name, _parameters.clone(), _kinematics.clone()));
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                ++clones;
+
+                return ObservablePtr(new ProductObservable(_name, parameters, _kinematics.clone()));
+            }
+    };
+
+    unsigned ProductObservable::clones = 0;
+}
+
+class ObservableCacheTest :
+    public TestCase
+{
+    public:
+        ObservableCacheTest() :
+            TestCase("observable_cache_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // Incremental updates
+            {
+                Parameters p = Parameters::Defaults();
+                Kinematics k{ { "q2", 1.0 } };
+
+                auto o = std::make_shared<CountingObservable>("test::counting", p, k);
+
+                ObservableCache cache(p);
+                auto id = cache.add(o);
+
+                // first update always evaluates
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 1u);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], p["mass::c"]() + p["mass::b(MSbar)"]() + 1.0, 1.0e-15);
+
+                // no change in the inputs
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 1u);
+
+                // change of an unused parameter
+                p["mass::tau"] = p["mass::tau"]() + 0.1;
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 1u);
+
+                // setting a used parameter to its present value
+                p["mass::c"] = p["mass::c"]();
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 1u);
+
+                // change of a used parameter
+                p["mass::c"] = 1.5;
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 2u);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], 1.5 + p["mass::b(MSbar)"]() + 1.0, 1.0e-15);
+
+                // change of a used parameter by name
+                p.set("mass::b(MSbar)", 4.0);
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 3u);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], 1.5 + 4.0 + 1.0, 1.0e-15);
+
+                // change of a kinematic variable
+                k.set("q2", 2.0);
+                cache.update();
+                TEST_CHECK_EQUAL(o->evaluations, 4u);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], 1.5 + 4.0 + 2.0, 1.0e-15);
+            }
+
+            // Gradients from finite differences
+            {
+                Parameters p = Parameters::Defaults();
+                p.seed_gradient({ p["mass::c"].id(), p["mass::b(MSbar)"].id(), p["mass::tau"].id() });
+
+                auto o = std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 1.0 } });
+
+                ObservableCache cache(p);
+                auto id = cache.add(o);
+                cache.update_gradients();
+
+                const Dual & d = cache.dual(id);
+                TEST_CHECK_NEARLY_EQUAL(d.value,         p["mass::c"]() + p["mass::b(MSbar)"]() + 1.0, 1.0e-15);
+                TEST_CHECK_NEARLY_EQUAL(d.derivative(0), 1.0,                                          1.0e-8);
+                TEST_CHECK_NEARLY_EQUAL(d.derivative(1), 1.0,                                          1.0e-8);
+                TEST_CHECK_EQUAL(d.derivative(2),        0.0);
+
+                // the parameters are varied on clones, which leaves the observable itself untouched
+                TEST_CHECK_EQUAL(o->evaluations, 1u);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], p["mass::c"]() + p["mass::b(MSbar)"]() + 1.0, 1.0e-15);
+            }
+
+            // Gradients from finite differences follow changes of the parameters and kinematics
+            {
+                Parameters p = Parameters::Defaults();
+                p.seed_gradient({ p["mass::c"].id(), p["mass::b(MSbar)"].id() });
+
+                Kinematics k{ { "q2", 2.0 } };
+                ObservableCache cache(p);
+                auto id = cache.add(std::make_shared<ProductObservable>("test::product", p, k));
+
+                cache.update_gradients();
+                const unsigned clones = ProductObservable::clones;
+                TEST_CHECK(clones > 0u);
+
+                double a = p["mass::c"](), b = p["mass::b(MSbar)"](), q2 = 2.0;
+                TEST_CHECK_RELATIVE_ERROR(cache.dual(id).derivative(0), b * q2, 1.0e-8);
+                TEST_CHECK_RELATIVE_ERROR(cache.dual(id).derivative(1), a * q2, 1.0e-8);
+
+                p["mass::c"] = 1.5;
+                p["mass::b(MSbar)"] = 4.5;
+                k.set("q2", 3.0);
+                a = 1.5; b = 4.5; q2 = 3.0;
+
+                cache.update_gradients();
+                TEST_CHECK_RELATIVE_ERROR(cache.dual(id).value,         a * b * q2, 1.0e-14);
+                TEST_CHECK_RELATIVE_ERROR(cache.dual(id).derivative(0), b * q2,     1.0e-8);
+                TEST_CHECK_RELATIVE_ERROR(cache.dual(id).derivative(1), a * q2,     1.0e-8);
+
+                // the clones are reused
+                TEST_CHECK_EQUAL(ProductObservable::clones, clones);
+            }
+
+            // Deduplication
+            {
+                Parameters p = Parameters::Defaults();
+
+                ObservableCache cache(p);
+                std::vector<ObservableCache::Id> ids;
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    ids.push_back(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 0.1 * i } })));
+                }
+                TEST_CHECK_EQUAL(cache.size(), 100u);
+
+                // identical name and kinematics, but independent objects
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 0.1 * i } })), ids[i]);
+                }
+                TEST_CHECK_EQUAL(cache.size(), 100u);
+
+                // 0.0 and -0.0 compare equal
+                TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", -0.0 } })), ids[0]);
+
+                // different name or kinematics
+                TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::other", p, Kinematics{ { "q2", 0.0 } })), 100u);
+                TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 0.0 }, { "k2", 0.0 } })), 101u);
+                TEST_CHECK_EQUAL(cache.size(), 102u);
+
+                // kinematics that change after an observable has been added
+                Kinematics k{ { "q2", 100.0 } };
+                auto id_k = cache.add(std::make_shared<CountingObservable>("test::counting", p, k));
+                TEST_CHECK_EQUAL(id_k, 102u);
+                k.set("q2", 200.0);
+                cache.update();
+                TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 200.0 } })), id_k);
+                TEST_CHECK_EQUAL(cache.add(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 100.0 } })), 103u);
+
+                // a clone keeps all ids
+                ObservableCache clone = cache.clone(p.clone());
+                TEST_CHECK_EQUAL(clone.size(), 104u);
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(clone.observable(ids[i])->kinematics()["q2"].evaluate(), 0.1 * i);
+                }
+            }
+
+            // Deduplication does not compare against observables that differ only in their kinematics
+            {
+                Parameters p = Parameters::Defaults();
+
+                ObservableCache cache(p);
+                std::vector<std::shared_ptr<CountingObservable>> observables;
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    observables.push_back(std::make_shared<CountingObservable>("test::counting", p, Kinematics{ { "q2", 0.01 * i } }));
+                    TEST_CHECK_EQUAL(cache.add(observables.back()), i);
+                }
+
+                // each observable's kinematics are requested once to hash them, and once more for each comparison
+                unsigned long requests = 0;
+                for (const auto & o : observables)
+                {
+                    requests += o->kinematics_requests;
+                }
+                TEST_CHECK(requests < 1000u + 10u);
+            }
+        }
+} observable_cache_test;
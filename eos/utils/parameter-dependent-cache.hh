@@ -0,0 +1,159 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_PARAMETER_DEPENDENT_CACHE_HH
+#define EOS_GUARD_EOS_UTILS_PARAMETER_DEPENDENT_CACHE_HH 1
+
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/parameters.hh>
+
+#include <utility>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Caches values that depend on a set of parameters, keyed by further arguments.
+     *
+     * The cache is a ParameterUser: the parameters on which the cached values depend
+     * register with the cache, e.g. as UsedParameter objects. All entries are discarded
+     * as soon as any of these parameters changes its value.
+     *
+     * The cache is thread safe. Values are computed outside of the lock, so that
+     * concurrent misses for different keys do not serialize.
+     */
+    template <typename Key_, typename Value_>
+    class ParameterDependentCache :
+        public ParameterUser
+    {
+        private:
+            Parameters _parameters;
+
+            const unsigned _capacity;
+
+            mutable Mutex _mutex;
+
+            // version of the parameters for which the entries are known to be valid
+            mutable Parameters::Version _version;
+
+            mutable std::vector<std::pair<Key_, Value_>> _entries;
+
+            // index of the next entry to replace once the cache is full
+            mutable unsigned _next;
+
+            // true if none of our parameters changed after the given version
+            bool _unchanged_since(const Parameters::Version & version) const
+            {
+                for (const auto & id : _ids)
+                {
+                    if (_parameters.version(id) > version)
+                        return false;
+                }
+
+                return true;
+            }
+
+            // discard all entries if any of our parameters changed; requires the lock to be held
+            void _refresh(const Parameters::Version & version) const
+            {
+                if (version == _version)
+                    return;
+
+                if (! _unchanged_since(_version))
+                {
+                    _entries.clear();
+                    _next = 0;
+                }
+
+                _version = version;
+            }
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param parameters  The parameters on which the cached values depend.
+             * @param capacity    The maximal number of keys that are cached at the same time.
+             */
+            explicit ParameterDependentCache(const Parameters & parameters, const unsigned & capacity = 16) :
+                _parameters(parameters),
+                _capacity(capacity),
+                _version(0),
+                _next(0)
+            {
+                _entries.reserve(capacity);
+            }
+
+            /*!
+             * Retrieve the value for a key, computing it if it is not cached.
+             *
+             * @param key      The key.
+             * @param compute  Function object without arguments that computes the value for this key.
+             */
+            template <typename Function_>
+            Value_ operator() (const Key_ & key, const Function_ & compute) const
+            {
+                const Parameters::Version version = _parameters.version();
+
+                {
+                    Lock l(_mutex);
+                    _refresh(version);
+
+                    for (const auto & e : _entries)
+                    {
+                        if (e.first == key)
+                            return e.second;
+                    }
+                }
+
+                Value_ result = compute();
+
+                {
+                    Lock l(_mutex);
+
+                    // do not store a value whose inputs changed while it was computed
+                    if (! _unchanged_since(version))
+                        return result;
+
+                    _refresh(_parameters.version());
+
+                    for (const auto & e : _entries)
+                    {
+                        if (e.first == key)
+                            return result;
+                    }
+
+                    if (_entries.size() < _capacity)
+                    {
+                        _entries.emplace_back(key, result);
+                    }
+                    else
+                    {
+                        _entries[_next] = std::make_pair(key, result);
+                        _next = (_next + 1) % _capacity;
+                    }
+                }
+
+                return result;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,117 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/parameter-dependent-cache.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <atomic>
+#include <tuple>
+
+using namespace test;
+using namespace eos;
+
+class ParameterDependentCacheTest :
+    public TestCase
+{
+    public:
+        ParameterDependentCacheTest() :
+            TestCase("parameter_dependent_cache_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // caching and invalidation
+            {
+                Parameters parameters = Parameters::Defaults();
+                ParameterDependentCache<std::tuple<double, bool>, double> cache(parameters, 2);
+                UsedParameter m_c(parameters["mass::c"], cache);
+                Parameter m_b = parameters["mass::b(MSbar)"];
+
+                unsigned evaluations = 0;
+                auto f = [&] (const double & mu) { ++evaluations; return mu * m_c(); };
+
+                const double m_c_central = m_c();
+
+                // misses, then hits
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, false), [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, true),  [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(evaluations, 2u);
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, false), [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, true),  [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(evaluations, 2u);
+
+                // changing a parameter that is not used keeps the entries
+                m_b = m_b() + 0.1;
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, false), [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(evaluations, 2u);
+
+                // setting a used parameter to its current value keeps the entries
+                parameters["mass::c"] = m_c_central;
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, false), [&] () { return f(4.2); }), 4.2 * m_c_central);
+                TEST_CHECK_EQUAL(evaluations, 2u);
+
+                // changing a used parameter discards the entries
+                parameters["mass::c"] = 1.0;
+                TEST_CHECK_EQUAL(cache(std::make_tuple(4.2, false), [&] () { return f(4.2); }), 4.2);
+                TEST_CHECK_EQUAL(evaluations, 3u);
+
+                // exceeding the capacity replaces entries
+                cache(std::make_tuple(4.8, false), [&] () { return f(4.8); });
+                cache(std::make_tuple(5.0, false), [&] () { return f(5.0); });
+                TEST_CHECK_EQUAL(evaluations, 5u);
+                TEST_CHECK_EQUAL(cache(std::make_tuple(5.0, false), [&] () { return f(5.0); }), 5.0);
+                TEST_CHECK_EQUAL(evaluations, 5u);
+            }
+
+            // exceptions are propagated, and nothing is stored
+            {
+                Parameters parameters = Parameters::Defaults();
+                ParameterDependentCache<int, double> cache(parameters);
+
+                TEST_CHECK_THROWS(InternalError, cache(1, [] () -> double { throw InternalError("failure"); }));
+                TEST_CHECK_EQUAL(cache(1, [] () { return 3.0; }), 3.0);
+            }
+
+            // concurrent access
+            {
+                Parameters parameters = Parameters::Defaults();
+                ParameterDependentCache<int, double> cache(parameters);
+                UsedParameter m_c(parameters["mass::c"], cache);
+
+                std::atomic<unsigned> evaluations(0);
+                std::vector<double> results(1000, 0.0);
+
+                ThreadPool::instance()->parallel_for(0, results.size(), [&] (const std::size_t & i)
+                {
+                    results[i] = cache(i % 4, [&] () { ++evaluations; return (i % 4) * m_c(); });
+                });
+
+                for (unsigned i = 0 ; i < results.size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL(results[i], (i % 4) * m_c());
+                }
+
+                // concurrent misses for the same key might each compute the value
+                TEST_CHECK(evaluations >= 4u);
+                TEST_CHECK(evaluations <= 4u * ThreadPool::instance()->number_of_threads() + 4u);
+            }
+        }
+} parameter_dependent_cache_test;
@@ -4,6 +4,7 @@
  * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017 Danny van Dyk
  * Copyright (c) 2021 Philip Lüghausen
  * Copyright (c) 2010 Christian Wacker
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -26,12 +27,14 @@
 #include <eos/utils/parameters.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qualified-name.hh>
+#include <eos/utils/registry-cache.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <cmath>
-#include <map>
 #include <random>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/filesystem/operations.hpp>
@@ -192,10 +195,17 @@ namespace eos
 
         Parameter::Id id;
 
+        Parameters::Version version;
+
+        // Direction of the gradient for automatic differentiation, or -1 if not differentiated
+        int direction;
+
         Data(const Parameter::Template & t, const Parameter::Id & i) :
             Parameter::Template(t),
             value(t.central),
-            id(i)
+            id(i),
+            version(0),
+            direction(-1)
         {
         }
     };
@@ -203,6 +213,24 @@ namespace eos
     struct Parameters::Data
     {
         std::vector<Parameter::Data> data;
+
+        // Incremented whenever the value of any parameter changes
+        Parameters::Version version = 0;
+
+        // Ids of the parameters that span the gradient, cf. Parameters::seed_gradient()
+        std::vector<Parameter::Id> gradient_ids;
+
+        inline void set(const unsigned & index, const double & value)
+        {
+            auto & d = data[index];
+
+            // only a genuine change of the value invalidates the users of this parameter
+            if (d.value == value)
+                return;
+
+            d.value   = value;
+            d.version = ++version;
+        }
     };
 
     template <>
@@ -222,37 +250,65 @@ namespace eos
     template <>
     struct Implementation<Parameters>
     {
+        using Index = std::unordered_map<std::string, unsigned>;
+
         std::shared_ptr<Parameters::Data> parameters_data;
 
-        std::map<QualifiedName, unsigned> parameters_map;
+        // Maps the short names of the parameters to their ids.
+        // The index is shared among clones, and only copied when a parameter is added to one of them.
+        std::shared_ptr<Index> parameters_index;
 
         std::vector<Parameter> parameters;
 
         std::vector<ParameterSection> sections;
 
         Implementation(const std::initializer_list<Parameter::Template> & list) :
-            parameters_data(new Parameters::Data)
+            parameters_data(new Parameters::Data),
+            parameters_index(new Index)
         {
+            parameters_index->reserve(list.size());
+
             unsigned idx(0);
             for (auto i(list.begin()), i_end(list.end()) ; i != i_end ; ++i, ++idx)
             {
                 parameters_data->data.push_back(Parameter::Data(*i, idx));
-                parameters_map[i->name] = idx;
+                insert(i->name, idx);
                 parameters.push_back(Parameter(parameters_data, idx));
             }
         }
 
         Implementation(const Implementation & other) :
             parameters_data(new Parameters::Data(*other.parameters_data)),
-            parameters_map(other.parameters_map)
+            parameters_index(other.parameters_index)
         {
             parameters.reserve(other.parameters.size());
-            for (unsigned i = 0 ; i != parameters.size() ; ++i)
+            for (unsigned i = 0 ; i != other.parameters.size() ; ++i)
             {
                 parameters.push_back(Parameter(parameters_data, i));
             }
         }
 
+        // Look up a parameter's id by its short name
+        const unsigned * find(const QualifiedName & name) const
+        {
+            auto i = parameters_index->find(name.str());
+            if (parameters_index->end() == i)
+                return nullptr;
+
+            return &i->second;
+        }
+
+        // Record a parameter's id under its short name
+        void insert(const QualifiedName & name, const unsigned & idx)
+        {
+            if (parameters_index.use_count() > 1)
+            {
+                parameters_index = std::make_shared<Index>(*parameters_index);
+            }
+
+            (*parameters_index)[name.str()] = idx;
+        }
+
         void
         override_from_file(const std::string & file)
         {
@@ -330,28 +386,28 @@ namespace eos
                         unit = Unit(unit_node.as<std::string>());
                     }
 
-                    auto i = parameters_map.find(name);
-                    if (parameters_map.end() != i)
+                    const QualifiedName qn(name);
+                    if (const unsigned * i = find(qn))
                     {
                         Log::instance()->message("[parameters.override]", ll_informational)
                             << "Overriding existing parameter '" << name << "' with central value '" << central << "'";
 
-                        parameters_data->data[i->second].value = central;
+                        parameters_data->set(*i, central);
                         if (has_min)
                         {
-                            parameters_data->data[i->second].min = min;
+                            parameters_data->data[*i].min = min;
                         }
                         if (has_max)
                         {
-                            parameters_data->data[i->second].max = max;
+                            parameters_data->data[*i].max = max;
                         }
                         if (has_latex)
                         {
-                            parameters_data->data[i->second].latex = latex;
+                            parameters_data->data[*i].latex = latex;
                         }
                         if (has_unit)
                         {
-                            parameters_data->data[i->second].unit = unit;
+                            parameters_data->data[*i].unit = unit;
                         }
                     }
                     else
@@ -369,8 +425,8 @@ namespace eos
                         }
 
                         auto idx = parameters_data->data.size();
-                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { QualifiedName(name), min, central, max, latex, unit }, idx));
-                        parameters_map[name] = idx;
+                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { qn, min, central, max, latex, unit }, idx));
+                        insert(qn, idx);
                         parameters.push_back(Parameter(parameters_data, idx));
                     }
                 }
@@ -381,36 +437,30 @@ namespace eos
             }
         }
 
-        void
-        load_defaults()
+        struct GroupTemplate
         {
-            fs::path base;
-            if (std::getenv("EOS_TESTS_PARAMETERS"))
-            {
-                std::string envvar = std::string(std::getenv("EOS_TESTS_PARAMETERS"));
-                base = fs::system_complete(envvar);
-            }
-            else if (std::getenv("EOS_HOME"))
-            {
-                std::string envvar = std::string(std::getenv("EOS_HOME"));
-                base = fs::system_complete(envvar) / "parameters";
-            }
-            else
-            {
-                base = fs::system_complete(EOS_DATADIR "/eos/parameters/");
-            }
+            std::string title;
 
-            if (! fs::exists(base))
-            {
-                throw InternalError("Could not find the parameter input files, '" + base.string() + "' does not exist");
-            }
+            std::string description;
 
-            if (! fs::is_directory(base))
-            {
-                throw InternalError("Expect '" + base.string() + " to be a directory");
-            }
+            std::vector<Parameter::Template> parameters;
+        };
+
+        struct SectionTemplate
+        {
+            std::string title;
+
+            std::string description;
+
+            std::vector<GroupTemplate> groups;
+        };
+
+        static std::vector<SectionTemplate>
+        parse_defaults(const fs::path & base)
+        {
+            std::vector<SectionTemplate> result;
+            std::set<QualifiedName> names;
 
-            unsigned idx = parameters.size();
             for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
             {
                 auto file_path = f->path();
@@ -425,7 +475,7 @@ namespace eos
                 try
                 {
                     YAML::Node root_node = YAML::LoadFile(file);
-                    std::vector<ParameterGroup> section_groups;
+                    SectionTemplate section;
 
                     // parse the section metadata
                     auto section_title_node = root_node["title"];
@@ -433,14 +483,14 @@ namespace eos
                         throw ParameterInputFileNodeError(file, "/", "has no entry named 'title'");
                     if (YAML::NodeType::Scalar != section_title_node.Type())
                         throw ParameterInputFileNodeError(file, "title", "is not a scalar");
-                    std::string section_title = section_title_node.as<std::string>();
+                    section.title = section_title_node.as<std::string>();
 
                     auto section_desc_node = root_node["description"];
                     if (! section_desc_node)
                         throw ParameterInputFileNodeError(file, "/", "has no entry named 'description'");
                     if (YAML::NodeType::Scalar != section_desc_node.Type())
                         throw ParameterInputFileNodeError(file, "description", "is not a scalar");
-                    std::string section_desc = section_desc_node.as<std::string>();
+                    section.description = section_desc_node.as<std::string>();
 
                     auto section_groups_node = root_node["groups"];
                     if (! section_groups_node)
@@ -451,27 +501,27 @@ namespace eos
                     // parse the section's groups
                     for (auto && group_node : section_groups_node)
                     {
-                        std::vector<Parameter> group_parameters;
+                        GroupTemplate group;
 
                         auto group_title_node = group_node["title"];
                         if (! group_title_node)
                             throw ParameterInputFileNodeError(file, "", "has no entry named 'title'");
                         if (YAML::NodeType::Scalar != group_title_node.Type())
                             throw ParameterInputFileNodeError(file, "title", "is not a scalar");
-                        std::string group_title = group_title_node.as<std::string>();
+                        group.title = group_title_node.as<std::string>();
 
                         auto group_desc_node = group_node["description"];
                         if (! group_desc_node)
-                            throw ParameterInputFileNodeError(file, group_title, "has no entry named 'description'");
+                            throw ParameterInputFileNodeError(file, group.title, "has no entry named 'description'");
                         if (YAML::NodeType::Scalar != group_desc_node.Type())
-                            throw ParameterInputFileNodeError(file, "'" + group_title + "'.description", "is not a scalar");
-                        std::string group_desc = group_desc_node.as<std::string>();
+                            throw ParameterInputFileNodeError(file, "'" + group.title + "'.description", "is not a scalar");
+                        group.description = group_desc_node.as<std::string>();
 
                         auto group_parameters_node = group_node["parameters"];
                         if (! group_parameters_node)
-                            throw ParameterInputFileNodeError(file, group_title, "has no entry named 'parameters'");
+                            throw ParameterInputFileNodeError(file, group.title, "has no entry named 'parameters'");
                         if (YAML::NodeType::Map != group_parameters_node.Type())
-                            throw ParameterInputFileNodeError(file, "'" + group_title + "'.parameters", "is not a map");
+                            throw ParameterInputFileNodeError(file, "'" + group.title + "'.parameters", "is not a map");
 
                         // parse the group's parameters
                         for (auto && p : group_parameters_node)
@@ -524,17 +574,12 @@ namespace eos
 
                             if (name.find("%") == std::string::npos) // The parameter is not templated
                             {
-                                if (parameters_map.end() != parameters_map.find(name))
+                                if (! names.insert(name).second)
                                 {
                                     throw ParameterInputDuplicateError(file, name);
                                 }
 
-                                parameters_data->data.push_back(Parameter::Data(Parameter::Template { QualifiedName(name), min, central, max, latex, unit }, idx));
-                                parameters_map[name] = idx;
-                                parameters.push_back(Parameter(parameters_data, idx));
-                                group_parameters.push_back(Parameter(parameters_data, idx));
-
-                                ++idx;
+                                group.parameters.push_back(Parameter::Template { QualifiedName(name), min, central, max, latex, unit });
                             }
                             else // The parameter is templated
                             {
@@ -576,31 +621,154 @@ namespace eos
 
                                         QualifiedName qn(templated_name.str());
 
-                                        if (parameters_map.end() != parameters_map.find(qn))
+                                        if (! names.insert(qn).second)
                                         {
                                             throw ParameterInputDuplicateError(file, qn.str());
                                         }
 
-                                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { qn, min, central, max, templated_latex.str(), unit }, idx));
-                                        parameters_map[templated_name.str()] = idx;
-                                        parameters.push_back(Parameter(parameters_data, idx));
-                                        group_parameters.push_back(Parameter(parameters_data, idx));
-
-                                        ++idx;
+                                        group.parameters.push_back(Parameter::Template { qn, min, central, max, templated_latex.str(), unit });
                                     }
                                 }
                             }
                         }
 
-                        section_groups.push_back(ParameterGroup(new Implementation<ParameterGroup>(group_title, group_desc, std::move(group_parameters))));
+                        section.groups.push_back(std::move(group));
                     }
-                    sections.push_back(ParameterSection(new Implementation<ParameterSection>(section_title, section_desc, std::move(section_groups))));
+                    result.push_back(std::move(section));
                 }
                 catch (std::exception & e)
                 {
                     throw ParameterInputFileParseError(file, e.what());
                 }
             }
+
+            return result;
+        }
+
+        static void
+        write_defaults(RegistryCache::Writer & writer, const std::vector<SectionTemplate> & sections)
+        {
+            writer.write_unsigned(sections.size());
+            for (const auto & section : sections)
+            {
+                writer.write_string(section.title);
+                writer.write_string(section.description);
+                writer.write_unsigned(section.groups.size());
+                for (const auto & group : section.groups)
+                {
+                    writer.write_string(group.title);
+                    writer.write_string(group.description);
+                    writer.write_unsigned(group.parameters.size());
+                    for (const auto & p : group.parameters)
+                    {
+                        writer.write_string(p.name.str());
+                        writer.write_double(p.min);
+                        writer.write_double(p.central);
+                        writer.write_double(p.max);
+                        writer.write_string(p.latex);
+                        writer.write_unsigned(static_cast<std::uint64_t>(p.unit.id()));
+                    }
+                }
+            }
+        }
+
+        static std::vector<SectionTemplate>
+        read_defaults(RegistryCache::Reader & reader)
+        {
+            std::vector<SectionTemplate> result(reader.read_unsigned());
+            for (auto & section : result)
+            {
+                section.title       = reader.read_string();
+                section.description = reader.read_string();
+                section.groups.resize(reader.read_unsigned());
+                for (auto & group : section.groups)
+                {
+                    group.title       = reader.read_string();
+                    group.description = reader.read_string();
+
+                    const auto size = reader.read_unsigned();
+                    group.parameters.reserve(size);
+                    for (std::uint64_t i = 0 ; i < size ; ++i)
+                    {
+                        QualifiedName name(reader.read_string());
+                        const double min     = reader.read_double();
+                        const double central = reader.read_double();
+                        const double max     = reader.read_double();
+                        std::string latex    = reader.read_string();
+                        const auto unit      = reader.read_unsigned();
+                        if (unit > static_cast<std::uint64_t>(Unit::Id::gev_s))
+                            throw InternalError("Parameters: invalid unit in snapshot");
+
+                        group.parameters.push_back(Parameter::Template { name, min, central, max, latex, Unit(static_cast<Unit::Id>(unit)) });
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        void
+        load_defaults()
+        {
+            fs::path base;
+            if (std::getenv("EOS_TESTS_PARAMETERS"))
+            {
+                std::string envvar = std::string(std::getenv("EOS_TESTS_PARAMETERS"));
+                base = fs::system_complete(envvar);
+            }
+            else if (std::getenv("EOS_HOME"))
+            {
+                std::string envvar = std::string(std::getenv("EOS_HOME"));
+                base = fs::system_complete(envvar) / "parameters";
+            }
+            else
+            {
+                base = fs::system_complete(EOS_DATADIR "/eos/parameters/");
+            }
+
+            if (! fs::exists(base))
+            {
+                throw InternalError("Could not find the parameter input files, '" + base.string() + "' does not exist");
+            }
+
+            if (! fs::is_directory(base))
+            {
+                throw InternalError("Expect '" + base.string() + " to be a directory");
+            }
+
+            // use the snapshot of the parsed input files if it is still valid
+            std::vector<SectionTemplate> section_templates;
+            RegistryCache cache("parameters", base.string());
+            if (! cache.load([&] (RegistryCache::Reader & reader) { section_templates = read_defaults(reader); }))
+            {
+                section_templates = parse_defaults(base);
+
+                RegistryCache::Writer writer;
+                write_defaults(writer, section_templates);
+                cache.store(writer);
+            }
+
+            unsigned idx = parameters.size();
+            for (auto && s : section_templates)
+            {
+                std::vector<ParameterGroup> section_groups;
+                for (auto && g : s.groups)
+                {
+                    std::vector<Parameter> group_parameters;
+                    for (auto && t : g.parameters)
+                    {
+                        parameters_data->data.push_back(Parameter::Data(t, idx));
+                        insert(t.name, idx);
+                        parameters.push_back(Parameter(parameters_data, idx));
+                        group_parameters.push_back(Parameter(parameters_data, idx));
+
+                        ++idx;
+                    }
+
+                    section_groups.push_back(ParameterGroup(new Implementation<ParameterGroup>(g.title, g.description, std::move(group_parameters))));
+                }
+                sections.push_back(ParameterSection(new Implementation<ParameterSection>(s.title, s.description, std::move(section_groups))));
+            }
         }
     };
 
@@ -622,12 +790,12 @@ namespace eos
     Parameter
     Parameters::operator[] (const QualifiedName & name) const
     {
-        auto i(_imp->parameters_map.find(name));
+        const unsigned * i = _imp->find(name);
 
-        if (_imp->parameters_map.end() == i)
+        if (nullptr == i)
             throw UnknownParameterError(name);
 
-        return Parameter(_imp->parameters_data, i->second);
+        return Parameter(_imp->parameters_data, *i);
     }
 
     Parameter
@@ -643,14 +811,13 @@ namespace eos
     Parameters::declare(const QualifiedName & name, double value)
     {
         // return existing parameter
-        auto i(_imp->parameters_map.find(name));
-        if (_imp->parameters_map.end() != i)
-            return Parameter(_imp->parameters_data, i->second);
+        if (const unsigned * i = _imp->find(name))
+            return Parameter(_imp->parameters_data, *i);
 
         // create new parameter
         unsigned idx = _imp->parameters.size();
         _imp->parameters_data->data.push_back(Parameter::Data(Parameter::Template { name, value, value, value, "LaTeX display not supported for run-time declared parameters", Unit::Undefined() }, idx));
-        _imp->parameters_map[name] = idx;
+        _imp->insert(name, idx);
         _imp->parameters.push_back(Parameter(_imp->parameters_data, idx));
 
         return _imp->parameters.back();
@@ -659,22 +826,18 @@ namespace eos
     void
     Parameters::set(const QualifiedName & name, const double & value)
     {
-        auto i(_imp->parameters_map.find(name));
+        const unsigned * i = _imp->find(name);
 
-        if (_imp->parameters_map.end() == i)
+        if (nullptr == i)
             throw UnknownParameterError(name);
 
-        _imp->parameters_data->data[i->second].value = value;
+        _imp->parameters_data->set(*i, value);
     }
 
     bool
-    Parameters::has(const QualifiedName & name)
+    Parameters::has(const QualifiedName & name) const
     {
-        auto i(_imp->parameters_map.find(name));
-
-        if (_imp->parameters_map.end() == i)
-            return false;
-        else return true;
+        return nullptr != _imp->find(name);
     }
 
     Parameters::Iterator
@@ -689,6 +852,48 @@ namespace eos
         return Parameters::Iterator(_imp->parameters.end());
     }
 
+    Parameters::Version
+    Parameters::version() const
+    {
+        return _imp->parameters_data->version;
+    }
+
+    Parameters::Version
+    Parameters::version(const Parameter::Id & id) const
+    {
+        return _imp->parameters_data->data[id].version;
+    }
+
+    void
+    Parameters::seed_gradient(const std::vector<unsigned> & ids)
+    {
+        auto & d = *_imp->parameters_data;
+
+        for (const auto & id : d.gradient_ids)
+        {
+            d.data[id].direction = -1;
+        }
+
+        for (unsigned i = 0 ; i < ids.size() ; ++i)
+        {
+            if (ids[i] >= d.data.size())
+                throw InternalError("Parameters::seed_gradient: invalid id '" + stringify(ids[i]) + "'");
+
+            if (d.data[ids[i]].direction >= 0)
+                throw InternalError("Parameters::seed_gradient: parameter '" + d.data[ids[i]].name.str() + "' is seeded more than once");
+
+            d.data[ids[i]].direction = i;
+        }
+
+        d.gradient_ids = ids;
+    }
+
+    const std::vector<unsigned> &
+    Parameters::gradient_ids() const
+    {
+        return _imp->parameters_data->gradient_ids;
+    }
+
     Parameters::SectionIterator
     Parameters::begin_sections() const
     {
@@ -761,10 +966,21 @@ namespace eos
         return _parameters_data->data[_index].value;
     }
 
+    Dual
+    Parameter::dual() const
+    {
+        const auto & d = _parameters_data->data[_index];
+
+        if (d.direction < 0)
+            return Dual(d.value);
+
+        return Dual::variable(d.value, d.direction, _parameters_data->gradient_ids.size());
+    }
+
     const Parameter &
     Parameter::operator= (const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
 
         return *this;
     }
@@ -772,7 +988,7 @@ namespace eos
     void
     Parameter::set(const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
     }
 
     const double &
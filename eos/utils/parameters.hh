@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2010, 2011, 2012, 2013, 2019 Danny van Dyk
  * Copyright (c) 2021 Philip Lüghausen
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,7 @@
 #ifndef EOS_GUARD_EOS_UTILS_PARAMETERS_HH
 #define EOS_GUARD_EOS_UTILS_PARAMETERS_HH 1
 
+#include <eos/maths/dual.hh>
 #include <eos/utils/exception.hh>
 #include <eos/utils/mutable.hh>
 #include <eos/utils/parameters-fwd.hh>
@@ -30,6 +32,7 @@
 #include <eos/utils/wrapped_forward_iterator.hh>
 
 #include <set>
+#include <vector>
 
 namespace eos
 {
@@ -164,7 +167,7 @@ namespace eos
              *
              * @param name  The name to be checked against the known parameters.
              */
-            bool has(const QualifiedName & name);
+            bool has(const QualifiedName & name) const;
 
             /*!
              * Retrieve a parameter's Parameter object by name.
@@ -188,6 +191,40 @@ namespace eos
             void override_from_file(const std::string & file);
             ///@}
 
+            ///@name Change tracking
+            ///@{
+            /*!
+             * A monotonically increasing counter that identifies the state of the
+             * parameters' values. It is incremented whenever any parameter's value changes.
+             */
+            using Version = unsigned long;
+
+            /// Retrieve the current version of the entire set of parameters.
+            Version version() const;
+
+            /*!
+             * Retrieve the version at which a parameter's value has last been changed.
+             *
+             * @param id    The id of the Parameter whose version shall be retrieved.
+             */
+            Version version(const unsigned & id) const;
+            ///@}
+
+            ///@name Automatic differentiation
+            ///@{
+            /*!
+             * Select the parameters with respect to which gradients are computed through
+             * forward-mode automatic differentiation, cf. Parameter::dual(). The i-th parameter
+             * spans the i-th direction of the gradient. All other parameters are treated as constants.
+             *
+             * @param ids   The ids of the parameters; an empty list disables differentiation.
+             */
+            void seed_gradient(const std::vector<unsigned> & ids);
+
+            /// Retrieve the ids of the parameters that span the gradient, in the order of the directions.
+            const std::vector<unsigned> & gradient_ids() const;
+            ///@}
+
             /*!
              * Compare two instances of Parameters on inequality of their
              * underlying implementations.
@@ -253,6 +290,9 @@ namespace eos
             /// Retrieve a Parameter's numeric value.
             virtual double evaluate() const;
 
+            /// Retrieve a Parameter's numeric value as a Dual, with a gradient as seeded by Parameters::seed_gradient().
+            Dual dual() const;
+
             /// Set a Parameter's numeric value.
             virtual const Parameter & operator= (const double &);
 
@@ -291,6 +331,16 @@ namespace eos
             ///@}
     };
 
+    /*!
+     * Retrieve a Parameter's numeric value either as a double, or as a Dual for
+     * forward-mode automatic differentiation.
+     */
+    template <typename T_> T_ parameter_value(const Parameter & p);
+
+    template <> inline double parameter_value<double>(const Parameter & p) { return p.evaluate(); }
+
+    template <> inline Dual parameter_value<Dual>(const Parameter & p) { return p.dual(); }
+
     /**
      * ParameterSection is used to keep track of one or more ParameterGroup objects, and groups
      * them together under a common name. Examples of observable sections include SM & EFT parameters,
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2011 Danny van Dyk
  * Copyright (c) 2021 Philip Lüghausen
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -73,6 +74,27 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(m_c_clone(), m_c_clone.central());
             }
 
+            // Versioning
+            {
+                Parameters p = Parameters::Defaults();
+                Parameter m_c = p["mass::c"];
+                Parameter m_b = p["mass::b(MSbar)"];
+
+                const auto v0 = p.version();
+
+                m_c = m_c();
+                TEST_CHECK_EQUAL(p.version(), v0);
+
+                m_c = 1.0;
+                TEST_CHECK(p.version() > v0);
+                TEST_CHECK_EQUAL(p.version(m_c.id()), p.version());
+                TEST_CHECK(p.version(m_b.id()) <= v0);
+
+                p.set("mass::b(MSbar)", 4.0);
+                TEST_CHECK(p.version(m_b.id()) > p.version(m_c.id()));
+                TEST_CHECK_EQUAL(p.version(m_b.id()), p.version());
+            }
+
             // Parameters::has
             {
                 Parameters p = Parameters::Defaults();
@@ -80,5 +102,29 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(p.has("mass::tau"), true);
                 TEST_CHECK_EQUAL(p.has("mass::boing747"), false);
             }
+
+            // Lookup by name in clones
+            {
+                Parameters original = Parameters::Defaults();
+                Parameters clone = original.clone();
+
+                // all parameters are available by id and by name
+                TEST_CHECK_EQUAL(std::distance(clone.begin(), clone.end()), std::distance(original.begin(), original.end()));
+                for (const auto & p : original)
+                {
+                    TEST_CHECK_EQUAL(clone[p.id()].name(), p.name());
+                    TEST_CHECK_EQUAL(clone[p.name()].id(), p.id());
+                }
+
+                // names are compared without their options
+                TEST_CHECK_EQUAL(original["mass::tau;foo=bar"].id(), original["mass::tau"].id());
+
+                // declaring a parameter in the clone does not affect the original
+                Parameter foo = clone.declare("test::foo", 1.0);
+                TEST_CHECK_EQUAL(clone.has("test::foo"), true);
+                TEST_CHECK_EQUAL(original.has("test::foo"), false);
+                TEST_CHECK_EQUAL(clone["test::foo"].id(), foo.id());
+                TEST_CHECK_THROWS(UnknownParameterError, original["test::foo"]);
+            }
         }
 } parameters_test;
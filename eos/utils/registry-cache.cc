@@ -0,0 +1,383 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <config.h>
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/registry-cache.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = boost::filesystem;
+
+namespace eos
+{
+    namespace impl
+    {
+        // Increment whenever the layout of any snapshot changes
+        static const std::uint64_t registry_cache_format = 1;
+
+        static const char registry_cache_magic[8] = { 'E', 'O', 'S', 'R', 'E', 'G', 'C', '\0' };
+
+        // FNV-1a
+        struct Fingerprint
+        {
+            std::uint64_t value = 0xcbf29ce484222325ull;
+
+            void add(const void * data, const std::size_t & size)
+            {
+                const unsigned char * bytes = static_cast<const unsigned char *>(data);
+                for (std::size_t i = 0 ; i < size ; ++i)
+                {
+                    value ^= bytes[i];
+                    value *= 0x100000001b3ull;
+                }
+            }
+
+            void add(const std::string & s)
+            {
+                std::uint64_t size = s.size();
+                add(&size, sizeof(size));
+                add(s.data(), s.size());
+            }
+
+            void add(const std::uint64_t & v)
+            {
+                add(&v, sizeof(v));
+            }
+        };
+
+        struct SnapshotHeader
+        {
+            char magic[8];
+            std::uint64_t format;
+            std::uint64_t fingerprint;
+            std::uint64_t size;
+        };
+
+        // modification time in nanoseconds, to detect changes within the same second
+        std::uint64_t modification_time(const fs::path & path)
+        {
+            struct stat st;
+            if (0 != ::stat(path.c_str(), &st))
+                return 0;
+
+            return static_cast<std::uint64_t>(st.st_mtim.tv_sec) * 1000000000ull + st.st_mtim.tv_nsec;
+        }
+
+        fs::path cache_directory()
+        {
+            if (const char * dir = std::getenv("EOS_CACHE_DIR"))
+                return fs::path(dir);
+
+            if (const char * dir = std::getenv("XDG_CACHE_HOME"))
+                return fs::path(dir) / "eos";
+
+            if (const char * dir = std::getenv("HOME"))
+                return fs::path(dir) / ".cache" / "eos";
+
+            return fs::path();
+        }
+    }
+
+    RegistryCache::Reader::Reader(const char * begin, const char * end) :
+        _position(begin),
+        _end(end)
+    {
+    }
+
+    void
+    RegistryCache::Reader::check(const std::size_t & size)
+    {
+        if (static_cast<std::size_t>(_end - _position) < size)
+            throw InternalError("RegistryCache::Reader: attempted to read beyond the end of the snapshot");
+    }
+
+    std::uint64_t
+    RegistryCache::Reader::read_unsigned()
+    {
+        std::uint64_t result;
+        check(sizeof(result));
+        std::memcpy(&result, _position, sizeof(result));
+        _position += sizeof(result);
+
+        return result;
+    }
+
+    double
+    RegistryCache::Reader::read_double()
+    {
+        double result;
+        check(sizeof(result));
+        std::memcpy(&result, _position, sizeof(result));
+        _position += sizeof(result);
+
+        return result;
+    }
+
+    std::string
+    RegistryCache::Reader::read_string()
+    {
+        const std::uint64_t size = read_unsigned();
+        check(size);
+        std::string result(_position, size);
+        _position += size;
+
+        return result;
+    }
+
+    bool
+    RegistryCache::Reader::exhausted() const
+    {
+        return _position == _end;
+    }
+
+    void
+    RegistryCache::Writer::write_unsigned(const std::uint64_t & value)
+    {
+        _buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void
+    RegistryCache::Writer::write_double(const double & value)
+    {
+        _buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void
+    RegistryCache::Writer::write_string(const std::string & value)
+    {
+        write_unsigned(value.size());
+        _buffer.append(value);
+    }
+
+    const std::string &
+    RegistryCache::Writer::buffer() const
+    {
+        return _buffer;
+    }
+
+    template <>
+    struct Implementation<RegistryCache>
+    {
+        std::string kind;
+
+        fs::path source;
+
+        fs::path snapshot;
+
+        std::uint64_t fingerprint;
+
+        Implementation(const std::string & kind, const std::string & source) :
+            kind(kind),
+            source(fs::system_complete(source))
+        {
+            // the fingerprint covers the names, sizes and modification times of all YAML files
+            std::vector<std::tuple<std::string, std::uint64_t, std::uint64_t>> files;
+            if (fs::is_directory(this->source))
+            {
+                for (fs::directory_iterator f(this->source), f_end ; f != f_end ; ++f)
+                {
+                    const auto & file_path = f->path();
+
+                    if (! fs::is_regular_file(fs::status(file_path)))
+                        continue;
+
+                    if (".yaml" != file_path.extension().string())
+                        continue;
+
+                    files.emplace_back(file_path.filename().string(), fs::file_size(file_path), impl::modification_time(file_path));
+                }
+            }
+            std::sort(files.begin(), files.end());
+
+            impl::Fingerprint fp;
+            fp.add(impl::registry_cache_format);
+            fp.add(std::string(PACKAGE_VERSION));
+            fp.add(kind);
+            for (const auto & f : files)
+            {
+                fp.add(std::get<0>(f));
+                fp.add(std::get<1>(f));
+                fp.add(std::get<2>(f));
+            }
+            fingerprint = fp.value;
+
+            // one snapshot per kind and source directory
+            const fs::path directory = impl::cache_directory();
+            if (! directory.empty())
+            {
+                impl::Fingerprint location;
+                location.add(this->source.string());
+
+                char name[17];
+                std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(location.value));
+                snapshot = directory / (kind + "-" + name + ".snapshot");
+            }
+        }
+
+        bool load(const std::function<void (RegistryCache::Reader &)> & f) const
+        {
+            if (snapshot.empty())
+                return false;
+
+            int fd = ::open(snapshot.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat st;
+            if ((0 != ::fstat(fd, &st)) || (static_cast<std::size_t>(st.st_size) < sizeof(impl::SnapshotHeader)))
+            {
+                ::close(fd);
+                return false;
+            }
+
+            const std::size_t size = st.st_size;
+            void * mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (MAP_FAILED == mapping)
+                return false;
+
+            bool result = false;
+            const char * data = static_cast<const char *>(mapping);
+
+            impl::SnapshotHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            if ((0 == std::memcmp(header.magic, impl::registry_cache_magic, sizeof(header.magic)))
+                    && (impl::registry_cache_format == header.format)
+                    && (fingerprint == header.fingerprint)
+                    && (size - sizeof(header) == header.size))
+            {
+                try
+                {
+                    RegistryCache::Reader reader(data + sizeof(header), data + size);
+                    f(reader);
+
+                    if (! reader.exhausted())
+                        throw InternalError("RegistryCache::Reader: trailing data in snapshot");
+
+                    result = true;
+                }
+                catch (std::exception & e)
+                {
+                    Log::instance()->message("[RegistryCache.load]", ll_warning)
+                        << "Ignoring snapshot '" << snapshot.string() << "' for '" << kind << "': " << e.what();
+                }
+            }
+            else
+            {
+                Log::instance()->message("[RegistryCache.load]", ll_informational)
+                    << "Snapshot '" << snapshot.string() << "' for '" << kind << "' is stale";
+            }
+
+            ::munmap(mapping, size);
+
+            return result;
+        }
+
+        void store(const RegistryCache::Writer & writer) const
+        {
+            if (snapshot.empty())
+                return;
+
+            boost::system::error_code ec;
+            fs::create_directories(snapshot.parent_path(), ec);
+            if (ec)
+            {
+                Log::instance()->message("[RegistryCache.store]", ll_informational)
+                    << "Cannot create cache directory '" << snapshot.parent_path().string() << "': " << ec.message();
+                return;
+            }
+
+            impl::SnapshotHeader header;
+            std::memcpy(header.magic, impl::registry_cache_magic, sizeof(header.magic));
+            header.format      = impl::registry_cache_format;
+            header.fingerprint = fingerprint;
+            header.size        = writer.buffer().size();
+
+            // write to a temporary file first, so that concurrent processes never see a partial snapshot
+            const fs::path temporary = snapshot.string() + "." + std::to_string(::getpid());
+            {
+                std::ofstream out(temporary.string(), std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                out.write(writer.buffer().data(), writer.buffer().size());
+
+                if (! out)
+                {
+                    Log::instance()->message("[RegistryCache.store]", ll_informational)
+                        << "Cannot write snapshot '" << temporary.string() << "'";
+                    fs::remove(temporary, ec);
+                    return;
+                }
+            }
+
+            fs::rename(temporary, snapshot, ec);
+            if (ec)
+            {
+                Log::instance()->message("[RegistryCache.store]", ll_informational)
+                    << "Cannot replace snapshot '" << snapshot.string() << "': " << ec.message();
+                fs::remove(temporary, ec);
+            }
+        }
+    };
+
+    RegistryCache::RegistryCache(const std::string & kind, const std::string & source) :
+        PrivateImplementationPattern<RegistryCache>(new Implementation<RegistryCache>(kind, source))
+    {
+    }
+
+    RegistryCache::~RegistryCache()
+    {
+    }
+
+    std::uint64_t
+    RegistryCache::fingerprint() const
+    {
+        return _imp->fingerprint;
+    }
+
+    bool
+    RegistryCache::load(const std::function<void (Reader &)> & f) const
+    {
+        return _imp->load(f);
+    }
+
+    void
+    RegistryCache::store(const Writer & writer) const
+    {
+        _imp->store(writer);
+    }
+}
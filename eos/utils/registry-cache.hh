@@ -0,0 +1,114 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_REGISTRY_CACHE_HH
+#define EOS_GUARD_EOS_UTILS_REGISTRY_CACHE_HH 1
+
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace eos
+{
+    /*!
+     * RegistryCache keeps a binary snapshot of the data parsed from a directory of YAML input files.
+     *
+     * The snapshot is tied to the names, sizes and modification times of all YAML files in the
+     * source directory, and is ignored as soon as any of these changes. Snapshots are stored in
+     * $EOS_CACHE_DIR, $XDG_CACHE_HOME/eos or $HOME/.cache/eos, in this order of preference.
+     * Setting EOS_CACHE_DIR to an empty string disables the snapshots.
+     */
+    class RegistryCache :
+        public PrivateImplementationPattern<RegistryCache>
+    {
+        public:
+            /// Sequential reader for the payload of a snapshot.
+            class Reader
+            {
+                private:
+                    const char * _position;
+
+                    const char * const _end;
+
+                    void check(const std::size_t & size);
+
+                public:
+                    Reader(const char * begin, const char * end);
+
+                    std::uint64_t read_unsigned();
+                    double read_double();
+                    std::string read_string();
+
+                    /// Return true if the entire payload has been read.
+                    bool exhausted() const;
+            };
+
+            /// Sequential writer for the payload of a snapshot.
+            class Writer
+            {
+                private:
+                    std::string _buffer;
+
+                public:
+                    void write_unsigned(const std::uint64_t & value);
+                    void write_double(const double & value);
+                    void write_string(const std::string & value);
+
+                    const std::string & buffer() const;
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param kind   The kind of registry, e.g. 'parameters'. Must be a valid file name.
+             * @param source The directory holding the YAML files.
+             */
+            RegistryCache(const std::string & kind, const std::string & source);
+
+            /// Destructor.
+            ~RegistryCache();
+            ///@}
+
+            /// Return the fingerprint of the YAML files in the source directory.
+            std::uint64_t fingerprint() const;
+
+            /*!
+             * Map a valid snapshot into memory and pass its payload to a callback.
+             *
+             * @param f  The callback that deserializes the payload.
+             *
+             * Returns false if no valid snapshot exists, or if the callback throws.
+             * In the latter case the results of the callback must be discarded.
+             */
+            bool load(const std::function<void (Reader &)> & f) const;
+
+            /*!
+             * Store a new snapshot, replacing any existing one.
+             *
+             * Failure to store the snapshot is logged but not considered an error.
+             */
+            void store(const Writer & writer) const;
+    };
+}
+
+#endif
@@ -0,0 +1,165 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/parameters.hh>
+#include <eos/utils/registry-cache.hh>
+
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+using namespace test;
+using namespace eos;
+
+namespace fs = boost::filesystem;
+
+class RegistryCacheTest :
+    public TestCase
+{
+    public:
+        RegistryCacheTest() :
+            TestCase("registry_cache_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            const fs::path base = fs::temp_directory_path() / fs::unique_path("eos-registry-cache-%%%%-%%%%");
+            const fs::path source = base / "source";
+            fs::create_directories(source);
+            ::setenv("EOS_CACHE_DIR", (base / "cache").c_str(), 1);
+
+            {
+                std::ofstream out((source / "a.yaml").string());
+                out << "a: 1" << std::endl;
+            }
+
+            auto read = [] (RegistryCache::Reader & reader, std::uint64_t & u, double & d, std::string & s)
+            {
+                u = reader.read_unsigned();
+                d = reader.read_double();
+                s = reader.read_string();
+            };
+
+            // no snapshot yet
+            {
+                RegistryCache cache("test", source.string());
+
+                std::uint64_t u = 0;
+                double d = 0.0;
+                std::string s;
+                TEST_CHECK(! cache.load([&] (RegistryCache::Reader & reader) { read(reader, u, d, s); }));
+
+                RegistryCache::Writer writer;
+                writer.write_unsigned(42);
+                writer.write_double(3.25);
+                writer.write_string("foo: [1, 2]");
+                cache.store(writer);
+            }
+
+            // valid snapshot
+            {
+                RegistryCache cache("test", source.string());
+
+                std::uint64_t u = 0;
+                double d = 0.0;
+                std::string s;
+                TEST_CHECK(cache.load([&] (RegistryCache::Reader & reader) { read(reader, u, d, s); }));
+                TEST_CHECK_EQUAL(42u,           u);
+                TEST_CHECK_EQUAL(3.25,          d);
+                TEST_CHECK_EQUAL("foo: [1, 2]", s);
+
+                // reading past the end of the payload rejects the snapshot
+                TEST_CHECK(! cache.load([&] (RegistryCache::Reader & reader) { read(reader, u, d, s); reader.read_unsigned(); }));
+
+                // leaving parts of the payload unread rejects the snapshot
+                TEST_CHECK(! cache.load([&] (RegistryCache::Reader & reader) { reader.read_unsigned(); }));
+            }
+
+            // a different kind does not see the snapshot
+            {
+                RegistryCache cache("other", source.string());
+
+                TEST_CHECK(! cache.load([&] (RegistryCache::Reader &) { }));
+            }
+
+            // modifying an input file invalidates the snapshot
+            {
+                const auto fingerprint = RegistryCache("test", source.string()).fingerprint();
+                {
+                    std::ofstream out((source / "a.yaml").string());
+                    out << "a: 12" << std::endl;
+                }
+
+                RegistryCache cache("test", source.string());
+                TEST_CHECK(fingerprint != cache.fingerprint());
+                TEST_CHECK(! cache.load([&] (RegistryCache::Reader &) { }));
+            }
+
+            // adding an input file invalidates the snapshot
+            {
+                RegistryCache cache("test", source.string());
+                RegistryCache::Writer writer;
+                writer.write_unsigned(17);
+                cache.store(writer);
+                TEST_CHECK(cache.load([&] (RegistryCache::Reader & reader) { reader.read_unsigned(); }));
+
+                {
+                    std::ofstream out((source / "b.yaml").string());
+                    out << "b: 2" << std::endl;
+                }
+
+                TEST_CHECK(! RegistryCache("test", source.string()).load([&] (RegistryCache::Reader & reader) { reader.read_unsigned(); }));
+            }
+
+            // the default parameters are identical with and without a snapshot
+            {
+                Parameters parsed = Parameters::Defaults();
+
+                bool has_snapshot = false;
+                for (fs::directory_iterator f(base / "cache"), f_end ; f != f_end ; ++f)
+                {
+                    if (0 == f->path().filename().string().find("parameters-"))
+                        has_snapshot = true;
+                }
+                TEST_CHECK(has_snapshot);
+
+                Parameters loaded = Parameters::Defaults();
+
+                auto p = parsed.begin(), p_end = parsed.end();
+                auto l = loaded.begin(), l_end = loaded.end();
+                for ( ; (p != p_end) && (l != l_end) ; ++p, ++l)
+                {
+                    TEST_CHECK_EQUAL(p->name(),      l->name());
+                    TEST_CHECK_EQUAL(p->central(),   l->central());
+                    TEST_CHECK_EQUAL(p->min(),       l->min());
+                    TEST_CHECK_EQUAL(p->max(),       l->max());
+                    TEST_CHECK_EQUAL(p->latex(),     l->latex());
+                    TEST_CHECK(p->unit() == l->unit());
+                }
+                TEST_CHECK(p == p_end);
+                TEST_CHECK(l == l_end);
+            }
+
+            fs::remove_all(base);
+        }
+} registry_cache_test;
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2021 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -26,12 +27,212 @@
 #include <eos/utils/thread.hh>
 #include <eos/utils/thread_pool.hh>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
 #include <list>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include <unistd.h>
 
 namespace eos
 {
+    namespace impl
+    {
+        // Set for the threads that are owned by the ThreadPool
+        thread_local bool is_thread_pool_worker = false;
+
+        // Index of the worker within the ThreadPool
+        thread_local unsigned worker_index = 0;
+
+        /*
+         * A range of indices that is processed by ThreadPool::parallel_for.
+         *
+         * All participating threads claim chunks of the range from a common counter,
+         * so that the range is shared among all threads that pick up a reference to it.
+         */
+        struct Range
+        {
+            const std::function<void (const std::size_t &)> & body;
+
+            const std::size_t end;
+
+            const std::size_t grain;
+
+            std::atomic<std::size_t> next;
+
+            // completed once all helping threads are done with the range
+            Ticket done;
+
+            Mutex mutex;
+
+            std::exception_ptr exception;
+
+            Range(const std::function<void (const std::size_t &)> & body, const std::size_t & begin, const std::size_t & end,
+                    const std::size_t & grain, const unsigned & helpers) :
+                body(body),
+                end(end),
+                grain(grain),
+                next(begin),
+                done(helpers)
+            {
+            }
+
+            void work()
+            {
+                while (true)
+                {
+                    const std::size_t first = next.fetch_add(grain);
+                    if (first >= end)
+                        break;
+
+                    const std::size_t last = std::min(first + grain, end);
+                    try
+                    {
+                        for (std::size_t i = first ; i < last ; ++i)
+                        {
+                            body(i);
+                        }
+                    }
+                    catch (...)
+                    {
+                        Lock l(mutex);
+
+                        if (! exception)
+                            exception = std::current_exception();
+
+                        // skip all remaining chunks
+                        next.store(end);
+                    }
+                }
+            }
+        };
+
+        /*
+         * Work-stealing deque, following Chase and Lev, with the memory orderings of
+         * Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013).
+         *
+         * Only the owning worker pushes to and pops from the bottom; all other workers
+         * steal from the top.
+         */
+        class WorkStealingDeque
+        {
+            private:
+                struct Buffer
+                {
+                    // always a power of two
+                    const long capacity;
+
+                    std::unique_ptr<std::atomic<Range *>[]> items;
+
+                    Buffer(const long & capacity) :
+                        capacity(capacity),
+                        items(new std::atomic<Range *>[capacity])
+                    {
+                    }
+
+                    Range * get(const long & i) const
+                    {
+                        return items[i & (capacity - 1)].load(std::memory_order_relaxed);
+                    }
+
+                    void put(const long & i, Range * r)
+                    {
+                        items[i & (capacity - 1)].store(r, std::memory_order_relaxed);
+                    }
+                };
+
+                std::atomic<long> _top;
+
+                std::atomic<long> _bottom;
+
+                std::atomic<Buffer *> _buffer;
+
+                // Buffers are only released along with the deque, since thieves might still read from a replaced buffer
+                std::vector<std::unique_ptr<Buffer>> _buffers;
+
+            public:
+                WorkStealingDeque() :
+                    _top(0),
+                    _bottom(0)
+                {
+                    _buffers.emplace_back(new Buffer(64));
+                    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+                }
+
+                void push(Range * r)
+                {
+                    const long b = _bottom.load(std::memory_order_relaxed);
+                    const long t = _top.load(std::memory_order_acquire);
+                    Buffer * a = _buffer.load(std::memory_order_relaxed);
+
+                    if (b - t > a->capacity - 1)
+                    {
+                        _buffers.emplace_back(new Buffer(2 * a->capacity));
+                        Buffer * grown = _buffers.back().get();
+                        for (long i = t ; i < b ; ++i)
+                        {
+                            grown->put(i, a->get(i));
+                        }
+                        _buffer.store(grown, std::memory_order_release);
+                        a = grown;
+                    }
+
+                    a->put(b, r);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    _bottom.store(b + 1, std::memory_order_relaxed);
+                }
+
+                Range * pop()
+                {
+                    const long b = _bottom.load(std::memory_order_relaxed) - 1;
+                    Buffer * a = _buffer.load(std::memory_order_relaxed);
+                    _bottom.store(b, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    long t = _top.load(std::memory_order_relaxed);
+
+                    if (t > b)
+                    {
+                        // empty
+                        _bottom.store(b + 1, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+
+                    Range * result = a->get(b);
+                    if (t == b)
+                    {
+                        // last item; race against the thieves
+                        if (! _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                            result = nullptr;
+
+                        _bottom.store(b + 1, std::memory_order_relaxed);
+                    }
+
+                    return result;
+                }
+
+                Range * steal()
+                {
+                    long t = _top.load(std::memory_order_acquire);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    const long b = _bottom.load(std::memory_order_acquire);
+
+                    if (t >= b)
+                        return nullptr;
+
+                    Buffer * a = _buffer.load(std::memory_order_acquire);
+                    Range * result = a->get(t);
+                    if (! _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        return nullptr;
+
+                    return result;
+                }
+        };
+    }
+
     template <>
     struct Implementation<ThreadPool>
     {
@@ -40,8 +241,6 @@ namespace eos
         unsigned long stop_capacity;
 
         // Thread termination
-        Mutex * const terminate_mutex;
-
         bool terminate;
 
         // Job handling
@@ -50,64 +249,140 @@ namespace eos
         ConditionVariable * const job_arrival;
         ConditionVariable * const job_capacity;
 
-        unsigned long waiting_for_jobs;
+        // number of workers that are asleep or about to fall asleep
+        std::atomic<unsigned long> waiting_for_jobs;
+
+        // number of single jobs that have been enqueued but have not yet completed
         unsigned long pending_jobs;
 
-        std::list<std::pair<Ticket, std::function<void (void)> *>> queue;
+        // number of jobs and ranges in all queues and deques
+        std::atomic<unsigned long> queued;
+
+        // single jobs and ranges enqueued from outside of the pool; protected by job_mutex
+        std::deque<std::pair<Ticket, std::function<void (void)>>> queue;
+        std::deque<impl::Range *> ranges;
+        std::atomic<unsigned long> injected;
+
+        // ranges enqueued by the workers
+        std::vector<std::unique_ptr<impl::WorkStealingDeque>> deques;
 
         std::list<Thread *> threads;
 
-        void thread_function()
+        void wake_up()
         {
-            std::function<void (void)> * job;
-            Ticket ticket;
+            if (0 == waiting_for_jobs.load())
+                return;
+
+            Lock l(*job_mutex);
+            job_arrival->broadcast();
+        }
 
-            do
+        void run(impl::Range * range)
+        {
+            // the range goes out of scope as soon as the ticket is completed; hold on to the ticket
+            Ticket done(range->done);
+
+            range->work();
+            done.mark();
+        }
+
+        // run one job or one range; returns false if no work could be found
+        bool run_one(const unsigned & index)
+        {
+            if (impl::Range * range = deques[index]->pop())
             {
-                {
-                    Lock l(*terminate_mutex);
-                    if (terminate)
-                        break;
-                }
+                queued -= 1;
+                run(range);
 
-                job = 0;
+                return true;
+            }
+
+            if (injected.load() > 0)
+            {
+                impl::Range * range = nullptr;
+                std::pair<Ticket, std::function<void (void)>> job;
+                bool found = false;
 
                 {
                     Lock l(*job_mutex);
 
-                    if (queue.empty())
+                    if (! ranges.empty())
+                    {
+                        range = ranges.front();
+                        ranges.pop_front();
+                        found = true;
+                    }
+                    else if (! queue.empty())
                     {
-                        waiting_for_jobs += 1;
-                        job_arrival->wait(*job_mutex);
-                        waiting_for_jobs -= 1;
+                        job = std::move(queue.front());
+                        queue.pop_front();
+                        found = true;
                     }
 
-                    if (queue.empty())
+                    if (found)
                     {
-                        Lock l(*terminate_mutex);
-                        if (terminate)
-                            break;
-                        else
-                            continue;
+                        injected -= 1;
+                        queued -= 1;
                     }
+                }
 
-                    ticket = queue.front().first;
-                    job = queue.front().second;
-                    queue.pop_front();
+                if (range)
+                {
+                    run(range);
+
+                    return true;
                 }
 
-                (*job)();
+                if (found)
                 {
-                    Lock l(*job_mutex);
-                    pending_jobs -= 1;
+                    job.second();
+                    {
+                        Lock l(*job_mutex);
+                        pending_jobs -= 1;
+
+                        if (pending_jobs == nominal_capacity)
+                            job_capacity->signal();
+                    }
+                    job.first.mark();
 
-                    if (pending_jobs == nominal_capacity)
-                        job_capacity->signal();
+                    return true;
+                }
+            }
+
+            for (unsigned i = 1 ; i < number_of_threads ; ++i)
+            {
+                if (impl::Range * range = deques[(index + i) % number_of_threads]->steal())
+                {
+                    queued -= 1;
+                    run(range);
 
+                    return true;
                 }
-                ticket.mark();
             }
-            while (true);
+
+            return false;
+        }
+
+        void thread_function(const unsigned index)
+        {
+            impl::is_thread_pool_worker = true;
+            impl::worker_index = index;
+
+            while (true)
+            {
+                if (run_one(index))
+                    continue;
+
+                Lock l(*job_mutex);
+
+                if (terminate)
+                    break;
+
+                waiting_for_jobs += 1;
+                if (0 == queued.load())
+                    job_arrival->wait(*job_mutex);
+                waiting_for_jobs -= 1;
+            }
         }
 
         static unsigned _number_of_threads()
@@ -123,36 +398,38 @@ namespace eos
                 result = std::min(result, max_threads);
             }
 
-            return result;
+            return std::max(result, 1u);
         }
 
         Implementation() :
             number_of_threads(_number_of_threads()),
             nominal_capacity(number_of_threads * 10),
             stop_capacity(nominal_capacity * 2),
-            terminate_mutex(new Mutex),
             terminate(false),
             job_mutex(new Mutex),
             job_arrival(new ConditionVariable),
             job_capacity(new ConditionVariable),
             waiting_for_jobs(0),
-            pending_jobs(0)
+            pending_jobs(0),
+            queued(0),
+            injected(0)
         {
             for (unsigned i(0) ; i < number_of_threads ; ++i)
             {
-                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this)));
+                deques.emplace_back(new impl::WorkStealingDeque);
             }
-        }
 
-        ~Implementation()
-        {
+            for (unsigned i(0) ; i < number_of_threads ; ++i)
             {
-                Lock l(*terminate_mutex);
-                terminate = true;
+                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this, i)));
             }
+        }
 
+        ~Implementation()
+        {
             {
                 Lock l(*job_mutex);
+                terminate = true;
                 job_arrival->broadcast();
             }
 
@@ -176,18 +453,89 @@ namespace eos
     Ticket
     ThreadPool::enqueue(const std::function<void (void)> & job)
     {
-        std::pair<Ticket, std::function<void (void)> *> item(Ticket(), new std::function<void (void)>(job));
+        // Jobs that are enqueued from within a job are run immediately. Otherwise, all workers
+        // could end up waiting for jobs that cannot be scheduled anymore.
+        if (impl::is_thread_pool_worker)
+        {
+            Ticket ticket;
+            job();
+            ticket.mark();
+
+            return ticket;
+        }
+
+        Ticket ticket;
 
         {
             Lock l(*_imp->job_mutex);
-            _imp->queue.push_back(item);
+            _imp->queue.emplace_back(ticket, job);
             _imp->pending_jobs += 1;
+            _imp->injected += 1;
+            _imp->queued += 1;
 
             if (_imp->waiting_for_jobs > 0)
                 _imp->job_arrival->signal();
         }
 
-        return item.first;
+        return ticket;
+    }
+
+    void
+    ThreadPool::parallel_for(const std::size_t & begin, const std::size_t & end,
+            const std::function<void (const std::size_t &)> & body, const std::size_t & grain)
+    {
+        if (end <= begin)
+            return;
+
+        const std::size_t chunk = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (end - begin + chunk - 1) / chunk;
+
+        // the calling thread processes chunks, too
+        const unsigned helpers = std::min<std::size_t>(_imp->number_of_threads, chunks - 1);
+
+        impl::Range range(body, begin, end, chunk, helpers);
+
+        if (impl::is_thread_pool_worker)
+        {
+            // nested ranges go to the worker's own deque, from where idle workers steal them
+            auto & deque = _imp->deques[impl::worker_index];
+            for (unsigned i = 0 ; i < helpers ; ++i)
+            {
+                deque->push(&range);
+            }
+            _imp->queued += helpers;
+
+            if (helpers > 0)
+                _imp->wake_up();
+
+            range.work();
+
+            // keep working rather than blocking this worker, until all helpers are done
+            while (! range.done.completed())
+            {
+                if (! _imp->run_one(impl::worker_index))
+                    std::this_thread::yield();
+            }
+        }
+        else
+        {
+            if (helpers > 0)
+            {
+                Lock l(*_imp->job_mutex);
+                _imp->ranges.insert(_imp->ranges.end(), helpers, &range);
+                _imp->injected += helpers;
+                _imp->queued += helpers;
+
+                if (_imp->waiting_for_jobs > 0)
+                    _imp->job_arrival->broadcast();
+            }
+
+            range.work();
+            range.done.wait();
+        }
+
+        if (range.exception)
+            std::rethrow_exception(range.exception);
     }
 
     ThreadPool *
@@ -213,4 +561,3 @@ namespace eos
         return _imp->number_of_threads;
     }
 }
-
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011, 2015 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -24,10 +25,18 @@
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/ticket.hh>
 
+#include <cstddef>
 #include <functional>
 
 namespace eos
 {
+    /*!
+     * ThreadPool distributes work across a fixed set of worker threads.
+     *
+     * Each worker owns a work-stealing deque; idle workers steal from the other
+     * workers' deques, and jobs from outside of the pool are handed out through
+     * a shared queue.
+     */
     class ThreadPool :
         public InstantiationPolicy<ThreadPool, Singleton>,
         public PrivateImplementationPattern<ThreadPool>
@@ -37,8 +46,33 @@ namespace eos
 
             ~ThreadPool();
 
+            /*!
+             * Enqueue a single job.
+             *
+             * Jobs enqueued by a worker of the pool are run immediately.
+             *
+             * Single jobs are meant for coarse-grained, independent work. They are copied
+             * into a shared queue that is protected by a mutex, and are not subject to work
+             * stealing. Use parallel_for for fine-grained work.
+             */
             Ticket enqueue(const std::function<void (void)> & work);
 
+            /*!
+             * Apply a function to all indices in a range, in parallel.
+             *
+             * The range is processed in chunks of at least grain indices. The calling thread
+             * takes part in the work, and returns once all indices have been processed.
+             * If the function throws, the remaining chunks are skipped and the first
+             * exception is rethrown in the calling thread.
+             *
+             * @param begin  The first index of the range.
+             * @param end    One past the last index of the range.
+             * @param body   The function to apply to each index.
+             * @param grain  The minimal number of indices per chunk.
+             */
+            void parallel_for(const std::size_t & begin, const std::size_t & end,
+                    const std::function<void (const std::size_t &)> & body, const std::size_t & grain = 1);
+
             static ThreadPool * instance();
 
             void wait_for_free_capacity();
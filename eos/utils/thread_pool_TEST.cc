@@ -0,0 +1,129 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class ThreadPoolTest :
+    public TestCase
+{
+    public:
+        ThreadPoolTest() :
+            TestCase("thread_pool_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            /* Ticket as a latch */
+            {
+                Ticket ticket(3);
+                TEST_CHECK(! ticket.completed());
+                ticket.mark();
+                ticket.mark();
+                TEST_CHECK(! ticket.completed());
+                ticket.mark();
+                TEST_CHECK(ticket.completed());
+                ticket.wait();
+
+                // surplus marks are harmless
+                ticket.mark();
+                TEST_CHECK(ticket.completed());
+
+                TEST_CHECK(Ticket(0).completed());
+            }
+
+            /* Single jobs */
+            {
+                std::atomic<unsigned> counter(0);
+                std::vector<Ticket> tickets;
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue([&counter] () { ++counter; }));
+                }
+
+                for (auto & t : tickets)
+                {
+                    t.wait();
+                }
+
+                TEST_CHECK_EQUAL(100u, counter.load());
+            }
+
+            /* parallel_for visits every index exactly once */
+            {
+                for (std::size_t grain : { 1, 7, 1000 })
+                {
+                    std::vector<unsigned> visits(10000, 0);
+                    ThreadPool::instance()->parallel_for(0, visits.size(), [&visits] (const std::size_t & i) { visits[i] += 1; }, grain);
+
+                    TEST_CHECK_EQUAL(visits.size(), std::accumulate(visits.begin(), visits.end(), 0ul));
+                    TEST_CHECK_EQUAL(1u, *std::max_element(visits.begin(), visits.end()));
+                }
+
+                // empty range
+                ThreadPool::instance()->parallel_for(5, 5, [] (const std::size_t &) { throw std::exception(); });
+            }
+
+            /* nested parallel_for, from within parallel_for and from within single jobs */
+            {
+                std::vector<std::atomic<unsigned>> sums(64);
+                ThreadPool::instance()->parallel_for(0, sums.size(), [&sums] (const std::size_t & i) {
+                    ThreadPool::instance()->parallel_for(0, 100, [&sums, i] (const std::size_t & j) { sums[i] += j; });
+                });
+
+                for (auto & s : sums)
+                {
+                    TEST_CHECK_EQUAL(4950u, s.load());
+                }
+
+                std::atomic<unsigned> total(0);
+                std::vector<Ticket> tickets;
+                for (unsigned i = 0 ; i < 16 ; ++i)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue([&total] () {
+                        ThreadPool::instance()->parallel_for(0, 100, [&total] (const std::size_t & j) { total += j; });
+                    }));
+                }
+
+                for (auto & t : tickets)
+                {
+                    t.wait();
+                }
+
+                TEST_CHECK_EQUAL(16u * 4950u, total.load());
+            }
+
+            /* exceptions are rethrown in the calling thread */
+            {
+                TEST_CHECK_THROWS(InternalError, ThreadPool::instance()->parallel_for(0, 1000, [] (const std::size_t & i) {
+                    if (i == 500)
+                        throw InternalError("failure at index 500");
+                }));
+            }
+        }
+} thread_pool_test;
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2008, 2015 Danny van Dyk <danny.dyk@uni-dortmund.de>
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS program. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -24,6 +25,7 @@
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/ticket.hh>
 
+#include <atomic>
 #include <list>
 #include <memory>
 
@@ -35,16 +37,52 @@ namespace eos
 
         ConditionVariable completion;
 
-        bool completed;
+        // number of outstanding marks
+        std::atomic<unsigned> pending;
 
-        Implementation() :
-            completed(false)
+        Implementation(const unsigned & count) :
+            pending(count)
         {
         }
+
+        void mark()
+        {
+            unsigned p = pending.load();
+            do
+            {
+                if (0 == p)
+                    return;
+            }
+            while (! pending.compare_exchange_weak(p, p - 1));
+
+            if (1 == p)
+            {
+                Lock l(mutex);
+                completion.broadcast();
+            }
+        }
+
+        void wait()
+        {
+            if (0 == pending.load())
+                return;
+
+            Lock l(mutex);
+
+            while (0 != pending.load())
+            {
+                completion.wait(mutex);
+            }
+        }
     };
 
     Ticket::Ticket() :
-        PrivateImplementationPattern<Ticket>(new Implementation<Ticket>)
+        PrivateImplementationPattern<Ticket>(new Implementation<Ticket>(1))
+    {
+    }
+
+    Ticket::Ticket(const unsigned & count) :
+        PrivateImplementationPattern<Ticket>(new Implementation<Ticket>(count))
     {
     }
 
@@ -55,21 +93,19 @@ namespace eos
     void
     Ticket::mark()
     {
-        Lock l(_imp->mutex);
+        _imp->mark();
+    }
 
-        _imp->completed = true;
-        _imp->completion.signal();
+    bool
+    Ticket::completed() const
+    {
+        return 0 == _imp->pending.load();
     }
 
     void
     Ticket::wait() const
     {
-        Lock l(_imp->mutex);
-
-        while (! _imp->completed)
-        {
-            _imp->completion.wait(_imp->mutex);
-        }
+        _imp->wait();
     }
 
     template <> struct Implementation<TicketList>
@@ -99,14 +135,7 @@ namespace eos
         {
             std::shared_ptr<Implementation<Ticket> > ticket(_imp->tickets.front());
 
-            {
-                Lock l(ticket->mutex);
-
-                while (! ticket->completed)
-                {
-                    ticket->completion.wait(ticket->mutex);
-                }
-            }
+            ticket->wait();
 
             _imp->tickets.pop_front();
         }
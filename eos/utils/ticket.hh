@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2008 Danny van Dyk <danny.dyk@uni-dortmund.de>
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS program. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -30,6 +31,9 @@ namespace eos
     /**
      * Ticket is used by all asynchronous function calls to relay/query
      * information on a function's completion status.
+     *
+     * A ticket acts as a latch: it is completed once it has been marked
+     * as often as requested upon construction.
      */
     class Ticket :
         public PrivateImplementationPattern<Ticket>
@@ -48,14 +52,24 @@ namespace eos
             /// Constructor.
             Ticket();
 
+            /**
+             * Constructor.
+             *
+             * \param count Number of marks required for completion.
+             */
+            explicit Ticket(const unsigned & count);
+
             /// Destructor.
             ~Ticket();
 
             /// \}
 
-            /// Mark ticket as completed.
+            /// Mark ticket as completed, or decrease the number of outstanding marks.
             void mark();
 
+            /// Return whether the ticket has been completed, without waiting.
+            bool completed() const;
+
             /// Wait for ticket completion.
             void wait() const;
     };
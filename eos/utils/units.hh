@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2021 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -34,8 +35,6 @@ namespace eos
         private:
             Id _id;
 
-            Unit(const Id & id) : _id(id) {}
-
         public:
             enum class Id :
                 int
@@ -54,6 +53,7 @@ namespace eos
                 gev_s
             };
 
+            explicit Unit(const Id & id) : _id(id) {}
             Unit(const std::string &);
             Unit(const Unit &) = default;
             Unit(Unit &&) = default;
@@ -61,6 +61,8 @@ namespace eos
 
             const std::string & latex() const;
 
+            const Id & id() const { return _id; }
+
             static Unit Undefined();
             static Unit None();
             static Unit GeV();
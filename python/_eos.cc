@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2016, 2019, 2020 Danny van Dyk
  * Copyright (c) 2021 Philip Lüghausen
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -24,6 +25,7 @@
 #include "eos/observable.hh"
 #include "eos/reference.hh"
 #include "eos/signal-pdf.hh"
+#include "eos/signal-pdf-event-generator.hh"
 #include "eos/models/model.hh"
 #include "eos/utils/kinematic.hh"
 #include "eos/utils/log.hh"
@@ -36,6 +38,9 @@
 #include "eos/statistics/log-likelihood.hh"
 #include "eos/statistics/log-posterior.hh"
 #include "eos/statistics/log-prior.hh"
+#include "eos/statistics/markov-chain-sampler.hh"
+#include "eos/statistics/no-u-turn-sampler.hh"
+#include "eos/statistics/posterior-predictive.hh"
 #include "eos/statistics/test-statistic-impl.hh"
 
 #include <boost/python.hpp>
@@ -192,7 +197,401 @@ namespace impl
 
     void logging_callback(PyObject * c, const std::string & id, const LogLevel & l, const std::string & m)
     {
-        call<void>(c, id, l, m);
+        // messages can originate from threads that do not hold the GIL
+        PyGILState_STATE state = PyGILState_Ensure();
+        try
+        {
+            call<void>(c, id, l, m);
+        }
+        catch (...)
+        {
+            PyGILState_Release(state);
+            throw;
+        }
+        PyGILState_Release(state);
+    }
+
+    // RAII wrapper around a Python buffer, with its contents interpreted as double precision numbers
+    struct DoubleBuffer
+    {
+        Py_buffer view;
+
+        DoubleBuffer(object o, int flags, const std::string & name)
+        {
+            if (0 != PyObject_GetBuffer(o.ptr(), &view, flags | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT))
+            {
+                throw_error_already_set();
+            }
+
+            if ((nullptr == view.format) || (std::string("d") != view.format))
+            {
+                PyBuffer_Release(&view);
+                PyErr_SetString(PyExc_TypeError, ("'" + name + "' must be a contiguous buffer of double precision numbers").c_str());
+                throw_error_already_set();
+            }
+        }
+
+        ~DoubleBuffer()
+        {
+            PyBuffer_Release(&view);
+        }
+
+        double * data() const { return static_cast<double *>(view.buf); }
+    };
+
+    // release the GIL for the lifetime of this object
+    //
+    // Evaluations can run on the ThreadPool, whose workers acquire the GIL to forward log messages
+    // to Python. Holding the GIL while waiting for the workers would deadlock.
+    class ScopedGILRelease
+    {
+        private:
+            PyThreadState * _state;
+
+        public:
+            ScopedGILRelease() :
+                _state(PyEval_SaveThread())
+            {
+            }
+
+            ~ScopedGILRelease()
+            {
+                PyEval_RestoreThread(_state);
+            }
+    };
+
+    double LogLikelihood_evaluate(const LogLikelihood & log_likelihood)
+    {
+        ScopedGILRelease release;
+
+        return log_likelihood();
+    }
+
+    double LogPosterior_evaluate(const LogPosterior & log_posterior)
+    {
+        ScopedGILRelease release;
+
+        return log_posterior.evaluate();
+    }
+
+    double Observable_evaluate(const Observable & observable)
+    {
+        ScopedGILRelease release;
+
+        return observable.evaluate();
+    }
+
+    void ObservableCache_update(ObservableCache & cache)
+    {
+        ScopedGILRelease release;
+
+        cache.update();
+    }
+
+    // evaluate the log(posterior) for a batch of points without holding the GIL
+    void LogPosterior_evaluate_batch(const LogPosterior & log_posterior, object points, object out)
+    {
+        DoubleBuffer p(points, PyBUF_SIMPLE, "points");
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+
+        if (2 != p.view.ndim)
+        {
+            PyErr_SetString(PyExc_ValueError, "'points' must be a two-dimensional array");
+            throw_error_already_set();
+        }
+
+        const std::size_t n   = p.view.shape[0];
+        const std::size_t dim = p.view.shape[1];
+
+        if ((1 != o.view.ndim) || (std::size_t(o.view.shape[0]) != n))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a one-dimensional array with one element per point");
+            throw_error_already_set();
+        }
+
+        {
+            ScopedGILRelease release;
+            log_posterior.evaluate_batch(p.data(), n, dim, o.data());
+        }
+    }
+
+    // evaluate the log(posterior) and its gradient; returns a tuple of the value and the list of derivatives
+    tuple LogPosterior_evaluate_with_gradient(const LogPosterior & log_posterior)
+    {
+        std::vector<double> gradient;
+        double value;
+        {
+            ScopedGILRelease release;
+            value = log_posterior.evaluate_with_gradient(gradient);
+        }
+
+        list result;
+        for (const auto & g : gradient)
+        {
+            result.append(g);
+        }
+
+        return boost::python::make_tuple(value, result);
+    }
+
+    // create a MarkovChainSampler from its configuration
+    std::shared_ptr<MarkovChainSampler> MarkovChainSampler_make(const LogPosterior & log_posterior, unsigned chains, unsigned N, unsigned stride,
+            unsigned pre_N, unsigned preruns, double cov_scale, unsigned long seed)
+    {
+        MarkovChainSampler::Config config;
+        config.number_of_chains  = chains;
+        config.samples           = N;
+        config.stride            = stride;
+        config.prerun_samples    = pre_N;
+        config.number_of_preruns = preruns;
+        config.covariance_scale  = cov_scale;
+        config.seed              = seed;
+
+        // the chains clone the log(posterior), which updates their caches on the ThreadPool
+        std::shared_ptr<MarkovChainSampler> result;
+        {
+            ScopedGILRelease release;
+            result = std::make_shared<MarkovChainSampler>(log_posterior, config);
+        }
+
+        return result;
+    }
+
+    // the following functions are shared by MarkovChainSampler and NoUTurnSampler
+
+    template <typename Sampler_>
+    void Sampler_set_start_point(Sampler_ & sampler, unsigned chain, object point)
+    {
+        std::vector<double> p;
+        for (unsigned i = 0, i_end = len(point) ; i < i_end ; ++i)
+        {
+            p.push_back(extract<double>(point[i]));
+        }
+
+        sampler.set_start_point(chain, p);
+    }
+
+    // run all chains without holding the GIL
+    template <typename Sampler_>
+    void Sampler_run(Sampler_ & sampler)
+    {
+        ScopedGILRelease release;
+
+        sampler.run();
+    }
+
+    template <typename Sampler_>
+    void Sampler_samples(const Sampler_ & sampler, object out)
+    {
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+
+        if ((3 != o.view.ndim)
+                || (std::size_t(o.view.shape[0]) != sampler.number_of_chains())
+                || (std::size_t(o.view.shape[1]) != sampler.number_of_samples())
+                || (std::size_t(o.view.shape[2]) != sampler.dimension()))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a three-dimensional array of shape (chains, N, D)");
+            throw_error_already_set();
+        }
+
+        std::copy(sampler.samples().cbegin(), sampler.samples().cend(), o.data());
+    }
+
+    template <typename Sampler_>
+    void Sampler_log_posterior_values(const Sampler_ & sampler, object out)
+    {
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+
+        if ((2 != o.view.ndim)
+                || (std::size_t(o.view.shape[0]) != sampler.number_of_chains())
+                || (std::size_t(o.view.shape[1]) != sampler.number_of_samples()))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a two-dimensional array of shape (chains, N)");
+            throw_error_already_set();
+        }
+
+        std::copy(sampler.log_posterior_values().cbegin(), sampler.log_posterior_values().cend(), o.data());
+    }
+
+    template <typename Sampler_>
+    boost::python::list Sampler_acceptance_rates(const Sampler_ & sampler)
+    {
+        boost::python::list result;
+        for (const auto & rate : sampler.acceptance_rates())
+        {
+            result.append(rate);
+        }
+
+        return result;
+    }
+
+    // create a NoUTurnSampler from its configuration
+    std::shared_ptr<NoUTurnSampler> NoUTurnSampler_make(const LogPosterior & log_posterior, unsigned chains, unsigned N, unsigned warmup,
+            double target_acceptance, unsigned max_depth, bool dense, unsigned long seed)
+    {
+        NoUTurnSampler::Config config;
+        config.number_of_chains   = chains;
+        config.samples            = N;
+        config.warmup_samples     = warmup;
+        config.target_acceptance  = target_acceptance;
+        config.maximum_tree_depth = max_depth;
+        config.dense_mass_matrix  = dense;
+        config.seed               = seed;
+
+        // the chains clone the log(posterior), which updates their caches on the ThreadPool
+        std::shared_ptr<NoUTurnSampler> result;
+        {
+            ScopedGILRelease release;
+            result = std::make_shared<NoUTurnSampler>(log_posterior, config);
+        }
+
+        return result;
+    }
+
+    boost::python::list NoUTurnSampler_step_sizes(const NoUTurnSampler & sampler)
+    {
+        boost::python::list result;
+        for (const auto & step_size : sampler.step_sizes())
+        {
+            result.append(step_size);
+        }
+
+        return result;
+    }
+
+    boost::python::list NoUTurnSampler_divergences(const NoUTurnSampler & sampler)
+    {
+        boost::python::list result;
+        for (const auto & divergences : sampler.divergences())
+        {
+            result.append(divergences);
+        }
+
+        return result;
+    }
+
+    // create a PosteriorPredictive for the observables in a cache
+    std::shared_ptr<PosteriorPredictive> PosteriorPredictive_make(const ObservableCache & cache, object parameters)
+    {
+        std::vector<std::string> names;
+        for (unsigned i = 0, i_end = len(parameters) ; i < i_end ; ++i)
+        {
+            names.push_back(extract<std::string>(parameters[i]));
+        }
+
+        return std::make_shared<PosteriorPredictive>(cache, names);
+    }
+
+    // evaluate the predictions into a caller-provided buffer without holding the GIL
+    void PosteriorPredictive_evaluate(const PosteriorPredictive & predictive, object samples, object out)
+    {
+        DoubleBuffer s(samples, PyBUF_SIMPLE, "samples");
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+
+        if (2 != s.view.ndim)
+        {
+            PyErr_SetString(PyExc_ValueError, "'samples' must be a two-dimensional array");
+            throw_error_already_set();
+        }
+
+        const std::size_t n   = s.view.shape[0];
+        const std::size_t dim = s.view.shape[1];
+
+        if ((2 != o.view.ndim)
+                || (std::size_t(o.view.shape[0]) != n)
+                || (std::size_t(o.view.shape[1]) != predictive.number_of_observables()))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a two-dimensional array with one row per sample and one column per observable");
+            throw_error_already_set();
+        }
+
+        {
+            ScopedGILRelease release;
+            predictive.evaluate(s.data(), n, dim, o.data());
+        }
+    }
+
+    // create a SignalPDFEventGenerator from its configuration
+    std::shared_ptr<SignalPDFEventGenerator> SignalPDFEventGenerator_make(const SignalPDFPtr & pdf, unsigned streams, unsigned bins,
+            unsigned adaptations, unsigned adaptation_samples, double safety_factor, unsigned long seed)
+    {
+        SignalPDFEventGenerator::Config config;
+        config.number_of_streams     = streams;
+        config.number_of_bins        = bins;
+        config.number_of_adaptations = adaptations;
+        config.adaptation_samples    = adaptation_samples;
+        config.safety_factor         = safety_factor;
+        config.seed                  = seed;
+
+        std::shared_ptr<SignalPDFEventGenerator> result;
+        {
+            ScopedGILRelease release;
+            result = std::make_shared<SignalPDFEventGenerator>(pdf, config);
+        }
+
+        return result;
+    }
+
+    // rebuild the importance grid and the envelope without holding the GIL
+    void SignalPDFEventGenerator_adapt(SignalPDFEventGenerator & generator)
+    {
+        ScopedGILRelease release;
+
+        generator.adapt();
+    }
+
+    // generate unweighted events into a caller-provided buffer without holding the GIL
+    void SignalPDFEventGenerator_generate(SignalPDFEventGenerator & generator, object out)
+    {
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+
+        if ((2 != o.view.ndim) || (std::size_t(o.view.shape[1]) != generator.dimension()))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a two-dimensional array of shape (N, D)");
+            throw_error_already_set();
+        }
+
+        const std::size_t n = o.view.shape[0];
+        {
+            ScopedGILRelease release;
+            generator.generate(o.data(), n);
+        }
+    }
+
+    // generate weighted events into caller-provided buffers without holding the GIL
+    void SignalPDFEventGenerator_generate_weighted(SignalPDFEventGenerator & generator, object out, object weights)
+    {
+        DoubleBuffer o(out, PyBUF_WRITABLE, "out");
+        DoubleBuffer w(weights, PyBUF_WRITABLE, "weights");
+
+        if ((2 != o.view.ndim) || (std::size_t(o.view.shape[1]) != generator.dimension()))
+        {
+            PyErr_SetString(PyExc_ValueError, "'out' must be a two-dimensional array of shape (N, D)");
+            throw_error_already_set();
+        }
+
+        const std::size_t n = o.view.shape[0];
+        if ((1 != w.view.ndim) || (std::size_t(w.view.shape[0]) != n))
+        {
+            PyErr_SetString(PyExc_ValueError, "'weights' must be a one-dimensional array of shape (N,)");
+            throw_error_already_set();
+        }
+
+        {
+            ScopedGILRelease release;
+            generator.generate_weighted(o.data(), w.data(), n);
+        }
+    }
+
+    boost::python::list SignalPDFEventGenerator_variables(const SignalPDFEventGenerator & generator)
+    {
+        boost::python::list result;
+        for (const auto & v : generator.variables())
+        {
+            result.append(v);
+        }
+
+        return result;
     }
 
     void register_log_callback(PyObject * c)
@@ -494,11 +893,12 @@ BOOST_PYTHON_MODULE(_eos)
         ;
 
     // ObservableCache
-    class_<ObservableCache>("ObservableCache", no_init)
+    class_<ObservableCache>("ObservableCache", init<Parameters>())
         .def("__iter__", range(&ObservableCache::begin, &ObservableCache::end))
         .def("__getitem__", &ObservableCache::operator[])
+        .def("__len__", &ObservableCache::size)
         .def("add", &ObservableCache::add)
-        .def("update", &ObservableCache::update)
+        .def("update", &impl::ObservableCache_update)
         ;
 
     // ReferenceName
@@ -526,7 +926,7 @@ BOOST_PYTHON_MODULE(_eos)
         .def("add", (void (LogLikelihood::*)(const Constraint &)) &LogLikelihood::add)
         .def("__iter__", range(&LogLikelihood::begin, &LogLikelihood::end))
         .def("observable_cache", &LogLikelihood::observable_cache)
-        .def("evaluate", &LogLikelihood::operator())
+        .def("evaluate", &impl::LogLikelihood_evaluate)
         ;
 
     // Constraint
@@ -637,7 +1037,157 @@ BOOST_PYTHON_MODULE(_eos)
         .def("add", &LogPosterior::add)
         .def("log_likelihood", &LogPosterior::log_likelihood)
         .def("log_priors", range(&LogPosterior::begin_priors, &LogPosterior::end_priors))
-        .def("evaluate", &LogPosterior::evaluate)
+        .def("evaluate", &impl::LogPosterior_evaluate)
+        .def("evaluate_batch", &impl::LogPosterior_evaluate_batch, R"(
+            Evaluates the log(posterior) for a batch of parameter points in parallel.
+
+            :param points: The parameter points, with one row per point and the columns in the order of the varied parameters.
+            :type points: numpy.ndarray of shape (N, D) and dtype float64, C-contiguous
+            :param out: The array that receives the values of the log(posterior).
+            :type out: numpy.ndarray of shape (N,) and dtype float64, C-contiguous
+        )", args("self", "points", "out"))
+        .def("evaluate_with_gradient", &impl::LogPosterior_evaluate_with_gradient, R"(
+            Evaluates the log(posterior) together with its gradient with respect to the varied parameters.
+
+            Observables that support automatic differentiation are differentiated exactly; all other
+            observables are differentiated numerically.
+
+            :returns: The value of the log(posterior) and the list of partial derivatives, in the order of the varied parameters.
+            :rtype: tuple of float and list of float
+        )", args("self"))
+        ;
+
+    // MarkovChainSampler
+    register_ptr_to_python<std::shared_ptr<MarkovChainSampler>>();
+    class_<MarkovChainSampler, boost::noncopyable>("MarkovChainSampler", R"(
+            Samples a log(posterior) natively with several independent adaptive Markov chains.
+
+            The chains run in parallel, each on its own clone of the log(posterior), and without holding the Python GIL.
+
+            :param log_posterior: The log(posterior) that shall be sampled.
+            :type log_posterior: eos.LogPosterior
+            :param chains: Number of independent chains.
+            :param N: Number of samples that each chain returns.
+            :param stride: Stride, i.e., the number by which the steps of each chain are thinned to return N samples.
+            :param pre_N: Number of steps in each prerun.
+            :param preruns: Number of preruns.
+            :param cov_scale: Scale factor for the initial guess of the covariance matrix.
+            :param seed: Seed for the random number generators; chain i uses seed + i.
+        )", no_init)
+        .def("__init__", make_constructor(&impl::MarkovChainSampler_make, default_call_policies(),
+                    (arg("log_posterior"), arg("chains") = 4, arg("N") = 1000, arg("stride") = 5, arg("pre_N") = 150,
+                     arg("preruns") = 3, arg("cov_scale") = 0.1, arg("seed") = 0)))
+        .def("set_start_point", &impl::Sampler_set_start_point<MarkovChainSampler>, R"(
+            Sets the starting point of one chain.
+
+            :param chain: The index of the chain.
+            :param point: The starting point, in the order of the varied parameters.
+        )", args("self", "chain", "point"))
+        .def("run", &impl::Sampler_run<MarkovChainSampler>, R"(
+            Runs the preruns and the main run of all chains.
+        )", args("self"))
+        .def("samples", &impl::Sampler_samples<MarkovChainSampler>, R"(
+            Retrieves the samples of all chains.
+
+            :param out: The array that receives the samples.
+            :type out: numpy.ndarray of shape (chains, N, D) and dtype float64, C-contiguous
+        )", args("self", "out"))
+        .def("log_posterior_values", &impl::Sampler_log_posterior_values<MarkovChainSampler>, R"(
+            Retrieves the values of the log(posterior) for the samples of all chains.
+
+            :param out: The array that receives the values.
+            :type out: numpy.ndarray of shape (chains, N) and dtype float64, C-contiguous
+        )", args("self", "out"))
+        .def("acceptance_rates", &impl::Sampler_acceptance_rates<MarkovChainSampler>, R"(
+            Returns the acceptance rate of each chain in its main run.
+        )", args("self"))
+        .def("number_of_chains", &MarkovChainSampler::number_of_chains)
+        .def("number_of_samples", &MarkovChainSampler::number_of_samples)
+        .def("dimension", &MarkovChainSampler::dimension)
+        ;
+
+    // NoUTurnSampler
+    register_ptr_to_python<std::shared_ptr<NoUTurnSampler>>();
+    class_<NoUTurnSampler, boost::noncopyable>("NoUTurnSampler", R"(
+            Samples a log(posterior) natively with several independent chains of the No-U-Turn Sampler.
+
+            The chains run in parallel, each on its own clone of the log(posterior), and without holding the Python GIL.
+            The gradient of the log(posterior) is obtained as in :meth:`eos.LogPosterior.evaluate_with_gradient`.
+
+            :param log_posterior: The log(posterior) that shall be sampled.
+            :type log_posterior: eos.LogPosterior
+            :param chains: Number of independent chains.
+            :param N: Number of samples that each chain returns.
+            :param warmup: Number of warmup steps, during which the step size and the mass matrix are adapted.
+            :param target_acceptance: Average acceptance probability targeted by the adaptation of the step size.
+            :param max_depth: Maximal depth of the trajectory's binary tree.
+            :param dense: If true, adapt a dense mass matrix; otherwise adapt a diagonal mass matrix.
+            :param seed: Seed for the random number generators; chain i uses seed + i.
+        )", no_init)
+        .def("__init__", make_constructor(&impl::NoUTurnSampler_make, default_call_policies(),
+                    (arg("log_posterior"), arg("chains") = 4, arg("N") = 1000, arg("warmup") = 500, arg("target_acceptance") = 0.8,
+                     arg("max_depth") = 10, arg("dense") = false, arg("seed") = 0)))
+        .def("set_start_point", &impl::Sampler_set_start_point<NoUTurnSampler>, R"(
+            Sets the starting point of one chain.
+
+            :param chain: The index of the chain.
+            :param point: The starting point, in the order of the varied parameters.
+        )", args("self", "chain", "point"))
+        .def("run", &impl::Sampler_run<NoUTurnSampler>, R"(
+            Runs the warmup and the main run of all chains.
+        )", args("self"))
+        .def("samples", &impl::Sampler_samples<NoUTurnSampler>, R"(
+            Retrieves the samples of all chains.
+
+            :param out: The array that receives the samples.
+            :type out: numpy.ndarray of shape (chains, N, D) and dtype float64, C-contiguous
+        )", args("self", "out"))
+        .def("log_posterior_values", &impl::Sampler_log_posterior_values<NoUTurnSampler>, R"(
+            Retrieves the values of the log(posterior) for the samples of all chains.
+
+            :param out: The array that receives the values.
+            :type out: numpy.ndarray of shape (chains, N) and dtype float64, C-contiguous
+        )", args("self", "out"))
+        .def("acceptance_rates", &impl::Sampler_acceptance_rates<NoUTurnSampler>, R"(
+            Returns the average acceptance probability of each chain in its main run.
+        )", args("self"))
+        .def("step_sizes", &impl::NoUTurnSampler_step_sizes, R"(
+            Returns the adapted step size of each chain.
+        )", args("self"))
+        .def("divergences", &impl::NoUTurnSampler_divergences, R"(
+            Returns the number of divergent trajectories of each chain in its main run.
+        )", args("self"))
+        .def("number_of_chains", &NoUTurnSampler::number_of_chains)
+        .def("number_of_samples", &NoUTurnSampler::number_of_samples)
+        .def("dimension", &NoUTurnSampler::dimension)
+        ;
+
+    // PosteriorPredictive
+    register_ptr_to_python<std::shared_ptr<PosteriorPredictive>>();
+    class_<PosteriorPredictive, boost::noncopyable>("PosteriorPredictive", R"(
+            Predicts the observables in a cache natively for a batch of posterior samples.
+
+            The samples are evaluated in parallel, each thread on its own clone of the cache, and without holding the Python GIL.
+
+            :param cache: The cache of the observables that shall be predicted.
+            :type cache: eos.ObservableCache
+            :param parameters: The names of the parameters, in the order of the components of each sample.
+            :type parameters: list of str
+        )", no_init)
+        .def("__init__", make_constructor(&impl::PosteriorPredictive_make, default_call_policies(),
+                    (arg("cache"), arg("parameters"))))
+        .def("evaluate", &impl::PosteriorPredictive_evaluate, R"(
+            Evaluates the predictions for a batch of samples.
+
+            If any observable cannot be evaluated for a sample, all predictions for that sample are NaN.
+
+            :param samples: The samples, with one row per sample.
+            :type samples: numpy.ndarray of shape (N, D) and dtype float64, C-contiguous
+            :param out: The array that receives the predictions, with one column per index returned by ObservableCache.add.
+            :type out: numpy.ndarray of shape (N, M) and dtype float64, C-contiguous
+        )", args("self", "samples", "out"))
+        .def("dimension", &PosteriorPredictive::dimension)
+        .def("number_of_observables", &PosteriorPredictive::number_of_observables)
         ;
 
     // test_statistics::ChiSquare
@@ -712,7 +1262,7 @@ BOOST_PYTHON_MODULE(_eos)
             :rtype: eos.Observable
         )", args("name", "parameters", "kinematics", "options"))
         .staticmethod("make")
-        .def("evaluate", &Observable::evaluate, R"(
+        .def("evaluate", &impl::Observable_evaluate, R"(
             Evaluates the observable for the present values of its bound set of parameters and set of kinematic variables.
 
             :return: The value of the observable.
@@ -818,6 +1368,55 @@ BOOST_PYTHON_MODULE(_eos)
         )")
         ;
 
+    // SignalPDFEventGenerator
+    register_ptr_to_python<std::shared_ptr<SignalPDFEventGenerator>>();
+    class_<SignalPDFEventGenerator, boost::noncopyable>("SignalPDFEventGenerator", R"(
+            Generates independent events from a signal PDF natively.
+
+            The generator adapts a VEGAS-style importance grid to the PDF at the current parameter point, and uses it
+            as the envelope for accept-reject sampling. Events are generated in parallel by independent streams,
+            each with its own clone of the PDF and its own random number generator, and without holding the Python GIL.
+
+            :param pdf: The PDF from which events shall be generated.
+            :type pdf: eos.SignalPDF
+            :param streams: Number of independent streams of events.
+            :param bins: Number of bins of the importance grid per kinematic variable.
+            :param adaptations: Number of adaptations of the importance grid.
+            :param adaptation_samples: Number of samples used in each adaptation.
+            :param safety_factor: Factor by which the largest weight observed in the adaptation is increased to obtain the envelope.
+            :param seed: Seed for the random number generators; stream i uses seed + i.
+        )", no_init)
+        .def("__init__", make_constructor(&impl::SignalPDFEventGenerator_make, default_call_policies(),
+                    (arg("pdf"), arg("streams") = 8, arg("bins") = 50, arg("adaptations") = 5,
+                     arg("adaptation_samples") = 20000, arg("safety_factor") = 1.2, arg("seed") = 0)))
+        .def("adapt", &impl::SignalPDFEventGenerator_adapt, R"(
+            Rebuilds the importance grid and the envelope. Must be called after any change of the PDF's parameters.
+        )", args("self"))
+        .def("generate", &impl::SignalPDFEventGenerator_generate, R"(
+            Generates unweighted events.
+
+            :param out: The array that receives the events; its number of rows determines the number of events.
+            :type out: numpy.ndarray of shape (N, D) and dtype float64, C-contiguous
+        )", args("self", "out"))
+        .def("generate_weighted", &impl::SignalPDFEventGenerator_generate_weighted, R"(
+            Generates weighted events from the importance grid, without rejection.
+
+            The mean of the weights estimates the integral of the PDF over the kinematic ranges.
+
+            :param out: The array that receives the events; its number of rows determines the number of events.
+            :type out: numpy.ndarray of shape (N, D) and dtype float64, C-contiguous
+            :param weights: The array that receives the weights.
+            :type weights: numpy.ndarray of shape (N,) and dtype float64, C-contiguous
+        )", args("self", "out", "weights"))
+        .def("variables", &impl::SignalPDFEventGenerator_variables, R"(
+            Returns the names of the kinematic variables, in the order of the columns of the events.
+        )", args("self"))
+        .def("dimension", &SignalPDFEventGenerator::dimension)
+        .def("integral", &SignalPDFEventGenerator::integral)
+        .def("acceptance_rate", &SignalPDFEventGenerator::acceptance_rate)
+        .def("number_of_overweight_events", &SignalPDFEventGenerator::number_of_overweight_events)
+        ;
+
     // SignalPDFEntry
     register_ptr_to_python<std::shared_ptr<SignalPDFEntry>>();
     class_<SignalPDFEntry, boost::noncopyable>("SignalPDFEntry", no_init)
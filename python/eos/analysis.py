@@ -2,6 +2,7 @@
 # vim: set sw=4 sts=4 et tw=120 :
 
 # Copyright (c) 2018, 2019, 2020 Danny van Dyk
+# Copyright (c) 2023 agent
 #
 # This file is part of the EOS project. EOS is free software;
 # you can redistribute it and/or modify it under the terms of the GNU General
@@ -226,7 +227,7 @@ class Analysis:
         return eos.GoodnessOfFit(self._log_posterior)
 
 
-    def optimize(self, start_point=None, rng=np.random.mtrand, **kwargs):
+    def optimize(self, start_point=None, rng=np.random.mtrand, gradient=False, **kwargs):
         """
         Optimize the log(posterior) and returns a best-fit-point summary.
 
@@ -235,6 +236,8 @@ class Analysis:
                             If not specified, optimization starts at the current parameter point.
         :type start_point: iterable, optional
         :param rng: Optional random number generator
+        :param gradient: If true, provide the optimizer with the gradient of the log(posterior), cf. eos.LogPosterior.evaluate_with_gradient.
+        :type gradient: bool, optional
         :param \**kwargs: Are passed to `scipy.optimize.minimize`
 
         """
@@ -247,8 +250,11 @@ class Analysis:
         # Update default values. If no keyword arguments are passed, kwargs is an empty dict
         scipy_opt_kwargs.update(kwargs)
 
+        if gradient:
+            scipy_opt_kwargs.update({ 'jac': True })
+
         res = scipy.optimize.minimize(
-            self.negative_log_pdf,
+            self.negative_log_pdf_with_gradient if gradient else self.negative_log_pdf,
             self._par_to_x(start_point),
             args=None,
             bounds=[(-1.0, 1.0) for b in self.bounds],
@@ -289,6 +295,28 @@ class Analysis:
             return(-np.inf)
 
 
+    def log_pdf_batch(self, xs):
+        """
+        Evaluates the log(posterior) for a batch of parameter points in parallel.
+
+        The points are evaluated natively and without holding the Python GIL. Points for which the evaluation
+        fails yield -inf.
+
+        :param xs: Parameter points, with one row per point and the elements of each row in the same order as in eos.Analysis.varied_parameters, rescaled so that every element is in the interval [-1, +1].
+        :type xs: 2D array-like
+        :return: The values of the log(posterior).
+        :rtype: numpy.ndarray
+        """
+        xs = np.atleast_2d(np.asarray(xs, dtype=np.float64))
+        bounds = np.array(self.bounds, dtype=np.float64)
+        points = np.ascontiguousarray((bounds[:, 1] - bounds[:, 0]) * xs / 2 + (bounds[:, 0] + bounds[:, 1]) / 2)
+        result = np.empty(points.shape[0], dtype=np.float64)
+
+        self._log_posterior.evaluate_batch(points, result)
+
+        return result
+
+
     def negative_log_pdf(self, x, *args):
         """
         Adapter for use with external optimization software (e.g. scipy.optimize.minimize) to aid when optimizing the log(posterior).
@@ -301,7 +329,35 @@ class Analysis:
         return -self.log_pdf(x, *args)
 
 
-    def sample(self, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, observables=None, start_point=None, rng=np.random.mtrand):
+    def negative_log_pdf_with_gradient(self, x, *args):
+        """
+        Adapter for use with external optimization software (e.g. scipy.optimize.minimize with jac=True) to aid when optimizing the log(posterior).
+
+        :param x: Parameter point, with the elements in the same order as in eos.Analysis.varied_parameters, rescaled so that every element is in the interval [-1, +1].
+        :type x: iterable
+        :param args: Dummy parameter (ignored)
+        :type args: optional
+        :return: The negative log(posterior) and its gradient with respect to the rescaled parameters.
+        :rtype: tuple of float and numpy.ndarray
+        """
+        for p, v in zip(self.varied_parameters, self._x_to_par(x)):
+            p.set(v)
+
+        try:
+            value, gradient = self._log_posterior.evaluate_with_gradient()
+        except RuntimeError as e:
+            error('encountered run time error ({e}) when evaluating log(posterior) in parameter point:'.format(e=e))
+            for p in self.varied_parameters:
+                error(' - {n}: {v}'.format(n=p.name(), v=p.evaluate()))
+            return (np.inf, np.zeros(len(self.varied_parameters)))
+
+        # chain rule for the rescaling to [-1, +1]
+        scale = np.array([(b[1] - b[0]) / 2 for b in self.bounds])
+
+        return (-value, -np.array(gradient) * scale)
+
+
+    def sample(self, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, observables=None, start_point=None, rng=np.random.mtrand, callback=None):
         """
         Return samples of the parameters, log(weights), and optionally posterior-predictive samples for a sequence of observables.
 
@@ -318,6 +374,10 @@ class Analysis:
         :param start_point: Optional starting point for the chain
         :type start_point: list-like, optional
         :param rng: Optional random number generator (must be compatible with the requirements of pypmc.sampler.markov_chain.MarkovChain)
+        :param callback: Optional function that is called with the keyword arguments ``samples`` and ``weights``, i.e., the parameters
+            and the logarithmic weights of the samples, as soon as each chunk of the main run is complete, e.g., the append method of
+            :meth:`eos.data.MarkovChain.stream`.
+        :type callback: callable, optional
 
         :return: A tuple of the parameters as array of size N, the logarithmic weights as array of size N, and optionally the posterior-predictive samples of the observables as array of size N x len(observables).
 
@@ -364,8 +424,18 @@ class Analysis:
         sample_chunk  = sample_total // 100
         sample_chunks = [sample_chunk for i in range(0, 99)]
         sample_chunks.append(sample_total - 99 * sample_chunk)
+        sample_offset = 0
         for current_chunk in progressbar(sample_chunks, desc="Main run", leave=False):
             accept_count = accept_count + sampler.run(current_chunk)
+            if callback is not None and current_chunk > 0:
+                # pass on the samples of this chunk that survive the thinning; chunks that are
+                # shorter than the stride can be left without any samples
+                first = (-sample_offset) % stride
+                chunk_samples = sampler.samples[-1][first::stride]
+                if len(chunk_samples) > 0:
+                    callback(samples=np.array([self._x_to_par(x) for x in chunk_samples]).reshape(-1, len(self.bounds)),
+                             weights=sampler.target_values[-1][first::stride, 0])
+            sample_offset += current_chunk
         accept_rate  = accept_count / (N * stride) * 100
         eos.info('Main run: acceptance rate is {:3.0f}%'.format(accept_rate))
 
@@ -386,6 +456,120 @@ class Analysis:
             return(parameter_samples, weights, np.array(observable_samples))
 
 
+    def sample_chains(self, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, chains=4, observables=None, start_point=None, seed=None, rng=np.random.mtrand):
+        """
+        Return samples of the parameters, log(weights), and optionally posterior-predictive samples for a sequence of observables.
+
+        Obtains random samples of the log(posterior) using several independent adaptive Markov Chain Monte Carlo chains.
+        The chains are run natively and in parallel, following the same prerun and adaptation scheme as :meth:`eos.Analysis.sample`.
+        The samples of the preruns are discarded.
+
+        :param N: Number of samples that shall be returned per chain.
+        :param stride: Stride, i.e., the number by which the actual amount of samples shall be thinned to return N samples.
+        :param pre_N: Number of samples in each prerun.
+        :param preruns: Number of preruns.
+        :param cov_scale: Scale factor for the initial guess of the covariance matrix.
+        :param chains: Number of independent chains.
+        :param observables: Observables for which posterior-predictive samples shall be obtained.
+        :type observables: list-like, optional
+        :param start_point: Optional starting point for all chains
+        :type start_point: list-like, optional
+        :param seed: Optional seed for the random number generators of the chains. If not provided, it is drawn from rng.
+        :type seed: int, optional
+        :param rng: Optional random number generator, used to draw the seed.
+
+        :return: A tuple of the parameters as array of size chains x N, the logarithmic weights as array of size chains x N, and optionally the posterior-predictive samples of the observables as array of size chains x N x len(observables).
+        """
+        if seed is None:
+            seed = int(rng.randint(0, 2**31))
+
+        sampler = eos.MarkovChainSampler(self._log_posterior, chains=chains, N=N, stride=stride, pre_N=pre_N, preruns=preruns, cov_scale=cov_scale, seed=seed)
+        if start_point is not None:
+            for chain in range(chains):
+                sampler.set_start_point(chain, list(start_point))
+
+        eos.info('Running {} chains ...'.format(chains))
+        sampler.run()
+        for chain, rate in enumerate(sampler.acceptance_rates()):
+            eos.info('Chain {}: acceptance rate is {:3.0f}%'.format(chain, rate * 100))
+
+        parameter_samples = np.empty((chains, N, len(self.varied_parameters)), dtype=np.float64)
+        sampler.samples(parameter_samples)
+        weights = np.empty((chains, N), dtype=np.float64)
+        sampler.log_posterior_values(weights)
+
+        if not observables:
+            return(parameter_samples, weights)
+        else:
+            observable_samples = []
+            for parameters in parameter_samples.reshape(chains * N, -1):
+                for p, v in zip(self.varied_parameters, parameters):
+                    p.set(v)
+
+                observable_samples.append([o.evaluate() for o in observables])
+
+            return(parameter_samples, weights, np.array(observable_samples).reshape(chains, N, len(observables)))
+
+
+    def sample_nuts(self, N=1000, warmup=500, chains=4, target_acceptance=0.8, max_depth=10, dense=False, observables=None, start_point=None, seed=None, rng=np.random.mtrand):
+        """
+        Return samples of the parameters, log(weights), and optionally posterior-predictive samples for a sequence of observables.
+
+        Obtains random samples of the log(posterior) using several independent chains of the No-U-Turn Sampler, a variant of
+        Hamiltonian Monte Carlo. The chains are run natively and in parallel. During the warmup, the step size and the mass matrix
+        are adapted. The samples of the warmup are discarded.
+        The gradient of the log(posterior) is obtained as in :meth:`eos.LogPosterior.evaluate_with_gradient`.
+
+        :param N: Number of samples that shall be returned per chain.
+        :param warmup: Number of warmup steps per chain.
+        :param chains: Number of independent chains.
+        :param target_acceptance: Average acceptance probability targeted by the adaptation of the step size.
+        :param max_depth: Maximal depth of the trajectory's binary tree, i.e., at most 2^max_depth leapfrog steps per sample.
+        :param dense: If true, adapt a dense mass matrix; otherwise adapt a diagonal mass matrix.
+        :param observables: Observables for which posterior-predictive samples shall be obtained.
+        :type observables: list-like, optional
+        :param start_point: Optional starting point for all chains
+        :type start_point: list-like, optional
+        :param seed: Optional seed for the random number generators of the chains. If not provided, it is drawn from rng.
+        :type seed: int, optional
+        :param rng: Optional random number generator, used to draw the seed.
+
+        :return: A tuple of the parameters as array of size chains x N, the logarithmic weights as array of size chains x N, and optionally the posterior-predictive samples of the observables as array of size chains x N x len(observables).
+        """
+        if seed is None:
+            seed = int(rng.randint(0, 2**31))
+
+        sampler = eos.NoUTurnSampler(self._log_posterior, chains=chains, N=N, warmup=warmup, target_acceptance=target_acceptance,
+                                     max_depth=max_depth, dense=dense, seed=seed)
+        if start_point is not None:
+            for chain in range(chains):
+                sampler.set_start_point(chain, list(start_point))
+
+        eos.info('Running {} chains ...'.format(chains))
+        sampler.run()
+        for chain, (rate, step_size, divergences) in enumerate(zip(sampler.acceptance_rates(), sampler.step_sizes(), sampler.divergences())):
+            eos.info('Chain {}: average acceptance probability is {:3.0f}%, step size is {:.3g}'.format(chain, rate * 100, step_size))
+            if divergences > 0:
+                eos.warn('Chain {}: encountered {} divergent transitions'.format(chain, divergences))
+
+        parameter_samples = np.empty((chains, N, len(self.varied_parameters)), dtype=np.float64)
+        sampler.samples(parameter_samples)
+        weights = np.empty((chains, N), dtype=np.float64)
+        sampler.log_posterior_values(weights)
+
+        if not observables:
+            return(parameter_samples, weights)
+        else:
+            observable_samples = []
+            for parameters in parameter_samples.reshape(chains * N, -1):
+                for p, v in zip(self.varied_parameters, parameters):
+                    p.set(v)
+
+                observable_samples.append([o.evaluate() for o in observables])
+
+            return(parameter_samples, weights, np.array(observable_samples).reshape(chains, N, len(observables)))
+
+
     def sample_pmc(self, log_proposal, step_N=1000, steps=10, final_N=5000, rng=np.random.mtrand,
                     return_final_only=True, final_perplexity_threshold=1.0, weight_threshold=1e-10,
                     pmc_iterations=1, pmc_rel_tol=1e-10, pmc_abs_tol=1e-05, pmc_lookback=1):
@@ -1,4 +1,5 @@
 # Copyright (c) 2019 Danny van Dyk
+# Copyright (c) 2023 agent
 #
 # This file is part of the EOS project. EOS is free software;
 # you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +22,147 @@ import yaml
 from scipy.special import erf
 from scipy.linalg import block_diag
 
+class ChunkedWriter:
+    """ Appends chunks of samples to the arrays of a data file.
+
+    Each array is stored in its own file NAME.f64 as a sequence of fixed-width records of little-endian float64 numbers,
+    without any header; the widths of the records are recorded in the 'storage' entry of the description file. Every
+    chunk is flushed to disk before append() returns, such that an interrupted run retains all complete chunks.
+
+    Use the static methods `stream` of `eos.data.MarkovChain`, `eos.data.ImportanceSamples`, and `eos.data.Prediction`
+    to create a data file that is written incrementally.
+    """
+    def __init__(self, path, description, arrays):
+        """ Create a new data file, and write its description.
+
+        :param path: Path to the storage location, which will be created as a directory.
+        :type path: str
+        :param description: The description of the data file.
+        :type description: dict
+        :param arrays: The names of the arrays and the number of columns of each. A value of 0 denotes a 1D array.
+        :type arrays: dict
+        """
+        self.path = path
+        self.arrays = dict(arrays)
+
+        description = dict(description)
+        description['storage'] = {
+            'format': 'chunked',
+            'dtype': 'float64',
+            'byteorder': 'little',
+            'arrays': self.arrays
+        }
+
+        os.makedirs(path, exist_ok=True)
+        self.files = {}
+        for name in self.arrays.keys():
+            self.files[name] = open(os.path.join(path, name + '.f64'), 'wb')
+        with open(os.path.join(path, 'description.yaml'), 'w') as description_file:
+            yaml.dump(description, description_file, default_flow_style=False)
+
+    def append(self, **chunks):
+        """ Append one chunk to each array.
+
+        :param chunks: For each array, the records of the chunk as an array of shape (N, columns) or (N, ).
+        """
+        if set(chunks.keys()) != set(self.arrays.keys()):
+            raise RuntimeError('Chunk for arrays {} does not match arrays {}'.format(sorted(chunks.keys()), sorted(self.arrays.keys())))
+
+        # validate all chunks before writing any of them, such that the arrays keep the same number of records
+        records = None
+        contiguous = {}
+        for name, chunk in chunks.items():
+            chunk = _np.ascontiguousarray(chunk, dtype='<f8')
+            if self.arrays[name] == 0 and chunk.ndim == 2 and chunk.shape[1] == 1:
+                chunk = chunk.reshape(chunk.shape[0])
+            elif self.arrays[name] == 1 and chunk.ndim == 1:
+                chunk = chunk.reshape(chunk.shape[0], 1)
+            shape = (chunk.shape[0], self.arrays[name]) if self.arrays[name] > 0 else (chunk.shape[0], )
+            if chunk.shape != shape:
+                raise RuntimeError('Shape of chunk {} for array {} incompatible with expected shape {}'.format(chunk.shape, name, shape))
+            if records is not None and records != chunk.shape[0]:
+                raise RuntimeError('Chunks for different arrays have different numbers of records')
+            records = chunk.shape[0]
+            contiguous[name] = chunk
+
+        for name, chunk in contiguous.items():
+            f = self.files[name]
+            f.write(chunk.tobytes())
+            f.flush()
+            os.fsync(f.fileno())
+
+    def close(self):
+        for f in self.files.values():
+            f.close()
+        self.files = {}
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self.close()
+
+
+def _read_arrays(path, description, names):
+    """ Read the arrays of a data file, as memory maps if the file uses chunked storage. """
+    result = {}
+
+    if 'storage' not in description:
+        for name in names:
+            f = os.path.join(path, name + '.npy')
+            if not os.path.exists(f) or not os.path.isfile(f):
+                raise RuntimeError('{} file {} does not exist or is not a file'.format(name.capitalize(), f))
+            result[name] = _np.load(f)
+        return result
+
+    storage = description['storage']
+    if storage['format'] != 'chunked' or storage['dtype'] != 'float64' or storage['byteorder'] != 'little':
+        raise RuntimeError('Path {} uses an unsupported storage format'.format(path))
+
+    # an interrupted run can leave a partial record, or one array with more records than the others
+    records = None
+    for name in names:
+        f = os.path.join(path, name + '.f64')
+        if not os.path.exists(f) or not os.path.isfile(f):
+            raise RuntimeError('{} file {} does not exist or is not a file'.format(name.capitalize(), f))
+        width = max(storage['arrays'][name], 1)
+        n = os.path.getsize(f) // (8 * width)
+        records = n if records is None else min(records, n)
+
+    for name in names:
+        f = os.path.join(path, name + '.f64')
+        width = storage['arrays'][name]
+        shape = (records, width) if width > 0 else (records, )
+        if records == 0:
+            result[name] = _np.empty(shape, dtype='<f8')
+        else:
+            result[name] = _np.memmap(f, dtype='<f8', mode='r', shape=shape)
+
+    return result
+
+
+def _columns(array):
+    """ Return the number of columns of a 2D array, or 0 for a 1D array. """
+    if array is None or array.ndim == 1:
+        return 0
+    return array.shape[1]
+
+
+def _describe_parameters(parameters):
+    return [{
+        'name': p.name(),
+        'min': p.min(),
+        'max': p.max()
+    } for p in parameters]
+
+
+def _describe_observables(observables):
+    return [{
+        'name': str(o.name()),
+        'kinematics': { k.name(): float(k) for k in o.kinematics() }
+    } for o in observables]
+
+
 class Mode:
     def __init__(self, path):
         """ Read a posterior's (local) mode from a file.
@@ -97,18 +239,9 @@ class MarkovChain:
         self.varied_parameters = description['parameters']
         self.lookup_table = { item['name']: idx for idx, item in enumerate(self.varied_parameters) }
 
-        f = os.path.join(path, 'samples.npy')
-        if not os.path.exists(f) or not os.path.isfile(f):
-            raise RuntimeError('Samples file {} does not exist or is not a file'.format(f))
-        self.samples = _np.load(f)
-
-        if description['has-weights']:
-            f = os.path.join(path, 'weights.npy')
-            if not os.path.exists(f) or not os.path.isfile(f):
-                raise RuntimeError('Weights file {} does not exist or is not a file'.format(f))
-            self.weights = _np.load(f)
-        else:
-            self.weights = None
+        arrays = _read_arrays(path, description, ['samples', 'weights'] if description['has-weights'] else ['samples'])
+        self.samples = arrays['samples']
+        self.weights = arrays.get('weights', None)
 
 
     @staticmethod
@@ -121,32 +254,49 @@ class MarkovChain:
         :type parameters: list or iterable of eos.Parameter
         :param samples: Samples as a 2D array of shape (N, P).
         :type samples: 2D numpy array
-        :param weights: Weights on a linear scale as a 2D array of shape (N, 1).
-        :type weights: 2D numpy array, optional
+        :param weights: Weights on a linear scale as an array of shape (N, ) or (N, 1). The shape is preserved when reading.
+        :type weights: numpy array, optional
         """
-        description = {}
-        description['version'] = eos.__version__
-        description['type'] = 'MarkovChain'
-        description['parameters'] = [{
-            'name': p.name(),
-            'min': p.min(),
-            'max': p.max()
-        } for p in parameters]
-        description['has-weights'] = (not weights is None)
-
         if not samples.shape[1] == len(parameters):
             raise RuntimeError('Shape of samples {} incompatible with number of parameters {}'.format(samples.shape, len(parameters)))
 
         if not weights is None and not samples.shape[0] == weights.shape[0]:
             raise RuntimeError('Shape of weights {} incompatible with shape of samples {}'.format(weights.shape, samples.shape))
 
-        os.makedirs(path, exist_ok=True)
-        with open(os.path.join(path, 'description.yaml'), 'w') as description_file:
-            yaml.dump(description, description_file, default_flow_style=False)
-        _np.save(os.path.join(path, 'samples.npy'), samples)
+        with MarkovChain.stream(path, parameters, has_weights=(not weights is None), weights_columns=_columns(weights)) as stream:
+            if weights is None:
+                stream.append(samples=samples)
+            else:
+                stream.append(samples=samples, weights=weights)
+
+
+    @staticmethod
+    def stream(path, parameters, has_weights=True, weights_columns=0):
+        """ Create a new MarkovChain object on disk, to which samples are appended in chunks.
+
+        :param path: Path to the storage location, which will be created as a directory.
+        :type path: str
+        :param parameters: Parameter descriptions as a 1D array of shape (P, ).
+        :type parameters: list or iterable of eos.Parameter
+        :param has_weights: Whether each chunk provides weights in addition to samples.
+        :type has_weights: bool, optional
+        :param weights_columns: The number of columns of the weights. Defaults to 0, i.e., weights of shape (N, ).
+        :type weights_columns: int, optional
+
+        :return: The writer, whose method append(samples=..., weights=...) appends one chunk.
+        :rtype: eos.data.ChunkedWriter
+        """
+        description = {}
+        description['version'] = eos.__version__
+        description['type'] = 'MarkovChain'
+        description['parameters'] = _describe_parameters(parameters)
+        description['has-weights'] = has_weights
+
+        arrays = { 'samples': len(description['parameters']) }
+        if has_weights:
+            arrays['weights'] = weights_columns
 
-        if not weights is None:
-            _np.save(os.path.join(path, 'weights.npy'), weights)
+        return ChunkedWriter(path, description, arrays)
 
 
 class MixtureDensity:
@@ -384,15 +534,9 @@ class ImportanceSamples:
         self.varied_parameters = description['parameters']
         self.lookup_table = { item['name']: idx for idx, item in enumerate(self.varied_parameters) }
 
-        f = os.path.join(path, 'samples.npy')
-        if not os.path.exists(f) or not os.path.isfile(f):
-            raise RuntimeError('Samples file {} does not exist or is not a file'.format(f))
-        self.samples = _np.load(f)
-
-        f = os.path.join(path, 'weights.npy')
-        if not os.path.exists(f) or not os.path.isfile(f):
-            raise RuntimeError('Weights file {} does not exist or is not a file'.format(f))
-        self.weights = _np.load(f)
+        arrays = _read_arrays(path, description, ['samples', 'weights'])
+        self.samples = arrays['samples']
+        self.weights = arrays['weights']
 
 
     @staticmethod
@@ -405,29 +549,39 @@ class ImportanceSamples:
         :type parameters: list or iterable of eos.Parameter
         :param samples: Samples as a 2D array of shape (N, P).
         :type samples: 2D numpy array
-        :param weights: Weights on a linear scale as a 2D array of shape (N, 1).
-        :type weights: 1D numpy array, optional
+        :param weights: Weights on a linear scale as an array of shape (N, ) or (N, 1). The shape is preserved when reading.
+        :type weights: numpy array
         """
-        description = {}
-        description['version'] = eos.__version__
-        description['type'] = 'ImportanceSamples'
-        description['parameters'] = [{
-            'name': p.name(),
-            'min': p.min(),
-            'max': p.max()
-        } for p in parameters]
-
         if not samples.shape[1] == len(parameters):
             raise RuntimeError('Shape of samples {} incompatible with number of parameters {}'.format(samples.shape, len(parameters)))
 
-        if not weights is None and not samples.shape[0] == weights.shape[0]:
+        if not samples.shape[0] == weights.shape[0]:
             raise RuntimeError('Shape of weights {} incompatible with shape of samples {}'.format(weights.shape, samples.shape))
 
-        os.makedirs(path, exist_ok=True)
-        with open(os.path.join(path, 'description.yaml'), 'w') as description_file:
-            yaml.dump(description, description_file, default_flow_style=False)
-        _np.save(os.path.join(path, 'samples.npy'), samples)
-        _np.save(os.path.join(path, 'weights.npy'), weights)
+        with ImportanceSamples.stream(path, parameters, weights_columns=_columns(weights)) as stream:
+            stream.append(samples=samples, weights=weights)
+
+
+    @staticmethod
+    def stream(path, parameters, weights_columns=0):
+        """ Create a new ImportanceSamples object on disk, to which samples are appended in chunks.
+
+        :param path: Path to the storage location, which will be created as a directory.
+        :type path: str
+        :param parameters: Parameter descriptions as a 1D array of shape (P, ).
+        :type parameters: list or iterable of eos.Parameter
+        :param weights_columns: The number of columns of the weights. Defaults to 0, i.e., weights of shape (N, ).
+        :type weights_columns: int, optional
+
+        :return: The writer, whose method append(samples=..., weights=...) appends one chunk.
+        :rtype: eos.data.ChunkedWriter
+        """
+        description = {}
+        description['version'] = eos.__version__
+        description['type'] = 'ImportanceSamples'
+        description['parameters'] = _describe_parameters(parameters)
+
+        return ChunkedWriter(path, description, { 'samples': len(description['parameters']), 'weights': weights_columns })
 
 
 class Prediction:
@@ -454,15 +608,9 @@ class Prediction:
         self.varied_parameters = description['observables']
         self.lookup_table = { item['name']: idx for idx, item in enumerate(self.varied_parameters) }
 
-        f = os.path.join(path, 'samples.npy')
-        if not os.path.exists(f) or not os.path.isfile(f):
-            raise RuntimeError('Samples file {} does not exist or is not a file'.format(f))
-        self.samples = _np.load(f)
-
-        f = os.path.join(path, 'weights.npy')
-        if not os.path.exists(f) or not os.path.isfile(f):
-            raise RuntimeError('Weights file {} does not exist or is not a file'.format(f))
-        self.weights = _np.load(f)
+        arrays = _read_arrays(path, description, ['samples', 'weights'])
+        self.samples = arrays['samples']
+        self.weights = arrays['weights']
 
 
     @staticmethod
@@ -478,25 +626,34 @@ class Prediction:
         :param weights: Weights on a linear scale as a 1D array of shape (N, ).
         :type weights: 1D numpy array
         """
-        description = {}
-        description['version'] = eos.__version__
-        description['type'] = 'Prediction'
-        description['observables'] = [{
-            'name': str(o.name()),
-            'kinematics': { k.name(): float(k) for k in o.kinematics() }
-        } for o in observables]
-
         if not samples.shape[1] == len(observables):
             raise RuntimeError('Shape of samples {} incompatible with number of observables {}'.format(samples.shape, len(observables)))
 
         if not samples.shape[0] == weights.shape[0]:
             raise RuntimeError('Shape of weights {} incompatible with shape of samples {}'.format(weights.shape, samples.shape))
 
-        os.makedirs(path, exist_ok=True)
-        with open(os.path.join(path, 'description.yaml'), 'w') as description_file:
-            yaml.dump(description, description_file, default_flow_style=False)
-        _np.save(os.path.join(path, 'samples.npy'), samples)
-        _np.save(os.path.join(path, 'weights.npy'), weights)
+        with Prediction.stream(path, observables) as stream:
+            stream.append(samples=samples, weights=weights)
+
+
+    @staticmethod
+    def stream(path, observables):
+        """ Create a new Prediction object on disk, to which samples are appended in chunks.
+
+        :param path: Path to the storage location, which will be created as a directory.
+        :type path: str
+        :param observables: Observables as a 1D array of shape (O, ).
+        :type observables: list or iterable of eos.Observable
+
+        :return: The writer, whose method append(samples=..., weights=...) appends one chunk.
+        :rtype: eos.data.ChunkedWriter
+        """
+        description = {}
+        description['version'] = eos.__version__
+        description['type'] = 'Prediction'
+        description['observables'] = _describe_observables(observables)
+
+        return ChunkedWriter(path, description, { 'samples': len(description['observables']), 'weights': 0 })
 
 
 class DynestyResults:
@@ -1,8 +1,11 @@
 import unittest
 
 import eos
+import os
 import pypmc
 import numpy as np
+import tempfile
+import yaml
 
 class PMCSamplerTests(unittest.TestCase):
 
@@ -30,5 +33,149 @@ class PMCSamplerTests(unittest.TestCase):
             delta=1e-5
         )
 
+
+class ChunkedStorageTests(unittest.TestCase):
+
+    def setUp(self):
+        self.directory = tempfile.TemporaryDirectory()
+        parameters = eos.Parameters.Defaults()
+        self.parameters = [parameters['mass::c'], parameters['mass::b(MSbar)']]
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def test_round_trip(self):
+        "Chunks appended through a stream are read back in order"
+        path = os.path.join(self.directory.name, 'mcmc')
+        samples = np.arange(20.0).reshape(10, 2)
+        weights = np.arange(10.0)
+
+        with eos.data.MarkovChain.stream(path, self.parameters) as stream:
+            stream.append(samples=samples[:4], weights=weights[:4])
+            stream.append(samples=samples[4:], weights=weights[4:])
+
+        chain = eos.data.MarkovChain(path)
+        self.assertEqual(chain.varied_parameters[0]['name'], 'mass::c')
+        self.assertEqual(chain.varied_parameters[1]['name'], 'mass::b(MSbar)')
+        np.testing.assert_array_equal(chain.samples, samples)
+        np.testing.assert_array_equal(chain.weights, weights)
+
+        # the arrays are memory maps of the files, rather than copies in memory
+        self.assertIsInstance(chain.samples, np.memmap)
+        self.assertIsInstance(chain.weights, np.memmap)
+        np.testing.assert_array_equal(chain.samples[3:7, 1], samples[3:7, 1])
+
+        # chunks must provide all arrays, with matching shapes and numbers of records
+        with eos.data.MarkovChain.stream(os.path.join(self.directory.name, 'invalid'), self.parameters) as stream:
+            with self.assertRaises(RuntimeError):
+                stream.append(samples=samples)
+            with self.assertRaises(RuntimeError):
+                stream.append(samples=samples[:, 0:1], weights=weights)
+            with self.assertRaises(RuntimeError):
+                stream.append(samples=samples[:4], weights=weights)
+
+    def test_callback(self):
+        "The chunks of the main run of Analysis.sample are streamed through the callback"
+        analysis = eos.Analysis(
+            priors=[
+                { 'parameter': 'mass::c',        'min': 1.0, 'max': 1.6, 'type': 'uniform' },
+                { 'parameter': 'mass::b(MSbar)', 'min': 3.7, 'max': 4.7, 'type': 'uniform' }
+            ],
+            likelihood=[]
+        )
+
+        # the second and third configurations lead to chunks that are shorter than the stride
+        for N, stride in [(200, 5), (30, 5), (10, 50)]:
+            path = os.path.join(self.directory.name, 'mcmc-{}-{}'.format(N, stride))
+            with eos.data.MarkovChain.stream(path, analysis.varied_parameters) as stream:
+                samples, weights = analysis.sample(N=N, stride=stride, pre_N=50, preruns=1,
+                                                   rng=np.random.mtrand.RandomState(1234), callback=stream.append)
+
+            chain = eos.data.MarkovChain(path)
+            self.assertEqual(chain.samples.shape, (N, 2))
+            np.testing.assert_array_equal(chain.samples, samples)
+            np.testing.assert_array_equal(chain.weights, weights)
+
+    def test_shape_of_weights(self):
+        "The shape of the weights is preserved"
+        samples = np.arange(20.0).reshape(10, 2)
+
+        for weights in [np.arange(10.0), np.arange(10.0).reshape(10, 1)]:
+            path = os.path.join(self.directory.name, 'mcmc-{}'.format(weights.ndim))
+            eos.data.MarkovChain.create(path, self.parameters, samples, weights)
+            chain = eos.data.MarkovChain(path)
+            self.assertEqual(chain.weights.shape, weights.shape)
+            np.testing.assert_array_equal(chain.weights, weights)
+
+            path = os.path.join(self.directory.name, 'samples-{}'.format(weights.ndim))
+            eos.data.ImportanceSamples.create(path, self.parameters, samples, weights)
+            importance_samples = eos.data.ImportanceSamples(path)
+            self.assertEqual(importance_samples.weights.shape, weights.shape)
+            np.testing.assert_array_equal(importance_samples.weights, weights)
+
+        path = os.path.join(self.directory.name, 'mcmc-unweighted')
+        eos.data.MarkovChain.create(path, self.parameters, samples)
+        chain = eos.data.MarkovChain(path)
+        self.assertIsNone(chain.weights)
+        np.testing.assert_array_equal(chain.samples, samples)
+
+    def test_recovery(self):
+        "Partial records and records beyond the shortest array are ignored"
+        path = os.path.join(self.directory.name, 'mcmc')
+        samples = np.arange(20.0).reshape(10, 2)
+        weights = np.arange(10.0)
+
+        with eos.data.MarkovChain.stream(path, self.parameters) as stream:
+            stream.append(samples=samples[:6], weights=weights[:6])
+
+        # an interrupted write leaves a partial record in one array ...
+        with open(os.path.join(path, 'samples.f64'), 'ab') as f:
+            f.write(samples[6].astype('<f8').tobytes()[:12])
+        # ... and complete records in another one
+        with open(os.path.join(path, 'weights.f64'), 'ab') as f:
+            f.write(weights[6:8].astype('<f8').tobytes())
+
+        chain = eos.data.MarkovChain(path)
+        np.testing.assert_array_equal(chain.samples, samples[:6])
+        np.testing.assert_array_equal(chain.weights, weights[:6])
+
+        # a chain without any complete record is empty
+        path = os.path.join(self.directory.name, 'mcmc-empty')
+        with eos.data.MarkovChain.stream(path, self.parameters) as stream:
+            pass
+        with open(os.path.join(path, 'samples.f64'), 'ab') as f:
+            f.write(samples[0].astype('<f8').tobytes()[:12])
+
+        chain = eos.data.MarkovChain(path)
+        self.assertEqual(chain.samples.shape, (0, 2))
+        self.assertEqual(chain.weights.shape, (0, ))
+
+    def test_legacy_files(self):
+        "Files in the former .npy layout are read"
+        path = os.path.join(self.directory.name, 'mcmc')
+        samples = np.arange(20.0).reshape(10, 2)
+        weights = np.arange(10.0).reshape(10, 1)
+
+        os.makedirs(path)
+        description = {
+            'version': eos.__version__,
+            'type': 'MarkovChain',
+            'parameters': [{ 'name': p.name(), 'min': p.min(), 'max': p.max() } for p in self.parameters],
+            'has-weights': True
+        }
+        with open(os.path.join(path, 'description.yaml'), 'w') as f:
+            yaml.dump(description, f, default_flow_style=False)
+        np.save(os.path.join(path, 'samples.npy'), samples)
+        np.save(os.path.join(path, 'weights.npy'), weights)
+
+        chain = eos.data.MarkovChain(path)
+        np.testing.assert_array_equal(chain.samples, samples)
+        np.testing.assert_array_equal(chain.weights, weights)
+
+        # a missing array is reported
+        os.remove(os.path.join(path, 'weights.npy'))
+        with self.assertRaises(RuntimeError):
+            eos.data.MarkovChain(path)
+
 if __name__ == '__main__':
     unittest.main(verbosity=5)
@@ -1,6 +1,7 @@
 # vim: set sw=4 sts=4 et tw=120 :
 
 # Copyright (c) 2021 Danny van Dyk
+# Copyright (c) 2023 agent
 #
 # This file is part of the EOS project. EOS is free software;
 # you can redistribute it and/or modify it under the terms of the GNU General
@@ -104,6 +105,37 @@ class SignalPDF(_SignalPDF):
 
         return(parameter_samples, weights)
 
+    def sample(self, N, weighted=False, streams=8, seed=0, **kwargs):
+        """
+        Return independent samples of the kinematic variables.
+
+        The samples are generated natively and in parallel, using an importance grid that is adapted to the PDF
+        at the current parameter point; see :class:`eos.SignalPDFEventGenerator`. Unlike :meth:`sample_mcmc`,
+        the samples are uncorrelated and cover the full kinematic ranges of the PDF.
+
+        :param N: Number of samples that shall be returned.
+        :param weighted: If true, return importance-weighted samples without rejection.
+        :type weighted: bool, optional
+        :param streams: Number of independent streams of samples.
+        :param seed: Seed for the random number generators.
+        :param kwargs: Further arguments passed to :class:`eos.SignalPDFEventGenerator`.
+
+        :return: The samples as an array of shape (N, D), with the columns in the order of the generator's variables.
+                 If ``weighted`` is true, a tuple of the samples and the array of their N weights.
+        """
+        generator = eos.SignalPDFEventGenerator(self, streams=streams, seed=seed, **kwargs)
+        samples = np.empty((N, generator.dimension()))
+
+        if weighted:
+            weights = np.empty(N)
+            generator.generate_weighted(samples, weights)
+            return (samples, weights)
+
+        generator.generate(samples)
+        eos.info('Generated {} samples with an acceptance rate of {:3.0f}%'.format(N, generator.acceptance_rate() * 100))
+
+        return samples
+
     @staticmethod
     def make(name, parameters, kinematics, options):
         """
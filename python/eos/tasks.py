@@ -45,8 +45,19 @@ class LogfileHandler:
 
 
 _tasks = {}
+_task_paths = {}
 
-def task(name, output, mode=lambda **kwargs: 'w'):
+def task(name, output, mode=lambda **kwargs: 'w', inputs=lambda **kwargs: [], outputs=lambda **kwargs: []):
+    """
+    Registers a function as a named task.
+
+    :param name: The name of the task.
+    :param output: The pattern of the task's output directory, relative to the base directory. Also holds the task's log file.
+    :param mode: Function returning the mode in which the log file is opened.
+    :param inputs: Function returning the patterns of all paths that the task reads, relative to the base directory.
+        The patterns may contain shell-style wildcards.
+    :param outputs: Function returning the patterns of all paths that the task writes in addition to its output directory.
+    """
     def _task(func):
         @functools.wraps(func)
         def task_wrapper(*args, **kwargs):
@@ -82,11 +93,13 @@ def task(name, output, mode=lambda **kwargs: 'w'):
                         iaccordion.selected_index = None
                     return result
         _tasks[name] = task_wrapper
+        _task_paths[name] = (output, inputs, outputs)
         return task_wrapper
     return _task
 
 
-@task('find-mode', '{posterior}/mode-{label}')
+@task('find-mode', '{posterior}/mode-{label}',
+      inputs=lambda posterior, chain, **kwargs: [f'{posterior}/mcmc-{chain:04}'] if chain is not None else [])
 def find_mode(analysis_file:str, posterior:str, base_directory:str='./', optimizations:int=3, start_point:list=None, chain:int=None, seed:int=None, label:str='default'):
     '''
     Finds the mode of the named posterior.
@@ -213,15 +226,16 @@ def sample_mcmc(analysis_file:str, posterior:str, chain:int, base_directory:str=
     analysis = analysis_file.analysis(posterior)
     rng = _np.random.mtrand.RandomState(int(chain) + 1701)
     try:
-        samples, weights = analysis.sample(N=N, stride=stride, pre_N=pre_N, preruns=preruns, rng=rng, cov_scale=cov_scale, start_point=start_point)
-        eos.data.MarkovChain.create(os.path.join(base_directory, posterior, f'mcmc-{chain:04}'), analysis.varied_parameters, samples, weights)
+        # write the samples as each chunk of the main run completes, such that an interrupted chain retains them
+        with eos.data.MarkovChain.stream(os.path.join(base_directory, posterior, f'mcmc-{chain:04}'), analysis.varied_parameters) as stream:
+            analysis.sample(N=N, stride=stride, pre_N=pre_N, preruns=preruns, rng=rng, cov_scale=cov_scale, start_point=start_point, callback=stream.append)
     except RuntimeError as e:
         eos.error('encountered run time error ({e}) in parameter point:'.format(e=e))
         for p in analysis.varied_parameters:
             eos.error(' - {n}: {v}'.format(n=p.name(), v=p.evaluate()))
 
 
-@task('find-clusters', '{posterior}/clusters')
+@task('find-clusters', '{posterior}/clusters', inputs=lambda posterior, **kwargs: [f'{posterior}/mcmc-*'])
 def find_clusters(posterior:str, base_directory:str='./', threshold:float=2.0, K_g:int=1, analysis_file:str=None):
     """
     Finds clusters among posterior MCMC samples, grouped by Gelman-Rubin R value, and creates a Gaussian mixture density.
@@ -256,7 +270,7 @@ def find_clusters(posterior:str, base_directory:str='./', threshold:float=2.0, K
     eos.data.MixtureDensity.create(os.path.join(base_directory, posterior, 'clusters'), density)
 
 
-@task('mixture-product', '{posterior}/product')
+@task('mixture-product', '{posterior}/product', inputs=lambda posteriors, **kwargs: [f'{p}/pmc' for p in posteriors])
 def mixture_product(posterior:str, posteriors:list, base_directory:str='./', analysis_file:str=None):
     """
     Compute the cartesian product of the densities listed in posteriors. Note that this product is not commutative.
@@ -278,7 +292,9 @@ def mixture_product(posterior:str, posteriors:list, base_directory:str='./', ana
 
 
 # Sample PMC
-@task('sample-pmc', '{posterior}/pmc', mode=lambda initial_proposal, **kwargs: 'a' if initial_proposal != 'clusters' else 'a')
+@task('sample-pmc', '{posterior}/pmc', mode=lambda initial_proposal, **kwargs: 'a' if initial_proposal != 'clusters' else 'a',
+      inputs=lambda posterior, initial_proposal, **kwargs: [f'{posterior}/{initial_proposal}'],
+      outputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
 def sample_pmc(analysis_file:str, posterior:str, base_directory:str='./', step_N:int=500, steps:int=10, final_N:int=5000,
                perplexity_threshold:float=1.0, weight_threshold:float=1e-10, sigma_test_stat:list=None, initial_proposal:str='clusters',
                pmc_iterations:int=1, pmc_rel_tol:float=1e-10, pmc_abs_tol:float=1e-05, pmc_lookback:int=1):
@@ -348,7 +364,7 @@ def sample_pmc(analysis_file:str, posterior:str, base_directory:str='./', step_N
 
 
 # Predict observables
-@task('predict-observables', '{posterior}/pred-{prediction}')
+@task('predict-observables', '{posterior}/pred-{prediction}', inputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
 def predict_observables(analysis_file:str, posterior:str, prediction:str, base_directory:str='./', begin:int=0, end:int=-1):
     '''
     Predicts a set of observables based on previously obtained importance samples.
@@ -374,31 +390,27 @@ def predict_observables(analysis_file:str, posterior:str, prediction:str, base_d
 
     data = eos.data.ImportanceSamples(os.path.join(base_directory, posterior, 'samples'))
 
-    try:
-        from tqdm.auto import tqdm
-        progressbar = tqdm
-    except ImportError:
-        progressbar = lambda x: x
-
-    parameters = [_parameters[p['name']] for p in data.varied_parameters]
-    observable_samples = []
-    for i, sample in enumerate(progressbar(data.samples[begin:end])):
-        for p, v in zip(parameters, sample):
-            p.set(v)
-        try:
-            observable_samples.append([o.evaluate() for o in observables])
-        except RuntimeError as e:
-            eos.error('skipping prediction for sample {i} due to runtime error ({e}): {s}'.format(i=i, e=e, s=sample))
-            observable_samples.append([_np.nan for o in observables])
-    observable_samples = _np.array(observable_samples)
+    # predict all samples natively, in parallel; failed samples yield NaN
+    cache = eos.ObservableCache(_parameters)
+    ids = [cache.add(o) for o in observables]
+    predictive = eos.PosteriorPredictive(cache, [p['name'] for p in data.varied_parameters])
 
+    # stream the samples in chunks, such that neither the inputs nor the predictions need to fit into memory
+    samples = data.samples[begin:end]
+    weights = data.weights[begin:end]
+    chunk_size = 10000
     output_path = os.path.join(base_directory, posterior, 'pred-{}'.format(prediction))
-    eos.data.Prediction.create(output_path, observables, observable_samples, data.weights[begin:end])
+    with eos.data.Prediction.stream(output_path, observables) as stream:
+        for first in range(0, samples.shape[0], chunk_size):
+            chunk = _np.ascontiguousarray(samples[first:first + chunk_size], dtype=_np.float64)
+            predictions = _np.empty((chunk.shape[0], len(cache)), dtype=_np.float64)
+            predictive.evaluate(chunk, predictions)
+            stream.append(samples=predictions[:, ids], weights=weights[first:first + chunk_size])
 
 
 # Run analysis steps
 @task('run', '')
-def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor:str='serial'):
+def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor:str='serial', workers:int=None):
     """
     Runs a list of predefined steps recorded in the analysis file.
 
@@ -414,11 +426,14 @@ def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor
     :type base_directory: str, optional
     :param dry_run: The flag that disables execution and insteads prints the full information on the tasks that would be run to standard output. Defaults to `False`.
     :type dry_run: bool, optional
-    :param executor: The flag that governs the execution type for the tasks. Currently only supports `serial` execution. Defaults to `serial`.
+    :param executor: The flag that governs the execution type for the tasks. Either `serial`, which runs the tasks one after another in the
+        current process, or `parallel`, which runs independent tasks concurrently in a pool of processes. Defaults to `serial`.
     :type executor: str, optional
+    :param workers: The number of worker processes of the `parallel` executor. Defaults to the number of CPUs.
+    :type workers: int, optional
     """
     try:
-        exec = Executor.make(executor, steps=analysis_file.steps(base_directory), dry_run=dry_run)
+        exec = Executor.make(executor, steps=analysis_file.steps(base_directory), dry_run=dry_run, workers=workers)
         exec.run()
         exec.join()
     except Exception as e:
@@ -426,7 +441,7 @@ def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor
 
 
 # Nested sampling
-@task('sample-nested', '{posterior}/nested')
+@task('sample-nested', '{posterior}/nested', outputs=lambda posterior, **kwargs: [f'{posterior}/dynesty_results'])
 def sample_nested(analysis_file:str, posterior:str, base_directory:str='./', bound:str='multi', nlive:int=250, dlogz:float=1.0, maxiter:int=None):
     """
     Samples from a likelihood associated with a named posterior using dynamic nested sampling.
@@ -459,9 +474,10 @@ def sample_nested(analysis_file:str, posterior:str, base_directory:str='./', bou
 class Executor:
     _factory_methods = {}
 
-    def __init__(self, steps, dry_run):
+    def __init__(self, steps, dry_run, workers=None):
         self._steps = steps
         self._dry_run = dry_run
+        self._workers = workers
 
     @staticmethod
     def register(name, type):
@@ -476,8 +492,8 @@ class Executor:
 
 
 class SerialExecutor(Executor):
-    def __init__(self, steps, dry_run=False):
-        Executor.__init__(self, steps, dry_run)
+    def __init__(self, steps, dry_run=False, workers=None):
+        Executor.__init__(self, steps, dry_run, workers)
 
     def run(self):
         pass
@@ -492,3 +508,133 @@ class SerialExecutor(Executor):
 Executor.register('serial', SerialExecutor)
 
 
+def _run_task(task, arguments):
+    _tasks[task](**arguments)
+
+
+class ParallelExecutor(Executor):
+    """
+    Runs the tasks of an analysis in a pool of processes, respecting their dependencies.
+
+    A task depends on an earlier task if it reads a path that the earlier task writes, if it writes a path
+    that the earlier task reads, or if both tasks write the same path. All other tasks run concurrently,
+    as soon as a worker process is available. Unless EOS_MAX_THREADS is set, each worker process uses
+    an equal share of the CPUs for its native threads.
+    """
+    def __init__(self, steps, dry_run=False, workers=None):
+        Executor.__init__(self, steps, dry_run, workers)
+        self._dependencies = ParallelExecutor._dependencies(self._steps)
+
+    @staticmethod
+    def _paths(task, arguments):
+        import inspect
+
+        # determine the effective arguments, including the defaults
+        _arguments = {
+            k: v.default
+            for k, v in inspect.signature(_tasks[task]).parameters.items()
+            if v.default is not inspect.Parameter.empty
+        }
+        _arguments.update(arguments)
+        base_directory = _arguments.get('base_directory', './')
+
+        output, inputs, outputs = _task_paths[task]
+        normalize = lambda path: os.path.normpath(os.path.join(base_directory, path))
+
+        _inputs  = [normalize(p) for p in inputs(**_arguments)]
+        _outputs = [normalize(output.format(**_arguments))] + [normalize(p) for p in outputs(**_arguments)]
+
+        return (_inputs, _outputs)
+
+    @staticmethod
+    def _dependencies(steps):
+        import fnmatch
+
+        # two paths overlap if they match, or if one contains the other
+        def _overlap(lhs, rhs):
+            for l in lhs:
+                for r in rhs:
+                    if fnmatch.fnmatchcase(l, r) or fnmatch.fnmatchcase(r, l):
+                        return True
+                    if l.startswith(r + os.sep) or r.startswith(l + os.sep):
+                        return True
+            return False
+
+        paths = [ParallelExecutor._paths(task, arguments) for _, _, task, arguments in steps]
+        result = []
+        for j, (inputs_j, outputs_j) in enumerate(paths):
+            result.append(set(
+                i for i, (inputs_i, outputs_i) in enumerate(paths[:j])
+                if _overlap(inputs_j, outputs_i) or _overlap(outputs_j, inputs_i) or _overlap(outputs_j, outputs_i)
+            ))
+
+        return result
+
+    @staticmethod
+    def _max_threads(workers):
+        # an explicit choice of the user takes precedence
+        if 'EOS_MAX_THREADS' in os.environ:
+            return int(os.environ['EOS_MAX_THREADS'])
+
+        return max(1, os.cpu_count() // workers)
+
+    def run(self):
+        pass
+
+    def join(self):
+        import concurrent.futures
+        import multiprocessing
+
+        if self._dry_run:
+            for idx, (name, desc, task, arguments) in enumerate(self._steps):
+                after = ' '.join(f'#{i}' for i in sorted(self._dependencies[idx]))
+                print(f'#{idx}: eos-analysis {task} {arguments}' + (f' (after {after})' if after else ''))
+            return
+
+        workers = self._workers if self._workers else os.cpu_count()
+
+        # the worker processes inherit the environment, and each only uses its share of the CPUs
+        environment = os.environ.copy()
+        os.environ['EOS_MAX_THREADS'] = str(ParallelExecutor._max_threads(workers))
+
+        try:
+            # spawn rather than fork, since the native thread pool cannot be inherited
+            context = multiprocessing.get_context('spawn')
+            with concurrent.futures.ProcessPoolExecutor(max_workers=workers, mp_context=context) as pool:
+                pending  = set(range(len(self._steps)))
+                finished = set()
+                running  = {}
+                while pending or running:
+                    for idx in sorted(pending):
+                        if not self._dependencies[idx] <= finished:
+                            continue
+
+                        name, desc, task, arguments = self._steps[idx]
+                        arguments = dict(arguments)
+                        if isinstance(arguments.get('analysis_file'), eos.AnalysisFile):
+                            arguments['analysis_file'] = arguments['analysis_file'].analysis_file
+
+                        eos.info(f'Starting task #{idx}: {task} in step "{name}"')
+                        running[pool.submit(_run_task, task, arguments)] = idx
+                        pending.remove(idx)
+
+                    done, _ = concurrent.futures.wait(running.keys(), return_when=concurrent.futures.FIRST_COMPLETED)
+                    for future in done:
+                        idx = running.pop(future)
+                        name, desc, task, arguments = self._steps[idx]
+                        try:
+                            future.result()
+                        except Exception as e:
+                            eos.error(f'Task #{idx}: {task} in step "{name}" failed: {e}')
+                            for f in running.keys():
+                                f.cancel()
+                            raise
+
+                        eos.info(f'Finished task #{idx}: {task} in step "{name}"')
+                        finished.add(idx)
+        finally:
+            os.environ.clear()
+            os.environ.update(environment)
+
+Executor.register('parallel', ParallelExecutor)
+
@@ -0,0 +1,88 @@
+import os
+import unittest
+import unittest.mock
+import eos
+from eos.tasks import ParallelExecutor
+
+class ParallelExecutorTests(unittest.TestCase):
+
+    def test_dependencies_of_an_analysis(self):
+
+        steps = [
+            ('mcmc',     '', 'sample-mcmc',         { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 0 }),
+            ('mcmc',     '', 'sample-mcmc',         { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 1 }),
+            ('mcmc',     '', 'sample-mcmc',         { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 2 }),
+            ('clusters', '', 'find-clusters',       { 'analysis_file': 'a.yaml', 'posterior': 'P' }),
+            ('pmc',      '', 'sample-pmc',          { 'analysis_file': 'a.yaml', 'posterior': 'P' }),
+            ('predict',  '', 'predict-observables', { 'analysis_file': 'a.yaml', 'posterior': 'P', 'prediction': 'X' }),
+            ('mcmc',     '', 'sample-mcmc',         { 'analysis_file': 'a.yaml', 'posterior': 'Q', 'chain': 0 }),
+            ('predict',  '', 'predict-observables', { 'analysis_file': 'a.yaml', 'posterior': 'P', 'prediction': 'Y' }),
+        ]
+
+        self.assertEqual(ParallelExecutor._dependencies(steps), [
+            set(),       # sample-mcmc P/mcmc-0000
+            set(),       # sample-mcmc P/mcmc-0001
+            set(),       # sample-mcmc P/mcmc-0002
+            { 0, 1, 2 }, # find-clusters reads P/mcmc-*
+            { 3 },       # sample-pmc reads P/clusters
+            { 4 },       # predict-observables reads P/samples
+            set(),       # sample-mcmc of an unrelated posterior
+            { 4 },       # predictions are independent of each other
+        ])
+
+    def test_dependencies_from_reads_and_writes(self):
+
+        # read after write, write after read, and write after write
+        steps = [
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 0 }),
+            ('clusters', '', 'find-clusters', { 'analysis_file': 'a.yaml', 'posterior': 'P' }),
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 0 }),
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 1 }),
+        ]
+
+        self.assertEqual(ParallelExecutor._dependencies(steps), [set(), { 0 }, { 0, 1 }, { 1 }])
+
+    def test_dependencies_from_matching_paths(self):
+
+        # wildcards in the inputs match the outputs of an earlier task
+        steps = [
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 7 }),
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'PQ', 'chain': 7 }),
+            ('clusters', '', 'find-clusters', { 'analysis_file': 'a.yaml', 'posterior': 'P' }),
+        ]
+        self.assertEqual(ParallelExecutor._dependencies(steps), [set(), set(), { 0 }])
+
+        # paths within the output of an earlier task
+        steps = [
+            ('pmc',  '', 'sample-pmc',  { 'analysis_file': 'a.yaml', 'posterior': 'P' }),
+            ('mcmc', '', 'sample-mcmc', { 'analysis_file': 'a.yaml', 'posterior': 'P/pmc', 'chain': 0 }),
+            ('mcmc', '', 'sample-mcmc', { 'analysis_file': 'a.yaml', 'posterior': 'P/pmcx', 'chain': 0 }),
+        ]
+        self.assertEqual(ParallelExecutor._dependencies(steps), [set(), { 0 }, set()])
+
+        # paths relative to the base directory
+        steps = [
+            ('mcmc',     '', 'sample-mcmc',   { 'analysis_file': 'a.yaml', 'posterior': 'P', 'chain': 0, 'base_directory': 'out' }),
+            ('clusters', '', 'find-clusters', { 'analysis_file': 'a.yaml', 'posterior': 'P', 'base_directory': './out/' }),
+            ('clusters', '', 'find-clusters', { 'analysis_file': 'a.yaml', 'posterior': 'P', 'base_directory': 'other' }),
+        ]
+        self.assertEqual(ParallelExecutor._dependencies(steps), [set(), { 0 }, set()])
+
+    def test_max_threads(self):
+
+        with unittest.mock.patch.dict(os.environ), unittest.mock.patch('os.cpu_count', return_value=8):
+            os.environ.pop('EOS_MAX_THREADS', None)
+
+            # each worker process uses an equal share of the CPUs
+            self.assertEqual(ParallelExecutor._max_threads(1), 8)
+            self.assertEqual(ParallelExecutor._max_threads(3), 2)
+            self.assertEqual(ParallelExecutor._max_threads(8), 1)
+            self.assertEqual(ParallelExecutor._max_threads(16), 1)
+
+            # an explicit choice of the user takes precedence
+            os.environ['EOS_MAX_THREADS'] = '4'
+            self.assertEqual(ParallelExecutor._max_threads(8), 4)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=5)
@@ -202,6 +202,45 @@ class LoggingTests(unittest.TestCase):
             self.assertEqual(cm.output,
                     [r"""ERROR:EOS:[ConcreteObservableEntry.make] Observable 'B->pilnu::BR' forces option key 'U' to value 'u', overriding user-provided value 'c'"""])
 
+    def test_log_from_threads(self):
+        "Messages logged during an evaluation reach the Python logger, even if they originate from worker threads"
+        import eos, yaml
+
+        parameters = eos.Parameters.Defaults()
+
+        # a renormalization scale mu_t above the top-quark pole mass logs an error when computing the b->s Wilson coefficients
+        parameters['QCD::mu_t'].set(2.0 * parameters['mass::t(pole)'].evaluate())
+        observable = eos.Observable.make('B->X_sgamma::BR@Minimal', parameters, eos.Kinematics(), eos.Options())
+        with self.assertLogs('EOS', level='ERROR') as cm:
+            observable.evaluate()
+        self.assertTrue(any('mu_t > m_t_pole' in line for line in cm.output))
+
+        # photon energy cuts beyond the kinematic endpoint throw when evaluated, which the observable cache logs from the
+        # thread that evaluates the observable; with many observables, these are the worker threads of the thread pool
+        log_likelihood = eos.LogLikelihood(parameters)
+        for i in range(16):
+            name = 'test::BR_{}'.format(i)
+            entry = eos.ConstraintEntry.deserialize(name, yaml.dump({
+                'type': 'Gaussian',
+                'observable': 'B->X_sgamma::BR(E_min)@NLO',
+                'kinematics': { 'E_min': 2.5 + 0.01 * i },
+                'options': {},
+                'mean': 3.0e-4,
+                'sigma-stat': { 'hi': 1.0e-5, 'lo': 1.0e-5 },
+                'sigma-sys': { 'hi': 0.0, 'lo': 0.0 }
+            }))
+            log_likelihood.add(entry.make(name, eos.Options()))
+        log_posterior = eos.LogPosterior(log_likelihood)
+
+        with self.assertLogs('EOS', level='ERROR') as cm:
+            log_posterior.evaluate()
+        self.assertEqual(16, sum(1 for line in cm.output if 'ObservableCache::update' in line and 'B->X_sgamma::BR(E_min)@NLO' in line))
+
+        parameters['mass::b(MSbar)'].set(parameters['mass::b(MSbar)'].evaluate() + 0.01)
+        with self.assertLogs('EOS', level='ERROR') as cm:
+            log_likelihood.evaluate()
+        self.assertEqual(16, sum(1 for line in cm.output if 'ObservableCache::update' in line and 'B->X_sgamma::BR(E_min)@NLO' in line))
+
 
 # Run legacy test cases
 tests = PythonTests()
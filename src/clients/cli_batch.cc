@@ -0,0 +1,317 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cli_batch.hh"
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <ostream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eos
+{
+    namespace cli
+    {
+        BatchOutput::~BatchOutput()
+        {
+        }
+
+        TextBatchOutput::TextBatchOutput(std::ostream & stream, const std::size_t & record_size, const Formatter & formatter) :
+            _stream(stream),
+            _record_size(record_size),
+            _formatter(formatter)
+        {
+        }
+
+        std::size_t
+        TextBatchOutput::completed() const
+        {
+            return 0;
+        }
+
+        void
+        TextBatchOutput::append(const double * records, const std::size_t & count)
+        {
+            for (std::size_t i = 0 ; i < count ; ++i)
+            {
+                const double * record = records + i * _record_size;
+
+                if (_formatter)
+                {
+                    _formatter(_stream, record);
+                }
+                else
+                {
+                    for (std::size_t j = 0 ; j < _record_size ; ++j)
+                    {
+                        _stream << (j > 0 ? "\t" : "") << record[j];
+                    }
+                }
+
+                _stream << '\n';
+            }
+
+            _stream.flush();
+        }
+    }
+
+    template <>
+    struct Implementation<cli::BinaryBatchOutput>
+    {
+        std::string path;
+
+        std::size_t record_size;
+
+        std::size_t completed;
+
+        std::FILE * file;
+
+        static void append_unsigned(std::string & header, const std::uint64_t & value)
+        {
+            // always stored as little endian
+            for (unsigned i = 0 ; i < 8 ; ++i)
+            {
+                header.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+            }
+        }
+
+        static void append_string(std::string & header, const std::string & value)
+        {
+            append_unsigned(header, value.size());
+            header.append(value);
+        }
+
+        Implementation(const std::string & path, const std::vector<std::string> & columns,
+                const std::size_t & points, const std::size_t & chunk_size,
+                const std::string & description, const bool & resume) :
+            path(path),
+            record_size(columns.size()),
+            completed(0),
+            file(nullptr)
+        {
+            // increment whenever the layout of the file changes
+            const std::uint64_t format = 1;
+
+            std::string header("EOSBATCH");
+            append_unsigned(header, format);
+            append_unsigned(header, points);
+            append_unsigned(header, chunk_size);
+            append_unsigned(header, columns.size());
+            for (const auto & column : columns)
+            {
+                append_string(header, column);
+            }
+            append_string(header, description);
+
+            const std::size_t record_bytes = record_size * sizeof(double);
+
+            struct stat st;
+            if (resume && (0 == ::stat(path.c_str(), &st)))
+            {
+                std::string existing(header.size(), '\0');
+                std::FILE * f = std::fopen(path.c_str(), "rb");
+                const bool matches = f
+                    && (std::size_t(st.st_size) >= header.size())
+                    && (1 == std::fread(&existing[0], header.size(), 1, f))
+                    && (existing == header);
+                if (f)
+                    std::fclose(f);
+
+                if (! matches)
+                    throw InternalError("Cannot resume '" + path + "': the file was created by a different run");
+
+                // keep only complete chunks; a run that finished is complete regardless of its last chunk
+                const std::size_t present = (std::size_t(st.st_size) - header.size()) / record_bytes;
+                completed = (present >= points) ? points : present / chunk_size * chunk_size;
+
+                if (0 != ::truncate(path.c_str(), header.size() + completed * record_bytes))
+                    throw InternalError("Cannot truncate '" + path + "' to its last complete chunk");
+
+                file = std::fopen(path.c_str(), "ab");
+                if (! file)
+                    throw InternalError("Cannot open '" + path + "' for appending");
+
+                Log::instance()->message("BatchOutput", ll_informational)
+                    << "Resuming '" << path << "' after " << completed << " of " << points << " points";
+            }
+            else
+            {
+                file = std::fopen(path.c_str(), "wb");
+                if (! file)
+                    throw InternalError("Cannot open '" + path + "' for writing");
+
+                if (1 != std::fwrite(header.data(), header.size(), 1, file))
+                {
+                    std::fclose(file);
+                    throw InternalError("Cannot write header to '" + path + "'");
+                }
+
+                std::fflush(file);
+            }
+        }
+
+        ~Implementation()
+        {
+            if (file)
+                std::fclose(file);
+        }
+
+        void append(const double * records, const std::size_t & count)
+        {
+            if (count != std::fwrite(records, record_size * sizeof(double), count, file))
+                throw InternalError("Cannot write records to '" + path + "'");
+
+            // make each chunk durable before reporting it as complete
+            std::fflush(file);
+            ::fsync(::fileno(file));
+
+            completed += count;
+        }
+    };
+
+    namespace cli
+    {
+        BinaryBatchOutput::BinaryBatchOutput(const std::string & path, const std::vector<std::string> & columns,
+                const std::size_t & points, const std::size_t & chunk_size,
+                const std::string & description, const bool & resume) :
+            PrivateImplementationPattern<BinaryBatchOutput>(new Implementation<BinaryBatchOutput>(path, columns, points, chunk_size, description, resume))
+        {
+        }
+
+        BinaryBatchOutput::~BinaryBatchOutput()
+        {
+        }
+
+        std::size_t
+        BinaryBatchOutput::completed() const
+        {
+            return _imp->completed;
+        }
+
+        void
+        BinaryBatchOutput::append(const double * records, const std::size_t & count)
+        {
+            _imp->append(records, count);
+        }
+
+        BatchEngine::BatchEngine(const std::size_t & points, const std::size_t & record_size, const std::size_t & chunk_size) :
+            _points(points),
+            _record_size(record_size),
+            _chunk_size(chunk_size)
+        {
+            if (0 == chunk_size)
+                throw InternalError("BatchEngine: the chunk size must be positive");
+
+            if (0 == record_size)
+                throw InternalError("BatchEngine: the records must not be empty");
+        }
+
+        void
+        BatchEngine::run(const WorkerFactory & factory, BatchOutput & output) const
+        {
+            const std::size_t first = output.completed();
+            if (first >= _points)
+                return;
+
+            if (0 != first % _chunk_size)
+                throw InternalError("BatchEngine: output ends in the middle of a chunk");
+
+            const std::size_t first_chunk = first / _chunk_size;
+            const std::size_t chunks = (_points + _chunk_size - 1) / _chunk_size - first_chunk;
+
+            // one worker for each chunk that can run concurrently; the calling thread takes part, too
+            //
+            // Workers that call parallel_for themselves, e.g. through ObservableCache::update(), can
+            // pick up further chunks on their own thread while their worker is still in use. Further
+            // workers are therefore created on demand, outside the lock.
+            std::vector<std::unique_ptr<Worker>> idle;
+            const std::size_t number_of_workers = std::min<std::size_t>(chunks, ThreadPool::instance()->number_of_threads() + 1);
+            for (std::size_t w = 0 ; w < number_of_workers ; ++w)
+            {
+                idle.push_back(std::unique_ptr<Worker>(new Worker(factory())));
+            }
+
+            Mutex mutex;
+            std::map<std::size_t, std::vector<double>> pending;
+            std::size_t next = first_chunk;
+
+            ThreadPool::instance()->parallel_for(first_chunk, first_chunk + chunks, [&, this] (const std::size_t & c)
+            {
+                std::unique_ptr<Worker> worker;
+                {
+                    Lock l(mutex);
+                    if (! idle.empty())
+                    {
+                        worker = std::move(idle.back());
+                        idle.pop_back();
+                    }
+                }
+
+                if (! worker)
+                {
+                    worker.reset(new Worker(factory()));
+                }
+
+                const std::size_t begin = c * _chunk_size, end = std::min(begin + _chunk_size, _points);
+                std::vector<double> records((end - begin) * _record_size);
+                try
+                {
+                    for (std::size_t p = begin ; p < end ; ++p)
+                    {
+                        (*worker)(p, records.data() + (p - begin) * _record_size);
+                    }
+                }
+                catch (...)
+                {
+                    Lock l(mutex);
+                    idle.push_back(std::move(worker));
+                    throw;
+                }
+
+                // pass on all chunks that are complete and in order
+                Lock l(mutex);
+                idle.push_back(std::move(worker));
+                pending[c].swap(records);
+                for (auto i = pending.find(next) ; pending.end() != i ; i = pending.find(next))
+                {
+                    output.append(i->second.data(), i->second.size() / _record_size);
+                    pending.erase(i);
+                    ++next;
+
+                    Log::instance()->message("BatchEngine", ll_informational)
+                        << "Completed " << std::min(next * _chunk_size, _points) << " of " << _points << " points";
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_CLIENTS_CLI_BATCH_HH
+#define EOS_GUARD_SRC_CLIENTS_CLI_BATCH_HH 1
+
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    namespace cli
+    {
+        /**
+         * Receives the records of a batch run, in the order of the points.
+         */
+        class BatchOutput
+        {
+            public:
+                virtual ~BatchOutput();
+
+                /**
+                 * The number of leading points whose records are already present,
+                 * e.g. from an interrupted run.
+                 */
+                virtual std::size_t completed() const = 0;
+
+                /**
+                 * Append the records of consecutive points.
+                 */
+                virtual void append(const double * records, const std::size_t & count) = 0;
+        };
+
+        /**
+         * Writes the records as tab-separated text, one line per point.
+         */
+        class TextBatchOutput :
+            public BatchOutput
+        {
+            public:
+                using Formatter = std::function<void (std::ostream &, const double *)>;
+
+            private:
+                std::ostream & _stream;
+
+                const std::size_t _record_size;
+
+                const Formatter _formatter;
+
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param stream       The stream to write to.
+                 * @param record_size  The number of values per point.
+                 * @param formatter    Optional function that writes one record, without the line break.
+                 */
+                TextBatchOutput(std::ostream & stream, const std::size_t & record_size, const Formatter & formatter = Formatter());
+
+                virtual std::size_t completed() const;
+
+                virtual void append(const double * records, const std::size_t & count);
+        };
+
+        /**
+         * Writes the records into a binary file, which can be resumed after an interruption.
+         *
+         * The file starts with a header:
+         *   - the magic string 'EOSBATCH';
+         *   - the format version, the number of points, the chunk size and the number of columns,
+         *     as little-endian 64 bit unsigned integers;
+         *   - the column names and a description of the run, each as a 64 bit length followed by the characters.
+         * The header is followed by the records as row-major 64 bit floating point numbers in native byte order.
+         *
+         * Records are appended in whole chunks only. An interrupted run can therefore be resumed after
+         * the last complete chunk, provided that the header of the existing file matches exactly.
+         */
+        class BinaryBatchOutput :
+            public BatchOutput,
+            public PrivateImplementationPattern<BinaryBatchOutput>
+        {
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * @param path         The path of the output file.
+                 * @param columns      The names of the values within each record.
+                 * @param points       The total number of points.
+                 * @param chunk_size   The number of points per chunk.
+                 * @param description  A description of the run, e.g. the command line; must match when resuming.
+                 * @param resume       If true, keep the complete chunks of an existing file.
+                 */
+                BinaryBatchOutput(const std::string & path, const std::vector<std::string> & columns,
+                        const std::size_t & points, const std::size_t & chunk_size,
+                        const std::string & description, const bool & resume);
+
+                ~BinaryBatchOutput();
+
+                virtual std::size_t completed() const;
+
+                virtual void append(const double * records, const std::size_t & count);
+        };
+
+        /**
+         * Evaluates a function on a range of points in parallel.
+         *
+         * The points are distributed across the ThreadPool in chunks. Every concurrently
+         * running chunk uses its own worker, created by a user-provided factory and reused
+         * by later chunks, such that workers can own cloned Parameters, Observables or
+         * ObservableCaches. The records are passed to the output in the order of the points,
+         * one chunk at a time.
+         */
+        class BatchEngine
+        {
+            public:
+                /// Evaluates one point and fills its record.
+                using Worker = std::function<void (const std::size_t & point, double * record)>;
+
+                /// Creates a new, independent worker. Can be called concurrently from any thread of the ThreadPool.
+                using WorkerFactory = std::function<Worker ()>;
+
+            private:
+                const std::size_t _points;
+
+                const std::size_t _record_size;
+
+                const std::size_t _chunk_size;
+
+            public:
+                BatchEngine(const std::size_t & points, const std::size_t & record_size, const std::size_t & chunk_size);
+
+                /**
+                 * Evaluate all points that are not yet present in the output.
+                 */
+                void run(const WorkerFactory & factory, BatchOutput & output) const;
+        };
+    }
+}
+
+#endif
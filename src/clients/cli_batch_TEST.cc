@@ -0,0 +1,130 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2023 agent
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include "cli_batch.hh"
+
+#include <eos/utils/thread_pool.hh>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+using namespace eos::cli;
+
+class BatchEngineTest :
+    public TestCase
+{
+    public:
+        BatchEngineTest() :
+            TestCase("batch_engine_test")
+        {
+        }
+
+        // collects all records in memory
+        struct MemoryBatchOutput :
+            public BatchOutput
+        {
+            std::vector<double> records;
+
+            virtual std::size_t completed() const
+            {
+                return 0;
+            }
+
+            virtual void append(const double * r, const std::size_t & count)
+            {
+                records.insert(records.end(), r, r + 2 * count);
+            }
+        };
+
+        virtual void run() const
+        {
+            /* records arrive in the order of the points */
+            {
+                BatchEngine engine(1000, 2, 7);
+                MemoryBatchOutput output;
+                engine.run([] () -> BatchEngine::Worker
+                {
+                    return [] (const std::size_t & point, double * record)
+                    {
+                        record[0] = point;
+                        record[1] = 2.0 * point;
+                    };
+                }, output);
+
+                TEST_CHECK_EQUAL(output.records.size(), 2000u);
+                for (std::size_t p = 0 ; p < 1000 ; ++p)
+                {
+                    TEST_CHECK_EQUAL(output.records[2 * p + 0], double(p));
+                    TEST_CHECK_EQUAL(output.records[2 * p + 1], 2.0 * p);
+                }
+            }
+
+            /* workers that run parallel_for themselves, like an ObservableCache does */
+            {
+                std::atomic<unsigned> workers(0);
+                std::atomic<unsigned> conflicts(0);
+
+                BatchEngine engine(500, 2, 1);
+                MemoryBatchOutput output;
+                engine.run([&] () -> BatchEngine::Worker
+                {
+                    ++workers;
+                    auto in_use = std::make_shared<std::atomic<bool>>(false);
+
+                    return [&conflicts, in_use] (const std::size_t & point, double * record)
+                    {
+                        // a worker must never be used by two chunks at the same time
+                        if (in_use->exchange(true))
+                            ++conflicts;
+
+                        std::vector<double> values(64, 0.0);
+                        ThreadPool::instance()->parallel_for(0, values.size(), [&] (const std::size_t & i)
+                        {
+                            values[i] = point + i;
+                        });
+
+                        double sum = 0.0;
+                        for (const auto & v : values)
+                        {
+                            sum += v;
+                        }
+
+                        record[0] = point;
+                        record[1] = sum;
+
+                        in_use->store(false);
+                    };
+                }, output);
+
+                TEST_CHECK_EQUAL(conflicts.load(), 0u);
+                TEST_CHECK(workers.load() >= 1u);
+
+                TEST_CHECK_EQUAL(output.records.size(), 1000u);
+                for (std::size_t p = 0 ; p < 500 ; ++p)
+                {
+                    TEST_CHECK_EQUAL(output.records[2 * p + 0], double(p));
+                    TEST_CHECK_EQUAL(output.records[2 * p + 1], 64.0 * p + 63.0 * 64.0 / 2.0);
+                }
+            }
+        }
+} batch_engine_test;
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -17,12 +18,15 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "cli_batch.hh"
+
 #include <eos/observable.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/cartesian-product.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
 
 #include <cmath>
 #include <cstdlib>
@@ -78,11 +82,22 @@ class CommandLine :
 
         int precision;
 
+        std::string output;
+
+        unsigned chunk_size;
+
+        bool resume;
+
+        // the command line without the resume flag, to identify the run when resuming
+        std::string description;
+
         CommandLine() :
             parameters(Parameters::Defaults()),
             budgets{std::make_tuple(std::string("delta"), std::vector<Parameter>())},
             use_budget(false),
-            precision(-1)
+            precision(-1),
+            chunk_size(64),
+            resume(false)
         {
         }
 
@@ -90,12 +105,41 @@ class CommandLine :
         {
             Log::instance()->set_program_name("eos-evaluate");
 
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                if (std::string("--resume") != *a)
+                    description += std::string(*a) + '\n';
+            }
+
             std::shared_ptr<EvaluationInput> evaluation_input(new EvaluationInput);
 
             for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
             {
                 std::string argument(*a);
 
+                if ("--resume" == argument)
+                {
+                    resume = true;
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    output = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--chunk-size" == argument)
+                {
+                    chunk_size = destringify<unsigned>(*(++a));
+                    if (0 == chunk_size)
+                        throw DoUsage("Chunk size must be positive");
+
+                    continue;
+                }
+
                 if ("--precision" == argument)
                 {
                 	precision = destringify<unsigned>(*(++a));
@@ -208,28 +252,9 @@ class CommandLine :
         }
 };
 
-void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input)
+void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input, const unsigned & index)
 {
-    // print headlines
-    std::cout << "# " << evaluation_input->observable->name()
-              << ": " << evaluation_input->observable->options().as_string() << std::endl;
-
-    std::cout << "# ";
-    for (const auto & kinematic_name : evaluation_input->kinematic_names)
-    {
-        std::cout << kinematic_name << '\t';
-    }
-    std::cout << "central";
-    for (auto & budget : CommandLine::instance()->budgets)
-    {
-        std::cout << '\t' << std::get<0>(budget) << "_min\t" << std::get<0>(budget) << "_max";
-    }
-    std::cout << "\tdelta_min\tdelta_max" << std::endl;
-
-    int precision = CommandLine::instance()->precision;
-    // set requested precision
-    if (precision != -1)
-        std::cout.precision(precision);
+    const auto & budgets = CommandLine::instance()->budgets;
 
     bool ranges_empty = false;
     // check if the kinematical ranges are empty
@@ -239,83 +264,160 @@ void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluat
 
         // create a vector with a single entry
         std::vector<double> range(1, 1.0);
-        // insert a dummy value for the for-loop
+        // insert a dummy value for the evaluation
         evaluation_input->ranges.over(range);
     }
 
-    // iterate over all kinematical ranges
-    for (auto r = evaluation_input->ranges.begin() ; r != evaluation_input->ranges.end() ; ++r)
+    // each record holds the kinematics, the central value, the lower and upper uncertainties
+    // of every budget, and the total lower and upper uncertainties
+    std::vector<std::string> columns;
+    if (! ranges_empty)
+        columns = evaluation_input->kinematic_names;
+
+    const std::size_t dim = columns.size();
+    columns.push_back("central");
+    for (const auto & budget : budgets)
+    {
+        columns.push_back(std::get<0>(budget) + "_min");
+        columns.push_back(std::get<0>(budget) + "_max");
+    }
+    columns.push_back("delta_min");
+    columns.push_back("delta_max");
+
+    // every worker uses its own clone of the observable, with its own parameters and kinematics
+    auto factory = [&] () -> cli::BatchEngine::Worker
     {
-        if (!ranges_empty)
+        ObservablePtr observable = evaluation_input->observable->clone();
+        Kinematics kinematics = observable->kinematics();
+        Parameters parameters = observable->parameters();
+
+        std::vector<std::vector<Parameter>> variations;
+        for (const auto & budget : budgets)
         {
-            // set the kinematics
-            // for every dimension
-            for (std::size_t i = 0 ; i < (*r).size() ; ++i)
+            std::vector<Parameter> v;
+            for (const auto & variation : std::get<1>(budget))
             {
-                evaluation_input->kinematics->set(evaluation_input->kinematic_names[i], (*r)[i]);
-                std::cout << (*r)[i] << '\t';
+                v.push_back(parameters[variation.name()]);
             }
+            variations.push_back(v);
         }
 
-        double central = evaluation_input->observable->evaluate();
-
-        std::cout << central;
-
-        // do the variations
-        double delta_max = 0.0, delta_min = 0.0;
-        for (auto & budget : CommandLine::instance()->budgets)
+        return [=] (const std::size_t & point, double * record) mutable
         {
-            double budget_min = 0.0;
-            double budget_max = 0.0;
+            if (! ranges_empty)
+            {
+                // set the kinematics for every dimension
+                auto r = evaluation_input->ranges.begin();
+                r += point;
+                const std::vector<double> values = *r;
+                for (std::size_t i = 0 ; i < dim ; ++i)
+                {
+                    kinematics.set(evaluation_input->kinematic_names[i], values[i]);
+                    record[i] = values[i];
+                }
+            }
 
-            std::vector<Parameter> variations = std::get<1>(budget);
+            const double central = observable->evaluate();
+            record[dim] = central;
 
-            for (auto & variation : variations)
+            // do the variations
+            double delta_max = 0.0, delta_min = 0.0;
+            for (std::size_t b = 0 ; b < variations.size() ; ++b)
             {
-                double old_v = variation;
+                double budget_min = 0.0;
+                double budget_max = 0.0;
 
-                // raise value
-                variation = variation.max();
+                for (auto & variation : variations[b])
+                {
+                    double old_v = variation;
 
-                double value = evaluation_input->observable->evaluate();
+                    // raise value
+                    variation = variation.max();
 
-                if (value > central)
-                {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
-                }
+                    double value = observable->evaluate();
 
-                // lower value
-                variation = variation.min();
+                    if (value > central)
+                    {
+                        budget_max += power_of<2>(value - central);
+                    }
+                    else if (value < central)
+                    {
+                        budget_min += power_of<2>(value - central);
+                    }
 
-                value = evaluation_input->observable->evaluate();
+                    // lower value
+                    variation = variation.min();
 
-                if (value > central)
-                {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
+                    value = observable->evaluate();
+
+                    if (value > central)
+                    {
+                        budget_max += power_of<2>(value - central);
+                    }
+                    else if (value < central)
+                    {
+                        budget_min += power_of<2>(value - central);
+                    }
+
+                    variation = old_v;
                 }
 
-                variation = old_v;
+                delta_min += budget_min;
+                delta_max += budget_max;
+
+                record[dim + 1 + 2 * b] = std::sqrt(budget_min);
+                record[dim + 2 + 2 * b] = std::sqrt(budget_max);
             }
 
-            delta_min += budget_min;
-            delta_max += budget_max;
+            record[dim + 1 + 2 * variations.size()] = std::sqrt(delta_min);
+            record[dim + 2 + 2 * variations.size()] = std::sqrt(delta_max);
+        };
+    };
 
-            std::cout << '\t' << std::sqrt(budget_min) << '\t' << std::sqrt(budget_max);
-        }
+    const auto & command_line = *CommandLine::instance();
+    cli::BatchEngine engine(evaluation_input->ranges.size(), columns.size(), command_line.chunk_size);
+
+    if (! command_line.output.empty())
+    {
+        cli::BinaryBatchOutput output(command_line.output + "." + stringify(index), columns, evaluation_input->ranges.size(),
+                command_line.chunk_size, command_line.description, command_line.resume);
+        engine.run(factory, output);
+
+        return;
+    }
 
-        std::cout
-            << '\t' << std::sqrt(delta_min) << '\t' << std::sqrt(delta_max)
-            << "   (-" << std::abs(std::sqrt(delta_min) / central) * 100 << "% / +" << std::abs(std::sqrt(delta_max) / central) * 100 << "%)"
-            << std::endl;
+    // print headlines
+    std::cout << "# " << evaluation_input->observable->name()
+              << ": " << evaluation_input->observable->options().as_string() << std::endl;
+
+    std::cout << "# ";
+    for (const auto & kinematic_name : evaluation_input->kinematic_names)
+    {
+        std::cout << kinematic_name << '\t';
+    }
+    std::cout << "central";
+    for (auto & budget : budgets)
+    {
+        std::cout << '\t' << std::get<0>(budget) << "_min\t" << std::get<0>(budget) << "_max";
     }
+    std::cout << "\tdelta_min\tdelta_max" << std::endl;
+
+    int precision = command_line.precision;
+    // set requested precision
+    if (precision != -1)
+        std::cout.precision(precision);
+
+    cli::TextBatchOutput output(std::cout, columns.size(), [&] (std::ostream & stream, const double * record)
+    {
+        for (std::size_t i = 0 ; i < columns.size() ; ++i)
+        {
+            stream << (i > 0 ? "\t" : "") << record[i];
+        }
+
+        const double central = record[dim], delta_min = record[columns.size() - 2], delta_max = record[columns.size() - 1];
+        stream << "   (-" << std::abs(delta_min / central) * 100 << "% / +" << std::abs(delta_max / central) * 100 << "%)";
+    });
+    engine.run(factory, output);
 }
 
 
@@ -329,9 +431,13 @@ main(int argc, char * argv[])
         if (CommandLine::instance()->evaluation_inputs.empty())
             throw DoUsage("No input specified");
 
+        if (CommandLine::instance()->resume && CommandLine::instance()->output.empty())
+            throw DoUsage("Resuming requires an output file");
+
+        unsigned index = 0;
         for (const auto & evaluation_input : CommandLine::instance()->evaluation_inputs)
         {
-            evaluate_with_sum_of_squares(evaluation_input);
+            evaluate_with_sum_of_squares(evaluation_input, index++);
         }
     }
     catch(DoUsage & e)
@@ -339,6 +445,7 @@ main(int argc, char * argv[])
         std::cout << e.what() << std::endl;
         std::cout << "Usage: eos-evaluate" << std::endl;
         std::cout << "  [--precision PRECISION]" << std::endl;
+        std::cout << "  [--output FILE [--resume]] [--chunk-size POINTS]" << std::endl;
         std::cout << "  [--vary PARAMETER]*" << std::endl;
         std::cout << "  [{--budget BUDGET[--parameter PARAMETER]*}*|{--parameter PARAMETER}*]" << std::endl;
         std::cout << "  [[--kinematics NAME VALUE|--range NAME MIN MAX POINTS]* --observable OBSERVABLE]*" << std::endl;
@@ -347,6 +454,9 @@ main(int argc, char * argv[])
         std::cout << "  eos-evaluate --budget \"SD\" --vary \"mu\" --vary \"mass::W\" \\" << std::endl;
         std::cout << "               --budget \"CKM\" --vary \"CKM::A\" --vary \"CKM::lambda\" \\" << std::endl;
         std::cout << "               --range s 14.18 22.86 12 --observable \"B->Kll::dBR/ds@LowRecoil;l=tau\"" << std::endl;
+        std::cout << std::endl;
+        std::cout << "With --output, the results for the i-th observable are written in binary form to FILE.i." << std::endl;
+        std::cout << "An interrupted run can be continued with --resume and otherwise identical arguments." << std::endl;
     }
     catch(Exception & e)
     {
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2023 agent
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,17 +22,17 @@
 #include <eos/observable.hh>
 #include <eos/utils/cartesian-product.hh>
 #include <eos/utils/destringify.hh>
-#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
-#include <eos/utils/mutex.hh>
-#include <eos/utils/thread_pool.hh>
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/stringify.hh>
+
+#include "cli_batch.hh"
 
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <list>
-#include <map>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -61,12 +62,23 @@ struct ScanData
     double max;
 };
 
+struct BatchOptions
+{
+    std::string output;
+
+    unsigned chunk_size;
+
+    bool resume;
+
+    std::string description;
+};
+
 class WilsonScan
 {
     public:
-        Mutex * const mutex;
+        Parameters parameters;
 
-        std::list<std::pair<Input, ObservablePtr>> bins;
+        std::vector<std::pair<Input, ObservablePtr>> bins;
 
         std::list<ScanData> scan_data;
 
@@ -76,24 +88,17 @@ class WilsonScan
 
         double theory_uncertainty;
 
-        std::list<std::pair<std::vector<double>, double>> results;
-
         WilsonScan(const std::list<ScanData> & scan_data,
                 const std::list<Input> & inputs,
                 const std::list<std::pair<std::string, double>> & param_changes,
                 const std::list<std::string> & variation_names,
                 const double & theory_uncertainty) :
-            mutex(new Mutex),
+            parameters(Parameters::Defaults()),
             scan_data(scan_data),
             inputs(inputs),
             variation_names(variation_names),
             theory_uncertainty(theory_uncertainty)
         {
-            Parameters parameters = Parameters::Defaults();
-            Kinematics kinematics;
-            kinematics.declare("s_min");
-            kinematics.declare("s_max");
-
             for (const auto & param_change : param_changes)
             {
                 parameters[param_change.first] = param_change.second;
@@ -101,85 +106,132 @@ class WilsonScan
 
             for (const auto & input : inputs)
             {
-                bins.push_back(std::make_pair(input, Observable::make(input.o_name, parameters.clone(), kinematics.clone(), Options())));
+                Kinematics kinematics;
+                kinematics.declare("s_min", input.min);
+                kinematics.declare("s_max", input.max);
+
+                bins.push_back(std::make_pair(input, Observable::make(input.o_name, parameters, kinematics, Options())));
             }
         }
 
-        void calc_chi_square(const Input & input, const ObservablePtr & observable,
-                const CartesianProduct<std::vector<double>>::Iterator & wc_iterator)
+        double chi_square(const Input & input, const double & central, const double & delta_min, const double & delta_max) const
         {
-            Kinematics k = observable->kinematics();
-            k.set("s_min", input.min);
-            k.set("s_max", input.max);
+            double chi = 0.0;
+            if (input.o - central > delta_max)
+                chi = input.o - central - delta_max;
+            else if (central - input.o > delta_min)
+                chi = central - input.o - delta_min;
 
-            ObservablePtr o = observable->clone();
-            Parameters params = o->parameters();
+            chi /= (input.o_max - input.o_min);
+
+            return chi * chi;
+        }
 
-            auto sd = scan_data.cbegin();
-            std::vector<double> wc_values = *wc_iterator;
-            for (auto w = wc_values.cbegin() ; wc_values.cend() != w ; ++w, ++sd)
+        /*
+         * Create an independent worker, which evaluates all inputs at one point of the scan.
+         *
+         * Each worker owns a clone of the parameters, and caches all inputs with respect to them.
+         * Its record holds the values of the scan parameters, the chi^2 of each input, and the total chi^2.
+         */
+        cli::BatchEngine::Worker make_worker(const CartesianProduct<std::vector<double>> & cp) const
+        {
+            Parameters p = parameters.clone();
+            ObservableCache cache(p);
+
+            std::vector<ObservableCache::Id> ids;
+            for (const auto & bin : bins)
             {
-                params[sd->name] = *w;
+                ids.push_back(cache.add(bin.second->clone(p)));
             }
 
-            // Calculate chi^2
-            double central = o->evaluate();
-            double delta_min = 0.0, delta_max = 0.0;
-            for (auto & variation_name : variation_names)
+            std::vector<Parameter> scan_parameters;
+            for (const auto & sd : scan_data)
             {
-                Parameter p = params[variation_name];
-                double old_p = p();
-                double max = 0.0, min = 0.0, value;
-
-                p = p.min();
-                value = o->evaluate();
-                if (value > central)
-                    max = value - central;
-
-                if (value < central)
-                    min = central - value;
-
-                p = p.max();
-                value = o->evaluate();
-                if (value > central)
-                    max = std::max(max, value - central);
-
-                if (value < central)
-                    min = std::max(min, central - value);
-
-                p = old_p;
+                scan_parameters.push_back(p[sd.name]);
+            }
 
-                delta_min += min * min;
-                delta_max += max * max;
+            std::vector<Parameter> variations;
+            for (const auto & variation_name : variation_names)
+            {
+                variations.push_back(p[variation_name]);
             }
 
-            delta_min += pow(central * theory_uncertainty, 2);
-            delta_max += pow(central * theory_uncertainty, 2);
+            return [this, cp, cache, ids, scan_parameters, variations] (const std::size_t & point, double * record) mutable
+            {
+                auto w = cp.begin();
+                w += point;
+                const std::vector<double> wc_values = *w;
+                for (std::size_t i = 0 ; i < wc_values.size() ; ++i)
+                {
+                    scan_parameters[i] = wc_values[i];
+                    record[i] = wc_values[i];
+                }
 
-            delta_max = std::sqrt(delta_max);
-            delta_min = std::sqrt(delta_min);
+                cache.update();
 
-            double chi = 0.0;
-            if (input.o - central > delta_max)
-                chi = input.o - central - delta_max;
-            else if (central - input.o > delta_min)
-                chi = central - input.o - delta_min;
+                const std::size_t n = ids.size();
+                std::vector<double> central(n), delta_min(n, 0.0), delta_max(n, 0.0);
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    central[i] = cache[ids[i]];
+                }
 
-            chi /= (input.o_max - input.o_min);
-            double chi_squared = chi * chi;
+                for (auto & p : variations)
+                {
+                    const double old_p = p();
+                    std::vector<double> min(n, 0.0), max(n, 0.0);
+
+                    p = p.min();
+                    cache.update();
+                    for (std::size_t i = 0 ; i < n ; ++i)
+                    {
+                        const double value = cache[ids[i]];
+                        if (value > central[i])
+                            max[i] = value - central[i];
+
+                        if (value < central[i])
+                            min[i] = central[i] - value;
+                    }
+
+                    p = p.max();
+                    cache.update();
+                    for (std::size_t i = 0 ; i < n ; ++i)
+                    {
+                        const double value = cache[ids[i]];
+                        if (value > central[i])
+                            max[i] = std::max(max[i], value - central[i]);
+
+                        if (value < central[i])
+                            min[i] = std::max(min[i], central[i] - value);
+                    }
+
+                    p = old_p;
+
+                    for (std::size_t i = 0 ; i < n ; ++i)
+                    {
+                        delta_min[i] += min[i] * min[i];
+                        delta_max[i] += max[i] * max[i];
+                    }
+                }
 
-            {
-                Lock l(*mutex);
-                results.push_back(std::make_pair(wc_values, chi_squared));
-            }
+                double total = 0.0;
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    delta_min[i] = std::sqrt(delta_min[i] + std::pow(central[i] * theory_uncertainty, 2));
+                    delta_max[i] = std::sqrt(delta_max[i] + std::pow(central[i] * theory_uncertainty, 2));
+
+                    const double chi_squared = chi_square(bins[i].first, central[i], delta_min[i], delta_max[i]);
+                    record[wc_values.size() + i] = chi_squared;
+                    total += chi_squared;
+                }
+                record[wc_values.size() + n] = total;
+            };
         }
 
-        void scan()
+        void scan(const BatchOptions & batch_options)
         {
-            std::cout << "# Generated by eos-scan (" EOS_GITHEAD ")" << std::endl;
-            std::cout << "# Scan data" << std::endl;
-
             CartesianProduct<std::vector<double>> cp;
+            std::vector<std::string> columns;
             for (auto sd = scan_data.cbegin() ; scan_data.cend() != sd ; ++sd)
             {
                 std::vector<double> set;
@@ -190,8 +242,32 @@ class WilsonScan
                     set.push_back(sd->min + delta * i);
                 }
                 cp.over(set);
+                columns.push_back(sd->name);
+            }
+
+            for (const auto & input : inputs)
+            {
+                columns.push_back("chi2[" + input.o_name + "," + stringify(input.min) + "," + stringify(input.max) + "]");
+            }
+            columns.push_back("chi2");
+
+            cli::BatchEngine engine(cp.size(), columns.size(), batch_options.chunk_size);
+            auto factory = [this, &cp] () { return this->make_worker(cp); };
+
+            if (! batch_options.output.empty())
+            {
+                cli::BinaryBatchOutput output(batch_options.output, columns, cp.size(), batch_options.chunk_size,
+                        batch_options.description, batch_options.resume);
+                engine.run(factory, output);
 
-                std::cout << "#   " << sd->name << ": [" << sd->min << ", " << sd->max << "], increment = " << delta << std::endl;
+                return;
+            }
+
+            std::cout << "# Generated by eos-scan (" EOS_GITHEAD ")" << std::endl;
+            std::cout << "# Scan data" << std::endl;
+            for (const auto & sd : scan_data)
+            {
+                std::cout << "#   " << sd.name << ": [" << sd.min << ", " << sd.max << "], increment = " << (sd.max - sd.min) / sd.points << std::endl;
             }
 
             std::cout << "# Inputs" << std::endl;
@@ -204,32 +280,17 @@ class WilsonScan
                     << std::endl;
             }
 
-            TicketList tickets;
-            unsigned long jobs = 0;
-            for (auto bin = bins.begin() ; bins.end() != bin ; ++bin)
+            std::cout << "# Columns" << std::endl;
+            std::cout << "#  ";
+            for (const auto & column : columns)
             {
-                for (auto w = cp.begin() ; cp.end() != w ; ++w)
-                {
-                    ThreadPool::instance()->wait_for_free_capacity();
-                    tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&WilsonScan::calc_chi_square, this, bin->first, bin->second, w)));
-                    ++jobs;
-                    if (jobs % 100 == 0)
-                        std::cerr << '[' << jobs << '/' << cp.size() << ']' << std::endl;
-                }
+                std::cout << ' ' << column;
             }
-
-            tickets.wait();
+            std::cout << std::endl;
 
             std::cout << std::scientific << std::setprecision(7);
-            for (const auto & result : results)
-            {
-                for (auto w = result.first.cbegin(), w_end = result.first.cend() ; w != w_end ; ++w)
-                {
-                    std::cout << *w << '\t';
-                }
-
-                std::cout << result.second << std::endl;
-            }
+            cli::TextBatchOutput output(std::cout, columns.size());
+            engine.run(factory, output);
         }
 };
 
@@ -260,9 +321,19 @@ main(int argc, char * argv[])
         std::list<std::string> variation_names;
         std::list<std::pair<std::string, double>> param_changes;
         double theory_uncertainty = 0.0;
+        BatchOptions batch_options{ "", 64, false, "" };
 
         Log::instance()->set_program_name("eos-scan");
 
+        // the description identifies the run when resuming; it comprises all arguments except --resume
+        for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+        {
+            if ("--resume" == std::string(*a))
+                continue;
+
+            batch_options.description += std::string(*a) + '\n';
+        }
+
         for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
         {
             std::string argument(*a);
@@ -313,6 +384,29 @@ main(int argc, char * argv[])
                 continue;
             }
 
+            if ("--output" == argument)
+            {
+                batch_options.output = std::string(*(++a));
+
+                continue;
+            }
+
+            if ("--chunk-size" == argument)
+            {
+                batch_options.chunk_size = destringify<unsigned>(*(++a));
+                if (0 == batch_options.chunk_size)
+                    throw DoUsage("Chunk size must be positive");
+
+                continue;
+            }
+
+            if ("--resume" == argument)
+            {
+                batch_options.resume = true;
+
+                continue;
+            }
+
             throw DoUsage("Unknown command line argument: " + argument);
         }
 
@@ -322,8 +416,11 @@ main(int argc, char * argv[])
         if (input.empty())
             throw DoUsage("Need at least one input");
 
+        if (batch_options.resume && batch_options.output.empty())
+            throw DoUsage("Resuming requires an output file");
+
         WilsonScan scanner(scan_data, input, param_changes, variation_names, theory_uncertainty);
-        scanner.scan();
+        scanner.scan(batch_options);
     }
     catch(DoUsage & e)
     {
@@ -334,6 +431,7 @@ main(int argc, char * argv[])
         std::cout << "  [--input NAME SMIN SMAX MIN CENTRAL MAX]+" << std::endl;
         std::cout << "  [--scan PARAMETER POINTS MIN MAX]+" << std::endl;
         std::cout << "  [--theory-uncertainty PERCENT]" << std::endl;
+        std::cout << "  [--output FILE [--resume]] [--chunk-size POINTS]" << std::endl;
     }
     catch(Exception & e)
     {